@@ -11,12 +11,14 @@ struct _PumpkinConfig {
   char *path;
   char *base_dir;
   char *default_download_url;
+  char *avatar_url;
   gboolean use_cache;
   gboolean run_in_background;
   gboolean detailed_overview_cards;
   gboolean autostart_on_boot;
   gboolean start_minimized;
   gboolean auto_start_servers_enabled;
+  int start_concurrency;
   gboolean review_prompt_shown;
   PumpkinDateFormat date_format;
   PumpkinTimeFormat time_format;
@@ -81,12 +83,14 @@ pumpkin_config_load(GError **error)
   config->path = config_path();
   config->base_dir = default_base_dir();
   config->default_download_url = g_strdup("");
+  config->avatar_url = g_strdup("");
   config->use_cache = TRUE;
   config->run_in_background = TRUE;
   config->detailed_overview_cards = FALSE;
   config->autostart_on_boot = FALSE;
   config->start_minimized = FALSE;
   config->auto_start_servers_enabled = FALSE;
+  config->start_concurrency = PUMPKIN_START_CONCURRENCY_DEFAULT;
   config->review_prompt_shown = FALSE;
   config->date_format = PUMPKIN_DATE_FORMAT_DMY;
   config->time_format = PUMPKIN_TIME_FORMAT_24H;
@@ -105,6 +109,13 @@ pumpkin_config_load(GError **error)
       config->default_download_url = g_strdup(url);
     }
 
+    /* Empty keeps the built-in avatar service; set it to point player heads at a local mirror. */
+    g_autofree char *avatar_url = g_key_file_get_string(key, "players", "avatar_url", NULL);
+    if (avatar_url != NULL && *avatar_url != '\0') {
+      g_clear_pointer(&config->avatar_url, g_free);
+      config->avatar_url = g_strdup(avatar_url);
+    }
+
     if (g_key_file_has_key(key, "storage", "use_cache", NULL)) {
       config->use_cache = g_key_file_get_boolean(key, "storage", "use_cache", NULL);
     }
@@ -129,6 +140,10 @@ pumpkin_config_load(GError **error)
       config->auto_start_servers_enabled = g_key_file_get_boolean(key, "behavior", "auto_start_servers_enabled", NULL);
     }
 
+    if (g_key_file_has_key(key, "behavior", "start_concurrency", NULL)) {
+      pumpkin_config_set_start_concurrency(config, g_key_file_get_integer(key, "behavior", "start_concurrency", NULL));
+    }
+
     if (g_key_file_has_key(key, "behavior", "review_prompt_shown", NULL)) {
       config->review_prompt_shown = g_key_file_get_boolean(key, "behavior", "review_prompt_shown", NULL);
     }
@@ -189,11 +204,13 @@ pumpkin_config_save(PumpkinConfig *config, GError **error)
   g_key_file_set_string(key, "storage", "base_dir", config->base_dir);
   g_key_file_set_boolean(key, "storage", "use_cache", config->use_cache);
   g_key_file_set_string(key, "updates", "default_download_url", config->default_download_url);
+  g_key_file_set_string(key, "players", "avatar_url", config->avatar_url);
   g_key_file_set_boolean(key, "behavior", "run_in_background", config->run_in_background);
   g_key_file_set_boolean(key, "behavior", "detailed_overview_cards", config->detailed_overview_cards);
   g_key_file_set_boolean(key, "behavior", "autostart_on_boot", config->autostart_on_boot);
   g_key_file_set_boolean(key, "behavior", "start_minimized", config->start_minimized);
   g_key_file_set_boolean(key, "behavior", "auto_start_servers_enabled", config->auto_start_servers_enabled);
+  g_key_file_set_integer(key, "behavior", "start_concurrency", config->start_concurrency);
   g_key_file_set_boolean(key, "behavior", "review_prompt_shown", config->review_prompt_shown);
   g_key_file_set_integer(key, "behavior", "date_format", config->date_format);
   g_key_file_set_integer(key, "behavior", "time_format", config->time_format);
@@ -214,6 +231,7 @@ pumpkin_config_free(PumpkinConfig *config)
   g_clear_pointer(&config->path, g_free);
   g_clear_pointer(&config->base_dir, g_free);
   g_clear_pointer(&config->default_download_url, g_free);
+  g_clear_pointer(&config->avatar_url, g_free);
   g_free(config);
 }
 
@@ -229,6 +247,12 @@ pumpkin_config_get_default_download_url(PumpkinConfig *config)
   return config->default_download_url;
 }
 
+const char *
+pumpkin_config_get_avatar_url(PumpkinConfig *config)
+{
+  return config->avatar_url;
+}
+
 gboolean
 pumpkin_config_get_use_cache(PumpkinConfig *config)
 {
@@ -261,6 +285,13 @@ pumpkin_config_set_default_download_url(PumpkinConfig *config, const char *url)
   config->default_download_url = g_strdup(url);
 }
 
+void
+pumpkin_config_set_avatar_url(PumpkinConfig *config, const char *url)
+{
+  g_free(config->avatar_url);
+  config->avatar_url = g_strdup(url != NULL ? url : "");
+}
+
 void
 pumpkin_config_set_use_cache(PumpkinConfig *config, gboolean enabled)
 {
@@ -297,6 +328,12 @@ pumpkin_config_get_auto_start_servers_enabled(PumpkinConfig *config)
   return config->auto_start_servers_enabled;
 }
 
+int
+pumpkin_config_get_start_concurrency(PumpkinConfig *config)
+{
+  return config->start_concurrency;
+}
+
 gboolean
 pumpkin_config_get_review_prompt_shown(PumpkinConfig *config)
 {
@@ -333,6 +370,12 @@ pumpkin_config_set_auto_start_servers_enabled(PumpkinConfig *config, gboolean en
   config->auto_start_servers_enabled = enabled;
 }
 
+void
+pumpkin_config_set_start_concurrency(PumpkinConfig *config, int count)
+{
+  config->start_concurrency = CLAMP(count, 0, PUMPKIN_START_CONCURRENCY_MAX);
+}
+
 void
 pumpkin_config_set_review_prompt_shown(PumpkinConfig *config, gboolean shown)
 {
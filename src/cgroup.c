@@ -0,0 +1,399 @@
+#include "cgroup.h"
+
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define CGROUP_ROOT "/sys/fs/cgroup"
+#define CGROUP_ENV "SMASHED_PUMPKIN_CGROUP"
+#define CGROUP_PREFIX "smashed_pumpkin"
+
+static int
+clamp_weight(int weight)
+{
+  if (weight <= 0) {
+    return PUMPKIN_CGROUP_WEIGHT_DEFAULT;
+  }
+  return CLAMP(weight, PUMPKIN_CGROUP_WEIGHT_MIN, PUMPKIN_CGROUP_WEIGHT_MAX);
+}
+
+static char *
+sanitize_unit_part(const char *text)
+{
+  GString *out = g_string_new(NULL);
+  for (const char *p = text != NULL ? text : ""; *p != '\0'; p++) {
+    g_string_append_c(out, g_ascii_isalnum(*p) || *p == '_' ? *p : '_');
+  }
+  if (out->len == 0) {
+    g_string_append(out, "server");
+  }
+  return g_string_free(out, FALSE);
+}
+
+#if defined(__linux__)
+static gboolean
+controllers_contain(const char *path, const char *controller)
+{
+  g_autofree char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return FALSE;
+  }
+  g_auto(GStrv) names = g_strsplit_set(g_strstrip(contents), " \n", -1);
+  return g_strv_contains((const char * const *)names, controller);
+}
+
+/* cgroupfs files must be written in place; g_file_set_contents() would rename over them. */
+static gboolean
+write_cgroup_file(const char *dir, const char *name, const char *value, GError **error)
+{
+  g_autofree char *path = g_build_filename(dir, name, NULL);
+  int fd = open(path, O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    int saved = errno;
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to open %s: %s", path, g_strerror(saved));
+    return FALSE;
+  }
+  gsize len = strlen(value);
+  gboolean ok = write(fd, value, len) == (gssize)len;
+  int saved = errno;
+  close(fd);
+  if (!ok) {
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to write %s: %s", path, g_strerror(saved));
+  }
+  return ok;
+}
+
+static void
+enable_controllers(const char *dir)
+{
+  static const char *controllers[] = { "+memory", "+cpu", "+io" };
+  for (guint i = 0; i < G_N_ELEMENTS(controllers); i++) {
+    write_cgroup_file(dir, "cgroup.subtree_control", controllers[i], NULL);
+  }
+}
+
+static gboolean
+systemd_user_manager_usable(void)
+{
+  g_autofree char *systemd_run = g_find_program_in_path("systemd-run");
+  g_autofree char *systemctl = g_find_program_in_path("systemctl");
+  if (systemd_run == NULL || systemctl == NULL) {
+    return FALSE;
+  }
+  /* systemd-run --user talks to the manager over the user bus, not its private socket. */
+  const char *bus_address = g_getenv("DBUS_SESSION_BUS_ADDRESS");
+  if (bus_address == NULL || *bus_address == '\0') {
+    g_autofree char *bus_socket = g_build_filename(g_get_user_runtime_dir(), "bus", NULL);
+    if (!g_file_test(bus_socket, G_FILE_TEST_EXISTS)) {
+      return FALSE;
+    }
+  }
+
+  /* Without memory and cpu delegated to the user manager the scope properties are silently ignored. */
+  guint uid = (guint)getuid();
+  g_autofree char *controllers = g_strdup_printf(CGROUP_ROOT "/user.slice/user-%u.slice/user@%u.service/cgroup.controllers",
+                                                 uid, uid);
+  return controllers_contain(controllers, "memory") && controllers_contain(controllers, "cpu");
+}
+#endif
+
+PumpkinCgroupMode
+pumpkin_cgroup_detect(void)
+{
+#if defined(__linux__)
+  static int cached = -1;
+  if (cached >= 0) {
+    return (PumpkinCgroupMode)cached;
+  }
+
+  PumpkinCgroupMode mode = PUMPKIN_CGROUP_NONE;
+  const char *override = g_getenv(CGROUP_ENV);
+  if (!g_file_test(CGROUP_ROOT "/cgroup.controllers", G_FILE_TEST_EXISTS) ||
+      g_strcmp0(override, "off") == 0) {
+    mode = PUMPKIN_CGROUP_NONE;
+  } else if (override != NULL && g_path_is_absolute(override)) {
+    g_autofree char *subtree = g_build_filename(override, "cgroup.subtree_control", NULL);
+    if (access(subtree, W_OK) == 0) {
+      mode = PUMPKIN_CGROUP_DIRECT;
+    }
+  } else if (systemd_user_manager_usable()) {
+    mode = PUMPKIN_CGROUP_SYSTEMD;
+  }
+  cached = (int)mode;
+  return mode;
+#else
+  return PUMPKIN_CGROUP_NONE;
+#endif
+}
+
+const char *
+pumpkin_cgroup_mode_label(PumpkinCgroupMode mode)
+{
+  switch (mode) {
+    case PUMPKIN_CGROUP_SYSTEMD:
+      return "systemd scope";
+    case PUMPKIN_CGROUP_DIRECT:
+      return "delegated cgroup";
+    case PUMPKIN_CGROUP_NONE:
+    default:
+      return "process limits";
+  }
+}
+
+char *
+pumpkin_cgroup_scope_name(const char *server_id, guint serial)
+{
+  g_autofree char *id = sanitize_unit_part(server_id);
+  return g_strdup_printf(CGROUP_PREFIX "-%s-%" G_GINT64_FORMAT "-%u.scope",
+                         id, g_get_real_time() / G_USEC_PER_SEC, serial);
+}
+
+char *
+pumpkin_cgroup_slice_name(const char *group_id)
+{
+  if (group_id == NULL || *group_id == '\0') {
+    return g_strdup(CGROUP_PREFIX ".slice");
+  }
+  /* A dash nests the slice, so every network slice sits under the app slice. */
+  g_autofree char *group = sanitize_unit_part(group_id);
+  return g_strdup_printf(CGROUP_PREFIX "-%s.slice", group);
+}
+
+static void
+append_systemd_properties(GPtrArray *out, const PumpkinCgroupLimits *limits, gboolean reset_unset, gboolean with_flag)
+{
+  g_autoptr(GPtrArray) props = g_ptr_array_new_with_free_func(g_free);
+  if (limits->max_ram_mb > 0) {
+    g_ptr_array_add(props, g_strdup_printf("MemoryMax=%dM", limits->max_ram_mb));
+    g_ptr_array_add(props, g_strdup_printf("MemoryHigh=%dM", MAX(1, limits->max_ram_mb * 9 / 10)));
+  } else if (reset_unset) {
+    g_ptr_array_add(props, g_strdup("MemoryMax=infinity"));
+    g_ptr_array_add(props, g_strdup("MemoryHigh=infinity"));
+  }
+  if (limits->max_cpu_cores > 0) {
+    g_ptr_array_add(props, g_strdup_printf("CPUQuota=%d%%", limits->max_cpu_cores * 100));
+  } else if (reset_unset) {
+    g_ptr_array_add(props, g_strdup("CPUQuota="));
+  }
+  g_ptr_array_add(props, g_strdup_printf("CPUWeight=%d", clamp_weight(limits->cpu_weight)));
+  g_ptr_array_add(props, g_strdup_printf("IOWeight=%d", clamp_weight(limits->io_weight)));
+
+  for (guint i = 0; i < props->len; i++) {
+    if (with_flag) {
+      g_ptr_array_add(out, g_strdup("-p"));
+    }
+    g_ptr_array_add(out, g_strdup(g_ptr_array_index(props, i)));
+  }
+}
+
+void
+pumpkin_cgroup_append_systemd_run_argv(GPtrArray *argv,
+                                       const char *scope,
+                                       const char *slice,
+                                       const PumpkinCgroupLimits *limits)
+{
+  g_return_if_fail(argv != NULL && scope != NULL && limits != NULL);
+
+  /* A scope execs the command in place, so the pid and stdio pipes stay ours. */
+  g_ptr_array_add(argv, g_strdup("systemd-run"));
+  g_ptr_array_add(argv, g_strdup("--user"));
+  g_ptr_array_add(argv, g_strdup("--scope"));
+  g_ptr_array_add(argv, g_strdup("--quiet"));
+  g_ptr_array_add(argv, g_strdup("--collect"));
+  g_ptr_array_add(argv, g_strdup_printf("--unit=%s", scope));
+  if (slice != NULL) {
+    g_ptr_array_add(argv, g_strdup_printf("--slice=%s", slice));
+  }
+  append_systemd_properties(argv, limits, FALSE, TRUE);
+  g_ptr_array_add(argv, g_strdup("--"));
+}
+
+static void
+set_property_done_cb(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+  g_autofree char *scope = user_data;
+  g_autoptr(GError) error = NULL;
+  if (!g_subprocess_wait_check_finish(G_SUBPROCESS(source), res, &error)) {
+    g_warning("Failed to update limits of %s: %s", scope, error != NULL ? error->message : "unknown error");
+  }
+  g_object_unref(source);
+}
+
+gboolean
+pumpkin_cgroup_apply_systemd(const char *scope, const PumpkinCgroupLimits *limits, GError **error)
+{
+  g_return_val_if_fail(scope != NULL && limits != NULL, FALSE);
+
+  g_autoptr(GPtrArray) argv = g_ptr_array_new_with_free_func(g_free);
+  g_ptr_array_add(argv, g_strdup("systemctl"));
+  g_ptr_array_add(argv, g_strdup("--user"));
+  g_ptr_array_add(argv, g_strdup("set-property"));
+  g_ptr_array_add(argv, g_strdup("--runtime"));
+  g_ptr_array_add(argv, g_strdup(scope));
+  append_systemd_properties(argv, limits, TRUE, FALSE);
+  g_ptr_array_add(argv, NULL);
+
+  GSubprocess *process = g_subprocess_newv((const char * const *)argv->pdata,
+                                           G_SUBPROCESS_FLAGS_STDOUT_SILENCE | G_SUBPROCESS_FLAGS_STDERR_SILENCE,
+                                           error);
+  if (process == NULL) {
+    return FALSE;
+  }
+  g_subprocess_wait_check_async(process, NULL, set_property_done_cb, g_strdup(scope));
+  return TRUE;
+}
+
+char *
+pumpkin_cgroup_create_direct(const char *server_id, const char *group_id, GError **error)
+{
+#if defined(__linux__)
+  const char *root = g_getenv(CGROUP_ENV);
+  if (root == NULL || !g_path_is_absolute(root)) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "No delegated cgroup configured");
+    return NULL;
+  }
+
+  g_autofree char *parent = g_strdup(root);
+  enable_controllers(parent);
+  if (group_id != NULL && *group_id != '\0') {
+    g_autofree char *group = sanitize_unit_part(group_id);
+    g_autofree char *group_dir = g_build_filename(root, group, NULL);
+    if (g_mkdir(group_dir, 0755) != 0 && errno != EEXIST) {
+      int saved = errno;
+      g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to create %s: %s", group_dir, g_strerror(saved));
+      return NULL;
+    }
+    enable_controllers(group_dir);
+    g_free(parent);
+    parent = g_steal_pointer(&group_dir);
+  }
+
+  g_autofree char *id = sanitize_unit_part(server_id);
+  char *dir = g_build_filename(parent, id, NULL);
+  if (g_mkdir(dir, 0755) != 0 && errno != EEXIST) {
+    int saved = errno;
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to create %s: %s", dir, g_strerror(saved));
+    g_free(dir);
+    return NULL;
+  }
+  return dir;
+#else
+  (void)server_id;
+  (void)group_id;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "cgroups are not supported on this platform");
+  return NULL;
+#endif
+}
+
+gboolean
+pumpkin_cgroup_apply_direct(const char *path, const PumpkinCgroupLimits *limits, GError **error)
+{
+#if defined(__linux__)
+  g_return_val_if_fail(path != NULL && limits != NULL, FALSE);
+
+  g_autofree char *memory_max = limits->max_ram_mb > 0
+    ? g_strdup_printf("%" G_GUINT64_FORMAT, (guint64)limits->max_ram_mb * 1024 * 1024)
+    : g_strdup("max");
+  g_autofree char *memory_high = limits->max_ram_mb > 0
+    ? g_strdup_printf("%" G_GUINT64_FORMAT, (guint64)limits->max_ram_mb * 1024 * 1024 / 10 * 9)
+    : g_strdup("max");
+  g_autofree char *cpu_max = limits->max_cpu_cores > 0
+    ? g_strdup_printf("%d 100000", limits->max_cpu_cores * 100000)
+    : g_strdup("max 100000");
+  g_autofree char *cpu_weight = g_strdup_printf("%d", clamp_weight(limits->cpu_weight));
+  g_autofree char *io_weight = g_strdup_printf("default %d", clamp_weight(limits->io_weight));
+
+  if (!write_cgroup_file(path, "memory.max", memory_max, error) ||
+      !write_cgroup_file(path, "memory.high", memory_high, error) ||
+      !write_cgroup_file(path, "cpu.max", cpu_max, error) ||
+      !write_cgroup_file(path, "cpu.weight", cpu_weight, error)) {
+    return FALSE;
+  }
+  /* io.weight only exists with a proportional I/O scheduler; treat it as best effort. */
+  write_cgroup_file(path, "io.weight", io_weight, NULL);
+  return TRUE;
+#else
+  (void)path;
+  (void)limits;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "cgroups are not supported on this platform");
+  return FALSE;
+#endif
+}
+
+gboolean
+pumpkin_cgroup_set_frozen(const char *path, gboolean frozen, GError **error)
+{
+#if defined(__linux__)
+  g_return_val_if_fail(path != NULL, FALSE);
+  return write_cgroup_file(path, "cgroup.freeze", frozen ? "1" : "0", error);
+#else
+  (void)path;
+  (void)frozen;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "cgroups are not supported on this platform");
+  return FALSE;
+#endif
+}
+
+/* memory.reclaim answers EAGAIN when it freed less than asked; that still counts. */
+gboolean
+pumpkin_cgroup_reclaim(const char *path, guint64 bytes, GError **error)
+{
+#if defined(__linux__)
+  g_return_val_if_fail(path != NULL, FALSE);
+  g_autofree char *value = g_strdup_printf("%" G_GUINT64_FORMAT, bytes);
+  g_autoptr(GError) local_error = NULL;
+  if (write_cgroup_file(path, "memory.reclaim", value, &local_error) ||
+      g_error_matches(local_error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
+    return TRUE;
+  }
+  g_propagate_error(error, g_steal_pointer(&local_error));
+  return FALSE;
+#else
+  (void)path;
+  (void)bytes;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "cgroups are not supported on this platform");
+  return FALSE;
+#endif
+}
+
+void
+pumpkin_cgroup_remove_direct(const char *path)
+{
+#if defined(__linux__)
+  if (path != NULL) {
+    g_rmdir(path);
+  }
+#else
+  (void)path;
+#endif
+}
+
+char *
+pumpkin_cgroup_path_for_pid(int pid)
+{
+#if defined(__linux__)
+  if (pid <= 0) {
+    return NULL;
+  }
+  g_autofree char *proc_path = g_strdup_printf("/proc/%d/cgroup", pid);
+  g_autofree char *contents = NULL;
+  if (!g_file_get_contents(proc_path, &contents, NULL, NULL)) {
+    return NULL;
+  }
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  for (guint i = 0; lines[i] != NULL; i++) {
+    if (g_str_has_prefix(lines[i], "0::")) {
+      return g_build_filename(CGROUP_ROOT, lines[i] + 3, NULL);
+    }
+  }
+  return NULL;
+#else
+  (void)pid;
+  return NULL;
+#endif
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glib.h>
+
+typedef enum {
+  PUMPKIN_CGROUP_NONE = 0,
+  PUMPKIN_CGROUP_SYSTEMD,
+  PUMPKIN_CGROUP_DIRECT
+} PumpkinCgroupMode;
+
+typedef struct {
+  int max_cpu_cores;
+  int max_ram_mb;
+  int cpu_weight;
+  int io_weight;
+} PumpkinCgroupLimits;
+
+enum {
+  PUMPKIN_CGROUP_WEIGHT_DEFAULT = 100,
+  PUMPKIN_CGROUP_WEIGHT_MIN = 1,
+  PUMPKIN_CGROUP_WEIGHT_MAX = 10000
+};
+
+PumpkinCgroupMode pumpkin_cgroup_detect(void);
+const char *pumpkin_cgroup_mode_label(PumpkinCgroupMode mode);
+char *pumpkin_cgroup_scope_name(const char *server_id, guint serial);
+char *pumpkin_cgroup_slice_name(const char *group_id);
+void pumpkin_cgroup_append_systemd_run_argv(GPtrArray *argv,
+                                            const char *scope,
+                                            const char *slice,
+                                            const PumpkinCgroupLimits *limits);
+gboolean pumpkin_cgroup_apply_systemd(const char *scope, const PumpkinCgroupLimits *limits, GError **error);
+char *pumpkin_cgroup_create_direct(const char *server_id, const char *group_id, GError **error);
+gboolean pumpkin_cgroup_apply_direct(const char *path, const PumpkinCgroupLimits *limits, GError **error);
+gboolean pumpkin_cgroup_set_frozen(const char *path, gboolean frozen, GError **error);
+gboolean pumpkin_cgroup_reclaim(const char *path, guint64 bytes, GError **error);
+void pumpkin_cgroup_remove_direct(const char *path);
+char *pumpkin_cgroup_path_for_pid(int pid);
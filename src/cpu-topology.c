@@ -0,0 +1,594 @@
+#define _GNU_SOURCE
+#include "cpu-topology.h"
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#define CPU_SYSFS "/sys/devices/system/cpu"
+#define NODE_SYSFS "/sys/devices/system/node"
+
+struct _PumpkinCpuAllocator {
+  GArray *cpus;
+  int *users;
+  int max_cpu;
+  int *position;
+  GHashTable *owners;
+};
+
+typedef struct {
+  char *owner;
+  int count;
+} CpuRequest;
+
+static GArray *
+parse_cpu_list(const char *text)
+{
+  GArray *cpus = g_array_new(FALSE, FALSE, sizeof(int));
+  if (text == NULL) {
+    return cpus;
+  }
+  g_auto(GStrv) ranges = g_strsplit(text, ",", -1);
+  for (guint i = 0; ranges[i] != NULL; i++) {
+    char *range = g_strstrip(ranges[i]);
+    if (*range == '\0') {
+      continue;
+    }
+    char *end = NULL;
+    long first = strtol(range, &end, 10);
+    long last = first;
+    if (end != NULL && *end == '-') {
+      last = strtol(end + 1, NULL, 10);
+    }
+    for (long cpu = first; cpu <= last && cpu >= 0; cpu++) {
+      int value = (int)cpu;
+      g_array_append_val(cpus, value);
+    }
+  }
+  return cpus;
+}
+
+static char *
+read_sysfs(const char *path)
+{
+  char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return NULL;
+  }
+  return g_strstrip(contents);
+}
+
+static int
+first_cpu_in_list_file(const char *path, int fallback)
+{
+  g_autofree char *text = read_sysfs(path);
+  if (text == NULL) {
+    return fallback;
+  }
+  g_autoptr(GArray) cpus = parse_cpu_list(text);
+  return cpus->len > 0 ? g_array_index(cpus, int, 0) : fallback;
+}
+
+static int
+read_int_file(const char *path, int fallback)
+{
+  g_autofree char *text = read_sysfs(path);
+  if (text == NULL || *text == '\0') {
+    return fallback;
+  }
+  return (int)g_ascii_strtoll(text, NULL, 10);
+}
+
+static int
+compare_cpu_info(gconstpointer a, gconstpointer b)
+{
+  const PumpkinCpuInfo *left = a;
+  const PumpkinCpuInfo *right = b;
+  if (left->node != right->node) {
+    return left->node < right->node ? -1 : 1;
+  }
+  if (left->l3 != right->l3) {
+    return left->l3 < right->l3 ? -1 : 1;
+  }
+  if (left->core != right->core) {
+    return left->core < right->core ? -1 : 1;
+  }
+  return left->cpu - right->cpu;
+}
+
+static int
+compare_int(gconstpointer a, gconstpointer b)
+{
+  return *(const int *)a - *(const int *)b;
+}
+
+static GArray *
+load_topology(void)
+{
+  GArray *infos = g_array_new(FALSE, FALSE, sizeof(PumpkinCpuInfo));
+  g_autofree char *online_text = read_sysfs(CPU_SYSFS "/online");
+  g_autoptr(GArray) online = parse_cpu_list(online_text);
+  if (online->len == 0) {
+    int n = MAX(1, (int)g_get_num_processors());
+    for (int cpu = 0; cpu < n; cpu++) {
+      g_array_append_val(online, cpu);
+    }
+  }
+
+  g_autoptr(GHashTable) node_of = g_hash_table_new(g_direct_hash, g_direct_equal);
+  GDir *dir = g_dir_open(NODE_SYSFS, 0, NULL);
+  if (dir != NULL) {
+    const char *name = NULL;
+    while ((name = g_dir_read_name(dir)) != NULL) {
+      if (!g_str_has_prefix(name, "node") || !g_ascii_isdigit(name[4])) {
+        continue;
+      }
+      int node = (int)g_ascii_strtoll(name + 4, NULL, 10);
+      g_autofree char *path = g_build_filename(NODE_SYSFS, name, "cpulist", NULL);
+      g_autofree char *text = read_sysfs(path);
+      g_autoptr(GArray) cpus = parse_cpu_list(text);
+      for (guint i = 0; i < cpus->len; i++) {
+        g_hash_table_insert(node_of, GINT_TO_POINTER(g_array_index(cpus, int, i) + 1), GINT_TO_POINTER(node));
+      }
+    }
+    g_dir_close(dir);
+  }
+
+  for (guint i = 0; i < online->len; i++) {
+    PumpkinCpuInfo info = { 0 };
+    info.cpu = g_array_index(online, int, i);
+    g_autofree char *base = g_strdup_printf(CPU_SYSFS "/cpu%d", info.cpu);
+    g_autofree char *package_path = g_build_filename(base, "topology", "physical_package_id", NULL);
+    g_autofree char *siblings_path = g_build_filename(base, "topology", "thread_siblings_list", NULL);
+    info.package = MAX(0, read_int_file(package_path, 0));
+    /* The lowest sibling names the physical core, which keeps SMT threads together. */
+    info.core = first_cpu_in_list_file(siblings_path, info.cpu);
+    info.l3 = -1;
+    for (int index = 0; index < 8 && info.l3 < 0; index++) {
+      g_autofree char *level_path = g_strdup_printf("%s/cache/index%d/level", base, index);
+      int level = read_int_file(level_path, -1);
+      if (level < 0) {
+        break;
+      }
+      if (level == 3) {
+        g_autofree char *shared_path = g_strdup_printf("%s/cache/index%d/shared_cpu_list", base, index);
+        info.l3 = first_cpu_in_list_file(shared_path, -1);
+      }
+    }
+    if (info.l3 < 0) {
+      info.l3 = G_MAXINT / 2 + info.package;
+    }
+    info.node = GPOINTER_TO_INT(g_hash_table_lookup(node_of, GINT_TO_POINTER(info.cpu + 1)));
+    g_array_append_val(infos, info);
+  }
+  g_array_sort(infos, compare_cpu_info);
+  return infos;
+}
+
+PumpkinCpuAllocator *
+pumpkin_cpu_allocator_get_default(void)
+{
+  static PumpkinCpuAllocator *allocator = NULL;
+  if (allocator != NULL) {
+    return allocator;
+  }
+  allocator = g_new0(PumpkinCpuAllocator, 1);
+  allocator->cpus = load_topology();
+  allocator->users = g_new0(int, MAX(1, allocator->cpus->len));
+  for (guint i = 0; i < allocator->cpus->len; i++) {
+    allocator->max_cpu = MAX(allocator->max_cpu, g_array_index(allocator->cpus, PumpkinCpuInfo, i).cpu);
+  }
+  allocator->position = g_new(int, allocator->max_cpu + 1);
+  for (int cpu = 0; cpu <= allocator->max_cpu; cpu++) {
+    allocator->position[cpu] = -1;
+  }
+  for (guint i = 0; i < allocator->cpus->len; i++) {
+    allocator->position[g_array_index(allocator->cpus, PumpkinCpuInfo, i).cpu] = (int)i;
+  }
+  allocator->owners = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_array_unref);
+  return allocator;
+}
+
+static const PumpkinCpuInfo *
+cpu_at(PumpkinCpuAllocator *self, guint pos)
+{
+  return &g_array_index(self->cpus, PumpkinCpuInfo, pos);
+}
+
+/* Take free CPUs from [start, end), whole physical cores first. */
+static void
+take_from_domain(PumpkinCpuAllocator *self, guint start, guint end, int count, GArray *out)
+{
+  for (int pass = 0; pass < 2 && (int)out->len < count; pass++) {
+    guint pos = start;
+    while (pos < end && (int)out->len < count) {
+      guint core_end = pos;
+      gboolean core_free = TRUE;
+      while (core_end < end && cpu_at(self, core_end)->core == cpu_at(self, pos)->core) {
+        core_free = core_free && self->users[core_end] == 0;
+        core_end++;
+      }
+      if (pass == 1 || core_free) {
+        for (guint i = pos; i < core_end && (int)out->len < count; i++) {
+          if (self->users[i] == 0) {
+            self->users[i]++;
+            g_array_append_val(out, cpu_at(self, i)->cpu);
+          }
+        }
+      }
+      pos = core_end;
+    }
+  }
+}
+
+static gboolean
+cpu_set_contains(const GArray *cpus, int cpu)
+{
+  for (guint i = 0; i < cpus->len; i++) {
+    if (g_array_index(cpus, int, i) == cpu) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static guint
+domain_end(PumpkinCpuAllocator *self, guint start)
+{
+  guint end = start;
+  while (end < self->cpus->len && cpu_at(self, end)->l3 == cpu_at(self, start)->l3) {
+    end++;
+  }
+  return end;
+}
+
+static int
+domain_free(PumpkinCpuAllocator *self, guint start, guint end)
+{
+  int free_cpus = 0;
+  for (guint i = start; i < end; i++) {
+    free_cpus += self->users[i] == 0 ? 1 : 0;
+  }
+  return free_cpus;
+}
+
+static GArray *
+pick_cpus(PumpkinCpuAllocator *self, int count, gboolean single_domain)
+{
+  GArray *out = g_array_new(FALSE, FALSE, sizeof(int));
+  guint best_start = G_MAXUINT;
+  int best_free = G_MAXINT;
+  int widest_free = -1;
+  guint widest_start = 0;
+  for (guint start = 0; start < self->cpus->len; start = domain_end(self, start)) {
+    int free_cpus = domain_free(self, start, domain_end(self, start));
+    if (free_cpus >= count && free_cpus < best_free) {
+      best_free = free_cpus;
+      best_start = start;
+    }
+    if (free_cpus > widest_free) {
+      widest_free = free_cpus;
+      widest_start = start;
+    }
+  }
+
+  if (best_start != G_MAXUINT) {
+    take_from_domain(self, best_start, domain_end(self, best_start), count, out);
+  } else if (single_domain) {
+    g_array_unref(out);
+    return NULL;
+  } else {
+    /* Spill from the roomiest domain outwards, staying on its NUMA node first. */
+    int node = self->cpus->len > 0 ? cpu_at(self, widest_start)->node : 0;
+    take_from_domain(self, widest_start, domain_end(self, widest_start), count, out);
+    for (int same_node = 1; same_node >= 0; same_node--) {
+      for (guint start = 0; start < self->cpus->len && (int)out->len < count; start = domain_end(self, start)) {
+        if ((cpu_at(self, start)->node == node) == (same_node == 1)) {
+          take_from_domain(self, start, domain_end(self, start), count, out);
+        }
+      }
+    }
+    /* Oversubscribed: share the least used CPUs rather than piling onto CPU 0. */
+    while ((int)out->len < count && out->len < self->cpus->len) {
+      int least = -1;
+      for (guint i = 0; i < self->cpus->len; i++) {
+        if (cpu_set_contains(out, cpu_at(self, i)->cpu)) {
+          continue;
+        }
+        if (least < 0 || self->users[i] < self->users[least]) {
+          least = (int)i;
+        }
+      }
+      if (least < 0) {
+        break;
+      }
+      self->users[least]++;
+      g_array_append_val(out, cpu_at(self, (guint)least)->cpu);
+    }
+  }
+  g_array_sort(out, compare_int);
+  return out;
+}
+
+static void
+unuse_cpus(PumpkinCpuAllocator *self, const GArray *cpus)
+{
+  for (guint i = 0; i < cpus->len; i++) {
+    int cpu = g_array_index(cpus, int, i);
+    if (cpu >= 0 && cpu <= self->max_cpu && self->position[cpu] >= 0 && self->users[self->position[cpu]] > 0) {
+      self->users[self->position[cpu]]--;
+    }
+  }
+}
+
+static void
+use_cpus(PumpkinCpuAllocator *self, const GArray *cpus)
+{
+  for (guint i = 0; i < cpus->len; i++) {
+    int cpu = g_array_index(cpus, int, i);
+    if (cpu >= 0 && cpu <= self->max_cpu && self->position[cpu] >= 0) {
+      self->users[self->position[cpu]]++;
+    }
+  }
+}
+
+/* Spans more than one L3 cache or shares a CPU with another owner. */
+static gboolean
+placement_degraded(PumpkinCpuAllocator *self, const GArray *cpus)
+{
+  int l3 = G_MININT;
+  for (guint i = 0; i < cpus->len; i++) {
+    int cpu = g_array_index(cpus, int, i);
+    int pos = cpu >= 0 && cpu <= self->max_cpu ? self->position[cpu] : -1;
+    if (pos < 0) {
+      continue;
+    }
+    if (self->users[pos] > 1 || (l3 != G_MININT && cpu_at(self, pos)->l3 != l3)) {
+      return TRUE;
+    }
+    l3 = cpu_at(self, pos)->l3;
+  }
+  return FALSE;
+}
+
+static int
+compare_request(gconstpointer a, gconstpointer b)
+{
+  const CpuRequest *left = a;
+  const CpuRequest *right = b;
+  return right->count - left->count;
+}
+
+static gboolean
+cpu_sets_equal(const GArray *a, const GArray *b)
+{
+  return a->len == b->len && memcmp(a->data, b->data, a->len * sizeof(int)) == 0;
+}
+
+/*
+ * Repack every owner largest-first so each lands inside one cache domain, or leave things as they were.
+ * A NULL owner repacks only the existing owners.
+ */
+static gboolean
+repack(PumpkinCpuAllocator *self, const char *owner, int count, GPtrArray *moved_owners)
+{
+  g_autoptr(GArray) requests = g_array_new(FALSE, FALSE, sizeof(CpuRequest));
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->owners);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    CpuRequest request = { key, (int)((GArray *)value)->len };
+    g_array_append_val(requests, request);
+  }
+  if (owner != NULL) {
+    CpuRequest fresh = { (char *)owner, count };
+    g_array_append_val(requests, fresh);
+  }
+  g_array_sort(requests, compare_request);
+
+  g_autofree int *saved_users = g_new(int, MAX(1, self->cpus->len));
+  memcpy(saved_users, self->users, sizeof(int) * self->cpus->len);
+  memset(self->users, 0, sizeof(int) * self->cpus->len);
+  g_autoptr(GPtrArray) picked = g_ptr_array_new_with_free_func((GDestroyNotify)g_array_unref);
+  for (guint i = 0; i < requests->len; i++) {
+    GArray *cpus = pick_cpus(self, g_array_index(requests, CpuRequest, i).count, TRUE);
+    if (cpus == NULL) {
+      memcpy(self->users, saved_users, sizeof(int) * self->cpus->len);
+      return FALSE;
+    }
+    g_ptr_array_add(picked, cpus);
+  }
+
+  for (guint i = 0; i < requests->len; i++) {
+    CpuRequest *request = &g_array_index(requests, CpuRequest, i);
+    GArray *cpus = g_array_ref(g_ptr_array_index(picked, i));
+    GArray *previous = g_hash_table_lookup(self->owners, request->owner);
+    if (previous != NULL && !cpu_sets_equal(previous, cpus) && moved_owners != NULL) {
+      g_ptr_array_add(moved_owners, g_strdup(request->owner));
+    }
+    g_hash_table_replace(self->owners, g_strdup(request->owner), cpus);
+  }
+  return TRUE;
+}
+
+const GArray *
+pumpkin_cpu_allocator_acquire(PumpkinCpuAllocator *self, const char *owner, int cpus, GPtrArray *moved_owners)
+{
+  g_return_val_if_fail(self != NULL && owner != NULL, NULL);
+  if (self->cpus->len == 0 || cpus <= 0) {
+    pumpkin_cpu_allocator_release(self, owner);
+    return NULL;
+  }
+  int count = MIN(cpus, (int)self->cpus->len);
+  GArray *existing = g_hash_table_lookup(self->owners, owner);
+  if (existing != NULL && (int)existing->len == count) {
+    return existing;
+  }
+  pumpkin_cpu_allocator_release(self, owner);
+
+  GArray *picked = pick_cpus(self, count, TRUE);
+  if (picked == NULL) {
+    if (repack(self, owner, count, moved_owners)) {
+      return g_hash_table_lookup(self->owners, owner);
+    }
+    picked = pick_cpus(self, count, FALSE);
+  }
+  g_hash_table_replace(self->owners, g_strdup(owner), picked);
+  return picked;
+}
+
+void
+pumpkin_cpu_allocator_release(PumpkinCpuAllocator *self, const char *owner)
+{
+  g_return_if_fail(self != NULL);
+  GArray *cpus = owner != NULL ? g_hash_table_lookup(self->owners, owner) : NULL;
+  if (cpus == NULL) {
+    return;
+  }
+  unuse_cpus(self, cpus);
+  g_hash_table_remove(self->owners, owner);
+}
+
+/*
+ * Call after a release: owners that had to spill across caches or share CPUs are placed again, alone
+ * first and then by repacking everyone. Owners whose set changed are added to moved_owners.
+ */
+void
+pumpkin_cpu_allocator_rebalance(PumpkinCpuAllocator *self, GPtrArray *moved_owners)
+{
+  g_return_if_fail(self != NULL);
+  g_autoptr(GPtrArray) degraded = g_ptr_array_new_with_free_func(g_free);
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->owners);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    if (placement_degraded(self, value)) {
+      g_ptr_array_add(degraded, g_strdup(key));
+    }
+  }
+
+  gboolean still_degraded = FALSE;
+  for (guint i = 0; i < degraded->len; i++) {
+    const char *owner = g_ptr_array_index(degraded, i);
+    GArray *previous = g_hash_table_lookup(self->owners, owner);
+    unuse_cpus(self, previous);
+    GArray *picked = pick_cpus(self, (int)previous->len, TRUE);
+    if (picked == NULL) {
+      use_cpus(self, previous);
+      still_degraded = TRUE;
+      continue;
+    }
+    if (!cpu_sets_equal(previous, picked) && moved_owners != NULL) {
+      g_ptr_array_add(moved_owners, g_strdup(owner));
+    }
+    g_hash_table_replace(self->owners, g_strdup(owner), picked);
+  }
+  if (still_degraded) {
+    repack(self, NULL, 0, moved_owners);
+  }
+}
+
+const GArray *
+pumpkin_cpu_allocator_lookup(PumpkinCpuAllocator *self, const char *owner)
+{
+  g_return_val_if_fail(self != NULL, NULL);
+  return owner != NULL ? g_hash_table_lookup(self->owners, owner) : NULL;
+}
+
+char *
+pumpkin_cpu_allocator_describe(PumpkinCpuAllocator *self, const char *owner)
+{
+  const GArray *cpus = pumpkin_cpu_allocator_lookup(self, owner);
+  if (cpus == NULL || cpus->len == 0) {
+    return NULL;
+  }
+
+  g_autoptr(GHashTable) domains = g_hash_table_new(g_direct_hash, g_direct_equal);
+  g_autoptr(GHashTable) nodes = g_hash_table_new(g_direct_hash, g_direct_equal);
+  gboolean shared = FALSE;
+  for (guint i = 0; i < cpus->len; i++) {
+    int cpu = g_array_index(cpus, int, i);
+    int pos = cpu <= self->max_cpu ? self->position[cpu] : -1;
+    if (pos < 0) {
+      continue;
+    }
+    g_hash_table_add(domains, GINT_TO_POINTER(cpu_at(self, pos)->l3 + 1));
+    g_hash_table_add(nodes, GINT_TO_POINTER(cpu_at(self, pos)->node + 1));
+    shared = shared || self->users[pos] > 1;
+  }
+  g_autofree char *list = pumpkin_cpu_set_format(cpus);
+  guint n_domains = g_hash_table_size(domains);
+  guint n_nodes = g_hash_table_size(nodes);
+  return g_strdup_printf("CPUs %s · %s%s%s",
+                         list,
+                         n_domains <= 1 ? "one L3 cache" : "split across L3 caches",
+                         n_nodes > 1 ? ", multiple NUMA nodes" : "",
+                         shared ? " (shared, host oversubscribed)" : "");
+}
+
+char *
+pumpkin_cpu_set_format(const GArray *cpus)
+{
+  GString *out = g_string_new(NULL);
+  guint i = 0;
+  while (cpus != NULL && i < cpus->len) {
+    int first = g_array_index(cpus, int, i);
+    int last = first;
+    while (i + 1 < cpus->len && g_array_index(cpus, int, i + 1) == last + 1) {
+      last = g_array_index(cpus, int, ++i);
+    }
+    if (out->len > 0) {
+      g_string_append_c(out, ',');
+    }
+    if (first == last) {
+      g_string_append_printf(out, "%d", first);
+    } else {
+      g_string_append_printf(out, "%d-%d", first, last);
+    }
+    i++;
+  }
+  return g_string_free(out, FALSE);
+}
+
+gboolean
+pumpkin_cpu_set_apply_to_process(int pid, const GArray *cpus)
+{
+#if defined(__linux__)
+  if (pid <= 0 || cpus == NULL || cpus->len == 0) {
+    return FALSE;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (guint i = 0; i < cpus->len; i++) {
+    int cpu = g_array_index(cpus, int, i);
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+
+  /* Affinity is per thread, and new threads inherit it from their creator. */
+  g_autofree char *task_dir = g_strdup_printf("/proc/%d/task", pid);
+  GDir *dir = g_dir_open(task_dir, 0, NULL);
+  if (dir == NULL) {
+    return sched_setaffinity(pid, sizeof(set), &set) == 0;
+  }
+  gboolean ok = TRUE;
+  const char *name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    pid_t tid = (pid_t)g_ascii_strtoll(name, NULL, 10);
+    if (tid > 0 && sched_setaffinity(tid, sizeof(set), &set) != 0) {
+      ok = FALSE;
+    }
+  }
+  g_dir_close(dir);
+  return ok;
+#else
+  (void)pid;
+  (void)cpus;
+  return FALSE;
+#endif
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  int cpu;
+  int package;
+  int core;
+  int l3;
+  int node;
+} PumpkinCpuInfo;
+
+typedef struct _PumpkinCpuAllocator PumpkinCpuAllocator;
+
+PumpkinCpuAllocator *pumpkin_cpu_allocator_get_default(void);
+const GArray *pumpkin_cpu_allocator_acquire(PumpkinCpuAllocator *self,
+                                            const char *owner,
+                                            int cpus,
+                                            GPtrArray *moved_owners);
+void pumpkin_cpu_allocator_release(PumpkinCpuAllocator *self, const char *owner);
+void pumpkin_cpu_allocator_rebalance(PumpkinCpuAllocator *self, GPtrArray *moved_owners);
+const GArray *pumpkin_cpu_allocator_lookup(PumpkinCpuAllocator *self, const char *owner);
+char *pumpkin_cpu_allocator_describe(PumpkinCpuAllocator *self, const char *owner);
+
+char *pumpkin_cpu_set_format(const GArray *cpus);
+gboolean pumpkin_cpu_set_apply_to_process(int pid, const GArray *cpus);
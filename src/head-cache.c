@@ -0,0 +1,357 @@
+#include "head-cache.h"
+#include "download.h"
+
+#include <glib/gstdio.h>
+
+#define HEAD_RETRY_USEC (10 * 60 * G_USEC_PER_SEC)
+
+/*
+ * Heads are stored once per host under objects/<sha256>.png, with by-uuid/<uuid> holding the hash.
+ * Default skins are shared by many players, so the texture LRU is keyed by content hash and those
+ * players end up sharing one decoded texture.
+ */
+struct _PumpkinHeadCache {
+  int ref_count;
+  char *root;
+  char *base_url;
+  PumpkinHeadReady ready;
+  gpointer ready_data;
+  GCancellable *cancellable;
+  GHashTable *hash_by_uuid;
+  GHashTable *textures;
+  GQueue lru;
+  GHashTable *pending;
+  GHashTable *retry_after;
+  GQueue download_queue;
+  guint downloads_active;
+};
+
+typedef struct {
+  char *hash;
+  GdkTexture *texture;
+} HeadTexture;
+
+typedef struct {
+  PumpkinHeadCache *cache;
+  char *uuid_key;
+  char *download_path;
+  char *hash;
+  GdkTexture *texture;
+} HeadJob;
+
+static void head_cache_pump(PumpkinHeadCache *cache);
+
+static void
+head_texture_free(HeadTexture *entry)
+{
+  g_free(entry->hash);
+  g_clear_object(&entry->texture);
+  g_free(entry);
+}
+
+static PumpkinHeadCache *
+head_cache_ref(PumpkinHeadCache *cache)
+{
+  cache->ref_count++;
+  return cache;
+}
+
+static void
+head_cache_unref(PumpkinHeadCache *cache)
+{
+  if (--cache->ref_count > 0) {
+    return;
+  }
+  g_queue_clear_full(&cache->lru, (GDestroyNotify)head_texture_free);
+  g_queue_clear_full(&cache->download_queue, g_free);
+  g_hash_table_destroy(cache->textures);
+  g_hash_table_destroy(cache->hash_by_uuid);
+  g_hash_table_destroy(cache->pending);
+  g_hash_table_destroy(cache->retry_after);
+  g_clear_object(&cache->cancellable);
+  g_free(cache->base_url);
+  g_free(cache->root);
+  g_free(cache);
+}
+
+static void
+head_job_free(HeadJob *job)
+{
+  head_cache_unref(job->cache);
+  g_free(job->uuid_key);
+  g_free(job->download_path);
+  g_free(job->hash);
+  g_clear_object(&job->texture);
+  g_free(job);
+}
+
+static HeadJob *
+head_job_new(PumpkinHeadCache *cache, const char *uuid_key)
+{
+  HeadJob *job = g_new0(HeadJob, 1);
+  job->cache = head_cache_ref(cache);
+  job->uuid_key = g_strdup(uuid_key);
+  return job;
+}
+
+PumpkinHeadCache *
+pumpkin_head_cache_new(PumpkinHeadReady ready, gpointer user_data)
+{
+  PumpkinHeadCache *cache = g_new0(PumpkinHeadCache, 1);
+  cache->ref_count = 1;
+  cache->root = g_build_filename(g_get_user_cache_dir(), "smashed-pumpkin", "player-heads", NULL);
+  cache->base_url = g_strdup(PUMPKIN_HEAD_CACHE_DEFAULT_URL);
+  cache->ready = ready;
+  cache->ready_data = user_data;
+  cache->cancellable = g_cancellable_new();
+  cache->hash_by_uuid = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  cache->textures = g_hash_table_new(g_str_hash, g_str_equal);
+  g_queue_init(&cache->lru);
+  cache->pending = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  cache->retry_after = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  g_queue_init(&cache->download_queue);
+
+  const char *subdirs[] = { "objects", "by-uuid", "downloads" };
+  for (guint i = 0; i < G_N_ELEMENTS(subdirs); i++) {
+    g_autofree char *dir = g_build_filename(cache->root, subdirs[i], NULL);
+    g_mkdir_with_parents(dir, 0755);
+  }
+  return cache;
+}
+
+/* Outstanding loads and downloads keep the cache alive but no longer report back. */
+void
+pumpkin_head_cache_free(PumpkinHeadCache *cache)
+{
+  if (cache == NULL) {
+    return;
+  }
+  cache->ready = NULL;
+  cache->ready_data = NULL;
+  g_cancellable_cancel(cache->cancellable);
+  head_cache_unref(cache);
+}
+
+void
+pumpkin_head_cache_set_base_url(PumpkinHeadCache *cache, const char *base_url)
+{
+  if (cache == NULL) {
+    return;
+  }
+  g_free(cache->base_url);
+  cache->base_url = g_strdup(base_url != NULL && *base_url != '\0' ? base_url : PUMPKIN_HEAD_CACHE_DEFAULT_URL);
+  gsize len = strlen(cache->base_url);
+  while (len > 0 && cache->base_url[len - 1] == '/') {
+    cache->base_url[--len] = '\0';
+  }
+}
+
+static GdkTexture *
+head_cache_store(PumpkinHeadCache *cache, const char *hash, GdkTexture *texture)
+{
+  GList *link = g_hash_table_lookup(cache->textures, hash);
+  if (link != NULL) {
+    g_queue_unlink(&cache->lru, link);
+    g_queue_push_head_link(&cache->lru, link);
+    return ((HeadTexture *)link->data)->texture;
+  }
+
+  HeadTexture *entry = g_new0(HeadTexture, 1);
+  entry->hash = g_strdup(hash);
+  entry->texture = g_object_ref(texture);
+  g_queue_push_head(&cache->lru, entry);
+  g_hash_table_insert(cache->textures, entry->hash, cache->lru.head);
+  while (cache->lru.length > PUMPKIN_HEAD_CACHE_TEXTURES) {
+    HeadTexture *evicted = g_queue_pop_tail(&cache->lru);
+    g_hash_table_remove(cache->textures, evicted->hash);
+    head_texture_free(evicted);
+  }
+  return texture;
+}
+
+static char *
+head_object_path(const char *root, const char *hash)
+{
+  g_autofree char *name = g_strdup_printf("%s.png", hash);
+  return g_build_filename(root, "objects", name, NULL);
+}
+
+/* Runs on a worker: imports a fresh download or follows the uuid reference, then decodes the PNG. */
+static void
+head_load_task(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+  HeadJob *job = task_data;
+  const char *root = job->cache->root;
+  g_autofree char *ref_path = g_build_filename(root, "by-uuid", job->uuid_key, NULL);
+  g_autofree char *contents = NULL;
+  gsize length = 0;
+
+  if (job->download_path != NULL) {
+    if (!g_file_get_contents(job->download_path, &contents, &length, NULL) || length == 0) {
+      g_remove(job->download_path);
+      g_task_return_boolean(task, FALSE);
+      return;
+    }
+    job->hash = g_compute_checksum_for_data(G_CHECKSUM_SHA256, (const guchar *)contents, length);
+    g_autofree char *object_path = head_object_path(root, job->hash);
+    if (g_file_test(object_path, G_FILE_TEST_EXISTS) || g_rename(job->download_path, object_path) != 0) {
+      g_remove(job->download_path);
+    }
+    g_file_set_contents(ref_path, job->hash, -1, NULL);
+  } else {
+    if (!g_file_get_contents(ref_path, &job->hash, NULL, NULL)) {
+      g_task_return_boolean(task, FALSE);
+      return;
+    }
+    g_strstrip(job->hash);
+    g_autofree char *object_path = head_object_path(root, job->hash);
+    if (!g_file_get_contents(object_path, &contents, &length, NULL)) {
+      g_task_return_boolean(task, FALSE);
+      return;
+    }
+  }
+
+  g_autoptr(GBytes) bytes = g_bytes_new_take(g_steal_pointer(&contents), length);
+  job->texture = gdk_texture_new_from_bytes(bytes, NULL);
+  g_task_return_boolean(task, job->texture != NULL);
+}
+
+static void
+head_cache_fail(PumpkinHeadCache *cache, const char *uuid_key)
+{
+  g_hash_table_remove(cache->pending, uuid_key);
+  gint64 *retry = g_new(gint64, 1);
+  *retry = g_get_monotonic_time() + HEAD_RETRY_USEC;
+  g_hash_table_replace(cache->retry_after, g_strdup(uuid_key), retry);
+}
+
+static void
+head_load_done(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+  (void)source;
+  (void)user_data;
+  HeadJob *job = g_task_get_task_data(G_TASK(res));
+  PumpkinHeadCache *cache = job->cache;
+  gboolean ok = g_task_propagate_boolean(G_TASK(res), NULL);
+  if (cache->ready == NULL) {
+    head_job_free(job);
+    return;
+  }
+
+  if (ok) {
+    g_hash_table_remove(cache->pending, job->uuid_key);
+    g_hash_table_replace(cache->hash_by_uuid, g_strdup(job->uuid_key), g_strdup(job->hash));
+    head_cache_store(cache, job->hash, job->texture);
+    cache->ready(job->uuid_key, cache->ready_data);
+  } else if (job->download_path == NULL) {
+    g_queue_push_tail(&cache->download_queue, g_strdup(job->uuid_key));
+    head_cache_pump(cache);
+  } else {
+    head_cache_fail(cache, job->uuid_key);
+  }
+  head_job_free(job);
+}
+
+static void
+head_cache_load(PumpkinHeadCache *cache, HeadJob *job)
+{
+  GTask *task = g_task_new(NULL, cache->cancellable, head_load_done, NULL);
+  /* Freed by head_load_done so the cache reference is only ever dropped on the main thread. */
+  g_task_set_task_data(task, job, NULL);
+  g_task_run_in_thread(task, head_load_task);
+  g_object_unref(task);
+}
+
+static void
+head_download_done(GObject *source, GAsyncResult *res, gpointer user_data)
+{
+  (void)source;
+  HeadJob *job = user_data;
+  PumpkinHeadCache *cache = job->cache;
+  gboolean ok = pumpkin_download_file_finish(res, NULL);
+  cache->downloads_active--;
+  if (cache->ready == NULL) {
+    head_job_free(job);
+    return;
+  }
+
+  if (ok) {
+    head_cache_load(cache, job);
+  } else {
+    g_remove(job->download_path);
+    head_cache_fail(cache, job->uuid_key);
+    head_job_free(job);
+  }
+  head_cache_pump(cache);
+}
+
+static void
+head_cache_pump(PumpkinHeadCache *cache)
+{
+  while (cache->downloads_active < PUMPKIN_HEAD_CACHE_DOWNLOADS && !g_queue_is_empty(&cache->download_queue)) {
+    g_autofree char *uuid_key = g_queue_pop_head(&cache->download_queue);
+    g_autofree char *uuid_compact = g_strdup(uuid_key);
+    char *dst = uuid_compact;
+    for (char *src = uuid_compact; *src != '\0'; src++) {
+      if (*src != '-') {
+        *dst++ = *src;
+      }
+    }
+    *dst = '\0';
+
+    HeadJob *job = head_job_new(cache, uuid_key);
+    g_autofree char *name = g_strdup_printf("%s.png", uuid_key);
+    job->download_path = g_build_filename(cache->root, "downloads", name, NULL);
+    g_autofree char *url = g_strdup_printf("%s/%s?size=64&overlay=true", cache->base_url, uuid_compact);
+    cache->downloads_active++;
+    pumpkin_download_file_async(url, job->download_path, cache->cancellable, NULL, NULL, head_download_done, job);
+  }
+}
+
+/*
+ * Returns a borrowed texture, or NULL while the head is loaded or downloaded in the background.
+ * The ready callback fires once it is available.
+ */
+GdkTexture *
+pumpkin_head_cache_lookup(PumpkinHeadCache *cache, const char *uuid_key)
+{
+  if (cache == NULL || uuid_key == NULL || *uuid_key == '\0' || uuid_key[0] == '.' ||
+      strpbrk(uuid_key, "/\\") != NULL) {
+    return NULL;
+  }
+  const char *hash = g_hash_table_lookup(cache->hash_by_uuid, uuid_key);
+  GList *link = hash != NULL ? g_hash_table_lookup(cache->textures, hash) : NULL;
+  if (link != NULL) {
+    g_queue_unlink(&cache->lru, link);
+    g_queue_push_head_link(&cache->lru, link);
+    return ((HeadTexture *)link->data)->texture;
+  }
+
+  if (g_hash_table_contains(cache->pending, uuid_key)) {
+    return NULL;
+  }
+  gint64 *retry = g_hash_table_lookup(cache->retry_after, uuid_key);
+  if (retry != NULL) {
+    if (g_get_monotonic_time() < *retry) {
+      return NULL;
+    }
+    g_hash_table_remove(cache->retry_after, uuid_key);
+  }
+  g_hash_table_add(cache->pending, g_strdup(uuid_key));
+  head_cache_load(cache, head_job_new(cache, uuid_key));
+  return NULL;
+}
+
+void
+pumpkin_head_cache_forget(PumpkinHeadCache *cache, const char *uuid_key)
+{
+  if (cache == NULL || uuid_key == NULL) {
+    return;
+  }
+  g_hash_table_remove(cache->hash_by_uuid, uuid_key);
+  g_hash_table_remove(cache->retry_after, uuid_key);
+  g_autofree char *ref_path = g_build_filename(cache->root, "by-uuid", uuid_key, NULL);
+  g_remove(ref_path);
+}
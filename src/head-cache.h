@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define PUMPKIN_HEAD_CACHE_DEFAULT_URL "https://crafatar.com/avatars"
+
+enum {
+  PUMPKIN_HEAD_CACHE_TEXTURES = 256,
+  PUMPKIN_HEAD_CACHE_DOWNLOADS = 4
+};
+
+typedef struct _PumpkinHeadCache PumpkinHeadCache;
+
+typedef void (*PumpkinHeadReady)(const char *uuid_key, gpointer user_data);
+
+PumpkinHeadCache *pumpkin_head_cache_new(PumpkinHeadReady ready, gpointer user_data);
+void pumpkin_head_cache_free(PumpkinHeadCache *cache);
+void pumpkin_head_cache_set_base_url(PumpkinHeadCache *cache, const char *base_url);
+GdkTexture *pumpkin_head_cache_lookup(PumpkinHeadCache *cache, const char *uuid_key);
+void pumpkin_head_cache_forget(PumpkinHeadCache *cache, const char *uuid_key);
+
+G_END_DECLS
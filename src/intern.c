@@ -0,0 +1,99 @@
+#include "intern.h"
+
+#include <string.h>
+
+typedef struct {
+  guint ref_count;
+  guint hash;
+  char str[];
+} InternEntry;
+
+#define INTERN_ENTRY(atom) ((InternEntry *)((char *)(atom) - G_STRUCT_OFFSET(InternEntry, str)))
+
+/*
+ * Atoms are refcounted, deduplicated strings that carry their own hash. Tables keyed by atoms use
+ * pumpkin_atom_hash() and g_direct_equal(), so a lookup with a string that was never interned
+ * has to go through pumpkin_intern_peek() first. Main thread only.
+ */
+static GHashTable *intern_table;
+
+const char *
+pumpkin_intern(const char *text)
+{
+  if (text == NULL) {
+    return NULL;
+  }
+  if (intern_table == NULL) {
+    intern_table = g_hash_table_new(g_str_hash, g_str_equal);
+  }
+  gpointer existing = NULL;
+  if (g_hash_table_lookup_extended(intern_table, text, &existing, NULL)) {
+    INTERN_ENTRY(existing)->ref_count++;
+    return existing;
+  }
+
+  gsize len = strlen(text);
+  InternEntry *entry = g_malloc(sizeof(InternEntry) + len + 1);
+  entry->ref_count = 1;
+  entry->hash = g_str_hash(text);
+  memcpy(entry->str, text, len + 1);
+  g_hash_table_add(intern_table, entry->str);
+  return entry->str;
+}
+
+const char *
+pumpkin_intern_take(char *text)
+{
+  const char *atom = pumpkin_intern(text);
+  g_free(text);
+  return atom;
+}
+
+/* Returns the atom for text without taking a reference, or NULL when nothing interned it yet. */
+const char *
+pumpkin_intern_peek(const char *text)
+{
+  gpointer existing = NULL;
+  if (text == NULL || intern_table == NULL ||
+      !g_hash_table_lookup_extended(intern_table, text, &existing, NULL)) {
+    return NULL;
+  }
+  return existing;
+}
+
+const char *
+pumpkin_intern_ref(const char *atom)
+{
+  if (atom != NULL) {
+    INTERN_ENTRY(atom)->ref_count++;
+  }
+  return atom;
+}
+
+void
+pumpkin_intern_unref(const char *atom)
+{
+  if (atom == NULL) {
+    return;
+  }
+  InternEntry *entry = INTERN_ENTRY(atom);
+  if (--entry->ref_count > 0) {
+    return;
+  }
+  g_hash_table_remove(intern_table, entry->str);
+  g_free(entry);
+}
+
+void
+pumpkin_intern_assign(const char **slot, const char *text)
+{
+  const char *atom = pumpkin_intern(text);
+  pumpkin_intern_unref(*slot);
+  *slot = atom;
+}
+
+guint
+pumpkin_atom_hash(gconstpointer atom)
+{
+  return atom != NULL ? INTERN_ENTRY(atom)->hash : 0;
+}
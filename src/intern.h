@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glib.h>
+
+const char *pumpkin_intern(const char *text);
+const char *pumpkin_intern_take(char *text);
+const char *pumpkin_intern_peek(const char *text);
+const char *pumpkin_intern_ref(const char *atom);
+void pumpkin_intern_unref(const char *atom);
+void pumpkin_intern_assign(const char **slot, const char *text);
+guint pumpkin_atom_hash(gconstpointer atom);
@@ -0,0 +1,233 @@
+#include "join-latency.h"
+
+#include <math.h>
+
+#define JOIN_HISTORY_MAX_BUILDS 50
+#define JOIN_REGRESSION_MIN_JOINS 5
+
+static double
+bucket_upper_ms(guint bucket)
+{
+  return 10.0 * exp2(bucket / 3.0);
+}
+
+void
+pumpkin_latency_histogram_add(PumpkinLatencyHistogram *histogram, guint ms)
+{
+  guint bucket = 0;
+  if (ms > 10) {
+    double position = ceil(3.0 * log2(ms / 10.0) - 1e-9);
+    bucket = (guint)MIN(position, PUMPKIN_LATENCY_BUCKETS - 1);
+  }
+  histogram->buckets[bucket]++;
+  histogram->count++;
+}
+
+/* Interpolates inside the bucket holding the rank, so the answer is within one bucket width (about 26%). */
+guint
+pumpkin_latency_histogram_percentile(const PumpkinLatencyHistogram *histogram, double percentile)
+{
+  if (histogram == NULL || histogram->count == 0) {
+    return 0;
+  }
+  guint64 rank = (guint64)ceil(percentile * histogram->count);
+  rank = CLAMP(rank, 1, histogram->count);
+  guint64 seen = 0;
+  for (guint i = 0; i < PUMPKIN_LATENCY_BUCKETS; i++) {
+    guint32 in_bucket = histogram->buckets[i];
+    if (in_bucket == 0 || seen + in_bucket < rank) {
+      seen += in_bucket;
+      continue;
+    }
+    double lower = i > 0 ? bucket_upper_ms(i - 1) : 0.0;
+    double upper = bucket_upper_ms(i);
+    return (guint)(lower + (upper - lower) * (double)(rank - seen) / in_bucket);
+  }
+  return (guint)bucket_upper_ms(PUMPKIN_LATENCY_BUCKETS - 1);
+}
+
+PumpkinJoinBuild *
+pumpkin_join_build_new(const char *build_id, const char *build_label)
+{
+  PumpkinJoinBuild *build = g_new0(PumpkinJoinBuild, 1);
+  build->build_id = g_strdup(build_id != NULL && *build_id != '\0' ? build_id : "unknown");
+  build->build_label = g_strdup(build_label != NULL ? build_label : "");
+  return build;
+}
+
+void
+pumpkin_join_build_free(PumpkinJoinBuild *build)
+{
+  if (build == NULL) {
+    return;
+  }
+  g_free(build->build_id);
+  g_free(build->build_label);
+  g_free(build);
+}
+
+static void
+parse_histogram(PumpkinLatencyHistogram *histogram, const char *text)
+{
+  g_auto(GStrv) counts = g_strsplit(text, ",", PUMPKIN_LATENCY_BUCKETS);
+  for (guint i = 0; counts[i] != NULL && i < PUMPKIN_LATENCY_BUCKETS; i++) {
+    histogram->buckets[i] = (guint32)g_ascii_strtoull(counts[i], NULL, 10);
+    histogram->count += histogram->buckets[i];
+  }
+}
+
+static void
+append_histogram(GString *out, const PumpkinLatencyHistogram *histogram)
+{
+  for (guint i = 0; i < PUMPKIN_LATENCY_BUCKETS; i++) {
+    g_string_append_printf(out, "%s%u", i > 0 ? "," : "", histogram->buckets[i]);
+  }
+}
+
+/*
+ * One build per line, least recently joined first: build id, last join, login/spawn/total bucket counts, label,
+ * first seen. Files written before first seen existed fall back to the last join.
+ */
+GPtrArray *
+pumpkin_join_history_load(const char *path)
+{
+  GPtrArray *builds = g_ptr_array_new_with_free_func((GDestroyNotify)pumpkin_join_build_free);
+  g_autofree char *contents = NULL;
+  if (path == NULL || !g_file_get_contents(path, &contents, NULL, NULL)) {
+    return builds;
+  }
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  for (guint i = 0; lines[i] != NULL; i++) {
+    if (lines[i][0] == '\0' || lines[i][0] == '#') {
+      continue;
+    }
+    g_auto(GStrv) fields = g_strsplit(lines[i], "\t", 7);
+    if (g_strv_length(fields) < 5) {
+      continue;
+    }
+    PumpkinJoinBuild *build = pumpkin_join_build_new(fields[0], fields[5]);
+    build->last_at = g_ascii_strtoll(fields[1], NULL, 10);
+    build->first_seen = fields[5] != NULL && fields[6] != NULL ? g_ascii_strtoll(fields[6], NULL, 10) : 0;
+    if (build->first_seen <= 0) {
+      build->first_seen = build->last_at;
+    }
+    for (guint stage = 0; stage < PUMPKIN_JOIN_STAGE_COUNT; stage++) {
+      parse_histogram(&build->stages[stage], fields[2 + stage]);
+    }
+    g_ptr_array_add(builds, build);
+  }
+  return builds;
+}
+
+gboolean
+pumpkin_join_history_save(const char *path, GPtrArray *builds, GError **error)
+{
+  GString *out = g_string_new("# build_id\tlast_at\tlogin_ms\tspawn_ms\ttotal_ms\tbuild_label\tfirst_seen\n");
+  for (guint i = 0; builds != NULL && i < builds->len; i++) {
+    PumpkinJoinBuild *build = g_ptr_array_index(builds, i);
+    g_autofree char *label = g_strdelimit(g_strdup(build->build_label), "\t\n", ' ');
+    g_string_append_printf(out, "%s\t%" G_GINT64_FORMAT, build->build_id, build->last_at);
+    for (guint stage = 0; stage < PUMPKIN_JOIN_STAGE_COUNT; stage++) {
+      g_string_append_c(out, '\t');
+      append_histogram(out, &build->stages[stage]);
+    }
+    g_string_append_printf(out, "\t%s\t%" G_GINT64_FORMAT "\n", label, build->first_seen);
+  }
+  gboolean ok = g_file_set_contents(path, out->str, (gssize)out->len, error);
+  g_string_free(out, TRUE);
+  return ok;
+}
+
+/* Returns the build's histograms, moved to the end so the list stays ordered by most recent join. */
+PumpkinJoinBuild *
+pumpkin_join_history_touch(GPtrArray *builds, const char *build_id, const char *build_label)
+{
+  PumpkinJoinBuild *build = NULL;
+  const char *id = build_id != NULL && *build_id != '\0' ? build_id : "unknown";
+  for (guint i = 0; i < builds->len; i++) {
+    PumpkinJoinBuild *candidate = g_ptr_array_index(builds, i);
+    if (g_strcmp0(candidate->build_id, id) == 0) {
+      build = g_ptr_array_steal_index(builds, i);
+      break;
+    }
+  }
+  if (build == NULL) {
+    build = pumpkin_join_build_new(id, build_label);
+  } else if (build_label != NULL && *build_label != '\0' && g_strcmp0(build->build_label, build_label) != 0) {
+    g_free(build->build_label);
+    build->build_label = g_strdup(build_label);
+  }
+  build->last_at = g_get_real_time() / G_USEC_PER_SEC;
+  if (build->first_seen <= 0) {
+    build->first_seen = build->last_at;
+  }
+  g_ptr_array_add(builds, build);
+  if (builds->len > JOIN_HISTORY_MAX_BUILDS) {
+    g_ptr_array_remove_range(builds, 0, builds->len - JOIN_HISTORY_MAX_BUILDS);
+  }
+  return build;
+}
+
+static gint
+compare_first_seen(gconstpointer a, gconstpointer b)
+{
+  const PumpkinJoinBuild *left = *(PumpkinJoinBuild *const *)a;
+  const PumpkinJoinBuild *right = *(PumpkinJoinBuild *const *)b;
+  if (left->first_seen != right->first_seen) {
+    return left->first_seen < right->first_seen ? -1 : 1;
+  }
+  return g_strcmp0(left->build_id, right->build_id);
+}
+
+/*
+ * The stored list is in join order so eviction drops the stalest build; comparisons want install order,
+ * otherwise a rollback would be measured against the newer build it replaced.
+ */
+GPtrArray *
+pumpkin_join_history_by_install(GPtrArray *builds)
+{
+  GPtrArray *ordered = g_ptr_array_sized_new(builds != NULL ? builds->len : 0);
+  for (guint i = 0; builds != NULL && i < builds->len; i++) {
+    g_ptr_array_add(ordered, g_ptr_array_index(builds, i));
+  }
+  g_ptr_array_sort(ordered, compare_first_seen);
+  return ordered;
+}
+
+static gboolean
+regressed(guint previous, guint current, double threshold, double *out_ratio)
+{
+  if (previous == 0 || current == 0) {
+    return FALSE;
+  }
+  *out_ratio = (double)current / (double)previous - 1.0;
+  return *out_ratio > threshold;
+}
+
+char *
+pumpkin_join_build_regression(const PumpkinJoinBuild *previous, const PumpkinJoinBuild *build, double threshold)
+{
+  if (previous == NULL || build == NULL) {
+    return NULL;
+  }
+  const PumpkinLatencyHistogram *before = &previous->stages[PUMPKIN_JOIN_STAGE_TOTAL];
+  const PumpkinLatencyHistogram *after = &build->stages[PUMPKIN_JOIN_STAGE_TOTAL];
+  if (before->count < JOIN_REGRESSION_MIN_JOINS || after->count < JOIN_REGRESSION_MIN_JOINS) {
+    return NULL;
+  }
+  GString *out = g_string_new(NULL);
+  double ratio = 0.0;
+  if (regressed(pumpkin_latency_histogram_percentile(before, 0.50),
+                pumpkin_latency_histogram_percentile(after, 0.50), threshold, &ratio)) {
+    g_string_append_printf(out, "P50 join %.0f%% slower", ratio * 100.0);
+  }
+  if (regressed(pumpkin_latency_histogram_percentile(before, 0.99),
+                pumpkin_latency_histogram_percentile(after, 0.99), threshold, &ratio)) {
+    g_string_append_printf(out, "%sP99 join %.0f%% slower", out->len > 0 ? ", " : "", ratio * 100.0);
+  }
+  if (out->len == 0) {
+    g_string_free(out, TRUE);
+    return NULL;
+  }
+  return g_string_free(out, FALSE);
+}
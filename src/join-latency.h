@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glib.h>
+
+#define PUMPKIN_LATENCY_BUCKETS 40
+
+typedef enum {
+  PUMPKIN_JOIN_STAGE_LOGIN,
+  PUMPKIN_JOIN_STAGE_SPAWN,
+  PUMPKIN_JOIN_STAGE_TOTAL,
+  PUMPKIN_JOIN_STAGE_COUNT
+} PumpkinJoinStage;
+
+/* Log-spaced buckets, three per doubling from 10 ms; the last one also takes everything slower. */
+typedef struct {
+  guint64 count;
+  guint32 buckets[PUMPKIN_LATENCY_BUCKETS];
+} PumpkinLatencyHistogram;
+
+typedef struct {
+  char *build_id;
+  char *build_label;
+  gint64 last_at;
+  gint64 first_seen;
+  PumpkinLatencyHistogram stages[PUMPKIN_JOIN_STAGE_COUNT];
+} PumpkinJoinBuild;
+
+void pumpkin_latency_histogram_add(PumpkinLatencyHistogram *histogram, guint ms);
+guint pumpkin_latency_histogram_percentile(const PumpkinLatencyHistogram *histogram, double percentile);
+PumpkinJoinBuild *pumpkin_join_build_new(const char *build_id, const char *build_label);
+void pumpkin_join_build_free(PumpkinJoinBuild *build);
+GPtrArray *pumpkin_join_history_load(const char *path);
+gboolean pumpkin_join_history_save(const char *path, GPtrArray *builds, GError **error);
+PumpkinJoinBuild *pumpkin_join_history_touch(GPtrArray *builds, const char *build_id, const char *build_label);
+GPtrArray *pumpkin_join_history_by_install(GPtrArray *builds);
+char *pumpkin_join_build_regression(const PumpkinJoinBuild *previous, const PumpkinJoinBuild *build, double threshold);
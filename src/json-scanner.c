@@ -0,0 +1,212 @@
+#include "json-scanner.h"
+
+#include <string.h>
+
+void
+pumpkin_json_scanner_init(PumpkinJsonScanner *scanner, const char *data, gssize length)
+{
+  if (data == NULL) {
+    data = "";
+    length = 0;
+  }
+  scanner->pos = data;
+  scanner->end = data + (length < 0 ? strlen(data) : (gsize)length);
+  scanner->text = g_string_sized_new(64);
+}
+
+void
+pumpkin_json_scanner_clear(PumpkinJsonScanner *scanner)
+{
+  if (scanner->text != NULL) {
+    g_string_free(scanner->text, TRUE);
+    scanner->text = NULL;
+  }
+  scanner->pos = scanner->end;
+}
+
+const char *
+pumpkin_json_scanner_text(PumpkinJsonScanner *scanner)
+{
+  return scanner->text->str;
+}
+
+static void
+skip_whitespace(PumpkinJsonScanner *scanner)
+{
+  while (scanner->pos < scanner->end && g_ascii_isspace(*scanner->pos)) {
+    scanner->pos++;
+  }
+}
+
+static gint
+read_hex4(PumpkinJsonScanner *scanner)
+{
+  if (scanner->end - scanner->pos < 4) {
+    return -1;
+  }
+  gint value = 0;
+  for (int i = 0; i < 4; i++) {
+    gint digit = g_ascii_xdigit_value(scanner->pos[i]);
+    if (digit < 0) {
+      return -1;
+    }
+    value = (value << 4) | digit;
+  }
+  scanner->pos += 4;
+  return value;
+}
+
+/* Expects pos just past "\u"; lone or broken surrogates become U+FFFD rather than failing the file. */
+static gboolean
+read_unicode_escape(PumpkinJsonScanner *scanner)
+{
+  gint unit = read_hex4(scanner);
+  if (unit < 0) {
+    return FALSE;
+  }
+  gunichar ch = (gunichar)unit;
+  if (unit >= 0xD800 && unit <= 0xDBFF) {
+    ch = 0xFFFD;
+    if (scanner->end - scanner->pos >= 6 && scanner->pos[0] == '\\' && scanner->pos[1] == 'u') {
+      const char *mark = scanner->pos;
+      scanner->pos += 2;
+      gint low = read_hex4(scanner);
+      if (low >= 0xDC00 && low <= 0xDFFF) {
+        ch = 0x10000 + (((gunichar)unit - 0xD800) << 10) + ((gunichar)low - 0xDC00);
+      } else {
+        scanner->pos = mark;
+      }
+    }
+  } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+    ch = 0xFFFD;
+  }
+  g_string_append_unichar(scanner->text, ch);
+  return TRUE;
+}
+
+static gboolean
+read_string(PumpkinJsonScanner *scanner)
+{
+  g_string_truncate(scanner->text, 0);
+  scanner->pos++;
+  while (scanner->pos < scanner->end) {
+    const char *run = scanner->pos;
+    while (scanner->pos < scanner->end && *scanner->pos != '"' && *scanner->pos != '\\') {
+      scanner->pos++;
+    }
+    g_string_append_len(scanner->text, run, scanner->pos - run);
+    if (scanner->pos >= scanner->end) {
+      return FALSE;
+    }
+    if (*scanner->pos == '"') {
+      scanner->pos++;
+      return TRUE;
+    }
+
+    scanner->pos++;
+    if (scanner->pos >= scanner->end) {
+      return FALSE;
+    }
+    char escape = *scanner->pos++;
+    switch (escape) {
+      case 'b':
+        g_string_append_c(scanner->text, '\b');
+        break;
+      case 'f':
+        g_string_append_c(scanner->text, '\f');
+        break;
+      case 'n':
+        g_string_append_c(scanner->text, '\n');
+        break;
+      case 'r':
+        g_string_append_c(scanner->text, '\r');
+        break;
+      case 't':
+        g_string_append_c(scanner->text, '\t');
+        break;
+      case 'u':
+        if (!read_unicode_escape(scanner)) {
+          return FALSE;
+        }
+        break;
+      default:
+        g_string_append_c(scanner->text, escape);
+        break;
+    }
+  }
+  return FALSE;
+}
+
+static PumpkinJsonToken
+read_literal(PumpkinJsonScanner *scanner, const char *word, PumpkinJsonToken token)
+{
+  gsize len = strlen(word);
+  if ((gsize)(scanner->end - scanner->pos) < len || memcmp(scanner->pos, word, len) != 0) {
+    return PUMPKIN_JSON_ERROR;
+  }
+  scanner->pos += len;
+  return token;
+}
+
+/*
+ * Commas and colons are treated as separators and not validated, so a stray comma in a hand-edited
+ * file does not drop the whole list. A string is reported as a key when a colon follows it.
+ */
+PumpkinJsonToken
+pumpkin_json_scanner_next(PumpkinJsonScanner *scanner)
+{
+  while (scanner->pos < scanner->end &&
+         (g_ascii_isspace(*scanner->pos) || *scanner->pos == ',' || *scanner->pos == ':')) {
+    scanner->pos++;
+  }
+  if (scanner->pos >= scanner->end) {
+    return PUMPKIN_JSON_END;
+  }
+
+  char c = *scanner->pos;
+  switch (c) {
+    case '{':
+      scanner->pos++;
+      return PUMPKIN_JSON_OBJECT_START;
+    case '}':
+      scanner->pos++;
+      return PUMPKIN_JSON_OBJECT_END;
+    case '[':
+      scanner->pos++;
+      return PUMPKIN_JSON_ARRAY_START;
+    case ']':
+      scanner->pos++;
+      return PUMPKIN_JSON_ARRAY_END;
+    case '"':
+      if (!read_string(scanner)) {
+        return PUMPKIN_JSON_ERROR;
+      }
+      skip_whitespace(scanner);
+      if (scanner->pos < scanner->end && *scanner->pos == ':') {
+        scanner->pos++;
+        return PUMPKIN_JSON_KEY;
+      }
+      return PUMPKIN_JSON_STRING;
+    case 't':
+      return read_literal(scanner, "true", PUMPKIN_JSON_TRUE);
+    case 'f':
+      return read_literal(scanner, "false", PUMPKIN_JSON_FALSE);
+    case 'n':
+      return read_literal(scanner, "null", PUMPKIN_JSON_NULL);
+    default:
+      break;
+  }
+
+  if (c != '-' && !g_ascii_isdigit(c)) {
+    return PUMPKIN_JSON_ERROR;
+  }
+  const char *start = scanner->pos;
+  while (scanner->pos < scanner->end &&
+         (g_ascii_isdigit(*scanner->pos) || *scanner->pos == '-' || *scanner->pos == '+' ||
+          *scanner->pos == '.' || *scanner->pos == 'e' || *scanner->pos == 'E')) {
+    scanner->pos++;
+  }
+  g_string_truncate(scanner->text, 0);
+  g_string_append_len(scanner->text, start, scanner->pos - start);
+  return PUMPKIN_JSON_NUMBER;
+}
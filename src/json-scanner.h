@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glib.h>
+
+typedef enum {
+  PUMPKIN_JSON_END = 0,
+  PUMPKIN_JSON_ERROR,
+  PUMPKIN_JSON_OBJECT_START,
+  PUMPKIN_JSON_OBJECT_END,
+  PUMPKIN_JSON_ARRAY_START,
+  PUMPKIN_JSON_ARRAY_END,
+  PUMPKIN_JSON_KEY,
+  PUMPKIN_JSON_STRING,
+  PUMPKIN_JSON_NUMBER,
+  PUMPKIN_JSON_TRUE,
+  PUMPKIN_JSON_FALSE,
+  PUMPKIN_JSON_NULL
+} PumpkinJsonToken;
+
+typedef struct {
+  const char *pos;
+  const char *end;
+  GString *text;
+} PumpkinJsonScanner;
+
+void pumpkin_json_scanner_init(PumpkinJsonScanner *scanner, const char *data, gssize length);
+void pumpkin_json_scanner_clear(PumpkinJsonScanner *scanner);
+PumpkinJsonToken pumpkin_json_scanner_next(PumpkinJsonScanner *scanner);
+const char *pumpkin_json_scanner_text(PumpkinJsonScanner *scanner);
@@ -0,0 +1,354 @@
+#define _GNU_SOURCE
+#include "launch-profile.h"
+
+#include <string.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define PROFILE_GROUP_PREFIX "launch-profile "
+
+enum {
+  IOPRIO_CLASS_BE = 2,
+  IOPRIO_CLASS_IDLE = 3,
+  IOPRIO_CLASS_SHIFT = 13,
+  IOPRIO_WHO_PROCESS = 1
+};
+
+static const char *allocator_names[] = { "system", "mimalloc", "jemalloc" };
+static const char *io_class_names[] = { "default", "best-effort", "idle" };
+static const char *sched_names[] = { "default", "batch", "idle" };
+
+static const char *mimalloc_candidates[] = {
+  "/usr/lib/x86_64-linux-gnu/libmimalloc.so.2",
+  "/usr/lib/aarch64-linux-gnu/libmimalloc.so.2",
+  "/usr/lib64/libmimalloc.so.2",
+  "/usr/lib/libmimalloc.so.2",
+  "/usr/local/lib/libmimalloc.so",
+  NULL
+};
+
+static const char *jemalloc_candidates[] = {
+  "/usr/lib/x86_64-linux-gnu/libjemalloc.so.2",
+  "/usr/lib/aarch64-linux-gnu/libjemalloc.so.2",
+  "/usr/lib64/libjemalloc.so.2",
+  "/usr/lib/libjemalloc.so.2",
+  "/usr/local/lib/libjemalloc.so",
+  NULL
+};
+
+static int
+name_index(const char *value, const char **names, int count, int fallback)
+{
+  if (value == NULL) {
+    return fallback;
+  }
+  for (int i = 0; i < count; i++) {
+    if (g_ascii_strcasecmp(value, names[i]) == 0) {
+      return i;
+    }
+  }
+  return fallback;
+}
+
+PumpkinLaunchProfile *
+pumpkin_launch_profile_new(const char *name)
+{
+  PumpkinLaunchProfile *profile = g_new0(PumpkinLaunchProfile, 1);
+  profile->name = g_strdup(name != NULL ? name : PUMPKIN_LAUNCH_PROFILE_DEFAULT);
+  profile->tuning.io_level = 4;
+  return profile;
+}
+
+void
+pumpkin_launch_profile_free(PumpkinLaunchProfile *profile)
+{
+  if (profile == NULL) {
+    return;
+  }
+  g_free(profile->name);
+  g_free(profile->allocator_path);
+  g_free(profile->rust_log);
+  g_strfreev(profile->env);
+  g_free(profile);
+}
+
+static GPtrArray *
+builtin_profiles(void)
+{
+  GPtrArray *profiles = g_ptr_array_new_with_free_func((GDestroyNotify)pumpkin_launch_profile_free);
+  g_ptr_array_add(profiles, pumpkin_launch_profile_new(PUMPKIN_LAUNCH_PROFILE_DEFAULT));
+
+  PumpkinLaunchProfile *throughput = pumpkin_launch_profile_new("Throughput");
+  throughput->allocator = PUMPKIN_ALLOCATOR_JEMALLOC;
+  throughput->tuning.sched_policy = PUMPKIN_SCHED_BATCH;
+  g_ptr_array_add(profiles, throughput);
+
+  PumpkinLaunchProfile *low_memory = pumpkin_launch_profile_new("Low memory");
+  low_memory->allocator = PUMPKIN_ALLOCATOR_MIMALLOC;
+  low_memory->malloc_arena_max = 2;
+  low_memory->tuning.thp_disable = TRUE;
+  g_ptr_array_add(profiles, low_memory);
+
+  PumpkinLaunchProfile *background = pumpkin_launch_profile_new("Background");
+  background->tuning.nice = 10;
+  background->tuning.io_class = PUMPKIN_IO_CLASS_IDLE;
+  background->tuning.sched_policy = PUMPKIN_SCHED_IDLE;
+  g_ptr_array_add(profiles, background);
+  return profiles;
+}
+
+static gboolean
+profile_name_equal(gconstpointer a, gconstpointer b)
+{
+  return g_strcmp0(((const PumpkinLaunchProfile *)a)->name, ((const PumpkinLaunchProfile *)b)->name) == 0;
+}
+
+static PumpkinLaunchProfile *
+load_profile(GKeyFile *keyfile, const char *group)
+{
+  PumpkinLaunchProfile *profile = pumpkin_launch_profile_new(group + strlen(PROFILE_GROUP_PREFIX));
+  g_autofree char *allocator = g_key_file_get_string(keyfile, group, "allocator", NULL);
+  if (allocator != NULL && g_path_is_absolute(allocator)) {
+    profile->allocator = PUMPKIN_ALLOCATOR_CUSTOM;
+    profile->allocator_path = g_steal_pointer(&allocator);
+  } else {
+    profile->allocator = name_index(allocator, allocator_names, G_N_ELEMENTS(allocator_names),
+                                    PUMPKIN_ALLOCATOR_SYSTEM);
+  }
+  profile->malloc_arena_max = MAX(0, g_key_file_get_integer(keyfile, group, "malloc_arena_max", NULL));
+  profile->rust_log = g_key_file_get_string(keyfile, group, "rust_log", NULL);
+  if (profile->rust_log != NULL) {
+    g_strstrip(profile->rust_log);
+    if (*profile->rust_log == '\0') {
+      g_clear_pointer(&profile->rust_log, g_free);
+    }
+  }
+  profile->env = g_key_file_get_string_list(keyfile, group, "env", NULL, NULL);
+
+  g_autofree char *thp = g_key_file_get_string(keyfile, group, "transparent_hugepages", NULL);
+  profile->tuning.thp_disable = g_strcmp0(thp, "disabled") == 0;
+  profile->tuning.nice = CLAMP(g_key_file_get_integer(keyfile, group, "nice", NULL), -20, 19);
+  g_autofree char *io_class = g_key_file_get_string(keyfile, group, "io_class", NULL);
+  profile->tuning.io_class = name_index(io_class, io_class_names, G_N_ELEMENTS(io_class_names),
+                                        PUMPKIN_IO_CLASS_DEFAULT);
+  if (g_key_file_has_key(keyfile, group, "io_level", NULL)) {
+    profile->tuning.io_level = CLAMP(g_key_file_get_integer(keyfile, group, "io_level", NULL), 0, 7);
+  }
+  g_autofree char *sched = g_key_file_get_string(keyfile, group, "scheduler", NULL);
+  profile->tuning.sched_policy = name_index(sched, sched_names, G_N_ELEMENTS(sched_names), PUMPKIN_SCHED_DEFAULT);
+  return profile;
+}
+
+/* Built-in profiles are seeded so they can be edited in server.ini like any other. */
+GPtrArray *
+pumpkin_launch_profiles_load(GKeyFile *keyfile)
+{
+  GPtrArray *profiles = builtin_profiles();
+  g_auto(GStrv) groups = keyfile != NULL ? g_key_file_get_groups(keyfile, NULL) : NULL;
+  for (guint i = 0; groups != NULL && groups[i] != NULL; i++) {
+    if (!g_str_has_prefix(groups[i], PROFILE_GROUP_PREFIX) || groups[i][strlen(PROFILE_GROUP_PREFIX)] == '\0') {
+      continue;
+    }
+    PumpkinLaunchProfile *profile = load_profile(keyfile, groups[i]);
+    guint index = 0;
+    if (g_ptr_array_find_with_equal_func(profiles, profile, profile_name_equal, &index)) {
+      pumpkin_launch_profile_free(g_ptr_array_index(profiles, index));
+      g_ptr_array_index(profiles, index) = profile;
+    } else {
+      g_ptr_array_add(profiles, profile);
+    }
+  }
+  return profiles;
+}
+
+void
+pumpkin_launch_profiles_save(GPtrArray *profiles, GKeyFile *keyfile)
+{
+  g_auto(GStrv) groups = g_key_file_get_groups(keyfile, NULL);
+  for (guint i = 0; groups != NULL && groups[i] != NULL; i++) {
+    if (g_str_has_prefix(groups[i], PROFILE_GROUP_PREFIX)) {
+      g_key_file_remove_group(keyfile, groups[i], NULL);
+    }
+  }
+  for (guint i = 0; profiles != NULL && i < profiles->len; i++) {
+    const PumpkinLaunchProfile *profile = g_ptr_array_index(profiles, i);
+    g_autofree char *group = g_strconcat(PROFILE_GROUP_PREFIX, profile->name, NULL);
+    const char *allocator = profile->allocator == PUMPKIN_ALLOCATOR_CUSTOM
+                              ? profile->allocator_path
+                              : allocator_names[profile->allocator];
+    g_key_file_set_string(keyfile, group, "allocator", allocator != NULL ? allocator : "system");
+    g_key_file_set_integer(keyfile, group, "malloc_arena_max", profile->malloc_arena_max);
+    g_key_file_set_string(keyfile, group, "transparent_hugepages", profile->tuning.thp_disable ? "disabled" : "default");
+    g_key_file_set_integer(keyfile, group, "nice", profile->tuning.nice);
+    g_key_file_set_string(keyfile, group, "io_class", io_class_names[profile->tuning.io_class]);
+    g_key_file_set_integer(keyfile, group, "io_level", profile->tuning.io_level);
+    g_key_file_set_string(keyfile, group, "scheduler", sched_names[profile->tuning.sched_policy]);
+    g_key_file_set_string(keyfile, group, "rust_log", profile->rust_log != NULL ? profile->rust_log : "");
+    if (profile->env != NULL && profile->env[0] != NULL) {
+      g_key_file_set_string_list(keyfile, group, "env", (const char * const *)profile->env,
+                                 g_strv_length(profile->env));
+    }
+  }
+}
+
+PumpkinLaunchProfile *
+pumpkin_launch_profiles_lookup(GPtrArray *profiles, const char *name)
+{
+  for (guint i = 0; profiles != NULL && name != NULL && i < profiles->len; i++) {
+    PumpkinLaunchProfile *profile = g_ptr_array_index(profiles, i);
+    if (g_strcmp0(profile->name, name) == 0) {
+      return profile;
+    }
+  }
+  return NULL;
+}
+
+char *
+pumpkin_launch_profile_describe(const PumpkinLaunchProfile *profile)
+{
+  if (profile == NULL) {
+    return g_strdup("System defaults.");
+  }
+  g_autoptr(GPtrArray) parts = g_ptr_array_new_with_free_func(g_free);
+  if (profile->allocator == PUMPKIN_ALLOCATOR_CUSTOM) {
+    g_ptr_array_add(parts, g_path_get_basename(profile->allocator_path));
+  } else if (profile->allocator != PUMPKIN_ALLOCATOR_SYSTEM) {
+    g_ptr_array_add(parts, g_strdup(allocator_names[profile->allocator]));
+  }
+  if (profile->malloc_arena_max > 0) {
+    g_ptr_array_add(parts, g_strdup_printf("%d malloc arenas", profile->malloc_arena_max));
+  }
+  if (profile->tuning.thp_disable) {
+    g_ptr_array_add(parts, g_strdup("THP off"));
+  }
+  if (profile->tuning.nice != 0) {
+    g_ptr_array_add(parts, g_strdup_printf("nice %d", profile->tuning.nice));
+  }
+  if (profile->tuning.io_class == PUMPKIN_IO_CLASS_IDLE) {
+    g_ptr_array_add(parts, g_strdup("idle I/O"));
+  } else if (profile->tuning.io_class == PUMPKIN_IO_CLASS_BEST_EFFORT) {
+    g_ptr_array_add(parts, g_strdup_printf("I/O priority %d", profile->tuning.io_level));
+  }
+  if (profile->tuning.sched_policy == PUMPKIN_SCHED_BATCH) {
+    g_ptr_array_add(parts, g_strdup("SCHED_BATCH"));
+  } else if (profile->tuning.sched_policy == PUMPKIN_SCHED_IDLE) {
+    g_ptr_array_add(parts, g_strdup("SCHED_IDLE"));
+  }
+  if (profile->rust_log != NULL) {
+    g_ptr_array_add(parts, g_strdup_printf("RUST_LOG=%s", profile->rust_log));
+  }
+  if (profile->env != NULL && profile->env[0] != NULL) {
+    g_ptr_array_add(parts, g_strdup_printf("%u env vars", g_strv_length(profile->env)));
+  }
+  if (parts->len == 0) {
+    return g_strdup("System defaults.");
+  }
+  g_ptr_array_add(parts, NULL);
+  g_autofree char *joined = g_strjoinv(" · ", (char **)parts->pdata);
+  return g_strdup_printf("%s.", joined);
+}
+
+char *
+pumpkin_launch_profile_resolve_allocator(const PumpkinLaunchProfile *profile)
+{
+  if (profile == NULL) {
+    return NULL;
+  }
+  const char **candidates = NULL;
+  switch (profile->allocator) {
+    case PUMPKIN_ALLOCATOR_CUSTOM:
+      return g_file_test(profile->allocator_path, G_FILE_TEST_IS_REGULAR) ? g_strdup(profile->allocator_path) : NULL;
+    case PUMPKIN_ALLOCATOR_MIMALLOC:
+      candidates = mimalloc_candidates;
+      break;
+    case PUMPKIN_ALLOCATOR_JEMALLOC:
+      candidates = jemalloc_candidates;
+      break;
+    default:
+      return NULL;
+  }
+  for (guint i = 0; candidates[i] != NULL; i++) {
+    if (g_file_test(candidates[i], G_FILE_TEST_IS_REGULAR)) {
+      return g_strdup(candidates[i]);
+    }
+  }
+  return NULL;
+}
+
+void
+pumpkin_launch_profile_apply_env(const PumpkinLaunchProfile *profile,
+                                 GSubprocessLauncher *launcher,
+                                 char **warning)
+{
+  if (profile == NULL || launcher == NULL) {
+    return;
+  }
+  if (profile->allocator != PUMPKIN_ALLOCATOR_SYSTEM) {
+    g_autofree char *library = pumpkin_launch_profile_resolve_allocator(profile);
+    if (library != NULL) {
+      const char *existing = g_getenv("LD_PRELOAD");
+      g_autofree char *preload = existing != NULL && *existing != '\0'
+                                   ? g_strdup_printf("%s:%s", library, existing)
+                                   : g_strdup(library);
+      g_subprocess_launcher_setenv(launcher, "LD_PRELOAD", preload, TRUE);
+    } else if (warning != NULL) {
+      *warning = g_strdup_printf("Launch profile %s: %s not found, using the system allocator",
+                                 profile->name,
+                                 profile->allocator == PUMPKIN_ALLOCATOR_CUSTOM
+                                   ? profile->allocator_path
+                                   : allocator_names[profile->allocator]);
+    }
+  }
+  if (profile->malloc_arena_max > 0) {
+    g_autofree char *arenas = g_strdup_printf("%d", profile->malloc_arena_max);
+    g_subprocess_launcher_setenv(launcher, "MALLOC_ARENA_MAX", arenas, TRUE);
+  }
+  if (profile->rust_log != NULL) {
+    g_subprocess_launcher_setenv(launcher, "RUST_LOG", profile->rust_log, TRUE);
+  }
+  for (guint i = 0; profile->env != NULL && profile->env[i] != NULL; i++) {
+    const char *eq = strchr(profile->env[i], '=');
+    if (eq == NULL || eq == profile->env[i]) {
+      continue;
+    }
+    g_autofree char *key = g_strndup(profile->env[i], (gsize)(eq - profile->env[i]));
+    g_subprocess_launcher_setenv(launcher, g_strstrip(key), eq + 1, TRUE);
+  }
+}
+
+/* Runs in the forked child, so only plain syscalls and no allocation. */
+void
+pumpkin_launch_tuning_apply(const PumpkinLaunchTuning *tuning)
+{
+#if defined(__linux__)
+  if (tuning == NULL) {
+    return;
+  }
+#if defined(PR_SET_THP_DISABLE)
+  if (tuning->thp_disable) {
+    prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0);
+  }
+#endif
+  if (tuning->nice != 0) {
+    setpriority(PRIO_PROCESS, 0, tuning->nice);
+  }
+#if defined(SYS_ioprio_set)
+  if (tuning->io_class == PUMPKIN_IO_CLASS_BEST_EFFORT) {
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | tuning->io_level);
+  } else if (tuning->io_class == PUMPKIN_IO_CLASS_IDLE) {
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+  }
+#endif
+  if (tuning->sched_policy != PUMPKIN_SCHED_DEFAULT) {
+    struct sched_param param = { .sched_priority = 0 };
+    sched_setscheduler(0, tuning->sched_policy == PUMPKIN_SCHED_BATCH ? SCHED_BATCH : SCHED_IDLE, &param);
+  }
+#else
+  (void)tuning;
+#endif
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <gio/gio.h>
+
+typedef enum {
+  PUMPKIN_ALLOCATOR_SYSTEM = 0,
+  PUMPKIN_ALLOCATOR_MIMALLOC,
+  PUMPKIN_ALLOCATOR_JEMALLOC,
+  PUMPKIN_ALLOCATOR_CUSTOM
+} PumpkinAllocator;
+
+typedef enum {
+  PUMPKIN_IO_CLASS_DEFAULT = 0,
+  PUMPKIN_IO_CLASS_BEST_EFFORT,
+  PUMPKIN_IO_CLASS_IDLE
+} PumpkinIoClass;
+
+typedef enum {
+  PUMPKIN_SCHED_DEFAULT = 0,
+  PUMPKIN_SCHED_BATCH,
+  PUMPKIN_SCHED_IDLE
+} PumpkinSchedPolicy;
+
+/* Plain data only: it is copied into the child and applied between fork and exec. */
+typedef struct {
+  gboolean thp_disable;
+  int nice;
+  PumpkinIoClass io_class;
+  int io_level;
+  PumpkinSchedPolicy sched_policy;
+} PumpkinLaunchTuning;
+
+typedef struct {
+  char *name;
+  PumpkinAllocator allocator;
+  char *allocator_path;
+  int malloc_arena_max;
+  char *rust_log;
+  char **env;
+  PumpkinLaunchTuning tuning;
+} PumpkinLaunchProfile;
+
+#define PUMPKIN_LAUNCH_PROFILE_DEFAULT "Default"
+
+PumpkinLaunchProfile *pumpkin_launch_profile_new(const char *name);
+void pumpkin_launch_profile_free(PumpkinLaunchProfile *profile);
+GPtrArray *pumpkin_launch_profiles_load(GKeyFile *keyfile);
+void pumpkin_launch_profiles_save(GPtrArray *profiles, GKeyFile *keyfile);
+PumpkinLaunchProfile *pumpkin_launch_profiles_lookup(GPtrArray *profiles, const char *name);
+char *pumpkin_launch_profile_describe(const PumpkinLaunchProfile *profile);
+char *pumpkin_launch_profile_resolve_allocator(const PumpkinLaunchProfile *profile);
+void pumpkin_launch_profile_apply_env(const PumpkinLaunchProfile *profile,
+                                      GSubprocessLauncher *launcher,
+                                      char **warning);
+void pumpkin_launch_tuning_apply(const PumpkinLaunchTuning *tuning);
@@ -0,0 +1,239 @@
+#include "memory-trend.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* One sample per minute for a day; windows are binned down before fitting. */
+#define TREND_SAMPLE_SECONDS 60
+#define TREND_CAPACITY 1440
+#define TREND_MIN_SPAN_SECONDS (30 * 60)
+#define TREND_LEAK_MIN_BYTES_PER_HOUR (8.0 * 1024.0 * 1024.0)
+#define TREND_LEAK_MIN_CONFIDENCE 0.75
+
+typedef struct {
+  gint64 span_seconds;
+  gint64 bin_seconds;
+} TrendWindow;
+
+static const TrendWindow trend_windows[] = {
+  { 24 * 3600, 20 * 60 },
+  { 6 * 3600, 5 * 60 },
+  { 3600, 60 }
+};
+
+typedef struct {
+  gint64 at;
+  double rss;
+} TrendSample;
+
+struct _PumpkinMemoryTrend {
+  TrendSample samples[TREND_CAPACITY];
+  int start;
+  int count;
+  gint64 bucket_at;
+  double bucket_sum;
+  int bucket_count;
+};
+
+PumpkinMemoryTrend *
+pumpkin_memory_trend_new(void)
+{
+  return g_new0(PumpkinMemoryTrend, 1);
+}
+
+void
+pumpkin_memory_trend_free(PumpkinMemoryTrend *trend)
+{
+  g_free(trend);
+}
+
+void
+pumpkin_memory_trend_reset(PumpkinMemoryTrend *trend)
+{
+  if (trend == NULL) {
+    return;
+  }
+  memset(trend, 0, sizeof(*trend));
+}
+
+static void
+trend_push(PumpkinMemoryTrend *trend, gint64 at, double rss)
+{
+  int idx = (trend->start + trend->count) % TREND_CAPACITY;
+  if (trend->count == TREND_CAPACITY) {
+    trend->start = (trend->start + 1) % TREND_CAPACITY;
+  } else {
+    trend->count++;
+  }
+  trend->samples[idx].at = at;
+  trend->samples[idx].rss = rss;
+}
+
+void
+pumpkin_memory_trend_add(PumpkinMemoryTrend *trend, gint64 mono_usec, guint64 rss_bytes)
+{
+  if (trend == NULL || rss_bytes == 0) {
+    return;
+  }
+  gint64 now = mono_usec / G_USEC_PER_SEC;
+  if (trend->bucket_count > 0 && now - trend->bucket_at >= TREND_SAMPLE_SECONDS) {
+    trend_push(trend, trend->bucket_at, trend->bucket_sum / (double)trend->bucket_count);
+    trend->bucket_count = 0;
+    trend->bucket_sum = 0.0;
+  }
+  if (trend->bucket_count == 0) {
+    trend->bucket_at = now;
+  }
+  trend->bucket_sum += (double)rss_bytes;
+  trend->bucket_count++;
+}
+
+static int
+compare_doubles(gconstpointer a, gconstpointer b)
+{
+  double left = *(const double *)a;
+  double right = *(const double *)b;
+  return (left > right) - (left < right);
+}
+
+static double
+median_in_place(double *values, guint count)
+{
+  qsort(values, count, sizeof(double), compare_doubles);
+  if (count % 2 == 1) {
+    return values[count / 2];
+  }
+  return (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+/* Median RSS per bin, so GC sawtooth and short spikes don't steer the fit. */
+static guint
+trend_bin(PumpkinMemoryTrend *trend, const TrendWindow *window, gint64 now, double *xs, double *ys, guint max_bins)
+{
+  gint64 from = now - window->span_seconds;
+  g_autofree double *scratch = g_new(double, trend->count);
+  guint bins = 0;
+  gint64 bin_start = -1;
+  guint in_bin = 0;
+  for (int i = 0; i <= trend->count; i++) {
+    const TrendSample *sample = i < trend->count ? &trend->samples[(trend->start + i) % TREND_CAPACITY] : NULL;
+    if (sample != NULL && sample->at < from) {
+      continue;
+    }
+    gint64 bin = sample != NULL ? (sample->at - from) / window->bin_seconds : -1;
+    if (in_bin > 0 && (sample == NULL || bin != bin_start)) {
+      if (bins < max_bins) {
+        xs[bins] = (double)(from + bin_start * window->bin_seconds) / 3600.0;
+        ys[bins] = median_in_place(scratch, in_bin);
+        bins++;
+      }
+      in_bin = 0;
+    }
+    if (sample == NULL) {
+      break;
+    }
+    bin_start = bin;
+    scratch[in_bin++] = sample->rss;
+  }
+  return bins;
+}
+
+static gboolean
+theil_sen(const double *xs, const double *ys, guint count, double *slope, double *intercept, double *confidence)
+{
+  if (count < 3) {
+    return FALSE;
+  }
+  guint pairs = count * (count - 1) / 2;
+  g_autofree double *slopes = g_new(double, pairs);
+  guint n = 0;
+  guint rising = 0;
+  guint falling = 0;
+  for (guint i = 0; i < count; i++) {
+    for (guint j = i + 1; j < count; j++) {
+      double dx = xs[j] - xs[i];
+      if (dx <= 0.0) {
+        continue;
+      }
+      double s = (ys[j] - ys[i]) / dx;
+      slopes[n++] = s;
+      if (s > 0.0) {
+        rising++;
+      } else if (s < 0.0) {
+        falling++;
+      }
+    }
+  }
+  if (n == 0) {
+    return FALSE;
+  }
+  *slope = median_in_place(slopes, n);
+
+  g_autofree double *residuals = g_new(double, count);
+  for (guint i = 0; i < count; i++) {
+    residuals[i] = ys[i] - *slope * xs[i];
+  }
+  *intercept = median_in_place(residuals, count);
+  *confidence = (rising + falling) > 0 ? (double)rising / (double)(rising + falling) : 0.0;
+  return TRUE;
+}
+
+gboolean
+pumpkin_memory_trend_estimate(PumpkinMemoryTrend *trend, PumpkinMemoryTrendEstimate *out)
+{
+  if (out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+  if (trend == NULL || trend->count < 3) {
+    return FALSE;
+  }
+
+  const TrendSample *first = &trend->samples[trend->start];
+  const TrendSample *last = &trend->samples[(trend->start + trend->count - 1) % TREND_CAPACITY];
+  gint64 covered = last->at - first->at;
+  if (covered < TREND_MIN_SPAN_SECONDS) {
+    return FALSE;
+  }
+
+  /* Prefer the longest window the history covers at least halfway. */
+  for (guint w = 0; w < G_N_ELEMENTS(trend_windows); w++) {
+    const TrendWindow *window = &trend_windows[w];
+    if (covered * 2 < window->span_seconds && w + 1 < G_N_ELEMENTS(trend_windows)) {
+      continue;
+    }
+    guint max_bins = (guint)(window->span_seconds / window->bin_seconds) + 1;
+    g_autofree double *xs = g_new(double, max_bins);
+    g_autofree double *ys = g_new(double, max_bins);
+    guint bins = trend_bin(trend, window, last->at, xs, ys, max_bins);
+    double slope = 0.0;
+    double intercept = 0.0;
+    double confidence = 0.0;
+    if (!theil_sen(xs, ys, bins, &slope, &intercept, &confidence)) {
+      continue;
+    }
+
+    out->valid = TRUE;
+    out->slope_bytes_per_hour = slope;
+    out->confidence = confidence;
+    out->fitted_bytes = fmax(0.0, intercept + slope * ((double)last->at / 3600.0));
+    out->window_seconds = MIN(window->span_seconds, covered);
+    out->leaking = slope >= TREND_LEAK_MIN_BYTES_PER_HOUR && confidence >= TREND_LEAK_MIN_CONFIDENCE;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+gint64
+pumpkin_memory_trend_seconds_to_limit(const PumpkinMemoryTrendEstimate *estimate, guint64 limit_bytes)
+{
+  if (estimate == NULL || !estimate->valid || estimate->slope_bytes_per_hour <= 0.0 || limit_bytes == 0) {
+    return -1;
+  }
+  double remaining = (double)limit_bytes - estimate->fitted_bytes;
+  if (remaining <= 0.0) {
+    return 0;
+  }
+  return (gint64)(remaining / estimate->slope_bytes_per_hour * 3600.0);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  gboolean valid;
+  gboolean leaking;
+  double slope_bytes_per_hour;
+  double confidence;
+  double fitted_bytes;
+  gint64 window_seconds;
+} PumpkinMemoryTrendEstimate;
+
+typedef struct _PumpkinMemoryTrend PumpkinMemoryTrend;
+
+PumpkinMemoryTrend *pumpkin_memory_trend_new(void);
+void pumpkin_memory_trend_free(PumpkinMemoryTrend *trend);
+void pumpkin_memory_trend_reset(PumpkinMemoryTrend *trend);
+void pumpkin_memory_trend_add(PumpkinMemoryTrend *trend, gint64 mono_usec, guint64 rss_bytes);
+gboolean pumpkin_memory_trend_estimate(PumpkinMemoryTrend *trend, PumpkinMemoryTrendEstimate *out);
+gint64 pumpkin_memory_trend_seconds_to_limit(const PumpkinMemoryTrendEstimate *estimate, guint64 limit_bytes);
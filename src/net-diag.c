@@ -0,0 +1,347 @@
+#include "net-diag.h"
+
+#include <gio/gio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/tcp.h>
+#endif
+
+#define PUMPKIN_TCP_STATE_ESTABLISHED 1
+
+typedef struct {
+  guint64 bytes_sent;
+  guint64 bytes_received;
+  guint32 total_retrans;
+} TcpCounters;
+
+struct _PumpkinTcpSampler {
+  GHashTable *counters;
+  gint64 last_sample_at;
+  int last_pid;
+  int last_port;
+};
+
+gboolean
+pumpkin_tcp_diag_supported(void)
+{
+#if defined(__linux__)
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+char *
+pumpkin_tcp_normalize_ip(const char *ip)
+{
+  if (ip == NULL) {
+    return NULL;
+  }
+  while (*ip == ' ' || *ip == '\t' || *ip == '/') {
+    ip++;
+  }
+  if (g_ascii_strncasecmp(ip, "::ffff:", 7) == 0 && strchr(ip + 7, '.') != NULL) {
+    ip += 7;
+  }
+  if (*ip == '\0') {
+    return NULL;
+  }
+  return g_ascii_strdown(ip, -1);
+}
+
+void
+pumpkin_tcp_connection_free(PumpkinTcpConnection *connection)
+{
+  if (connection == NULL) {
+    return;
+  }
+  g_clear_pointer(&connection->remote_ip, g_free);
+  g_free(connection);
+}
+
+#if defined(__linux__)
+static GHashTable *
+collect_socket_inodes(int pid)
+{
+  if (pid <= 0) {
+    return NULL;
+  }
+  g_autofree char *fd_dir = g_strdup_printf("/proc/%d/fd", pid);
+  GDir *dir = g_dir_open(fd_dir, 0, NULL);
+  if (dir == NULL) {
+    return NULL;
+  }
+
+  GHashTable *inodes = g_hash_table_new(g_direct_hash, g_direct_equal);
+  const char *name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    g_autofree char *link_path = g_build_filename(fd_dir, name, NULL);
+    char target[64];
+    ssize_t len = readlink(link_path, target, sizeof(target) - 1);
+    if (len <= 0) {
+      continue;
+    }
+    target[len] = '\0';
+    if (!g_str_has_prefix(target, "socket:[")) {
+      continue;
+    }
+    guint64 inode = g_ascii_strtoull(target + 8, NULL, 10);
+    if (inode > 0 && inode <= G_MAXUINT32) {
+      g_hash_table_add(inodes, GUINT_TO_POINTER((guint)inode));
+    }
+  }
+  g_dir_close(dir);
+  return inodes;
+}
+
+static gboolean
+dump_tcp_family(int fd, guint8 family, int local_port, GHashTable *inodes, GPtrArray *out, GError **error)
+{
+  struct {
+    struct nlmsghdr nlh;
+    struct inet_diag_req_v2 req;
+  } request;
+  memset(&request, 0, sizeof(request));
+  request.nlh.nlmsg_len = sizeof(request);
+  request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+  request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  request.req.sdiag_family = family;
+  request.req.sdiag_protocol = IPPROTO_TCP;
+  request.req.idiag_states = 1U << PUMPKIN_TCP_STATE_ESTABLISHED;
+  request.req.idiag_ext = 1U << (INET_DIAG_INFO - 1);
+
+  struct sockaddr_nl addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.nl_family = AF_NETLINK;
+  if (sendto(fd, &request, sizeof(request), 0, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(errno), "sock_diag request failed: %s",
+                g_strerror(errno));
+    return FALSE;
+  }
+
+  guint32 buffer[8192];
+  for (;;) {
+    ssize_t len = recv(fd, buffer, sizeof(buffer), 0);
+    if (len < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      g_set_error(error, G_IO_ERROR, g_io_error_from_errno(errno), "sock_diag read failed: %s",
+                  g_strerror(errno));
+      return FALSE;
+    }
+    if (len == 0) {
+      return TRUE;
+    }
+
+    int remaining = (int)len;
+    for (struct nlmsghdr *nlh = (struct nlmsghdr *)buffer; NLMSG_OK(nlh, remaining);
+         nlh = NLMSG_NEXT(nlh, remaining)) {
+      if (nlh->nlmsg_type == NLMSG_DONE) {
+        return TRUE;
+      }
+      if (nlh->nlmsg_type == NLMSG_ERROR) {
+        const struct nlmsgerr *err = NLMSG_DATA(nlh);
+        int code = err->error < 0 ? -err->error : err->error;
+        g_set_error(error, G_IO_ERROR, g_io_error_from_errno(code), "sock_diag error: %s", g_strerror(code));
+        return FALSE;
+      }
+      if (nlh->nlmsg_type != SOCK_DIAG_BY_FAMILY || nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct inet_diag_msg))) {
+        continue;
+      }
+
+      const struct inet_diag_msg *msg = NLMSG_DATA(nlh);
+      if ((int)ntohs(msg->id.idiag_sport) != local_port) {
+        continue;
+      }
+      if (inodes != NULL && !g_hash_table_contains(inodes, GUINT_TO_POINTER(msg->idiag_inode))) {
+        continue;
+      }
+
+      struct tcp_info info;
+      memset(&info, 0, sizeof(info));
+      int attr_len = (int)(nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*msg)));
+      for (struct rtattr *attr = (struct rtattr *)(msg + 1); RTA_OK(attr, attr_len);
+           attr = RTA_NEXT(attr, attr_len)) {
+        if (attr->rta_type == INET_DIAG_INFO) {
+          gsize copy = MIN((gsize)RTA_PAYLOAD(attr), sizeof(info));
+          memcpy(&info, RTA_DATA(attr), copy);
+        }
+      }
+
+      char ip[INET6_ADDRSTRLEN];
+      if (inet_ntop(msg->idiag_family, msg->id.idiag_dst, ip, sizeof(ip)) == NULL) {
+        continue;
+      }
+
+      PumpkinTcpConnection *connection = g_new0(PumpkinTcpConnection, 1);
+      connection->remote_ip = pumpkin_tcp_normalize_ip(ip);
+      connection->remote_port = (int)ntohs(msg->id.idiag_dport);
+      connection->cookie = (guint64)msg->id.idiag_cookie[0] | ((guint64)msg->id.idiag_cookie[1] << 32);
+      connection->bytes_sent = info.tcpi_bytes_acked;
+      connection->bytes_received = info.tcpi_bytes_received;
+      connection->rtt_usec = info.tcpi_rtt;
+      connection->rtt_var_usec = info.tcpi_rttvar;
+      connection->total_retrans = info.tcpi_total_retrans;
+      g_ptr_array_add(out, connection);
+    }
+  }
+}
+#endif
+
+GPtrArray *
+pumpkin_tcp_list_connections(int pid, int local_port, GError **error)
+{
+#if defined(__linux__)
+  if (local_port <= 0) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "Invalid port");
+    return NULL;
+  }
+
+  int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+  if (fd < 0) {
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(errno), "sock_diag unavailable: %s",
+                g_strerror(errno));
+    return NULL;
+  }
+
+  /* Without access to the fd table the port alone still identifies the server. */
+  GHashTable *inodes = collect_socket_inodes(pid);
+  GPtrArray *connections = g_ptr_array_new_with_free_func((GDestroyNotify)pumpkin_tcp_connection_free);
+  gboolean ok = dump_tcp_family(fd, AF_INET, local_port, inodes, connections, error) &&
+                dump_tcp_family(fd, AF_INET6, local_port, inodes, connections, error);
+  close(fd);
+  if (inodes != NULL) {
+    g_hash_table_unref(inodes);
+  }
+  if (!ok) {
+    g_ptr_array_unref(connections);
+    return NULL;
+  }
+  return connections;
+#else
+  (void)pid;
+  (void)local_port;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "sock_diag is only available on Linux");
+  return NULL;
+#endif
+}
+
+PumpkinTcpSampler *
+pumpkin_tcp_sampler_new(void)
+{
+  PumpkinTcpSampler *sampler = g_new0(PumpkinTcpSampler, 1);
+  sampler->counters = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, g_free);
+  return sampler;
+}
+
+void
+pumpkin_tcp_sampler_free(PumpkinTcpSampler *sampler)
+{
+  if (sampler == NULL) {
+    return;
+  }
+  g_clear_pointer(&sampler->counters, g_hash_table_unref);
+  g_free(sampler);
+}
+
+void
+pumpkin_tcp_sampler_reset(PumpkinTcpSampler *sampler)
+{
+  if (sampler == NULL) {
+    return;
+  }
+  g_hash_table_remove_all(sampler->counters);
+  sampler->last_sample_at = 0;
+  sampler->last_pid = 0;
+  sampler->last_port = 0;
+}
+
+static guint64
+counter_delta(guint64 current, guint64 previous)
+{
+  return current >= previous ? current - previous : 0;
+}
+
+gboolean
+pumpkin_tcp_sampler_update(PumpkinTcpSampler *sampler,
+                           int pid,
+                           int local_port,
+                           gint64 now_mono,
+                           PumpkinTcpSample *out)
+{
+  if (sampler == NULL || out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+
+  GPtrArray *connections = pumpkin_tcp_list_connections(pid, local_port, NULL);
+  if (connections == NULL) {
+    pumpkin_tcp_sampler_reset(sampler);
+    return FALSE;
+  }
+
+  gboolean has_baseline = sampler->last_sample_at > 0 &&
+                          sampler->last_pid == pid &&
+                          sampler->last_port == local_port &&
+                          now_mono > sampler->last_sample_at;
+  guint64 rx_total = 0;
+  guint64 tx_total = 0;
+  guint retrans_total = 0;
+  GHashTable *next = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, g_free);
+  for (guint i = 0; i < connections->len; i++) {
+    PumpkinTcpConnection *connection = g_ptr_array_index(connections, i);
+    TcpCounters *previous = g_hash_table_lookup(sampler->counters, &connection->cookie);
+    if (previous != NULL) {
+      rx_total += counter_delta(connection->bytes_received, previous->bytes_received);
+      tx_total += counter_delta(connection->bytes_sent, previous->bytes_sent);
+      retrans_total += (guint)counter_delta(connection->total_retrans, previous->total_retrans);
+    } else if (has_baseline) {
+      rx_total += connection->bytes_received;
+      tx_total += connection->bytes_sent;
+      retrans_total += connection->total_retrans;
+    }
+
+    gint64 *key = g_new(gint64, 1);
+    *key = (gint64)connection->cookie;
+    TcpCounters *counters = g_new0(TcpCounters, 1);
+    counters->bytes_sent = connection->bytes_sent;
+    counters->bytes_received = connection->bytes_received;
+    counters->total_retrans = connection->total_retrans;
+    g_hash_table_replace(next, key, counters);
+  }
+
+  if (has_baseline) {
+    double elapsed = (double)(now_mono - sampler->last_sample_at) / (double)G_USEC_PER_SEC;
+    out->rates_valid = TRUE;
+    out->rx_bytes_per_sec = (double)rx_total / elapsed;
+    out->tx_bytes_per_sec = (double)tx_total / elapsed;
+    out->retransmits = retrans_total;
+  }
+  out->connections = connections;
+
+  g_hash_table_unref(sampler->counters);
+  sampler->counters = next;
+  sampler->last_sample_at = now_mono;
+  sampler->last_pid = pid;
+  sampler->last_port = local_port;
+  return TRUE;
+}
+
+void
+pumpkin_tcp_sample_clear(PumpkinTcpSample *sample)
+{
+  if (sample == NULL) {
+    return;
+  }
+  g_clear_pointer(&sample->connections, g_ptr_array_unref);
+}
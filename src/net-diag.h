@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  char *remote_ip;
+  int remote_port;
+  guint64 cookie;
+  guint64 bytes_sent;
+  guint64 bytes_received;
+  guint32 rtt_usec;
+  guint32 rtt_var_usec;
+  guint32 total_retrans;
+} PumpkinTcpConnection;
+
+typedef struct {
+  gboolean rates_valid;
+  double rx_bytes_per_sec;
+  double tx_bytes_per_sec;
+  guint retransmits;
+  GPtrArray *connections;
+} PumpkinTcpSample;
+
+typedef struct _PumpkinTcpSampler PumpkinTcpSampler;
+
+gboolean pumpkin_tcp_diag_supported(void);
+char *pumpkin_tcp_normalize_ip(const char *ip);
+void pumpkin_tcp_connection_free(PumpkinTcpConnection *connection);
+GPtrArray *pumpkin_tcp_list_connections(int pid, int local_port, GError **error);
+
+PumpkinTcpSampler *pumpkin_tcp_sampler_new(void);
+void pumpkin_tcp_sampler_free(PumpkinTcpSampler *sampler);
+void pumpkin_tcp_sampler_reset(PumpkinTcpSampler *sampler);
+gboolean pumpkin_tcp_sampler_update(PumpkinTcpSampler *sampler,
+                                    int pid,
+                                    int local_port,
+                                    gint64 now_mono,
+                                    PumpkinTcpSample *out);
+void pumpkin_tcp_sample_clear(PumpkinTcpSample *sample);
@@ -0,0 +1,142 @@
+#include "json-scanner.h"
+#include "player-entries.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_ENTRIES 100000
+#define BENCH_ROUNDS 5
+
+typedef enum {
+  FIXTURE_USERCACHE,
+  FIXTURE_WHITELIST
+} FixtureShape;
+
+/* Same layout Pumpkin writes for usercache.json and whitelist.json, with an escaped name every so often. */
+static char *
+build_player_file(FixtureShape shape, guint entries)
+{
+  GString *out = g_string_sized_new((gsize)entries * 160);
+  g_string_append(out, "[\n");
+  for (guint i = 0; i < entries; i++) {
+    g_autofree char *uuid = g_strdup_printf("%08x-%04x-4%03x-8%03x-%012x",
+                                            i, i & 0xffff, i & 0xfff, (i >> 12) & 0xfff, i * 2654435761u);
+    const char *name = i % 64 == 0 ? "Pl\\u00e4yer\\\"" : "Player";
+    if (shape == FIXTURE_USERCACHE) {
+      g_string_append_printf(out,
+                             "  {\n"
+                             "    \"name\": \"%s%u\",\n"
+                             "    \"uuid\": \"%s\",\n"
+                             "    \"expiresOn\": \"2026-%02u-%02u 12:00:00 +0000\"\n"
+                             "  }",
+                             name, i, uuid, i % 12 + 1, i % 28 + 1);
+    } else {
+      g_string_append_printf(out,
+                             "  {\n"
+                             "    \"uuid\": \"%s\",\n"
+                             "    \"name\": \"%s%u\"\n"
+                             "  }",
+                             uuid, name, i);
+    }
+    g_string_append(out, i + 1 < entries ? ",\n" : "\n");
+  }
+  g_string_append(out, "]\n");
+  return g_string_free(out, FALSE);
+}
+
+static guint
+scan_tokens(const char *contents)
+{
+  PumpkinJsonScanner scanner;
+  pumpkin_json_scanner_init(&scanner, contents, -1);
+  guint tokens = 0;
+  PumpkinJsonToken token;
+  while ((token = pumpkin_json_scanner_next(&scanner)) != PUMPKIN_JSON_END && token != PUMPKIN_JSON_ERROR) {
+    tokens++;
+  }
+  pumpkin_json_scanner_clear(&scanner);
+  return token == PUMPKIN_JSON_ERROR ? 0 : tokens;
+}
+
+static guint
+parse_entries(const char *contents)
+{
+  GPtrArray *entries = parse_player_entries(contents);
+  guint parsed = 0;
+  for (guint i = 0; i < entries->len; i++) {
+    PlayerEntry *entry = g_ptr_array_index(entries, i);
+    if (entry->name != NULL && entry->uuid != NULL) {
+      parsed++;
+    }
+  }
+  g_ptr_array_unref(entries);
+  return parsed;
+}
+
+static int
+compare_int64(gconstpointer a, gconstpointer b)
+{
+  gint64 left = *(const gint64 *)a;
+  gint64 right = *(const gint64 *)b;
+  return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static void
+report(const char *label, gint64 *samples, gsize length)
+{
+  qsort(samples, BENCH_ROUNDS, sizeof(samples[0]), compare_int64);
+  double best_ms = samples[0] / 1000.0;
+  double median_ms = samples[BENCH_ROUNDS / 2] / 1000.0;
+  double mib = length / (1024.0 * 1024.0);
+  g_print("  %-6s best=%.2f ms median=%.2f ms (%.1f MiB/s)\n", label, best_ms, median_ms,
+          best_ms > 0 ? mib / (best_ms / 1000.0) : 0.0);
+}
+
+/* "scan" is the tokenizer alone; "parse" adds filling PlayerEntry structs, which is what the app runs. */
+static gboolean
+run_fixture(const char *label, FixtureShape shape, guint entries)
+{
+  g_autofree char *contents = build_player_file(shape, entries);
+  gsize length = strlen(contents);
+  gint64 scan_samples[BENCH_ROUNDS];
+  gint64 parse_samples[BENCH_ROUNDS];
+  guint tokens = 0;
+
+  for (guint round = 0; round < BENCH_ROUNDS; round++) {
+    gint64 start = g_get_monotonic_time();
+    tokens = scan_tokens(contents);
+    scan_samples[round] = g_get_monotonic_time() - start;
+
+    start = g_get_monotonic_time();
+    guint parsed = parse_entries(contents);
+    parse_samples[round] = g_get_monotonic_time() - start;
+    if (tokens == 0 || parsed != entries) {
+      g_printerr("%s: parsed %u of %u synthetic entries\n", label, parsed, entries);
+      return FALSE;
+    }
+  }
+
+  g_print("%s: entries=%u bytes=%" G_GSIZE_FORMAT " tokens=%u\n", label, entries, length, tokens);
+  report("scan", scan_samples, length);
+  report("parse", parse_samples, length);
+  return TRUE;
+}
+
+int
+main(int argc, char **argv)
+{
+  guint entries = BENCH_DEFAULT_ENTRIES;
+  if (argc > 1) {
+    entries = (guint)strtoul(argv[1], NULL, 10);
+    if (entries == 0) {
+      g_printerr("Usage: %s [entries]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (!run_fixture("usercache.json", FIXTURE_USERCACHE, entries) ||
+      !run_fixture("whitelist.json", FIXTURE_WHITELIST, entries)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include "player-entries.h"
+
+static PlayerEntry *
+find_entry(GPtrArray *entries, const char *name)
+{
+  for (guint i = 0; i < entries->len; i++) {
+    PlayerEntry *entry = g_ptr_array_index(entries, i);
+    if (g_strcmp0(entry->name, name) == 0) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+static void
+test_string_escapes(void)
+{
+  g_autoptr(GPtrArray) entries =
+    parse_player_entries("[{\"name\": \"a\\\"b\\\\c\\/d\\u00e9\\ud83c\\udf83\", \"uuid\": \"u1\","
+                         " \"reason\": \"line\\nbreak\\ttab\"}]");
+  g_assert_cmpuint(entries->len, ==, 1);
+  PlayerEntry *entry = g_ptr_array_index(entries, 0);
+  g_assert_cmpstr(entry->name, ==, "a\"b\\c/d\xc3\xa9\xf0\x9f\x8e\x83");
+  g_assert_cmpstr(entry->uuid, ==, "u1");
+  g_assert_cmpstr(entry->reason, ==, "line\nbreak\ttab");
+}
+
+static void
+test_broken_surrogates(void)
+{
+  g_autoptr(GPtrArray) entries =
+    parse_player_entries("[{\"name\": \"x\\ud83cy\"}, {\"name\": \"\\udf83z\"}]");
+  g_assert_cmpuint(entries->len, ==, 2);
+  PlayerEntry *lone_high = g_ptr_array_index(entries, 0);
+  PlayerEntry *lone_low = g_ptr_array_index(entries, 1);
+  g_assert_cmpstr(lone_high->name, ==, "x\xef\xbf\xbdy");
+  g_assert_cmpstr(lone_low->name, ==, "\xef\xbf\xbdz");
+}
+
+static void
+test_nested_keys_stay_inside(void)
+{
+  g_autoptr(GPtrArray) entries =
+    parse_player_entries("[{\"name\": \"outer\","
+                         "  \"extra\": {\"name\": \"inner\", \"ip\": \"10.0.0.1\", \"level\": 4},"
+                         "  \"history\": [{\"uuid\": \"ghost\"}, \"loose\"],"
+                         "  \"uuid\": \"u2\", \"level\": 2, \"bypassesPlayerLimit\": true}]");
+  PlayerEntry *outer = find_entry(entries, "outer");
+  g_assert_nonnull(outer);
+  g_assert_cmpstr(outer->uuid, ==, "u2");
+  g_assert_null(outer->ip);
+  g_assert_cmpint(outer->op_level, ==, 2);
+  g_assert_true(outer->bypasses_player_limit);
+
+  PlayerEntry *inner = find_entry(entries, "inner");
+  g_assert_nonnull(inner);
+  g_assert_cmpstr(inner->ip, ==, "10.0.0.1");
+  g_assert_cmpint(inner->op_level, ==, 4);
+  g_assert_cmpuint(entries->len, ==, 2);
+}
+
+static void
+test_truncated_input(void)
+{
+  static const char *inputs[] = {
+    "[{\"name\": \"kept\", \"uuid\": \"u3\"}, {\"name\": \"cut",
+    "[{\"name\": \"kept\", \"uuid\": \"u3\"}, {\"name\": \"b\\u00",
+    "[{\"name\": \"kept\", \"uuid\": \"u3\"}, {\"name\": \"b\\",
+    "[{\"name\": \"kept\", \"uuid\": \"u3\"}, {\"name\": \"open\", \"uuid\": \"u4\"",
+    "[{\"name\": \"kept\", \"uuid\": \"u3\"}, {\"name\": tru"
+  };
+  for (guint i = 0; i < G_N_ELEMENTS(inputs); i++) {
+    g_autoptr(GPtrArray) entries = parse_player_entries(inputs[i]);
+    g_assert_cmpuint(entries->len, ==, 1);
+    PlayerEntry *entry = g_ptr_array_index(entries, 0);
+    g_assert_cmpstr(entry->name, ==, "kept");
+  }
+
+  g_autoptr(GPtrArray) empty = parse_player_entries("");
+  g_assert_cmpuint(empty->len, ==, 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  g_test_init(&argc, &argv, NULL);
+  g_test_add_func("/player-entries/string-escapes", test_string_escapes);
+  g_test_add_func("/player-entries/broken-surrogates", test_broken_surrogates);
+  g_test_add_func("/player-entries/nested-keys", test_nested_keys_stay_inside);
+  g_test_add_func("/player-entries/truncated", test_truncated_input);
+  return g_test_run();
+}
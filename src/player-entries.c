@@ -0,0 +1,217 @@
+#include "player-entries.h"
+#include "json-scanner.h"
+
+#include <stdlib.h>
+
+void
+player_entry_free(PlayerEntry *entry)
+{
+  if (entry == NULL) {
+    return;
+  }
+  g_clear_pointer(&entry->name, g_free);
+  g_clear_pointer(&entry->uuid, g_free);
+  g_clear_pointer(&entry->ip, g_free);
+  g_clear_pointer(&entry->reason, g_free);
+  g_clear_pointer(&entry->created, g_free);
+  g_clear_pointer(&entry->source, g_free);
+  g_clear_pointer(&entry->expires, g_free);
+  g_free(entry);
+}
+
+/* Takes the first occurrence of the key at any depth whose value has the wanted type. */
+static PumpkinJsonToken
+find_json_field(PumpkinJsonScanner *scanner, const char *object_text, const char *field,
+                PumpkinJsonToken want, PumpkinJsonToken also)
+{
+  pumpkin_json_scanner_init(scanner, object_text, -1);
+  PumpkinJsonToken token;
+  while ((token = pumpkin_json_scanner_next(scanner)) != PUMPKIN_JSON_END && token != PUMPKIN_JSON_ERROR) {
+    if (token != PUMPKIN_JSON_KEY || g_ascii_strcasecmp(pumpkin_json_scanner_text(scanner), field) != 0) {
+      continue;
+    }
+    token = pumpkin_json_scanner_next(scanner);
+    if (token == want || token == also) {
+      return token;
+    }
+  }
+  return PUMPKIN_JSON_END;
+}
+
+char *
+extract_json_string_field(const char *object_text, const char *field)
+{
+  if (object_text == NULL || field == NULL || *field == '\0') {
+    return NULL;
+  }
+  PumpkinJsonScanner scanner;
+  char *value = NULL;
+  if (find_json_field(&scanner, object_text, field, PUMPKIN_JSON_STRING, PUMPKIN_JSON_STRING) ==
+      PUMPKIN_JSON_STRING) {
+    value = g_strdup(pumpkin_json_scanner_text(&scanner));
+  }
+  pumpkin_json_scanner_clear(&scanner);
+  return value;
+}
+
+int
+extract_json_int_field(const char *object_text, const char *field, int default_value)
+{
+  if (object_text == NULL || field == NULL || *field == '\0') {
+    return default_value;
+  }
+  PumpkinJsonScanner scanner;
+  int value = default_value;
+  if (find_json_field(&scanner, object_text, field, PUMPKIN_JSON_NUMBER, PUMPKIN_JSON_NUMBER) ==
+      PUMPKIN_JSON_NUMBER) {
+    value = (int)strtol(pumpkin_json_scanner_text(&scanner), NULL, 10);
+  }
+  pumpkin_json_scanner_clear(&scanner);
+  return value;
+}
+
+gboolean
+extract_json_bool_field(const char *object_text, const char *field, gboolean default_value)
+{
+  if (object_text == NULL || field == NULL || *field == '\0') {
+    return default_value;
+  }
+  PumpkinJsonScanner scanner;
+  PumpkinJsonToken token = find_json_field(&scanner, object_text, field, PUMPKIN_JSON_TRUE, PUMPKIN_JSON_FALSE);
+  pumpkin_json_scanner_clear(&scanner);
+  if (token == PUMPKIN_JSON_END) {
+    return default_value;
+  }
+  return token == PUMPKIN_JSON_TRUE;
+}
+
+typedef enum {
+  ENTRY_FIELD_NONE = 0,
+  ENTRY_FIELD_NAME,
+  ENTRY_FIELD_UUID,
+  ENTRY_FIELD_IP,
+  ENTRY_FIELD_REASON,
+  ENTRY_FIELD_CREATED,
+  ENTRY_FIELD_SOURCE,
+  ENTRY_FIELD_EXPIRES,
+  ENTRY_FIELD_LEVEL,
+  ENTRY_FIELD_BYPASSES_LIMIT
+} EntryField;
+
+static EntryField
+entry_field_for_key(const char *key)
+{
+  static const struct {
+    const char *key;
+    EntryField field;
+  } fields[] = {
+    { "name", ENTRY_FIELD_NAME },
+    { "uuid", ENTRY_FIELD_UUID },
+    { "ip", ENTRY_FIELD_IP },
+    { "reason", ENTRY_FIELD_REASON },
+    { "created", ENTRY_FIELD_CREATED },
+    { "source", ENTRY_FIELD_SOURCE },
+    { "expires", ENTRY_FIELD_EXPIRES },
+    { "level", ENTRY_FIELD_LEVEL },
+    { "bypasses_player_limit", ENTRY_FIELD_BYPASSES_LIMIT },
+    { "bypassesPlayerLimit", ENTRY_FIELD_BYPASSES_LIMIT }
+  };
+  for (guint i = 0; i < G_N_ELEMENTS(fields); i++) {
+    if (g_ascii_strcasecmp(key, fields[i].key) == 0) {
+      return fields[i].field;
+    }
+  }
+  return ENTRY_FIELD_NONE;
+}
+
+static char **
+entry_string_slot(PlayerEntry *entry, EntryField field)
+{
+  switch (field) {
+    case ENTRY_FIELD_NAME:
+      return &entry->name;
+    case ENTRY_FIELD_UUID:
+      return &entry->uuid;
+    case ENTRY_FIELD_IP:
+      return &entry->ip;
+    case ENTRY_FIELD_REASON:
+      return &entry->reason;
+    case ENTRY_FIELD_CREATED:
+      return &entry->created;
+    case ENTRY_FIELD_SOURCE:
+      return &entry->source;
+    case ENTRY_FIELD_EXPIRES:
+      return &entry->expires;
+    default:
+      return NULL;
+  }
+}
+
+/*
+ * Single pass over the file. Every object becomes a candidate entry and keys apply to the innermost
+ * open object; arrays are kept on the stack as NULL so nested values never leak into their parent.
+ */
+GPtrArray *
+parse_player_entries(const char *contents)
+{
+  g_autoptr(GPtrArray) entries = g_ptr_array_new_with_free_func((GDestroyNotify)player_entry_free);
+  g_autoptr(GPtrArray) stack = g_ptr_array_new_with_free_func((GDestroyNotify)player_entry_free);
+  PumpkinJsonScanner scanner;
+  pumpkin_json_scanner_init(&scanner, contents, -1);
+
+  EntryField field = ENTRY_FIELD_NONE;
+  PumpkinJsonToken token;
+  while ((token = pumpkin_json_scanner_next(&scanner)) != PUMPKIN_JSON_END && token != PUMPKIN_JSON_ERROR) {
+    PlayerEntry *top = stack->len > 0 ? g_ptr_array_index(stack, stack->len - 1) : NULL;
+    const char *text = pumpkin_json_scanner_text(&scanner);
+    switch (token) {
+      case PUMPKIN_JSON_OBJECT_START: {
+        PlayerEntry *entry = g_new0(PlayerEntry, 1);
+        entry->op_level = -1;
+        g_ptr_array_add(stack, entry);
+        break;
+      }
+      case PUMPKIN_JSON_ARRAY_START:
+        g_ptr_array_add(stack, NULL);
+        break;
+      case PUMPKIN_JSON_OBJECT_END:
+      case PUMPKIN_JSON_ARRAY_END:
+        if (stack->len == 0) {
+          break;
+        }
+        top = g_ptr_array_steal_index(stack, stack->len - 1);
+        if (top != NULL && (top->name != NULL || top->ip != NULL)) {
+          g_ptr_array_add(entries, top);
+        } else {
+          player_entry_free(top);
+        }
+        break;
+      case PUMPKIN_JSON_KEY:
+        field = top != NULL ? entry_field_for_key(text) : ENTRY_FIELD_NONE;
+        continue;
+      case PUMPKIN_JSON_STRING: {
+        char **slot = top != NULL ? entry_string_slot(top, field) : NULL;
+        if (slot != NULL && *slot == NULL && *text != '\0') {
+          *slot = g_strdup(text);
+        }
+        break;
+      }
+      case PUMPKIN_JSON_NUMBER:
+        if (top != NULL && field == ENTRY_FIELD_LEVEL) {
+          top->op_level = (int)strtol(text, NULL, 10);
+        }
+        break;
+      case PUMPKIN_JSON_TRUE:
+        if (top != NULL && field == ENTRY_FIELD_BYPASSES_LIMIT) {
+          top->bypasses_player_limit = TRUE;
+        }
+        break;
+      default:
+        break;
+    }
+    field = ENTRY_FIELD_NONE;
+  }
+
+  pumpkin_json_scanner_clear(&scanner);
+  return g_steal_pointer(&entries);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  char *name;
+  char *uuid;
+  char *ip;
+  char *reason;
+  char *created;
+  char *source;
+  char *expires;
+  int op_level;
+  gboolean bypasses_player_limit;
+} PlayerEntry;
+
+void player_entry_free(PlayerEntry *entry);
+char *extract_json_string_field(const char *object_text, const char *field);
+int extract_json_int_field(const char *object_text, const char *field, int default_value);
+gboolean extract_json_bool_field(const char *object_text, const char *field, gboolean default_value);
+GPtrArray *parse_player_entries(const char *contents);
@@ -0,0 +1,381 @@
+#include "player-index.h"
+#include "intern.h"
+
+#include <string.h>
+
+struct _PumpkinPlayerIndex {
+  GHashTable *entries;
+  GHashTable *by_uuid;
+  GHashTable *by_name;
+  guint open_sessions;
+  gboolean dirty;
+};
+
+static void
+entry_free(PumpkinPlayerIndexEntry *entry)
+{
+  if (entry == NULL) {
+    return;
+  }
+  for (guint i = 0; i < entry->servers->len; i++) {
+    pumpkin_intern_unref(g_array_index(entry->servers, PumpkinPlayerIndexServer, i).server_id);
+  }
+  g_array_unref(entry->servers);
+  pumpkin_intern_unref(entry->uuid);
+  pumpkin_intern_unref(entry->name);
+  g_free(entry);
+}
+
+PumpkinPlayerIndex *
+pumpkin_player_index_new(void)
+{
+  PumpkinPlayerIndex *index = g_new0(PumpkinPlayerIndex, 1);
+  index->entries = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)entry_free);
+  index->by_uuid = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                         (GDestroyNotify)pumpkin_intern_unref, NULL);
+  index->by_name = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                         (GDestroyNotify)pumpkin_intern_unref, NULL);
+  return index;
+}
+
+void
+pumpkin_player_index_free(PumpkinPlayerIndex *index)
+{
+  if (index == NULL) {
+    return;
+  }
+  g_hash_table_destroy(index->by_uuid);
+  g_hash_table_destroy(index->by_name);
+  g_hash_table_destroy(index->entries);
+  g_free(index);
+}
+
+static char *
+lower_key(const char *text)
+{
+  if (text == NULL) {
+    return NULL;
+  }
+  g_autofree char *tmp = g_strstrip(g_strdup(text));
+  return tmp[0] != '\0' ? g_ascii_strdown(tmp, -1) : NULL;
+}
+
+static PumpkinPlayerIndexEntry *
+lookup(GHashTable *table, const char *text)
+{
+  g_autofree char *key = lower_key(text);
+  const char *atom = key != NULL ? pumpkin_intern_peek(key) : NULL;
+  return atom != NULL ? g_hash_table_lookup(table, atom) : NULL;
+}
+
+static void
+unbind(GHashTable *table, const char *text, PumpkinPlayerIndexEntry *entry)
+{
+  g_autofree char *key = lower_key(text);
+  const char *atom = key != NULL ? pumpkin_intern_peek(key) : NULL;
+  if (atom != NULL && g_hash_table_lookup(table, atom) == entry) {
+    g_hash_table_remove(table, atom);
+  }
+}
+
+static void
+bind(GHashTable *table, const char *text, PumpkinPlayerIndexEntry *entry)
+{
+  g_autofree char *key = lower_key(text);
+  if (key != NULL) {
+    g_hash_table_replace(table, (gpointer)pumpkin_intern(key), entry);
+  }
+}
+
+static PumpkinPlayerIndexServer *
+server_record(PumpkinPlayerIndexEntry *entry, const char *server_id, gboolean create)
+{
+  for (guint i = 0; i < entry->servers->len; i++) {
+    PumpkinPlayerIndexServer *record = &g_array_index(entry->servers, PumpkinPlayerIndexServer, i);
+    if (g_strcmp0(record->server_id, server_id) == 0) {
+      return record;
+    }
+  }
+  if (!create || server_id == NULL || *server_id == '\0') {
+    return NULL;
+  }
+  PumpkinPlayerIndexServer record = { .server_id = pumpkin_intern(server_id) };
+  g_array_append_val(entry->servers, record);
+  return &g_array_index(entry->servers, PumpkinPlayerIndexServer, entry->servers->len - 1);
+}
+
+static void
+close_record(PumpkinPlayerIndex *index, PumpkinPlayerIndexServer *record, gint64 at)
+{
+  if (record->online_since > 0) {
+    if (at > record->online_since) {
+      record->playtime_seconds += (guint64)(at - record->online_since);
+    }
+    record->online_since = 0;
+    index->open_sessions--;
+  }
+  record->last_seen = MAX(record->last_seen, at);
+}
+
+/* A name-only entry is folded into its UUID entry once a log line connects the two. */
+static void
+merge_entry(PumpkinPlayerIndex *index, PumpkinPlayerIndexEntry *into, PumpkinPlayerIndexEntry *from)
+{
+  for (guint i = 0; i < from->servers->len; i++) {
+    PumpkinPlayerIndexServer *source = &g_array_index(from->servers, PumpkinPlayerIndexServer, i);
+    PumpkinPlayerIndexServer *target = server_record(into, source->server_id, TRUE);
+    target->playtime_seconds += source->playtime_seconds;
+    target->last_seen = MAX(target->last_seen, source->last_seen);
+    if (target->online_since == 0) {
+      target->online_since = source->online_since;
+    } else if (source->online_since > 0) {
+      index->open_sessions--;
+    }
+  }
+  unbind(index->by_name, from->name, from);
+  g_hash_table_remove(index->entries, from);
+}
+
+static PumpkinPlayerIndexEntry *
+resolve(PumpkinPlayerIndex *index, const char *uuid, const char *name, gboolean create)
+{
+  g_autofree char *uuid_key = lower_key(uuid);
+  PumpkinPlayerIndexEntry *by_uuid = uuid_key != NULL ? lookup(index->by_uuid, uuid_key) : NULL;
+  PumpkinPlayerIndexEntry *by_name = name != NULL ? lookup(index->by_name, name) : NULL;
+
+  if (uuid_key != NULL && by_uuid == NULL && by_name != NULL && by_name->uuid == NULL) {
+    by_name->uuid = pumpkin_intern(uuid_key);
+    bind(index->by_uuid, uuid_key, by_name);
+    index->dirty = TRUE;
+    return by_name;
+  }
+  if (by_uuid != NULL) {
+    if (by_name != NULL && by_name != by_uuid && by_name->uuid == NULL) {
+      merge_entry(index, by_uuid, by_name);
+      by_name = NULL;
+    }
+    if (name != NULL && *name != '\0' && (by_name != by_uuid || g_strcmp0(by_uuid->name, name) != 0)) {
+      unbind(index->by_name, by_uuid->name, by_uuid);
+      pumpkin_intern_assign(&by_uuid->name, name);
+      bind(index->by_name, name, by_uuid);
+      index->dirty = TRUE;
+    }
+    return by_uuid;
+  }
+  if (uuid_key == NULL && by_name != NULL) {
+    return by_name;
+  }
+  if (!create || (uuid_key == NULL && (name == NULL || *name == '\0'))) {
+    return NULL;
+  }
+
+  PumpkinPlayerIndexEntry *entry = g_new0(PumpkinPlayerIndexEntry, 1);
+  entry->servers = g_array_new(FALSE, FALSE, sizeof(PumpkinPlayerIndexServer));
+  g_hash_table_add(index->entries, entry);
+  if (uuid_key != NULL) {
+    entry->uuid = pumpkin_intern(uuid_key);
+    bind(index->by_uuid, uuid_key, entry);
+  }
+  if (name != NULL && *name != '\0') {
+    entry->name = pumpkin_intern(name);
+    bind(index->by_name, name, entry);
+  }
+  index->dirty = TRUE;
+  return entry;
+}
+
+void
+pumpkin_player_index_learn(PumpkinPlayerIndex *index, const char *uuid, const char *name)
+{
+  g_return_if_fail(index != NULL);
+  resolve(index, uuid, name, TRUE);
+}
+
+void
+pumpkin_player_index_join(PumpkinPlayerIndex *index, const char *server_id, const char *name, gint64 at)
+{
+  g_return_if_fail(index != NULL);
+  PumpkinPlayerIndexEntry *entry = resolve(index, NULL, name, TRUE);
+  PumpkinPlayerIndexServer *record = entry != NULL ? server_record(entry, server_id, TRUE) : NULL;
+  if (record == NULL) {
+    return;
+  }
+  if (record->online_since == 0) {
+    record->online_since = at;
+    index->open_sessions++;
+  }
+  record->last_seen = MAX(record->last_seen, at);
+  index->dirty = TRUE;
+}
+
+void
+pumpkin_player_index_leave(PumpkinPlayerIndex *index, const char *server_id, const char *name, gint64 at)
+{
+  g_return_if_fail(index != NULL);
+  PumpkinPlayerIndexEntry *entry = resolve(index, NULL, name, FALSE);
+  PumpkinPlayerIndexServer *record = entry != NULL ? server_record(entry, server_id, FALSE) : NULL;
+  if (record != NULL) {
+    close_record(index, record, at);
+    index->dirty = TRUE;
+  }
+}
+
+/* A NULL server closes every open session, for shutdown. */
+void
+pumpkin_player_index_server_stopped(PumpkinPlayerIndex *index, const char *server_id, gint64 at)
+{
+  g_return_if_fail(index != NULL);
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, index->entries);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    PumpkinPlayerIndexEntry *entry = key;
+    for (guint i = 0; i < entry->servers->len; i++) {
+      PumpkinPlayerIndexServer *record = &g_array_index(entry->servers, PumpkinPlayerIndexServer, i);
+      if (record->online_since > 0 && (server_id == NULL || g_strcmp0(record->server_id, server_id) == 0)) {
+        close_record(index, record, at);
+        index->dirty = TRUE;
+      }
+    }
+  }
+}
+
+/* Tracking files and the live log count the same sessions, so the larger total wins instead of adding up. */
+void
+pumpkin_player_index_seed(PumpkinPlayerIndex *index, const char *server_id, const char *uuid,
+                          const char *name, guint64 playtime_seconds, gint64 last_seen)
+{
+  g_return_if_fail(index != NULL);
+  PumpkinPlayerIndexEntry *entry = resolve(index, uuid, name, TRUE);
+  PumpkinPlayerIndexServer *record = entry != NULL ? server_record(entry, server_id, TRUE) : NULL;
+  if (record == NULL) {
+    return;
+  }
+  if (playtime_seconds > record->playtime_seconds || last_seen > record->last_seen) {
+    record->playtime_seconds = MAX(record->playtime_seconds, playtime_seconds);
+    record->last_seen = MAX(record->last_seen, last_seen);
+    index->dirty = TRUE;
+  }
+}
+
+const PumpkinPlayerIndexEntry *
+pumpkin_player_index_find(PumpkinPlayerIndex *index, const char *uuid_or_name)
+{
+  g_return_val_if_fail(index != NULL, NULL);
+  PumpkinPlayerIndexEntry *entry = lookup(index->by_uuid, uuid_or_name);
+  return entry != NULL ? entry : lookup(index->by_name, uuid_or_name);
+}
+
+guint64
+pumpkin_player_index_server_playtime(const PumpkinPlayerIndexServer *server, gint64 now)
+{
+  guint64 playtime = server->playtime_seconds;
+  if (server->online_since > 0 && now > server->online_since) {
+    playtime += (guint64)(now - server->online_since);
+  }
+  return playtime;
+}
+
+static gboolean
+contains_server(GPtrArray *server_ids, const char *server_id)
+{
+  if (server_ids == NULL) {
+    return TRUE;
+  }
+  for (guint i = 0; i < server_ids->len; i++) {
+    if (g_strcmp0(g_ptr_array_index(server_ids, i), server_id) == 0) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/* Players are counted once however many of the given servers they played on; NULL means every server. */
+void
+pumpkin_player_index_totals(PumpkinPlayerIndex *index, GPtrArray *server_ids, gint64 now,
+                            PumpkinPlayerIndexTotals *out)
+{
+  g_return_if_fail(index != NULL && out != NULL);
+  memset(out, 0, sizeof(*out));
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, index->entries);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    PumpkinPlayerIndexEntry *entry = key;
+    gboolean played = FALSE;
+    gboolean online = FALSE;
+    for (guint i = 0; i < entry->servers->len; i++) {
+      PumpkinPlayerIndexServer *record = &g_array_index(entry->servers, PumpkinPlayerIndexServer, i);
+      if (!contains_server(server_ids, record->server_id)) {
+        continue;
+      }
+      played = TRUE;
+      online = online || record->online_since > 0;
+      out->playtime_seconds += pumpkin_player_index_server_playtime(record, now);
+    }
+    out->players += played ? 1 : 0;
+    out->online += online ? 1 : 0;
+  }
+}
+
+/* One line per player and server: uuid ("-" if unknown), name, server id, playtime, last seen. */
+gboolean
+pumpkin_player_index_load(PumpkinPlayerIndex *index, const char *path)
+{
+  g_return_val_if_fail(index != NULL, FALSE);
+  g_autofree char *contents = NULL;
+  if (path == NULL || !g_file_get_contents(path, &contents, NULL, NULL)) {
+    return FALSE;
+  }
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  for (guint i = 0; lines[i] != NULL; i++) {
+    if (lines[i][0] == '\0' || lines[i][0] == '#') {
+      continue;
+    }
+    g_auto(GStrv) fields = g_strsplit(lines[i], "\t", 5);
+    if (g_strv_length(fields) < 5 || fields[2][0] == '\0') {
+      continue;
+    }
+    const char *uuid = g_strcmp0(fields[0], "-") != 0 ? fields[0] : NULL;
+    const char *name = fields[1][0] != '\0' ? fields[1] : NULL;
+    PumpkinPlayerIndexEntry *entry = resolve(index, uuid, name, TRUE);
+    PumpkinPlayerIndexServer *record = entry != NULL ? server_record(entry, fields[2], TRUE) : NULL;
+    if (record != NULL) {
+      record->playtime_seconds += g_ascii_strtoull(fields[3], NULL, 10);
+      record->last_seen = MAX(record->last_seen, g_ascii_strtoll(fields[4], NULL, 10));
+    }
+  }
+  index->dirty = FALSE;
+  return TRUE;
+}
+
+/* Open sessions are written up to now, so a crash loses at most one flush interval of playtime. */
+gboolean
+pumpkin_player_index_save(PumpkinPlayerIndex *index, const char *path, GError **error)
+{
+  g_return_val_if_fail(index != NULL, FALSE);
+  if (!index->dirty && index->open_sessions == 0) {
+    return TRUE;
+  }
+  gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+  GString *out = g_string_new("# uuid\tname\tserver_id\tplaytime_seconds\tlast_seen\n");
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, index->entries);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    PumpkinPlayerIndexEntry *entry = key;
+    for (guint i = 0; i < entry->servers->len; i++) {
+      PumpkinPlayerIndexServer *record = &g_array_index(entry->servers, PumpkinPlayerIndexServer, i);
+      g_string_append_printf(out, "%s\t%s\t%s\t%" G_GUINT64_FORMAT "\t%" G_GINT64_FORMAT "\n",
+                             entry->uuid != NULL ? entry->uuid : "-", entry->name != NULL ? entry->name : "",
+                             record->server_id, pumpkin_player_index_server_playtime(record, now),
+                             record->last_seen);
+    }
+  }
+  gboolean ok = g_file_set_contents(path, out->str, (gssize)out->len, error);
+  g_string_free(out, TRUE);
+  if (ok) {
+    index->dirty = FALSE;
+  }
+  return ok;
+}
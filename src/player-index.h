@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct _PumpkinPlayerIndex PumpkinPlayerIndex;
+
+typedef struct {
+  const char *server_id;
+  guint64 playtime_seconds;
+  gint64 online_since;
+  gint64 last_seen;
+} PumpkinPlayerIndexServer;
+
+/* Strings are interned atoms; uuid stays NULL until a log line or tracking file ties it to the name. */
+typedef struct {
+  const char *uuid;
+  const char *name;
+  GArray *servers;
+} PumpkinPlayerIndexEntry;
+
+typedef struct {
+  guint players;
+  guint online;
+  guint64 playtime_seconds;
+} PumpkinPlayerIndexTotals;
+
+PumpkinPlayerIndex *pumpkin_player_index_new(void);
+void pumpkin_player_index_free(PumpkinPlayerIndex *index);
+gboolean pumpkin_player_index_load(PumpkinPlayerIndex *index, const char *path);
+gboolean pumpkin_player_index_save(PumpkinPlayerIndex *index, const char *path, GError **error);
+void pumpkin_player_index_learn(PumpkinPlayerIndex *index, const char *uuid, const char *name);
+void pumpkin_player_index_join(PumpkinPlayerIndex *index, const char *server_id, const char *name, gint64 at);
+void pumpkin_player_index_leave(PumpkinPlayerIndex *index, const char *server_id, const char *name, gint64 at);
+void pumpkin_player_index_server_stopped(PumpkinPlayerIndex *index, const char *server_id, gint64 at);
+void pumpkin_player_index_seed(PumpkinPlayerIndex *index, const char *server_id, const char *uuid,
+                               const char *name, guint64 playtime_seconds, gint64 last_seen);
+const PumpkinPlayerIndexEntry *pumpkin_player_index_find(PumpkinPlayerIndex *index, const char *uuid_or_name);
+guint64 pumpkin_player_index_server_playtime(const PumpkinPlayerIndexServer *server, gint64 now);
+void pumpkin_player_index_totals(PumpkinPlayerIndex *index, GPtrArray *server_ids, gint64 now,
+                                 PumpkinPlayerIndexTotals *out);
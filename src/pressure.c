@@ -0,0 +1,113 @@
+#include "pressure.h"
+
+#include <gio/gio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const char *resource_names[PUMPKIN_PRESSURE_COUNT] = { "cpu", "memory", "io" };
+
+gboolean
+pumpkin_pressure_supported(void)
+{
+#if defined(__linux__)
+  return g_file_test("/proc/pressure/memory", G_FILE_TEST_EXISTS);
+#else
+  return FALSE;
+#endif
+}
+
+const char *
+pumpkin_pressure_resource_name(PumpkinPressureResource resource)
+{
+  if (resource < 0 || resource >= PUMPKIN_PRESSURE_COUNT) {
+    return "";
+  }
+  return resource_names[resource];
+}
+
+char *
+pumpkin_pressure_path(const char *cgroup_dir, PumpkinPressureResource resource)
+{
+  const char *name = pumpkin_pressure_resource_name(resource);
+  if (cgroup_dir == NULL) {
+    return g_build_filename("/proc/pressure", name, NULL);
+  }
+  g_autofree char *file = g_strdup_printf("%s.pressure", name);
+  return g_build_filename(cgroup_dir, file, NULL);
+}
+
+static void
+parse_pressure_line(const char *line, double *avg10, double *avg60, guint64 *total)
+{
+  g_auto(GStrv) fields = g_strsplit(line, " ", -1);
+  for (guint i = 0; fields[i] != NULL; i++) {
+    if (g_str_has_prefix(fields[i], "avg10=")) {
+      *avg10 = g_ascii_strtod(fields[i] + 6, NULL);
+    } else if (g_str_has_prefix(fields[i], "avg60=")) {
+      *avg60 = g_ascii_strtod(fields[i] + 6, NULL);
+    } else if (g_str_has_prefix(fields[i], "total=")) {
+      *total = g_ascii_strtoull(fields[i] + 6, NULL, 10);
+    }
+  }
+}
+
+gboolean
+pumpkin_pressure_read(const char *path, PumpkinPressure *out)
+{
+  if (path == NULL || out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+  g_autofree char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return FALSE;
+  }
+  gboolean found = FALSE;
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  for (guint i = 0; lines[i] != NULL; i++) {
+    if (g_str_has_prefix(lines[i], "some ")) {
+      parse_pressure_line(lines[i], &out->some_avg10, &out->some_avg60, &out->some_total_usec);
+      found = TRUE;
+    } else if (g_str_has_prefix(lines[i], "full ")) {
+      parse_pressure_line(lines[i], &out->full_avg10, &out->full_avg60, &out->full_total_usec);
+    }
+  }
+  return found;
+}
+
+/* The returned fd raises POLLPRI whenever stalls exceed stall_usec within window_usec. */
+int
+pumpkin_pressure_trigger_open(const char *path,
+                              gboolean full,
+                              guint stall_usec,
+                              guint window_usec,
+                              GError **error)
+{
+#if defined(__linux__)
+  int fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    int saved = errno;
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to open %s: %s", path, g_strerror(saved));
+    return -1;
+  }
+  /* The trigger string must include its terminating NUL. */
+  g_autofree char *trigger = g_strdup_printf("%s %u %u", full ? "full" : "some", stall_usec, window_usec);
+  if (write(fd, trigger, strlen(trigger) + 1) < 0) {
+    int saved = errno;
+    close(fd);
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to arm %s: %s", path, g_strerror(saved));
+    return -1;
+  }
+  return fd;
+#else
+  (void)full;
+  (void)stall_usec;
+  (void)window_usec;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Pressure stall information is not available for %s", path);
+  return -1;
+#endif
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glib.h>
+
+typedef enum {
+  PUMPKIN_PRESSURE_CPU = 0,
+  PUMPKIN_PRESSURE_MEMORY,
+  PUMPKIN_PRESSURE_IO,
+  PUMPKIN_PRESSURE_COUNT
+} PumpkinPressureResource;
+
+typedef struct {
+  double some_avg10;
+  double some_avg60;
+  double full_avg10;
+  double full_avg60;
+  guint64 some_total_usec;
+  guint64 full_total_usec;
+} PumpkinPressure;
+
+gboolean pumpkin_pressure_supported(void);
+const char *pumpkin_pressure_resource_name(PumpkinPressureResource resource);
+char *pumpkin_pressure_path(const char *cgroup_dir, PumpkinPressureResource resource);
+gboolean pumpkin_pressure_read(const char *path, PumpkinPressure *out);
+int pumpkin_pressure_trigger_open(const char *path,
+                                  gboolean full,
+                                  guint stall_usec,
+                                  guint window_usec,
+                                  GError **error);
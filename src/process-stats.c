@@ -0,0 +1,530 @@
+#include "process-stats.h"
+
+#include <gio/gio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+struct _PumpkinSchedSampler {
+  GHashTable *tasks;
+  PumpkinProcessSched totals;
+  int last_pid;
+};
+
+#if defined(__linux__)
+static char *
+read_proc_file(int pid, const char *name)
+{
+  if (pid <= 0 || name == NULL) {
+    return NULL;
+  }
+  g_autofree char *path = g_strdup_printf("/proc/%d/%s", pid, name);
+  char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return NULL;
+  }
+  return contents;
+}
+
+static gboolean
+lookup_u64_field(const char *contents, const char *key, guint64 *out)
+{
+  if (contents == NULL || key == NULL || out == NULL) {
+    return FALSE;
+  }
+  gsize key_len = strlen(key);
+  const char *line = contents;
+  while (line != NULL && *line != '\0') {
+    if (strncmp(line, key, key_len) == 0 && line[key_len] == ':') {
+      const char *value = line + key_len + 1;
+      while (*value == ' ' || *value == '\t') {
+        value++;
+      }
+      *out = g_ascii_strtoull(value, NULL, 10);
+      return TRUE;
+    }
+    line = strchr(line, '\n');
+    if (line != NULL) {
+      line++;
+    }
+  }
+  return FALSE;
+}
+
+static gboolean
+parse_schedstat(const char *contents, guint64 *run_ns, guint64 *wait_ns, guint64 *timeslices)
+{
+  if (contents == NULL) {
+    return FALSE;
+  }
+  guint64 values[3] = { 0, 0, 0 };
+  const char *cursor = contents;
+  for (int i = 0; i < 3; i++) {
+    char *end = NULL;
+    values[i] = g_ascii_strtoull(cursor, &end, 10);
+    if (end == cursor) {
+      return FALSE;
+    }
+    cursor = end;
+  }
+  *run_ns += values[0];
+  *wait_ns += values[1];
+  *timeslices += values[2];
+  return TRUE;
+}
+
+/* Run time and context switches for one thread, so both come from the same set of tasks. */
+static gboolean
+read_task_sched(const char *task_dir, const char *tid, PumpkinProcessSched *out)
+{
+  memset(out, 0, sizeof(*out));
+  g_autofree char *schedstat_path = g_build_filename(task_dir, tid, "schedstat", NULL);
+  g_autofree char *schedstat = NULL;
+  if (!g_file_get_contents(schedstat_path, &schedstat, NULL, NULL) ||
+      !parse_schedstat(schedstat, &out->run_ns, &out->wait_ns, &out->timeslices)) {
+    return FALSE;
+  }
+  g_autofree char *status_path = g_build_filename(task_dir, tid, "status", NULL);
+  g_autofree char *status = NULL;
+  if (g_file_get_contents(status_path, &status, NULL, NULL)) {
+    lookup_u64_field(status, "voluntary_ctxt_switches", &out->voluntary_switches);
+    lookup_u64_field(status, "nonvoluntary_ctxt_switches", &out->involuntary_switches);
+  }
+  out->threads = 1;
+  return TRUE;
+}
+
+static void
+sched_add(PumpkinProcessSched *total, const PumpkinProcessSched *task)
+{
+  total->run_ns += task->run_ns;
+  total->wait_ns += task->wait_ns;
+  total->timeslices += task->timeslices;
+  total->voluntary_switches += task->voluntary_switches;
+  total->involuntary_switches += task->involuntary_switches;
+  total->threads += task->threads;
+}
+
+static guint64
+counter_delta(guint64 current, guint64 previous)
+{
+  return current >= previous ? current - previous : current;
+}
+
+/* Fields are numbered as in proc(5), so 1 is the pid and 2 the comm. */
+static gboolean
+read_stat_fields(int pid, const int *fields, guint64 *values, int count)
+{
+  g_autofree char *contents = read_proc_file(pid, "stat");
+  if (contents == NULL) {
+    return FALSE;
+  }
+  char *paren = strrchr(contents, ')');
+  if (paren == NULL) {
+    return FALSE;
+  }
+
+  int field = 3;
+  int found = 0;
+  char *saveptr = NULL;
+  char *token = strtok_r(paren + 1, " ", &saveptr);
+  while (token != NULL && found < count) {
+    for (int i = 0; i < count; i++) {
+      if (fields[i] == field) {
+        values[i] = g_ascii_strtoull(token, NULL, 10);
+        found++;
+      }
+    }
+    field++;
+    token = strtok_r(NULL, " ", &saveptr);
+  }
+  return found == count;
+}
+#endif
+
+gboolean
+pumpkin_process_stats_supported(void)
+{
+#if defined(__linux__)
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+gboolean
+pumpkin_process_read_io(int pid, PumpkinProcessIo *out)
+{
+#if defined(__linux__)
+  if (pid <= 0 || out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+
+  static const int fault_fields[] = { 10, 12 };
+  guint64 faults[2] = { 0, 0 };
+  if (!read_stat_fields(pid, fault_fields, faults, G_N_ELEMENTS(fault_fields))) {
+    return FALSE;
+  }
+  out->minor_faults = faults[0];
+  out->major_faults = faults[1];
+
+  /* /proc/<pid>/io needs ptrace access; faults alone are still useful without it. */
+  g_autofree char *io = read_proc_file(pid, "io");
+  if (io != NULL) {
+    lookup_u64_field(io, "read_bytes", &out->read_bytes);
+    lookup_u64_field(io, "write_bytes", &out->write_bytes);
+    lookup_u64_field(io, "syscr", &out->read_syscalls);
+    lookup_u64_field(io, "syscw", &out->write_syscalls);
+  }
+  return TRUE;
+#else
+  (void)pid;
+  (void)out;
+  return FALSE;
+#endif
+}
+
+/* /proc/<pid>/schedstat and status only cover the main thread, so every task is summed. */
+gboolean
+pumpkin_process_read_sched(int pid, PumpkinProcessSched *out)
+{
+#if defined(__linux__)
+  if (pid <= 0 || out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+
+  g_autofree char *task_dir = g_strdup_printf("/proc/%d/task", pid);
+  GDir *dir = g_dir_open(task_dir, 0, NULL);
+  if (dir == NULL) {
+    return FALSE;
+  }
+  const char *name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    PumpkinProcessSched task;
+    if (read_task_sched(task_dir, name, &task)) {
+      sched_add(out, &task);
+    }
+  }
+  g_dir_close(dir);
+  return out->threads > 0;
+#else
+  (void)pid;
+  (void)out;
+  return FALSE;
+#endif
+}
+
+PumpkinSchedSampler *
+pumpkin_sched_sampler_new(void)
+{
+  PumpkinSchedSampler *sampler = g_new0(PumpkinSchedSampler, 1);
+  sampler->tasks = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  return sampler;
+}
+
+void
+pumpkin_sched_sampler_free(PumpkinSchedSampler *sampler)
+{
+  if (sampler == NULL) {
+    return;
+  }
+  g_clear_pointer(&sampler->tasks, g_hash_table_unref);
+  g_free(sampler);
+}
+
+/*
+ * Like pumpkin_process_read_sched, but the counters only ever grow: each thread contributes what it
+ * did since the previous read, so a thread exiting does not take its history out of the total.
+ */
+gboolean
+pumpkin_sched_sampler_read(PumpkinSchedSampler *sampler, int pid, PumpkinProcessSched *out)
+{
+#if defined(__linux__)
+  if (sampler == NULL || pid <= 0 || out == NULL) {
+    return FALSE;
+  }
+  if (pid != sampler->last_pid) {
+    g_hash_table_remove_all(sampler->tasks);
+    memset(&sampler->totals, 0, sizeof(sampler->totals));
+    sampler->last_pid = pid;
+  }
+
+  g_autofree char *task_dir = g_strdup_printf("/proc/%d/task", pid);
+  GDir *dir = g_dir_open(task_dir, 0, NULL);
+  if (dir == NULL) {
+    return FALSE;
+  }
+  GHashTable *tasks = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  const char *name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    PumpkinProcessSched *task = g_new(PumpkinProcessSched, 1);
+    if (!read_task_sched(task_dir, name, task)) {
+      g_free(task);
+      continue;
+    }
+    PumpkinProcessSched previous = { 0 };
+    PumpkinProcessSched *known = g_hash_table_lookup(sampler->tasks, name);
+    if (known != NULL) {
+      previous = *known;
+    }
+    sampler->totals.run_ns += counter_delta(task->run_ns, previous.run_ns);
+    sampler->totals.wait_ns += counter_delta(task->wait_ns, previous.wait_ns);
+    sampler->totals.timeslices += counter_delta(task->timeslices, previous.timeslices);
+    sampler->totals.voluntary_switches += counter_delta(task->voluntary_switches, previous.voluntary_switches);
+    sampler->totals.involuntary_switches += counter_delta(task->involuntary_switches,
+                                                          previous.involuntary_switches);
+    g_hash_table_replace(tasks, g_strdup(name), task);
+  }
+  g_dir_close(dir);
+  g_hash_table_unref(sampler->tasks);
+  sampler->tasks = tasks;
+
+  *out = sampler->totals;
+  out->threads = g_hash_table_size(tasks);
+  return out->threads > 0;
+#else
+  (void)sampler;
+  (void)pid;
+  (void)out;
+  return FALSE;
+#endif
+}
+
+gboolean
+pumpkin_process_read_memory(int pid, PumpkinProcessMemory *out)
+{
+#if defined(__linux__)
+  if (pid <= 0 || out == NULL) {
+    return FALSE;
+  }
+  memset(out, 0, sizeof(*out));
+
+  g_autofree char *rollup = read_proc_file(pid, "smaps_rollup");
+  if (rollup == NULL || !lookup_u64_field(rollup, "Rss", &out->rss)) {
+    return FALSE;
+  }
+  lookup_u64_field(rollup, "Pss", &out->pss);
+  lookup_u64_field(rollup, "Anonymous", &out->anon);
+  lookup_u64_field(rollup, "Swap", &out->swap);
+
+  /* smaps_rollup has no shmem share of Rss; status does, and file is the remainder. */
+  g_autofree char *status = read_proc_file(pid, "status");
+  if (status != NULL) {
+    lookup_u64_field(status, "RssShmem", &out->shmem);
+  }
+  if (out->anon > out->rss) {
+    out->anon = out->rss;
+  }
+  if (out->shmem > out->rss - out->anon) {
+    out->shmem = out->rss - out->anon;
+  }
+  out->file = out->rss - out->anon - out->shmem;
+
+  out->rss *= 1024;
+  out->pss *= 1024;
+  out->anon *= 1024;
+  out->file *= 1024;
+  out->shmem *= 1024;
+  out->swap *= 1024;
+  return TRUE;
+#else
+  (void)pid;
+  (void)out;
+  return FALSE;
+#endif
+}
+
+#if defined(__linux__)
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT 21
+#endif
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_process_madvise
+#define SYS_process_madvise 440
+#endif
+#define PAGEOUT_BATCH 512
+
+/* Private anonymous mappings only: file pages are cheap to drop and reread on their own. */
+static gboolean
+is_anon_mapping(const char *line, guint64 *start, guint64 *end)
+{
+  char perms[8] = { 0 };
+  unsigned long long lo = 0;
+  unsigned long long hi = 0;
+  unsigned long long offset = 0;
+  unsigned long inode = 0;
+  int path_at = 0;
+  if (sscanf(line, "%llx-%llx %7s %llx %*s %lu %n", &lo, &hi, perms, &offset, &inode, &path_at) < 5) {
+    return FALSE;
+  }
+  if (perms[1] != 'w' || perms[3] != 'p' || inode != 0) {
+    return FALSE;
+  }
+  const char *path = path_at > 0 ? line + path_at : "";
+  if (*path != '\0' && g_strcmp0(path, "[heap]") != 0 && !g_str_has_prefix(path, "[anon:")) {
+    return FALSE;
+  }
+  *start = lo;
+  *end = hi;
+  return TRUE;
+}
+
+static gssize
+pageout_batch(int pidfd, struct iovec *iov, guint count)
+{
+  gssize total = 0;
+  while (count > 0) {
+    long advised = syscall(SYS_process_madvise, pidfd, iov, (size_t)count, MADV_PAGEOUT, 0U);
+    if (advised < 0) {
+      return -1;
+    }
+    total += advised;
+    /* A short count means the kernel stopped early; skip the region it choked on. */
+    gsize consumed = (gsize)advised;
+    while (count > 0 && consumed >= iov->iov_len) {
+      consumed -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov++;
+      count--;
+    }
+  }
+  return total;
+}
+#endif
+
+/* Asks the kernel to push the process's anonymous memory out to swap or zram. */
+gboolean
+pumpkin_process_pageout(int pid, guint64 *out_bytes, GError **error)
+{
+#if defined(__linux__)
+  if (out_bytes != NULL) {
+    *out_bytes = 0;
+  }
+  g_autofree char *maps = read_proc_file(pid, "maps");
+  if (maps == NULL) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND, "Cannot read memory map of process %d", pid);
+    return FALSE;
+  }
+  int pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+  if (pidfd < 0) {
+    int saved = errno;
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "pidfd_open failed: %s", g_strerror(saved));
+    return FALSE;
+  }
+
+  struct iovec iov[PAGEOUT_BATCH];
+  guint count = 0;
+  guint64 total = 0;
+  gboolean ok = TRUE;
+  g_auto(GStrv) lines = g_strsplit(maps, "\n", -1);
+  for (guint i = 0; lines[i] != NULL && ok; i++) {
+    guint64 start = 0;
+    guint64 end = 0;
+    if (!is_anon_mapping(lines[i], &start, &end)) {
+      continue;
+    }
+    iov[count].iov_base = (void *)(guintptr)start;
+    iov[count].iov_len = (size_t)(end - start);
+    count++;
+    if (count == PAGEOUT_BATCH) {
+      gssize advised = pageout_batch(pidfd, iov, count);
+      ok = advised >= 0;
+      total += advised > 0 ? (guint64)advised : 0;
+      count = 0;
+    }
+  }
+  if (ok && count > 0) {
+    gssize advised = pageout_batch(pidfd, iov, count);
+    ok = advised >= 0;
+    total += advised > 0 ? (guint64)advised : 0;
+  }
+  int saved = errno;
+  close(pidfd);
+  if (!ok) {
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "process_madvise failed: %s", g_strerror(saved));
+    return FALSE;
+  }
+  if (out_bytes != NULL) {
+    *out_bytes = total;
+  }
+  return TRUE;
+#else
+  (void)pid;
+  (void)out_bytes;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Memory reclaim is only available on Linux");
+  return FALSE;
+#endif
+}
+
+#if defined(__linux__)
+static char *
+read_task_file(const char *task_dir, const char *name)
+{
+  g_autofree char *path = g_build_filename(task_dir, name, NULL);
+  char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return NULL;
+  }
+  g_strchomp(contents);
+  return contents;
+}
+#endif
+
+/* Kernel stacks need CAP_SYS_ADMIN; state and wchan alone usually show where a hung thread sleeps. */
+char *
+pumpkin_process_dump_threads(int pid)
+{
+#if defined(__linux__)
+  if (pid <= 0) {
+    return NULL;
+  }
+  g_autofree char *task_root = g_strdup_printf("/proc/%d/task", pid);
+  GDir *dir = g_dir_open(task_root, 0, NULL);
+  if (dir == NULL) {
+    return NULL;
+  }
+  GString *out = g_string_new(NULL);
+  const char *name = NULL;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    g_autofree char *task_dir = g_build_filename(task_root, name, NULL);
+    g_autofree char *comm = read_task_file(task_dir, "comm");
+    g_autofree char *stat = read_task_file(task_dir, "stat");
+    g_autofree char *wchan = read_task_file(task_dir, "wchan");
+    g_autofree char *stack = read_task_file(task_dir, "stack");
+    char state = '?';
+    const char *paren = stat != NULL ? strrchr(stat, ')') : NULL;
+    if (paren != NULL && paren[1] == ' ') {
+      state = paren[2];
+    }
+    g_string_append_printf(out, "tid %s (%s) state %c wchan %s\n",
+                           name,
+                           comm != NULL ? comm : "?",
+                           state,
+                           wchan != NULL && *wchan != '\0' ? wchan : "-");
+    if (stack != NULL && *stack != '\0') {
+      g_string_append(out, stack);
+      g_string_append_c(out, '\n');
+    } else {
+      g_string_append(out, "  (kernel stack unavailable)\n");
+    }
+    g_string_append_c(out, '\n');
+  }
+  g_dir_close(dir);
+  return g_string_free(out, FALSE);
+#else
+  (void)pid;
+  return NULL;
+#endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  guint64 read_bytes;
+  guint64 write_bytes;
+  guint64 read_syscalls;
+  guint64 write_syscalls;
+  guint64 minor_faults;
+  guint64 major_faults;
+} PumpkinProcessIo;
+
+typedef struct {
+  guint64 run_ns;
+  guint64 wait_ns;
+  guint64 timeslices;
+  guint64 voluntary_switches;
+  guint64 involuntary_switches;
+  guint threads;
+} PumpkinProcessSched;
+
+typedef struct {
+  guint64 rss;
+  guint64 pss;
+  guint64 anon;
+  guint64 file;
+  guint64 shmem;
+  guint64 swap;
+} PumpkinProcessMemory;
+
+typedef struct _PumpkinSchedSampler PumpkinSchedSampler;
+
+gboolean pumpkin_process_stats_supported(void);
+gboolean pumpkin_process_read_io(int pid, PumpkinProcessIo *out);
+gboolean pumpkin_process_read_sched(int pid, PumpkinProcessSched *out);
+PumpkinSchedSampler *pumpkin_sched_sampler_new(void);
+void pumpkin_sched_sampler_free(PumpkinSchedSampler *sampler);
+gboolean pumpkin_sched_sampler_read(PumpkinSchedSampler *sampler, int pid, PumpkinProcessSched *out);
+gboolean pumpkin_process_read_memory(int pid, PumpkinProcessMemory *out);
+gboolean pumpkin_process_pageout(int pid, guint64 *out_bytes, GError **error);
+char *pumpkin_process_dump_threads(int pid);
@@ -0,0 +1,446 @@
+#include "search-index.h"
+
+#include <string.h>
+
+#define SEARCH_NONE G_MAXUINT32
+#define SEARCH_COMPACT_MIN 4096
+#define SEARCH_DEAD 0x80
+#define SEARCH_RANK_MASK 0x7f
+#define GRAM_IN_NAME 1
+#define GRAM_NAME_START 2
+#define GRAM_FLAG_BITS 2
+
+typedef struct {
+  char *key;
+  char *name;
+  char *uuid;
+  char *ip;
+} SearchDoc;
+
+typedef struct {
+  guint32 child;
+  guint32 sibling;
+  guint32 docs;
+  guint8 byte;
+} TrieNode;
+
+typedef struct {
+  guint32 doc;
+  guint32 next;
+} TrieLink;
+
+/*
+ * Documents are append-only: changing a player tombstones its old document and appends a new one,
+ * so trie links and trigram postings never need to be edited in place. Tombstones are dropped by
+ * rebuilding once they outnumber live documents.
+ *
+ * Postings hold doc ids shifted left by GRAM_FLAG_BITS, tagged with where the gram sits in the name,
+ * so a three-character query is ranked without touching the documents.
+ */
+struct _PumpkinSearchIndex {
+  GArray *docs;
+  GByteArray *ranks;
+  GHashTable *doc_by_key;
+  GArray *nodes;
+  GArray *links;
+  GHashTable *grams;
+  char *query;
+  gsize query_len;
+  guint live;
+  guint dead;
+};
+
+static void
+search_doc_clear(SearchDoc *doc)
+{
+  g_clear_pointer(&doc->key, g_free);
+  g_clear_pointer(&doc->name, g_free);
+  g_clear_pointer(&doc->uuid, g_free);
+  g_clear_pointer(&doc->ip, g_free);
+}
+
+static void
+posting_free(gpointer data)
+{
+  g_array_free(data, TRUE);
+}
+
+static void
+search_index_reset(PumpkinSearchIndex *index)
+{
+  g_array_set_size(index->nodes, 0);
+  TrieNode root = { SEARCH_NONE, SEARCH_NONE, SEARCH_NONE, 0 };
+  g_array_append_val(index->nodes, root);
+  g_array_set_size(index->links, 0);
+  g_hash_table_remove_all(index->grams);
+  g_hash_table_remove_all(index->doc_by_key);
+  g_byte_array_set_size(index->ranks, 0);
+  index->live = 0;
+  index->dead = 0;
+}
+
+PumpkinSearchIndex *
+pumpkin_search_index_new(void)
+{
+  PumpkinSearchIndex *index = g_new0(PumpkinSearchIndex, 1);
+  index->docs = g_array_new(FALSE, TRUE, sizeof(SearchDoc));
+  index->ranks = g_byte_array_new();
+  index->doc_by_key = g_hash_table_new(g_str_hash, g_str_equal);
+  index->nodes = g_array_new(FALSE, FALSE, sizeof(TrieNode));
+  index->links = g_array_new(FALSE, FALSE, sizeof(TrieLink));
+  index->grams = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, posting_free);
+  search_index_reset(index);
+  return index;
+}
+
+void
+pumpkin_search_index_clear(PumpkinSearchIndex *index)
+{
+  if (index == NULL) {
+    return;
+  }
+  for (guint i = 0; i < index->docs->len; i++) {
+    search_doc_clear(&g_array_index(index->docs, SearchDoc, i));
+  }
+  g_array_set_size(index->docs, 0);
+  search_index_reset(index);
+}
+
+void
+pumpkin_search_index_free(PumpkinSearchIndex *index)
+{
+  if (index == NULL) {
+    return;
+  }
+  pumpkin_search_index_clear(index);
+  g_array_free(index->docs, TRUE);
+  g_byte_array_free(index->ranks, TRUE);
+  g_hash_table_destroy(index->doc_by_key);
+  g_array_free(index->nodes, TRUE);
+  g_array_free(index->links, TRUE);
+  g_hash_table_destroy(index->grams);
+  g_free(index->query);
+  g_free(index);
+}
+
+static guint32
+trie_child(PumpkinSearchIndex *index, guint32 node, guint8 byte, gboolean create)
+{
+  guint32 child = g_array_index(index->nodes, TrieNode, node).child;
+  while (child != SEARCH_NONE) {
+    TrieNode *entry = &g_array_index(index->nodes, TrieNode, child);
+    if (entry->byte == byte) {
+      return child;
+    }
+    child = entry->sibling;
+  }
+  if (!create) {
+    return SEARCH_NONE;
+  }
+  TrieNode added = { SEARCH_NONE, g_array_index(index->nodes, TrieNode, node).child, SEARCH_NONE, byte };
+  g_array_append_val(index->nodes, added);
+  child = index->nodes->len - 1;
+  g_array_index(index->nodes, TrieNode, node).child = child;
+  return child;
+}
+
+static void
+trie_insert(PumpkinSearchIndex *index, const char *name, guint32 doc)
+{
+  guint32 node = 0;
+  for (const guint8 *p = (const guint8 *)name; *p != '\0'; p++) {
+    node = trie_child(index, node, *p, TRUE);
+  }
+  TrieLink link = { doc, g_array_index(index->nodes, TrieNode, node).docs };
+  g_array_append_val(index->links, link);
+  g_array_index(index->nodes, TrieNode, node).docs = index->links->len - 1;
+}
+
+static inline guint32
+gram_at(const char *text)
+{
+  return ((guint32)(guint8)text[0] << 16) | ((guint32)(guint8)text[1] << 8) | (guint32)(guint8)text[2];
+}
+
+static void
+grams_insert(PumpkinSearchIndex *index, const char *text, guint32 doc, gboolean is_name)
+{
+  if (text == NULL) {
+    return;
+  }
+  gsize len = strlen(text);
+  for (gsize i = 0; i + PUMPKIN_SEARCH_MIN_FRAGMENT <= len; i++) {
+    gpointer gram = GUINT_TO_POINTER(gram_at(text + i));
+    guint32 flags = is_name ? (i == 0 ? GRAM_IN_NAME | GRAM_NAME_START : GRAM_IN_NAME) : 0;
+    GArray *posting = g_hash_table_lookup(index->grams, gram);
+    if (posting == NULL) {
+      posting = g_array_new(FALSE, FALSE, sizeof(guint32));
+      g_hash_table_insert(index->grams, gram, posting);
+    } else if ((g_array_index(posting, guint32, posting->len - 1) >> GRAM_FLAG_BITS) == doc) {
+      g_array_index(posting, guint32, posting->len - 1) |= flags;
+      continue;
+    }
+    guint32 entry = (doc << GRAM_FLAG_BITS) | flags;
+    g_array_append_val(posting, entry);
+  }
+}
+
+static PumpkinSearchRank
+search_doc_rank(PumpkinSearchIndex *index, const SearchDoc *doc)
+{
+  if (index->query == NULL || doc->key == NULL) {
+    return PUMPKIN_SEARCH_RANK_NONE;
+  }
+  if (doc->name != NULL && strncmp(doc->name, index->query, index->query_len) == 0) {
+    return doc->name[index->query_len] == '\0' ? PUMPKIN_SEARCH_RANK_NAME_EXACT : PUMPKIN_SEARCH_RANK_NAME_PREFIX;
+  }
+  if (index->query_len < PUMPKIN_SEARCH_MIN_FRAGMENT) {
+    return PUMPKIN_SEARCH_RANK_NONE;
+  }
+  if (doc->name != NULL && strstr(doc->name, index->query) != NULL) {
+    return PUMPKIN_SEARCH_RANK_NAME_SUBSTRING;
+  }
+  if ((doc->uuid != NULL && strstr(doc->uuid, index->query) != NULL) ||
+      (doc->ip != NULL && strstr(doc->ip, index->query) != NULL)) {
+    return PUMPKIN_SEARCH_RANK_FIELD;
+  }
+  return PUMPKIN_SEARCH_RANK_NONE;
+}
+
+/* Takes ownership of the strings. */
+static void
+search_index_append(PumpkinSearchIndex *index, char *key, char *name, char *uuid, char *ip)
+{
+  SearchDoc doc = { key, name, uuid, ip };
+  g_array_append_val(index->docs, doc);
+  guint32 id = index->docs->len - 1;
+  g_hash_table_insert(index->doc_by_key, key, GUINT_TO_POINTER(id));
+  if (name != NULL) {
+    trie_insert(index, name, id);
+  }
+  grams_insert(index, name, id, TRUE);
+  grams_insert(index, uuid, id, FALSE);
+  grams_insert(index, ip, id, FALSE);
+  guint8 rank = (guint8)search_doc_rank(index, &doc);
+  g_byte_array_append(index->ranks, &rank, 1);
+  index->live++;
+}
+
+static void
+search_index_compact(PumpkinSearchIndex *index)
+{
+  GArray *old_docs = index->docs;
+  index->docs = g_array_sized_new(FALSE, TRUE, sizeof(SearchDoc), index->live);
+  search_index_reset(index);
+  for (guint i = 0; i < old_docs->len; i++) {
+    SearchDoc *doc = &g_array_index(old_docs, SearchDoc, i);
+    if (doc->key != NULL) {
+      search_index_append(index, doc->key, doc->name, doc->uuid, doc->ip);
+    }
+  }
+  g_array_free(old_docs, TRUE);
+}
+
+static void
+search_index_drop(PumpkinSearchIndex *index, guint32 id)
+{
+  SearchDoc *doc = &g_array_index(index->docs, SearchDoc, id);
+  g_hash_table_remove(index->doc_by_key, doc->key);
+  search_doc_clear(doc);
+  index->ranks->data[id] = SEARCH_DEAD;
+  index->live--;
+  index->dead++;
+}
+
+static gboolean
+search_index_lookup(PumpkinSearchIndex *index, const char *key, guint32 *out_id)
+{
+  gpointer value = NULL;
+  if (key == NULL || !g_hash_table_lookup_extended(index->doc_by_key, key, NULL, &value)) {
+    return FALSE;
+  }
+  *out_id = GPOINTER_TO_UINT(value);
+  return TRUE;
+}
+
+/* Fields are expected to be normalized already; unchanged documents are left alone. */
+void
+pumpkin_search_index_set(PumpkinSearchIndex *index,
+                         const char *key,
+                         const char *name,
+                         const char *uuid,
+                         const char *ip)
+{
+  if (index == NULL || key == NULL) {
+    return;
+  }
+  guint32 id = 0;
+  if (search_index_lookup(index, key, &id)) {
+    SearchDoc *doc = &g_array_index(index->docs, SearchDoc, id);
+    if (g_strcmp0(doc->name, name) == 0 && g_strcmp0(doc->uuid, uuid) == 0 && g_strcmp0(doc->ip, ip) == 0) {
+      return;
+    }
+    search_index_drop(index, id);
+  }
+  search_index_append(index, g_strdup(key), g_strdup(name), g_strdup(uuid), g_strdup(ip));
+  if (index->dead > SEARCH_COMPACT_MIN && index->dead > index->live) {
+    search_index_compact(index);
+  }
+}
+
+void
+pumpkin_search_index_remove(PumpkinSearchIndex *index, const char *key)
+{
+  guint32 id = 0;
+  if (index != NULL && search_index_lookup(index, key, &id)) {
+    search_index_drop(index, id);
+  }
+}
+
+static guint
+search_index_mark(PumpkinSearchIndex *index, guint32 id, PumpkinSearchRank rank)
+{
+  guint8 *slot = &index->ranks->data[id];
+  if (*slot != PUMPKIN_SEARCH_RANK_NONE || rank == PUMPKIN_SEARCH_RANK_NONE) {
+    return 0;
+  }
+  *slot = (guint8)rank;
+  return 1;
+}
+
+/* Docs stored on the final node are exact matches, everything below it is a prefix match. */
+static guint
+search_index_query_prefix(PumpkinSearchIndex *index)
+{
+  guint32 node = 0;
+  for (gsize i = 0; i < index->query_len && node != SEARCH_NONE; i++) {
+    node = trie_child(index, node, (guint8)index->query[i], FALSE);
+  }
+  if (node == SEARCH_NONE) {
+    return 0;
+  }
+
+  guint matches = 0;
+  g_autoptr(GArray) stack = g_array_new(FALSE, FALSE, sizeof(guint32));
+  g_array_append_val(stack, node);
+  while (stack->len > 0) {
+    guint32 current = g_array_index(stack, guint32, stack->len - 1);
+    g_array_set_size(stack, stack->len - 1);
+    TrieNode *entry = &g_array_index(index->nodes, TrieNode, current);
+    PumpkinSearchRank rank = current == node ? PUMPKIN_SEARCH_RANK_NAME_EXACT : PUMPKIN_SEARCH_RANK_NAME_PREFIX;
+    for (guint32 link = entry->docs; link != SEARCH_NONE;) {
+      TrieLink *item = &g_array_index(index->links, TrieLink, link);
+      matches += search_index_mark(index, item->doc, rank);
+      link = item->next;
+    }
+    for (guint32 child = entry->child; child != SEARCH_NONE;) {
+      g_array_append_val(stack, child);
+      child = g_array_index(index->nodes, TrieNode, child).sibling;
+    }
+  }
+  return matches;
+}
+
+static gint
+posting_len_cmp(gconstpointer a, gconstpointer b)
+{
+  const GArray *left = *(GArray * const *)a;
+  const GArray *right = *(GArray * const *)b;
+  return left->len < right->len ? -1 : (left->len > right->len ? 1 : 0);
+}
+
+static guint
+search_index_query_grams(PumpkinSearchIndex *index)
+{
+  g_autoptr(GPtrArray) postings = g_ptr_array_new();
+  for (gsize i = 0; i + PUMPKIN_SEARCH_MIN_FRAGMENT <= index->query_len; i++) {
+    GArray *posting = g_hash_table_lookup(index->grams, GUINT_TO_POINTER(gram_at(index->query + i)));
+    if (posting == NULL) {
+      return 0;
+    }
+    g_ptr_array_add(postings, posting);
+  }
+  g_ptr_array_sort(postings, posting_len_cmp);
+  GArray *shortest = g_ptr_array_index(postings, 0);
+
+  guint matches = 0;
+  if (index->query_len == PUMPKIN_SEARCH_MIN_FRAGMENT) {
+    for (guint i = 0; i < shortest->len; i++) {
+      guint32 entry = g_array_index(shortest, guint32, i);
+      guint32 id = entry >> GRAM_FLAG_BITS;
+      PumpkinSearchRank rank = PUMPKIN_SEARCH_RANK_FIELD;
+      if (entry & GRAM_NAME_START) {
+        const char *name = g_array_index(index->docs, SearchDoc, id).name;
+        rank = name != NULL && name[index->query_len] == '\0' ? PUMPKIN_SEARCH_RANK_NAME_EXACT
+                                                              : PUMPKIN_SEARCH_RANK_NAME_PREFIX;
+      } else if (entry & GRAM_IN_NAME) {
+        rank = PUMPKIN_SEARCH_RANK_NAME_SUBSTRING;
+      }
+      matches += search_index_mark(index, id, rank);
+    }
+    return matches;
+  }
+
+  /* Intersect the two rarest grams before checking candidates against the full query. */
+  g_autoptr(GArray) candidates = g_array_sized_new(FALSE, FALSE, sizeof(guint32), shortest->len);
+  GArray *next = postings->len > 1 ? g_ptr_array_index(postings, 1) : NULL;
+  guint j = 0;
+  for (guint i = 0; i < shortest->len; i++) {
+    guint32 id = g_array_index(shortest, guint32, i) >> GRAM_FLAG_BITS;
+    if (next != NULL) {
+      while (j < next->len && (g_array_index(next, guint32, j) >> GRAM_FLAG_BITS) < id) {
+        j++;
+      }
+      if (j >= next->len) {
+        break;
+      }
+      if ((g_array_index(next, guint32, j) >> GRAM_FLAG_BITS) != id) {
+        continue;
+      }
+    }
+    g_array_append_val(candidates, id);
+  }
+  for (guint i = 0; i < candidates->len; i++) {
+    guint32 id = g_array_index(candidates, guint32, i);
+    if (index->ranks->data[id] == PUMPKIN_SEARCH_RANK_NONE) {
+      matches += search_index_mark(index, id, search_doc_rank(index, &g_array_index(index->docs, SearchDoc, id)));
+    }
+  }
+  return matches;
+}
+
+/*
+ * Ranks every document against the query and returns the number of matches. Ranks stay current
+ * across later set/remove calls until the next query.
+ */
+guint
+pumpkin_search_index_query(PumpkinSearchIndex *index, const char *query)
+{
+  if (index == NULL) {
+    return 0;
+  }
+  g_clear_pointer(&index->query, g_free);
+  index->query_len = 0;
+  for (guint i = 0; i < index->ranks->len; i++) {
+    index->ranks->data[i] &= SEARCH_DEAD;
+  }
+  if (query == NULL || *query == '\0') {
+    return 0;
+  }
+  index->query = g_strdup(query);
+  index->query_len = strlen(query);
+  if (index->query_len < PUMPKIN_SEARCH_MIN_FRAGMENT) {
+    return search_index_query_prefix(index);
+  }
+  return search_index_query_grams(index);
+}
+
+PumpkinSearchRank
+pumpkin_search_index_rank(PumpkinSearchIndex *index, const char *key)
+{
+  guint32 id = 0;
+  if (index == NULL || index->query == NULL || !search_index_lookup(index, key, &id)) {
+    return PUMPKIN_SEARCH_RANK_NONE;
+  }
+  return (PumpkinSearchRank)(index->ranks->data[id] & SEARCH_RANK_MASK);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <glib.h>
+
+/* Queries shorter than this only match name prefixes; longer ones match fragments of any field. */
+#define PUMPKIN_SEARCH_MIN_FRAGMENT 3
+
+typedef enum {
+  PUMPKIN_SEARCH_RANK_NONE = 0,
+  PUMPKIN_SEARCH_RANK_FIELD,
+  PUMPKIN_SEARCH_RANK_NAME_SUBSTRING,
+  PUMPKIN_SEARCH_RANK_NAME_PREFIX,
+  PUMPKIN_SEARCH_RANK_NAME_EXACT
+} PumpkinSearchRank;
+
+typedef struct _PumpkinSearchIndex PumpkinSearchIndex;
+
+PumpkinSearchIndex *pumpkin_search_index_new(void);
+void pumpkin_search_index_free(PumpkinSearchIndex *index);
+void pumpkin_search_index_clear(PumpkinSearchIndex *index);
+void pumpkin_search_index_set(PumpkinSearchIndex *index,
+                              const char *key,
+                              const char *name,
+                              const char *uuid,
+                              const char *ip);
+void pumpkin_search_index_remove(PumpkinSearchIndex *index, const char *key);
+guint pumpkin_search_index_query(PumpkinSearchIndex *index, const char *query);
+PumpkinSearchRank pumpkin_search_index_rank(PumpkinSearchIndex *index, const char *key);
@@ -1,5 +1,8 @@
 #define _GNU_SOURCE
 #include "server.h"
+#include "cgroup.h"
+#include "cpu-topology.h"
+#include "launch-profile.h"
 
 #include <gio/gio.h>
 #include <glib/gstdio.h>
@@ -17,6 +20,7 @@
 #include <sys/sysctl.h>
 #endif
 #if defined(__linux__)
+#include <fcntl.h>
 #include <sched.h>
 #include <sys/prctl.h>
 #endif
@@ -28,9 +32,18 @@ enum {
   SERVER_STATS_SAMPLE_MSEC_MAX = 2000,
   SERVER_DDNS_INTERVAL_SECONDS_DEFAULT = 300,
   SERVER_DDNS_INTERVAL_SECONDS_MIN = 30,
-  SERVER_DDNS_INTERVAL_SECONDS_MAX = 86400
+  SERVER_DDNS_INTERVAL_SECONDS_MAX = 86400,
+  SERVER_HIBERNATE_MINUTES_MAX = 1440,
+  SERVER_FREEZE_MINUTES_MAX = 1440,
+  SERVER_WATCHDOG_SECONDS_MIN = 15,
+  SERVER_WATCHDOG_SECONDS_MAX = 3600,
+  SERVER_CRASH_TAIL_LINES = 200,
+  SERVER_CRASH_LOOP_FAILURES = 5,
+  SERVER_CRASH_BACKOFF_MAX_MSEC = 600000
 };
 
+#define SERVER_CRASH_WINDOW_USEC (10 * 60 * G_USEC_PER_SEC)
+
 static const char *
 default_download_url(void)
 {
@@ -82,9 +95,18 @@ struct _PumpkinServer {
   int max_players;
   int max_cpu_cores;
   int max_ram_mb;
+  int cpu_weight;
+  int io_weight;
+  char *launch_profile;
+  GPtrArray *launch_profiles;
   int stats_sample_msec;
   gboolean auto_restart;
   int auto_restart_delay;
+  gboolean leak_restart;
+  int hibernate_minutes;
+  int freeze_minutes;
+  int watchdog_seconds;
+  gboolean watchdog_restart;
   gboolean auto_update_enabled;
   gboolean auto_update_use_schedule;
   int auto_update_hour;
@@ -93,6 +115,18 @@ struct _PumpkinServer {
   int auto_start_delay;
   gboolean stop_requested;
   guint restart_source_id;
+  char *cgroup_group;
+  PumpkinCgroupMode cgroup_mode;
+  char *cgroup_target;
+  guint cgroup_serial;
+  gboolean frozen;
+  gboolean frozen_by_cgroup;
+  gint64 started_at;
+  guint64 peak_rss;
+  GQueue *output_tail;
+  GArray *crash_times;
+  gboolean degraded;
+  gboolean auto_restarting;
 #if defined(G_OS_WIN32)
   HANDLE job_handle;
   HANDLE process_handle;
@@ -117,6 +151,11 @@ enum {
 
 static guint signals[LAST_SIGNAL];
 
+#if defined(__linux__)
+static void
+release_cpu_set(PumpkinServer *self);
+#endif
+
 static void
 pumpkin_server_finalize(GObject *object)
 {
@@ -141,6 +180,17 @@ pumpkin_server_finalize(GObject *object)
   g_clear_object(&self->stderr_dis);
   g_clear_object(&self->log_stream);
   g_clear_pointer(&self->log_path, g_free);
+  if (self->output_tail != NULL) {
+    g_queue_free_full(self->output_tail, g_free);
+  }
+  g_clear_pointer(&self->crash_times, g_array_unref);
+#if defined(__linux__)
+  release_cpu_set(self);
+#endif
+  g_clear_pointer(&self->cgroup_group, g_free);
+  g_clear_pointer(&self->cgroup_target, g_free);
+  g_clear_pointer(&self->launch_profile, g_free);
+  g_clear_pointer(&self->launch_profiles, g_ptr_array_unref);
 #if defined(G_OS_WIN32)
   if (self->job_handle != NULL) {
     CloseHandle(self->job_handle);
@@ -192,9 +242,16 @@ pumpkin_server_init(PumpkinServer *self)
   self->max_players = 20;
   self->max_cpu_cores = 0;
   self->max_ram_mb = 0;
+  self->cpu_weight = PUMPKIN_CGROUP_WEIGHT_DEFAULT;
+  self->io_weight = PUMPKIN_CGROUP_WEIGHT_DEFAULT;
+  self->launch_profile = g_strdup(PUMPKIN_LAUNCH_PROFILE_DEFAULT);
+  self->launch_profiles = pumpkin_launch_profiles_load(NULL);
   self->stats_sample_msec = SERVER_STATS_SAMPLE_MSEC_DEFAULT;
   self->auto_restart = FALSE;
   self->auto_restart_delay = 10000;
+  self->leak_restart = FALSE;
+  self->output_tail = g_queue_new();
+  self->crash_times = g_array_new(FALSE, FALSE, sizeof(gint64));
   self->auto_update_enabled = FALSE;
   self->auto_update_use_schedule = FALSE;
   self->auto_update_hour = 1;
@@ -296,6 +353,15 @@ clamp_stats_sample_msec(int requested)
   return requested;
 }
 
+static int
+clamp_cgroup_weight(int weight)
+{
+  if (weight <= 0) {
+    return PUMPKIN_CGROUP_WEIGHT_DEFAULT;
+  }
+  return CLAMP(weight, PUMPKIN_CGROUP_WEIGHT_MIN, PUMPKIN_CGROUP_WEIGHT_MAX);
+}
+
 static int
 clamp_ddns_interval_seconds(int requested)
 {
@@ -310,6 +376,13 @@ typedef struct {
   int max_cpu_cores;
   int max_ram_mb;
   int parent_pid;
+  gboolean in_cgroup;
+  char cgroup_procs[1024];
+#if defined(__linux__)
+  gboolean has_cpu_set;
+  cpu_set_t cpu_set;
+#endif
+  PumpkinLaunchTuning tuning;
 } ChildLimits;
 
 static void
@@ -325,6 +398,26 @@ child_setup_cb(gpointer data)
     }
   }
 #endif
+  gboolean in_cgroup = limits->in_cgroup;
+#if defined(__linux__)
+  if (limits->cgroup_procs[0] != '\0') {
+    int fd = open(limits->cgroup_procs, O_WRONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      in_cgroup = write(fd, "0", 1) == 1;
+      close(fd);
+    }
+  }
+#endif
+#if defined(__linux__)
+  if (limits->has_cpu_set) {
+    sched_setaffinity(0, sizeof(limits->cpu_set), &limits->cpu_set);
+  }
+#endif
+  pumpkin_launch_tuning_apply(&limits->tuning);
+  /* The cgroup caps real usage; the rlimit is only a fallback without one. */
+  if (in_cgroup) {
+    return;
+  }
   if (limits->max_ram_mb > 0) {
     struct rlimit lim;
     rlim_t bytes = (rlim_t)limits->max_ram_mb * 1024ULL * 1024ULL;
@@ -333,7 +426,7 @@ child_setup_cb(gpointer data)
     setrlimit(RLIMIT_AS, &lim);
   }
 #if defined(__linux__)
-  if (limits->max_cpu_cores > 0) {
+  if (limits->max_cpu_cores > 0 && !limits->has_cpu_set) {
     cpu_set_t set;
     CPU_ZERO(&set);
     int cores = limits->max_cpu_cores;
@@ -446,6 +539,35 @@ toml_replace_or_append_in_section(const char *contents,
   return g_string_free(out, FALSE);
 }
 
+static char *
+toml_lookup_in_section(const char *contents, const char *section, const char *key)
+{
+  if (contents == NULL || section == NULL || key == NULL) {
+    return NULL;
+  }
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  g_autofree char *section_header = g_strdup_printf("[%s]", section);
+  gboolean in_section = FALSE;
+  for (guint i = 0; lines[i] != NULL; i++) {
+    g_autofree char *trimmed = g_strdup(lines[i]);
+    g_strstrip(trimmed);
+    if (trimmed[0] == '[') {
+      in_section = g_strcmp0(trimmed, section_header) == 0;
+      continue;
+    }
+    char *eq = strchr(trimmed, '=');
+    if (!in_section || eq == NULL) {
+      continue;
+    }
+    *eq = '\0';
+    g_strstrip(trimmed);
+    if (g_strcmp0(trimmed, key) == 0) {
+      return g_strstrip(g_strdup(eq + 1));
+    }
+  }
+  return NULL;
+}
+
 static gboolean
 sync_pumpkin_basic_configuration(PumpkinServer *self, GError **error)
 {
@@ -653,6 +775,12 @@ pumpkin_server_load(const char *dir, GError **error)
   if (self->max_ram_mb < 0) {
     self->max_ram_mb = 0;
   }
+  if (g_key_file_has_key(keyfile, "server", "cpu_weight", NULL)) {
+    self->cpu_weight = clamp_cgroup_weight(g_key_file_get_integer(keyfile, "server", "cpu_weight", NULL));
+  }
+  if (g_key_file_has_key(keyfile, "server", "io_weight", NULL)) {
+    self->io_weight = clamp_cgroup_weight(g_key_file_get_integer(keyfile, "server", "io_weight", NULL));
+  }
   self->stats_sample_msec =
     clamp_stats_sample_msec(g_key_file_get_integer(keyfile, "server", "stats_sample_msec", NULL));
 
@@ -667,6 +795,11 @@ pumpkin_server_load(const char *dir, GError **error)
   if (self->auto_restart_delay <= 0) {
     self->auto_restart_delay = 10000;
   }
+  self->leak_restart = g_key_file_get_boolean(keyfile, "server", "leak_restart", NULL);
+  pumpkin_server_set_hibernate_minutes(self, g_key_file_get_integer(keyfile, "server", "hibernate_minutes", NULL));
+  pumpkin_server_set_freeze_minutes(self, g_key_file_get_integer(keyfile, "server", "freeze_minutes", NULL));
+  pumpkin_server_set_watchdog_seconds(self, g_key_file_get_integer(keyfile, "server", "watchdog_seconds", NULL));
+  self->watchdog_restart = g_key_file_get_boolean(keyfile, "server", "watchdog_restart", NULL);
 
   if (g_key_file_has_key(keyfile, "server", "auto_update_enabled", NULL)) {
     self->auto_update_enabled = g_key_file_get_boolean(keyfile, "server", "auto_update_enabled", NULL);
@@ -696,6 +829,11 @@ pumpkin_server_load(const char *dir, GError **error)
     self->auto_start_delay = 10;
   }
 
+  g_ptr_array_unref(self->launch_profiles);
+  self->launch_profiles = pumpkin_launch_profiles_load(keyfile);
+  g_autofree char *launch_profile = g_key_file_get_string(keyfile, "server", "launch_profile", NULL);
+  pumpkin_server_set_launch_profile(self, launch_profile);
+
   return self;
 }
 
@@ -733,9 +871,17 @@ pumpkin_server_save(PumpkinServer *self, GError **error)
   g_key_file_set_integer(keyfile, "ddns", "interval_seconds", clamp_ddns_interval_seconds(self->ddns_interval_seconds));
   g_key_file_set_integer(keyfile, "server", "max_cpu_cores", self->max_cpu_cores);
   g_key_file_set_integer(keyfile, "server", "max_ram_mb", self->max_ram_mb);
+  g_key_file_set_integer(keyfile, "server", "cpu_weight", self->cpu_weight);
+  g_key_file_set_integer(keyfile, "server", "io_weight", self->io_weight);
+  g_key_file_set_string(keyfile, "server", "launch_profile", self->launch_profile);
   g_key_file_set_integer(keyfile, "server", "stats_sample_msec", self->stats_sample_msec);
   g_key_file_set_boolean(keyfile, "server", "auto_restart", self->auto_restart);
   g_key_file_set_integer(keyfile, "server", "auto_restart_delay", self->auto_restart_delay);
+  g_key_file_set_boolean(keyfile, "server", "leak_restart", self->leak_restart);
+  g_key_file_set_integer(keyfile, "server", "hibernate_minutes", self->hibernate_minutes);
+  g_key_file_set_integer(keyfile, "server", "freeze_minutes", self->freeze_minutes);
+  g_key_file_set_integer(keyfile, "server", "watchdog_seconds", self->watchdog_seconds);
+  g_key_file_set_boolean(keyfile, "server", "watchdog_restart", self->watchdog_restart);
   g_key_file_set_boolean(keyfile, "server", "auto_update_enabled", self->auto_update_enabled);
   g_key_file_set_boolean(keyfile, "server", "auto_update_use_schedule", self->auto_update_use_schedule);
   g_key_file_set_integer(keyfile, "server", "auto_update_hour", self->auto_update_hour);
@@ -757,6 +903,7 @@ pumpkin_server_save(PumpkinServer *self, GError **error)
   if (self->rcon_password != NULL) {
     g_key_file_set_string(keyfile, "rcon", "password", self->rcon_password);
   }
+  pumpkin_launch_profiles_save(self->launch_profiles, keyfile);
 
   g_autofree char *ini = server_ini_path(self->root_dir);
   g_autofree char *data = g_key_file_to_data(keyfile, NULL, NULL);
@@ -910,6 +1057,30 @@ pumpkin_server_get_max_ram_mb(PumpkinServer *self)
   return self->max_ram_mb;
 }
 
+int
+pumpkin_server_get_cpu_weight(PumpkinServer *self)
+{
+  return self->cpu_weight;
+}
+
+int
+pumpkin_server_get_io_weight(PumpkinServer *self)
+{
+  return self->io_weight;
+}
+
+const char *
+pumpkin_server_get_launch_profile(PumpkinServer *self)
+{
+  return self->launch_profile;
+}
+
+GPtrArray *
+pumpkin_server_get_launch_profiles(PumpkinServer *self)
+{
+  return self->launch_profiles;
+}
+
 int
 pumpkin_server_get_stats_sample_msec(PumpkinServer *self)
 {
@@ -934,6 +1105,36 @@ pumpkin_server_get_auto_restart_delay(PumpkinServer *self)
   return self->auto_restart_delay;
 }
 
+gboolean
+pumpkin_server_get_leak_restart(PumpkinServer *self)
+{
+  return self->leak_restart;
+}
+
+int
+pumpkin_server_get_hibernate_minutes(PumpkinServer *self)
+{
+  return self->hibernate_minutes;
+}
+
+int
+pumpkin_server_get_freeze_minutes(PumpkinServer *self)
+{
+  return self->freeze_minutes;
+}
+
+int
+pumpkin_server_get_watchdog_seconds(PumpkinServer *self)
+{
+  return self->watchdog_seconds;
+}
+
+gboolean
+pumpkin_server_get_watchdog_restart(PumpkinServer *self)
+{
+  return self->watchdog_restart;
+}
+
 gboolean
 pumpkin_server_get_auto_update_enabled(PumpkinServer *self)
 {
@@ -1007,6 +1208,36 @@ pumpkin_server_set_auto_restart_delay(PumpkinServer *self, int seconds)
   }
 }
 
+void
+pumpkin_server_set_leak_restart(PumpkinServer *self, gboolean enabled)
+{
+  self->leak_restart = enabled;
+}
+
+void
+pumpkin_server_set_hibernate_minutes(PumpkinServer *self, int minutes)
+{
+  self->hibernate_minutes = CLAMP(minutes, 0, SERVER_HIBERNATE_MINUTES_MAX);
+}
+
+void
+pumpkin_server_set_freeze_minutes(PumpkinServer *self, int minutes)
+{
+  self->freeze_minutes = CLAMP(minutes, 0, SERVER_FREEZE_MINUTES_MAX);
+}
+
+void
+pumpkin_server_set_watchdog_seconds(PumpkinServer *self, int seconds)
+{
+  self->watchdog_seconds = seconds <= 0 ? 0 : CLAMP(seconds, SERVER_WATCHDOG_SECONDS_MIN, SERVER_WATCHDOG_SECONDS_MAX);
+}
+
+void
+pumpkin_server_set_watchdog_restart(PumpkinServer *self, gboolean enabled)
+{
+  self->watchdog_restart = enabled;
+}
+
 void
 pumpkin_server_set_auto_update_enabled(PumpkinServer *self, gboolean enabled)
 {
@@ -1168,6 +1399,35 @@ pumpkin_server_set_max_ram_mb(PumpkinServer *self, int max_ram_mb)
   }
 }
 
+void
+pumpkin_server_set_cpu_weight(PumpkinServer *self, int weight)
+{
+  self->cpu_weight = clamp_cgroup_weight(weight);
+}
+
+void
+pumpkin_server_set_io_weight(PumpkinServer *self, int weight)
+{
+  self->io_weight = clamp_cgroup_weight(weight);
+}
+
+void
+pumpkin_server_set_launch_profile(PumpkinServer *self, const char *name)
+{
+  if (pumpkin_launch_profiles_lookup(self->launch_profiles, name) == NULL) {
+    name = PUMPKIN_LAUNCH_PROFILE_DEFAULT;
+  }
+  g_free(self->launch_profile);
+  self->launch_profile = g_strdup(name);
+}
+
+void
+pumpkin_server_set_cgroup_group(PumpkinServer *self, const char *group_id)
+{
+  g_free(self->cgroup_group);
+  self->cgroup_group = group_id != NULL && *group_id != '\0' ? g_strdup(group_id) : NULL;
+}
+
 void
 pumpkin_server_set_stats_sample_msec(PumpkinServer *self, int msec)
 {
@@ -1222,6 +1482,22 @@ pumpkin_server_get_data_dir(PumpkinServer *self)
   return g_build_filename(self->root_dir, "data", NULL);
 }
 
+/* Set by hand in features.toml when the server sits behind a proxy that sends a PROXY protocol header. */
+gboolean
+pumpkin_server_get_proxy_protocol(PumpkinServer *self)
+{
+  if (self == NULL || self->root_dir == NULL) {
+    return FALSE;
+  }
+  g_autofree char *path = g_build_filename(self->root_dir, "data", "config", "features.toml", NULL);
+  g_autofree char *contents = NULL;
+  if (!g_file_get_contents(path, &contents, NULL, NULL)) {
+    return FALSE;
+  }
+  g_autofree char *value = toml_lookup_in_section(contents, "networking.proxy", "proxy_protocol");
+  return g_strcmp0(value, "true") == 0;
+}
+
 char *
 pumpkin_server_get_plugins_dir(PumpkinServer *self)
 {
@@ -1246,6 +1522,18 @@ pumpkin_server_get_logs_dir(PumpkinServer *self)
   return g_build_filename(self->root_dir, "logs", NULL);
 }
 
+char *
+pumpkin_server_get_diagnostics_dir(PumpkinServer *self)
+{
+  return g_build_filename(self->root_dir, "diagnostics", NULL);
+}
+
+char *
+pumpkin_server_get_crashes_dir(PumpkinServer *self)
+{
+  return g_build_filename(self->root_dir, "crashes", NULL);
+}
+
 static void
 read_stream_line(GDataInputStream *dis, PumpkinServer *self, const char *label);
 
@@ -1256,7 +1544,10 @@ auto_restart_cb(gpointer data)
   srv->restart_source_id = 0;
   srv->stop_requested = FALSE;
   g_autoptr(GError) err = NULL;
-  if (!pumpkin_server_start(srv, &err)) {
+  srv->auto_restarting = TRUE;
+  gboolean started = pumpkin_server_start(srv, &err);
+  srv->auto_restarting = FALSE;
+  if (!started) {
     if (err != NULL) {
       g_signal_emit(srv, signals[LOG_LINE], 0, err->message);
     }
@@ -1265,6 +1556,98 @@ auto_restart_cb(gpointer data)
   return G_SOURCE_REMOVE;
 }
 
+static void
+remember_output_line(PumpkinServer *self, const char *line)
+{
+  g_queue_push_tail(self->output_tail, g_strdup(line));
+  while (g_queue_get_length(self->output_tail) > SERVER_CRASH_TAIL_LINES) {
+    g_free(g_queue_pop_head(self->output_tail));
+  }
+}
+
+static char *
+write_crash_report(PumpkinServer *self, const char *exit_desc, gint64 runtime_usec, guint crashes)
+{
+  g_autofree char *dir = pumpkin_server_get_crashes_dir(self);
+  if (g_mkdir_with_parents(dir, 0755) != 0) {
+    return NULL;
+  }
+  g_autoptr(GDateTime) now = g_date_time_new_now_local();
+  g_autofree char *stamp = g_date_time_format(now, "%Y%m%d-%H%M%S");
+  g_autofree char *when = g_date_time_format(now, "%Y-%m-%d %H:%M:%S");
+  g_autofree char *filename = g_strdup_printf("crash-%s.txt", stamp);
+  g_autofree char *path = g_build_filename(dir, filename, NULL);
+  g_autofree char *peak = self->peak_rss > 0 ? g_format_size_full(self->peak_rss, G_FORMAT_SIZE_IEC_UNITS)
+                                             : g_strdup("unknown");
+
+  GString *report = g_string_new(NULL);
+  g_string_append_printf(report, "server: %s (%s)\n", self->name != NULL ? self->name : "", self->id);
+  g_string_append_printf(report, "exited: %s\n", when);
+  g_string_append_printf(report, "status: %s\n", exit_desc);
+  g_string_append_printf(report, "runtime: %" G_GINT64_FORMAT " s\n", runtime_usec / G_USEC_PER_SEC);
+  g_string_append_printf(report, "peak rss: %s\n", peak);
+  g_string_append_printf(report, "crashes in the last 10 minutes: %u\n", crashes);
+  g_string_append_printf(report, "\nlast %u lines of output:\n", g_queue_get_length(self->output_tail));
+  for (GList *l = self->output_tail->head; l != NULL; l = l->next) {
+    g_string_append_printf(report, "%s\n", (const char *)l->data);
+  }
+  gboolean ok = g_file_set_contents(path, report->str, (gssize)report->len, NULL);
+  g_string_free(report, TRUE);
+  return ok ? g_steal_pointer(&path) : NULL;
+}
+
+/*
+ * Backoff doubles per crash inside the window; a server that keeps dying is parked as degraded.
+ * A zero exit status (e.g. /stop typed in-game) is a shutdown, not a crash.
+ */
+static void
+handle_unexpected_exit(PumpkinServer *self, gboolean clean, const char *exit_desc)
+{
+  if (self->stop_requested || clean) {
+    return;
+  }
+  gint64 now = g_get_monotonic_time();
+  gint64 runtime = self->started_at > 0 ? now - self->started_at : 0;
+  while (self->crash_times->len > 0 &&
+         now - g_array_index(self->crash_times, gint64, 0) > SERVER_CRASH_WINDOW_USEC) {
+    g_array_remove_index(self->crash_times, 0);
+  }
+  g_array_append_val(self->crash_times, now);
+  guint crashes = self->crash_times->len;
+
+  g_autofree char *report = write_crash_report(self, exit_desc, runtime, crashes);
+  g_autofree char *message = report != NULL
+                               ? g_strdup_printf("Server crashed (%s), report saved to %s", exit_desc, report)
+                               : g_strdup_printf("Server crashed (%s)", exit_desc);
+  g_signal_emit(self, signals[LOG_LINE], 0, message);
+
+  if (!self->auto_restart) {
+    return;
+  }
+  if (crashes >= SERVER_CRASH_LOOP_FAILURES) {
+    self->degraded = TRUE;
+    g_autofree char *degraded = g_strdup_printf(
+      "Crash loop detected: %u crashes within 10 minutes, auto-restart paused until the server is started again",
+      crashes);
+    g_signal_emit(self, signals[LOG_LINE], 0, degraded);
+    return;
+  }
+  guint delay = self->auto_restart_delay > 0 ? (guint)self->auto_restart_delay : 10000;
+  for (guint i = 1; i < crashes && delay < SERVER_CRASH_BACKOFF_MAX_MSEC; i++) {
+    delay *= 2;
+  }
+  delay = MIN(delay, SERVER_CRASH_BACKOFF_MAX_MSEC);
+  /* Jitter keeps servers that died together from restarting in lockstep. */
+  delay = (guint)(delay * g_random_double_range(0.8, 1.2));
+  if (crashes > 1) {
+    g_autofree char *backoff = g_strdup_printf("Crash %u within 10 minutes, backing off %.1f s", crashes,
+                                               delay / 1000.0);
+    g_signal_emit(self, signals[LOG_LINE], 0, backoff);
+  }
+  g_signal_emit(self, signals[LOG_LINE], 0, "Auto-restart scheduled");
+  self->restart_source_id = g_timeout_add(delay, auto_restart_cb, g_object_ref(self));
+}
+
 static void
 ensure_log_stream(PumpkinServer *self)
 {
@@ -1392,6 +1775,7 @@ read_line_cb(GObject *source, GAsyncResult *res, gpointer user_data)
   }
 
   append_log_line(self, line);
+  remember_output_line(self, line);
   g_signal_emit(self, signals[LOG_LINE], 0, line);
   read_stream_line(dis, self, NULL);
   g_object_unref(self);
@@ -1431,6 +1815,10 @@ pumpkin_server_handle_exit(PumpkinServer *self, const char *message)
   g_clear_object(&self->stdin_stream);
   self->pid = 0;
 
+  DWORD exit_code = 0;
+  gboolean have_exit_code = self->process_handle != NULL && GetExitCodeProcess(self->process_handle, &exit_code);
+  g_autofree char *exit_desc = have_exit_code ? g_strdup_printf("exit code 0x%08lx", (unsigned long)exit_code)
+                                              : g_strdup("unknown");
   if (self->process_handle != NULL) {
     CloseHandle(self->process_handle);
     self->process_handle = NULL;
@@ -1452,11 +1840,7 @@ pumpkin_server_handle_exit(PumpkinServer *self, const char *message)
     self->restart_source_id = 0;
   }
 
-  if (self->auto_restart && !self->stop_requested) {
-    guint delay = self->auto_restart_delay > 0 ? (guint)self->auto_restart_delay : 10000;
-    g_signal_emit(self, signals[LOG_LINE], 0, "Auto-restart scheduled");
-    self->restart_source_id = g_timeout_add(delay, auto_restart_cb, g_object_ref(self));
-  }
+  handle_unexpected_exit(self, have_exit_code && exit_code == 0, exit_desc);
 
   g_signal_emit(self, signals[LOG_LINE], 0, message != NULL ? message : "Server process exited");
 }
@@ -1616,7 +2000,94 @@ fail:
 }
 #endif
 
+#if defined(__linux__)
+static GHashTable *running_servers = NULL;
+
+static void
+repin_server(PumpkinServer *self)
+{
+  if (self->pid <= 0) {
+    return;
+  }
+  const GArray *cpus = pumpkin_cpu_allocator_lookup(pumpkin_cpu_allocator_get_default(), self->id);
+  if (cpus != NULL) {
+    pumpkin_cpu_set_apply_to_process(self->pid, cpus);
+    return;
+  }
+  g_autoptr(GArray) all = g_array_new(FALSE, FALSE, sizeof(int));
+  int n = get_system_max_cores();
+  for (int cpu = 0; cpu < n; cpu++) {
+    g_array_append_val(all, cpu);
+  }
+  pumpkin_cpu_set_apply_to_process(self->pid, all);
+}
+
+static void
+repin_moved_servers(PumpkinServer *self, GPtrArray *moved)
+{
+  for (guint i = 0; i < moved->len; i++) {
+    const char *id = g_ptr_array_index(moved, i);
+    PumpkinServer *other = running_servers != NULL ? g_hash_table_lookup(running_servers, id) : NULL;
+    if (other != NULL && other != self) {
+      repin_server(other);
+    }
+  }
+}
+
+/* Freed cores go to servers that had to spill or share, so they recover without a restart. */
+static void
+release_and_rebalance_cpu_set(PumpkinServer *self)
+{
+  PumpkinCpuAllocator *allocator = pumpkin_cpu_allocator_get_default();
+  if (pumpkin_cpu_allocator_lookup(allocator, self->id) == NULL) {
+    return;
+  }
+  pumpkin_cpu_allocator_release(allocator, self->id);
+  g_autoptr(GPtrArray) moved = g_ptr_array_new_with_free_func(g_free);
+  pumpkin_cpu_allocator_rebalance(allocator, moved);
+  repin_moved_servers(self, moved);
+}
+
+/* Cores are handed out host-wide so limited servers stop sharing the first N cores. */
+static const GArray *
+acquire_cpu_set(PumpkinServer *self, int max_cpu)
+{
+  PumpkinCpuAllocator *allocator = pumpkin_cpu_allocator_get_default();
+  if (max_cpu <= 0) {
+    release_and_rebalance_cpu_set(self);
+    return NULL;
+  }
+  g_autoptr(GPtrArray) moved = g_ptr_array_new_with_free_func(g_free);
+  const GArray *cpus = pumpkin_cpu_allocator_acquire(allocator, self->id, max_cpu, moved);
+  repin_moved_servers(self, moved);
+  return cpus;
+}
+
+static void
+release_cpu_set(PumpkinServer *self)
+{
+  if (running_servers != NULL && self->id != NULL &&
+      g_hash_table_lookup(running_servers, self->id) == self) {
+    g_hash_table_remove(running_servers, self->id);
+    release_and_rebalance_cpu_set(self);
+  }
+}
+#endif
+
 #if !defined(G_OS_WIN32)
+static char *
+describe_exit_status(GSubprocess *process)
+{
+  if (g_subprocess_get_if_signaled(process)) {
+    int sig = g_subprocess_get_term_sig(process);
+    return g_strdup_printf("killed by signal %d, %s", sig, g_strsignal(sig));
+  }
+  if (g_subprocess_get_if_exited(process)) {
+    return g_strdup_printf("exit status %d", g_subprocess_get_exit_status(process));
+  }
+  return g_strdup("unknown");
+}
+
 static void
 process_wait_cb(GObject *source, GAsyncResult *res, gpointer user_data)
 {
@@ -1626,6 +2097,15 @@ process_wait_cb(GObject *source, GAsyncResult *res, gpointer user_data)
   g_clear_object(&self->process);
   self->stdin_stream = NULL;
   self->pid = 0;
+  self->frozen = FALSE;
+#if defined(__linux__)
+  release_cpu_set(self);
+#endif
+  if (self->cgroup_mode == PUMPKIN_CGROUP_DIRECT) {
+    pumpkin_cgroup_remove_direct(self->cgroup_target);
+  }
+  self->cgroup_mode = PUMPKIN_CGROUP_NONE;
+  g_clear_pointer(&self->cgroup_target, g_free);
   if (self->log_stream != NULL) {
     g_output_stream_flush(self->log_stream, NULL, NULL);
     g_clear_object(&self->log_stream);
@@ -1636,13 +2116,14 @@ process_wait_cb(GObject *source, GAsyncResult *res, gpointer user_data)
     self->restart_source_id = 0;
   }
 
-  if (self->auto_restart && !self->stop_requested) {
-    guint delay = self->auto_restart_delay > 0 ? (guint)self->auto_restart_delay : 10000;
-    g_signal_emit(self, signals[LOG_LINE], 0, "Auto-restart scheduled");
-    self->restart_source_id = g_timeout_add(delay, auto_restart_cb, g_object_ref(self));
-  }
+  gboolean waited = g_subprocess_wait_finish(G_SUBPROCESS(source), res, &error);
+  g_autofree char *exit_desc = waited ? describe_exit_status(G_SUBPROCESS(source))
+                                      : g_strdup(error != NULL ? error->message : "unknown");
+  gboolean clean = waited && g_subprocess_get_if_exited(G_SUBPROCESS(source)) &&
+                   g_subprocess_get_exit_status(G_SUBPROCESS(source)) == 0;
+  handle_unexpected_exit(self, clean, exit_desc);
 
-  if (!g_subprocess_wait_finish(G_SUBPROCESS(source), res, &error)) {
+  if (!waited) {
     if (error != NULL) {
       g_signal_emit(self, signals[LOG_LINE], 0, error->message);
     }
@@ -1668,6 +2149,14 @@ pumpkin_server_start(PumpkinServer *self, GError **error)
     g_source_remove(self->restart_source_id);
     self->restart_source_id = 0;
   }
+  /* Starting by hand acknowledges earlier crashes. */
+  if (!self->auto_restarting) {
+    g_array_set_size(self->crash_times, 0);
+    self->degraded = FALSE;
+  }
+  self->started_at = g_get_monotonic_time();
+  self->peak_rss = 0;
+  g_queue_clear_full(self->output_tail, g_free);
 
   g_autofree char *bin = pumpkin_server_get_bin_path(self);
   if (!g_file_test(bin, G_FILE_TEST_EXISTS)) {
@@ -1687,7 +2176,36 @@ pumpkin_server_start(PumpkinServer *self, GError **error)
 #if defined(G_OS_WIN32)
   return pumpkin_server_start_windows(self, bin, data_dir, max_cpu, max_ram, error);
 #else
-  const char *argv[] = { bin, NULL };
+  PumpkinCgroupLimits cgroup_limits = {
+    .max_cpu_cores = max_cpu,
+    .max_ram_mb = max_ram,
+    .cpu_weight = self->cpu_weight,
+    .io_weight = self->io_weight
+  };
+  PumpkinCgroupMode cgroup_mode = pumpkin_cgroup_detect();
+  g_autofree char *cgroup_target = NULL;
+  g_autoptr(GPtrArray) argv = g_ptr_array_new_with_free_func(g_free);
+  if (cgroup_mode == PUMPKIN_CGROUP_SYSTEMD) {
+    g_autofree char *slice = pumpkin_cgroup_slice_name(self->cgroup_group);
+    cgroup_target = pumpkin_cgroup_scope_name(self->id, ++self->cgroup_serial);
+    pumpkin_cgroup_append_systemd_run_argv(argv, cgroup_target, slice, &cgroup_limits);
+  } else if (cgroup_mode == PUMPKIN_CGROUP_DIRECT) {
+    g_autoptr(GError) cgroup_error = NULL;
+    cgroup_target = pumpkin_cgroup_create_direct(self->id, self->cgroup_group, &cgroup_error);
+    if (cgroup_target != NULL && !pumpkin_cgroup_apply_direct(cgroup_target, &cgroup_limits, &cgroup_error)) {
+      pumpkin_cgroup_remove_direct(cgroup_target);
+      g_clear_pointer(&cgroup_target, g_free);
+    }
+    if (cgroup_target == NULL) {
+      g_autofree char *line = g_strdup_printf("cgroup unavailable, using process limits: %s",
+                                              cgroup_error != NULL ? cgroup_error->message : "unknown error");
+      g_signal_emit(self, signals[LOG_LINE], 0, line);
+      cgroup_mode = PUMPKIN_CGROUP_NONE;
+    }
+  }
+  g_ptr_array_add(argv, g_strdup(bin));
+  g_ptr_array_add(argv, NULL);
+
   GSubprocessLauncher *launcher = g_subprocess_launcher_new(
     G_SUBPROCESS_FLAGS_STDOUT_PIPE | G_SUBPROCESS_FLAGS_STDERR_PIPE | G_SUBPROCESS_FLAGS_STDIN_PIPE
   );
@@ -1698,18 +2216,54 @@ pumpkin_server_start(PumpkinServer *self, GError **error)
     g_subprocess_launcher_setenv(launcher, "OMP_NUM_THREADS", num, TRUE);
     g_subprocess_launcher_setenv(launcher, "TOKIO_WORKER_THREADS", num, TRUE);
   }
+  const PumpkinLaunchProfile *profile = pumpkin_launch_profiles_lookup(self->launch_profiles, self->launch_profile);
+  g_autofree char *profile_warning = NULL;
+  pumpkin_launch_profile_apply_env(profile, launcher, &profile_warning);
+  if (profile_warning != NULL) {
+    g_signal_emit(self, signals[LOG_LINE], 0, profile_warning);
+  }
   ChildLimits *limits = g_new0(ChildLimits, 1);
   limits->max_cpu_cores = max_cpu;
   limits->max_ram_mb = max_ram;
   limits->parent_pid = (int)getpid();
+  limits->in_cgroup = cgroup_mode == PUMPKIN_CGROUP_SYSTEMD;
+  if (profile != NULL) {
+    limits->tuning = profile->tuning;
+  }
+#if defined(__linux__)
+  const GArray *cpus = acquire_cpu_set(self, max_cpu);
+  if (cpus != NULL) {
+    limits->has_cpu_set = TRUE;
+    CPU_ZERO(&limits->cpu_set);
+    for (guint i = 0; i < cpus->len; i++) {
+      int cpu = g_array_index(cpus, int, i);
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &limits->cpu_set);
+      }
+    }
+  }
+#endif
+  if (cgroup_mode == PUMPKIN_CGROUP_DIRECT) {
+    g_autofree char *procs = g_build_filename(cgroup_target, "cgroup.procs", NULL);
+    g_strlcpy(limits->cgroup_procs, procs, sizeof(limits->cgroup_procs));
+  }
   g_subprocess_launcher_set_child_setup(launcher, child_setup_cb, limits, g_free);
 
-  self->process = g_subprocess_launcher_spawnv(launcher, argv, error);
+  self->process = g_subprocess_launcher_spawnv(launcher, (const char * const *)argv->pdata, error);
   g_object_unref(launcher);
 
   if (self->process == NULL) {
+    if (cgroup_mode == PUMPKIN_CGROUP_DIRECT) {
+      pumpkin_cgroup_remove_direct(cgroup_target);
+    }
+#if defined(__linux__)
+    release_and_rebalance_cpu_set(self);
+#endif
     return FALSE;
   }
+  self->cgroup_mode = cgroup_mode;
+  g_free(self->cgroup_target);
+  self->cgroup_target = g_steal_pointer(&cgroup_target);
 
   self->stdin_stream = g_subprocess_get_stdin_pipe(self->process);
   const char *pid_str = g_subprocess_get_identifier(self->process);
@@ -1718,6 +2272,12 @@ pumpkin_server_start(PumpkinServer *self, GError **error)
   } else {
     self->pid = 0;
   }
+#if defined(__linux__)
+  if (running_servers == NULL) {
+    running_servers = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  }
+  g_hash_table_replace(running_servers, g_strdup(self->id), self);
+#endif
   pumpkin_server_attach_output(self);
   g_subprocess_wait_async(self->process, NULL, process_wait_cb, self);
   return TRUE;
@@ -1746,10 +2306,166 @@ pumpkin_server_stop(PumpkinServer *self)
     TerminateProcess(self->process_handle, 0);
   }
 #else
+  /* A frozen process would sit on the signal until thawed. */
+  if (self->frozen) {
+    pumpkin_server_set_frozen(self, FALSE, NULL);
+  }
   g_subprocess_send_signal(self->process, SIGTERM);
 #endif
 }
 
+/* For hung processes: SIGTERM relies on a shutdown path that may itself be stuck. */
+void
+pumpkin_server_kill(PumpkinServer *self)
+{
+  if (self->process == NULL
+#if defined(G_OS_WIN32)
+      && self->process_handle == NULL
+#endif
+  ) {
+    return;
+  }
+
+  self->stop_requested = TRUE;
+  if (self->restart_source_id != 0) {
+    g_source_remove(self->restart_source_id);
+    self->restart_source_id = 0;
+  }
+
+#if defined(G_OS_WIN32)
+  if (self->process_handle != NULL) {
+    TerminateProcess(self->process_handle, 1);
+  }
+#else
+  g_subprocess_force_exit(self->process);
+#endif
+}
+
+gboolean
+pumpkin_server_get_frozen(PumpkinServer *self)
+{
+  return self->frozen;
+}
+
+gint64
+pumpkin_server_get_started_at(PumpkinServer *self)
+{
+  return self->started_at;
+}
+
+gboolean
+pumpkin_server_get_degraded(PumpkinServer *self)
+{
+  return self->degraded;
+}
+
+guint
+pumpkin_server_get_recent_crashes(PumpkinServer *self)
+{
+  return self->crash_times->len;
+}
+
+void
+pumpkin_server_note_rss(PumpkinServer *self, guint64 rss)
+{
+  self->peak_rss = MAX(self->peak_rss, rss);
+}
+
+/* Prefers the cgroup freezer, which stops every thread atomically; SIGSTOP covers servers without a cgroup. */
+gboolean
+pumpkin_server_set_frozen(PumpkinServer *self, gboolean frozen, GError **error)
+{
+#if defined(G_OS_WIN32)
+  (void)frozen;
+  g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Freezing servers is not supported on Windows");
+  return FALSE;
+#else
+  if (!pumpkin_server_get_running(self) || self->pid <= 0) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_CONNECTED, "Server is not running");
+    return FALSE;
+  }
+  if (self->frozen == frozen) {
+    return TRUE;
+  }
+  gboolean use_cgroup = frozen ? self->cgroup_mode != PUMPKIN_CGROUP_NONE : self->frozen_by_cgroup;
+  if (use_cgroup) {
+    g_autofree char *path = pumpkin_server_get_cgroup_path(self);
+    if (path != NULL && pumpkin_cgroup_set_frozen(path, frozen, frozen ? NULL : error)) {
+      self->frozen = frozen;
+      self->frozen_by_cgroup = frozen;
+      return TRUE;
+    }
+    if (!frozen) {
+      return FALSE;
+    }
+  }
+  if (kill(self->pid, frozen ? SIGSTOP : SIGCONT) != 0) {
+    int saved = errno;
+    g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved), "Failed to %s process %d: %s",
+                frozen ? "stop" : "continue", self->pid, g_strerror(saved));
+    return FALSE;
+  }
+  self->frozen = frozen;
+  self->frozen_by_cgroup = FALSE;
+  return TRUE;
+#endif
+}
+
+gboolean
+pumpkin_server_get_limits_live(PumpkinServer *self)
+{
+  return pumpkin_server_get_running(self) && self->cgroup_mode != PUMPKIN_CGROUP_NONE;
+}
+
+gboolean
+pumpkin_server_apply_limits(PumpkinServer *self, GError **error)
+{
+  if (!pumpkin_server_get_limits_live(self)) {
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Server is not running in a cgroup");
+    return FALSE;
+  }
+  PumpkinCgroupLimits limits = {
+    .max_cpu_cores = clamp_cpu_cores(self->max_cpu_cores),
+    .max_ram_mb = clamp_ram_mb(self->max_ram_mb),
+    .cpu_weight = self->cpu_weight,
+    .io_weight = self->io_weight
+  };
+#if defined(__linux__)
+  acquire_cpu_set(self, limits.max_cpu_cores);
+  repin_server(self);
+#endif
+  if (self->cgroup_mode == PUMPKIN_CGROUP_SYSTEMD) {
+    return pumpkin_cgroup_apply_systemd(self->cgroup_target, &limits, error);
+  }
+  return pumpkin_cgroup_apply_direct(self->cgroup_target, &limits, error);
+}
+
+char *
+pumpkin_server_describe_cpu_set(PumpkinServer *self)
+{
+#if defined(__linux__)
+  if (!pumpkin_server_get_running(self)) {
+    return NULL;
+  }
+  return pumpkin_cpu_allocator_describe(pumpkin_cpu_allocator_get_default(), self->id);
+#else
+  (void)self;
+  return NULL;
+#endif
+}
+
+char *
+pumpkin_server_get_cgroup_path(PumpkinServer *self)
+{
+  if (!pumpkin_server_get_limits_live(self)) {
+    return NULL;
+  }
+  if (self->cgroup_mode == PUMPKIN_CGROUP_DIRECT) {
+    return g_strdup(self->cgroup_target);
+  }
+  return pumpkin_cgroup_path_for_pid(self->pid);
+}
+
 gboolean
 pumpkin_server_get_running(PumpkinServer *self)
 {
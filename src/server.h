@@ -14,6 +14,7 @@ gboolean pumpkin_server_save(PumpkinServer *self, GError **error);
 
 gboolean pumpkin_server_start(PumpkinServer *self, GError **error);
 void pumpkin_server_stop(PumpkinServer *self);
+void pumpkin_server_kill(PumpkinServer *self);
 gboolean pumpkin_server_send_command(PumpkinServer *self, const char *command, GError **error);
 
 const char *pumpkin_server_get_id(PumpkinServer *self);
@@ -25,6 +26,11 @@ const char *pumpkin_server_get_installed_build_id(PumpkinServer *self);
 const char *pumpkin_server_get_installed_build_label(PumpkinServer *self);
 gboolean pumpkin_server_get_auto_restart(PumpkinServer *self);
 int pumpkin_server_get_auto_restart_delay(PumpkinServer *self);
+gboolean pumpkin_server_get_leak_restart(PumpkinServer *self);
+int pumpkin_server_get_hibernate_minutes(PumpkinServer *self);
+int pumpkin_server_get_freeze_minutes(PumpkinServer *self);
+int pumpkin_server_get_watchdog_seconds(PumpkinServer *self);
+gboolean pumpkin_server_get_watchdog_restart(PumpkinServer *self);
 gboolean pumpkin_server_get_auto_update_enabled(PumpkinServer *self);
 gboolean pumpkin_server_get_auto_update_use_schedule(PumpkinServer *self);
 int pumpkin_server_get_auto_update_hour(PumpkinServer *self);
@@ -46,11 +52,25 @@ int pumpkin_server_get_bedrock_port(PumpkinServer *self);
 int pumpkin_server_get_max_players(PumpkinServer *self);
 int pumpkin_server_get_max_cpu_cores(PumpkinServer *self);
 int pumpkin_server_get_max_ram_mb(PumpkinServer *self);
+int pumpkin_server_get_cpu_weight(PumpkinServer *self);
+int pumpkin_server_get_io_weight(PumpkinServer *self);
+const char *pumpkin_server_get_launch_profile(PumpkinServer *self);
+GPtrArray *pumpkin_server_get_launch_profiles(PumpkinServer *self);
 int pumpkin_server_get_stats_sample_msec(PumpkinServer *self);
 gboolean pumpkin_server_get_auto_start_on_launch(PumpkinServer *self);
 int pumpkin_server_get_auto_start_delay(PumpkinServer *self);
 
 gboolean pumpkin_server_get_running(PumpkinServer *self);
+gboolean pumpkin_server_get_limits_live(PumpkinServer *self);
+gboolean pumpkin_server_apply_limits(PumpkinServer *self, GError **error);
+char *pumpkin_server_get_cgroup_path(PumpkinServer *self);
+gboolean pumpkin_server_get_frozen(PumpkinServer *self);
+gboolean pumpkin_server_set_frozen(PumpkinServer *self, gboolean frozen, GError **error);
+gint64 pumpkin_server_get_started_at(PumpkinServer *self);
+gboolean pumpkin_server_get_degraded(PumpkinServer *self);
+guint pumpkin_server_get_recent_crashes(PumpkinServer *self);
+void pumpkin_server_note_rss(PumpkinServer *self, guint64 rss);
+char *pumpkin_server_describe_cpu_set(PumpkinServer *self);
 
 void pumpkin_server_set_name(PumpkinServer *self, const char *name);
 void pumpkin_server_set_download_url(PumpkinServer *self, const char *url);
@@ -59,6 +79,11 @@ void pumpkin_server_set_installed_build_id(PumpkinServer *self, const char *buil
 void pumpkin_server_set_installed_build_label(PumpkinServer *self, const char *build_label);
 void pumpkin_server_set_auto_restart(PumpkinServer *self, gboolean enabled);
 void pumpkin_server_set_auto_restart_delay(PumpkinServer *self, int seconds);
+void pumpkin_server_set_leak_restart(PumpkinServer *self, gboolean enabled);
+void pumpkin_server_set_hibernate_minutes(PumpkinServer *self, int minutes);
+void pumpkin_server_set_freeze_minutes(PumpkinServer *self, int minutes);
+void pumpkin_server_set_watchdog_seconds(PumpkinServer *self, int seconds);
+void pumpkin_server_set_watchdog_restart(PumpkinServer *self, gboolean enabled);
 void pumpkin_server_set_auto_update_enabled(PumpkinServer *self, gboolean enabled);
 void pumpkin_server_set_auto_update_use_schedule(PumpkinServer *self, gboolean enabled);
 void pumpkin_server_set_auto_update_hour(PumpkinServer *self, int hour);
@@ -80,6 +105,10 @@ void pumpkin_server_set_bedrock_port(PumpkinServer *self, int port);
 void pumpkin_server_set_max_players(PumpkinServer *self, int max_players);
 void pumpkin_server_set_max_cpu_cores(PumpkinServer *self, int max_cpu_cores);
 void pumpkin_server_set_max_ram_mb(PumpkinServer *self, int max_ram_mb);
+void pumpkin_server_set_cpu_weight(PumpkinServer *self, int weight);
+void pumpkin_server_set_io_weight(PumpkinServer *self, int weight);
+void pumpkin_server_set_launch_profile(PumpkinServer *self, const char *name);
+void pumpkin_server_set_cgroup_group(PumpkinServer *self, const char *group_id);
 void pumpkin_server_set_stats_sample_msec(PumpkinServer *self, int msec);
 void pumpkin_server_set_auto_start_on_launch(PumpkinServer *self, gboolean enabled);
 void pumpkin_server_set_auto_start_delay(PumpkinServer *self, int seconds);
@@ -87,10 +116,13 @@ void pumpkin_server_set_root_dir(PumpkinServer *self, const char *dir);
 
 char *pumpkin_server_get_bin_path(PumpkinServer *self);
 char *pumpkin_server_get_data_dir(PumpkinServer *self);
+gboolean pumpkin_server_get_proxy_protocol(PumpkinServer *self);
 char *pumpkin_server_get_plugins_dir(PumpkinServer *self);
 char *pumpkin_server_get_worlds_dir(PumpkinServer *self);
 char *pumpkin_server_get_players_dir(PumpkinServer *self);
 char *pumpkin_server_get_logs_dir(PumpkinServer *self);
+char *pumpkin_server_get_diagnostics_dir(PumpkinServer *self);
+char *pumpkin_server_get_crashes_dir(PumpkinServer *self);
 int pumpkin_server_get_pid(PumpkinServer *self);
 
 G_END_DECLS
@@ -0,0 +1,481 @@
+#include "session-history.h"
+
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SESSION_LOG_FILE "player-sessions.log"
+#define SESSION_AGG_FILE "player-sessions.agg"
+#define SESSION_RECORD_SIZE 16
+#define SESSION_AGG_MAGIC 0x41535053u
+#define SESSION_AGG_VERSION 1
+#define SESSION_FOLD_BATCH 4096
+
+/* BEGIN and END bracket the time the window was watching the server, so the app being closed is not zero load. */
+enum {
+  SESSION_JOIN = 1,
+  SESSION_LEAVE = 2,
+  SESSION_BEGIN = 3,
+  SESSION_END = 4,
+};
+
+typedef struct {
+  guint32 day;
+  guint32 peak;
+} SessionDay;
+
+struct _PumpkinSessionHistory {
+  char *log_path;
+  char *agg_path;
+  guint64 folded_bytes;
+  gint64 last_at;
+  guint online;
+  gboolean tracking;
+  guint64 player_seconds[PUMPKIN_SESSION_WEEK_HOURS];
+  guint64 observed_seconds[PUMPKIN_SESSION_WEEK_HOURS];
+  GArray *days;
+  gboolean dirty;
+};
+
+static gint64
+local_offset(gint64 at)
+{
+  g_autoptr(GDateTime) time = g_date_time_new_from_unix_local(at);
+  return time != NULL ? g_date_time_get_utc_offset(time) / G_USEC_PER_SEC : 0;
+}
+
+static guint32
+local_day(gint64 at)
+{
+  gint64 local = at + local_offset(at);
+  return local > 0 ? (guint32)(local / 86400) : 0;
+}
+
+/* Slot 0 is Monday 00:00 local time; the epoch fell on a Thursday. */
+static guint
+week_slot(gint64 local)
+{
+  return (guint)((((local / 86400) + 3) % 7) * 24 + (local % 86400) / 3600);
+}
+
+static guint32
+player_hash(const char *player)
+{
+  guint32 hash = 2166136261u;
+  for (const guchar *p = (const guchar *)player; p != NULL && *p != '\0'; p++) {
+    hash = (hash ^ *p) * 16777619u;
+  }
+  return hash;
+}
+
+static void
+note_day_peak(GArray *days, guint32 day, guint32 peak)
+{
+  guint i = days->len;
+  while (i > 0 && g_array_index(days, SessionDay, i - 1).day > day) {
+    i--;
+  }
+  if (i > 0 && g_array_index(days, SessionDay, i - 1).day == day) {
+    SessionDay *entry = &g_array_index(days, SessionDay, i - 1);
+    entry->peak = MAX(entry->peak, peak);
+    return;
+  }
+  SessionDay entry = { .day = day, .peak = peak };
+  g_array_insert_val(days, i, entry);
+}
+
+/* Spreads the concurrency held between two events over the hour-of-week slots it covered. */
+static void
+accumulate(gint64 from, gint64 to, guint online, guint64 *player_seconds, guint64 *observed_seconds, GArray *days)
+{
+  if (from <= 0 || to <= from) {
+    return;
+  }
+  gint64 offset = local_offset(from);
+  gint64 local = from + offset;
+  gint64 end = to + offset;
+  guint32 day = G_MAXUINT32;
+  while (local < end) {
+    gint64 span = MIN((local / 3600 + 1) * 3600, end) - local;
+    guint slot = week_slot(local);
+    observed_seconds[slot] += (guint64)span;
+    player_seconds[slot] += (guint64)span * online;
+    if (days != NULL && (guint32)(local / 86400) != day) {
+      day = (guint32)(local / 86400);
+      note_day_peak(days, day, online);
+    }
+    local += span;
+  }
+}
+
+static void
+fold_record(PumpkinSessionHistory *history, gint64 at, guint kind, guint online)
+{
+  if (history->tracking) {
+    accumulate(history->last_at, at, history->online, history->player_seconds, history->observed_seconds,
+               history->days);
+  }
+  if (at > history->last_at) {
+    history->last_at = at;
+  }
+  history->online = kind == SESSION_END ? 0 : online;
+  history->tracking = kind != SESSION_END;
+  if (history->tracking) {
+    note_day_peak(history->days, local_day(at), history->online);
+  }
+  history->dirty = TRUE;
+}
+
+static void
+reset_aggregates(PumpkinSessionHistory *history)
+{
+  history->folded_bytes = 0;
+  history->last_at = 0;
+  history->online = 0;
+  history->tracking = FALSE;
+  memset(history->player_seconds, 0, sizeof(history->player_seconds));
+  memset(history->observed_seconds, 0, sizeof(history->observed_seconds));
+  g_array_set_size(history->days, 0);
+  history->dirty = TRUE;
+}
+
+static guint64
+read_u64(const guint8 *data)
+{
+  guint64 value = 0;
+  memcpy(&value, data, sizeof(value));
+  return GUINT64_FROM_LE(value);
+}
+
+static guint32
+read_u32(const guint8 *data)
+{
+  guint32 value = 0;
+  memcpy(&value, data, sizeof(value));
+  return GUINT32_FROM_LE(value);
+}
+
+static guint16
+read_u16(const guint8 *data)
+{
+  guint16 value = 0;
+  memcpy(&value, data, sizeof(value));
+  return GUINT16_FROM_LE(value);
+}
+
+static void
+put_u64(GByteArray *out, guint64 value)
+{
+  value = GUINT64_TO_LE(value);
+  g_byte_array_append(out, (const guint8 *)&value, sizeof(value));
+}
+
+static void
+put_u32(GByteArray *out, guint32 value)
+{
+  value = GUINT32_TO_LE(value);
+  g_byte_array_append(out, (const guint8 *)&value, sizeof(value));
+}
+
+#define SESSION_AGG_HEADER_SIZE (4 + 4 + 8 + 8 + 4 + 4 + PUMPKIN_SESSION_WEEK_HOURS * 16 + 4)
+
+static gboolean
+load_aggregates(PumpkinSessionHistory *history)
+{
+  g_autofree char *contents = NULL;
+  gsize length = 0;
+  if (!g_file_get_contents(history->agg_path, &contents, &length, NULL) || length < SESSION_AGG_HEADER_SIZE) {
+    return FALSE;
+  }
+  const guint8 *p = (const guint8 *)contents;
+  if (read_u32(p) != SESSION_AGG_MAGIC || read_u32(p + 4) != SESSION_AGG_VERSION) {
+    return FALSE;
+  }
+  guint32 n_days = read_u32(p + SESSION_AGG_HEADER_SIZE - 4);
+  if (length != SESSION_AGG_HEADER_SIZE + (gsize)n_days * 8) {
+    return FALSE;
+  }
+  history->folded_bytes = read_u64(p + 8);
+  history->last_at = (gint64)read_u64(p + 16);
+  history->online = read_u32(p + 24);
+  history->tracking = read_u32(p + 28) != 0;
+  p += 32;
+  for (guint i = 0; i < PUMPKIN_SESSION_WEEK_HOURS; i++, p += 16) {
+    history->player_seconds[i] = read_u64(p);
+    history->observed_seconds[i] = read_u64(p + 8);
+  }
+  p += 4;
+  g_array_set_size(history->days, n_days);
+  for (guint i = 0; i < n_days; i++, p += 8) {
+    SessionDay *entry = &g_array_index(history->days, SessionDay, i);
+    entry->day = read_u32(p);
+    entry->peak = read_u32(p + 4);
+  }
+  history->dirty = FALSE;
+  return TRUE;
+}
+
+/* A torn last record would misalign every append after it, so it is cut before anything is added. */
+static void
+trim_torn_tail(PumpkinSessionHistory *history, guint64 size)
+{
+  g_autofree char *contents = NULL;
+  gsize length = 0;
+  if (!g_file_get_contents(history->log_path, &contents, &length, NULL) || length != size) {
+    return;
+  }
+  g_autoptr(GError) error = NULL;
+  gsize aligned = length - length % SESSION_RECORD_SIZE;
+  if (!g_file_set_contents(history->log_path, contents, (gssize)aligned, &error)) {
+    g_warning("Failed to repair session log: %s", error->message);
+  }
+}
+
+static void
+fold_log_tail(PumpkinSessionHistory *history)
+{
+  GStatBuf st;
+  if (g_stat(history->log_path, &st) != 0) {
+    if (history->folded_bytes > 0) {
+      reset_aggregates(history);
+    }
+    return;
+  }
+  guint64 size = (guint64)st.st_size;
+  if (size % SESSION_RECORD_SIZE != 0) {
+    trim_torn_tail(history, size);
+    size -= size % SESSION_RECORD_SIZE;
+  }
+  if (size < history->folded_bytes || history->folded_bytes % SESSION_RECORD_SIZE != 0) {
+    reset_aggregates(history);
+  }
+  if (size == history->folded_bytes) {
+    return;
+  }
+
+  FILE *file = g_fopen(history->log_path, "rb");
+  if (file == NULL) {
+    return;
+  }
+  if (fseek(file, (long)history->folded_bytes, SEEK_SET) != 0) {
+    fclose(file);
+    return;
+  }
+  g_autofree guint8 *batch = g_malloc(SESSION_RECORD_SIZE * SESSION_FOLD_BATCH);
+  while (history->folded_bytes < size) {
+    gsize wanted = (gsize)MIN((size - history->folded_bytes) / SESSION_RECORD_SIZE, SESSION_FOLD_BATCH);
+    gsize got = fread(batch, SESSION_RECORD_SIZE, wanted, file);
+    for (gsize i = 0; i < got; i++) {
+      const guint8 *record = batch + i * SESSION_RECORD_SIZE;
+      fold_record(history, (gint64)read_u64(record), read_u16(record + 12), read_u16(record + 14));
+    }
+    history->folded_bytes += (guint64)got * SESSION_RECORD_SIZE;
+    if (got < wanted) {
+      break;
+    }
+  }
+  fclose(file);
+}
+
+/* Aggregates are cached next to the log with the byte offset they cover, so opening only replays new records. */
+PumpkinSessionHistory *
+pumpkin_session_history_open(const char *dir)
+{
+  g_return_val_if_fail(dir != NULL, NULL);
+  PumpkinSessionHistory *history = g_new0(PumpkinSessionHistory, 1);
+  history->log_path = g_build_filename(dir, SESSION_LOG_FILE, NULL);
+  history->agg_path = g_build_filename(dir, SESSION_AGG_FILE, NULL);
+  history->days = g_array_new(FALSE, FALSE, sizeof(SessionDay));
+  if (!load_aggregates(history)) {
+    reset_aggregates(history);
+  }
+  fold_log_tail(history);
+  return history;
+}
+
+void
+pumpkin_session_history_free(PumpkinSessionHistory *history)
+{
+  if (history == NULL) {
+    return;
+  }
+  g_free(history->log_path);
+  g_free(history->agg_path);
+  g_array_unref(history->days);
+  g_free(history);
+}
+
+static void
+append_record(PumpkinSessionHistory *history, gint64 at, const char *player, guint kind, guint online)
+{
+  online = MIN(online, G_MAXUINT16);
+  guint8 record[SESSION_RECORD_SIZE];
+  guint64 at_le = GUINT64_TO_LE((guint64)at);
+  guint32 player_le = GUINT32_TO_LE(player != NULL ? player_hash(player) : 0);
+  guint16 kind_le = GUINT16_TO_LE((guint16)kind);
+  guint16 online_le = GUINT16_TO_LE((guint16)online);
+  memcpy(record, &at_le, 8);
+  memcpy(record + 8, &player_le, 4);
+  memcpy(record + 12, &kind_le, 2);
+  memcpy(record + 14, &online_le, 2);
+
+  FILE *file = g_fopen(history->log_path, "ab");
+  gboolean written = file != NULL && fwrite(record, sizeof(record), 1, file) == 1;
+  if (file != NULL && fclose(file) != 0) {
+    written = FALSE;
+  }
+  if (!written) {
+    g_warning("Failed to append to session log %s", history->log_path);
+    return;
+  }
+  history->folded_bytes += SESSION_RECORD_SIZE;
+  fold_record(history, at, kind, online);
+}
+
+void
+pumpkin_session_history_join(PumpkinSessionHistory *history, gint64 at, const char *player)
+{
+  g_return_if_fail(history != NULL);
+  if (!history->tracking) {
+    append_record(history, at, NULL, SESSION_BEGIN, history->online);
+  }
+  append_record(history, at, player, SESSION_JOIN, history->online + 1);
+}
+
+void
+pumpkin_session_history_leave(PumpkinSessionHistory *history, gint64 at, const char *player)
+{
+  g_return_if_fail(history != NULL);
+  if (!history->tracking) {
+    append_record(history, at, NULL, SESSION_BEGIN, 0);
+  }
+  append_record(history, at, player, SESSION_LEAVE, history->online > 0 ? history->online - 1 : 0);
+}
+
+/*
+ * Starts a watch with the players already known to be online; one left open by a crash is closed at its
+ * last event, since its real end is unknown.
+ */
+void
+pumpkin_session_history_begin(PumpkinSessionHistory *history, gint64 at, guint online)
+{
+  g_return_if_fail(history != NULL);
+  if (history->tracking) {
+    append_record(history, history->last_at, NULL, SESSION_END, 0);
+  }
+  append_record(history, MAX(at, history->last_at), NULL, SESSION_BEGIN, online);
+}
+
+void
+pumpkin_session_history_end(PumpkinSessionHistory *history, gint64 at)
+{
+  g_return_if_fail(history != NULL);
+  if (history->tracking) {
+    append_record(history, MAX(at, history->last_at), NULL, SESSION_END, 0);
+  }
+}
+
+gboolean
+pumpkin_session_history_flush(PumpkinSessionHistory *history, GError **error)
+{
+  g_return_val_if_fail(history != NULL, FALSE);
+  if (!history->dirty) {
+    return TRUE;
+  }
+  GByteArray *out = g_byte_array_sized_new(SESSION_AGG_HEADER_SIZE + history->days->len * 8);
+  put_u32(out, SESSION_AGG_MAGIC);
+  put_u32(out, SESSION_AGG_VERSION);
+  put_u64(out, history->folded_bytes);
+  put_u64(out, (guint64)history->last_at);
+  put_u32(out, history->online);
+  put_u32(out, history->tracking ? 1 : 0);
+  for (guint i = 0; i < PUMPKIN_SESSION_WEEK_HOURS; i++) {
+    put_u64(out, history->player_seconds[i]);
+    put_u64(out, history->observed_seconds[i]);
+  }
+  put_u32(out, history->days->len);
+  for (guint i = 0; i < history->days->len; i++) {
+    SessionDay *entry = &g_array_index(history->days, SessionDay, i);
+    put_u32(out, entry->day);
+    put_u32(out, entry->peak);
+  }
+  gboolean ok = g_file_set_contents(history->agg_path, (const char *)out->data, (gssize)out->len, error);
+  g_byte_array_unref(out);
+  if (ok) {
+    history->dirty = FALSE;
+  }
+  return ok;
+}
+
+/* Average concurrent players per hour of the week, counting the still-open interval up to now. */
+gboolean
+pumpkin_session_history_heatmap(PumpkinSessionHistory *history, gint64 now, double out[PUMPKIN_SESSION_WEEK_HOURS])
+{
+  g_return_val_if_fail(history != NULL, FALSE);
+  guint64 player_seconds[PUMPKIN_SESSION_WEEK_HOURS];
+  guint64 observed_seconds[PUMPKIN_SESSION_WEEK_HOURS];
+  memcpy(player_seconds, history->player_seconds, sizeof(player_seconds));
+  memcpy(observed_seconds, history->observed_seconds, sizeof(observed_seconds));
+  if (history->tracking) {
+    accumulate(history->last_at, now, history->online, player_seconds, observed_seconds, NULL);
+  }
+  gboolean any = FALSE;
+  for (guint i = 0; i < PUMPKIN_SESSION_WEEK_HOURS; i++) {
+    out[i] = observed_seconds[i] > 0 ? (double)player_seconds[i] / (double)observed_seconds[i] : 0.0;
+    any = any || observed_seconds[i] > 0;
+  }
+  return any;
+}
+
+static int
+compare_guint(gconstpointer a, gconstpointer b)
+{
+  guint va = *(const guint *)a;
+  guint vb = *(const guint *)b;
+  return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+static guint
+nearest_rank(GArray *sorted, double percentile)
+{
+  gsize rank = (gsize)(percentile * sorted->len + 0.999999);
+  return g_array_index(sorted, guint, CLAMP(rank, 1, sorted->len) - 1);
+}
+
+/* Percentiles of the daily peak over the last `days` days; days the window never watched are left out. */
+void
+pumpkin_session_history_peaks(PumpkinSessionHistory *history, gint64 now, guint days, PumpkinSessionPeaks *out)
+{
+  g_return_if_fail(history != NULL && out != NULL);
+  memset(out, 0, sizeof(*out));
+  guint32 today = local_day(now);
+  guint32 first = today >= days ? today - days + 1 : 0;
+  g_autoptr(GArray) peaks = g_array_new(FALSE, FALSE, sizeof(guint));
+  guint32 last_day = 0;
+  for (guint i = history->days->len; i > 0; i--) {
+    SessionDay *entry = &g_array_index(history->days, SessionDay, i - 1);
+    if (entry->day < first) {
+      break;
+    }
+    if (entry->day <= today) {
+      guint peak = entry->peak;
+      g_array_append_val(peaks, peak);
+      last_day = MAX(last_day, entry->day);
+    }
+  }
+  if (history->tracking) {
+    guint online = history->online;
+    for (guint32 day = MAX(last_day + 1, first); day <= today; day++) {
+      g_array_append_val(peaks, online);
+    }
+  }
+  if (peaks->len == 0) {
+    return;
+  }
+  g_array_sort(peaks, compare_guint);
+  out->days = peaks->len;
+  out->p50 = nearest_rank(peaks, 0.50);
+  out->p95 = nearest_rank(peaks, 0.95);
+  out->p99 = nearest_rank(peaks, 0.99);
+  out->max = g_array_index(peaks, guint, peaks->len - 1);
+}
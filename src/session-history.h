@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glib.h>
+
+#define PUMPKIN_SESSION_WEEK_HOURS 168
+
+typedef struct _PumpkinSessionHistory PumpkinSessionHistory;
+
+typedef struct {
+  guint days;
+  guint p50;
+  guint p95;
+  guint p99;
+  guint max;
+} PumpkinSessionPeaks;
+
+PumpkinSessionHistory *pumpkin_session_history_open(const char *dir);
+void pumpkin_session_history_free(PumpkinSessionHistory *history);
+void pumpkin_session_history_begin(PumpkinSessionHistory *history, gint64 at, guint online);
+void pumpkin_session_history_end(PumpkinSessionHistory *history, gint64 at);
+void pumpkin_session_history_join(PumpkinSessionHistory *history, gint64 at, const char *player);
+void pumpkin_session_history_leave(PumpkinSessionHistory *history, gint64 at, const char *player);
+gboolean pumpkin_session_history_flush(PumpkinSessionHistory *history, GError **error);
+gboolean pumpkin_session_history_heatmap(PumpkinSessionHistory *history, gint64 now,
+                                         double out[PUMPKIN_SESSION_WEEK_HOURS]);
+void pumpkin_session_history_peaks(PumpkinSessionHistory *history, gint64 now, guint days,
+                                   PumpkinSessionPeaks *out);
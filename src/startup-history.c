@@ -0,0 +1,195 @@
+#include "startup-history.h"
+
+#define STARTUP_HISTORY_MAX_RECORDS 500
+
+PumpkinStartupRecord *
+pumpkin_startup_record_new(const char *build_id, const char *build_label)
+{
+  PumpkinStartupRecord *record = g_new0(PumpkinStartupRecord, 1);
+  record->started_at = g_get_real_time() / G_USEC_PER_SEC;
+  record->build_id = g_strdup(build_id != NULL && *build_id != '\0' ? build_id : "unknown");
+  record->build_label = g_strdup(build_label != NULL ? build_label : "");
+  return record;
+}
+
+void
+pumpkin_startup_record_free(PumpkinStartupRecord *record)
+{
+  if (record == NULL) {
+    return;
+  }
+  g_free(record->build_id);
+  g_free(record->build_label);
+  g_free(record);
+}
+
+/* One run per line: started_at, build id, ready ms, world ms, steady rss, build label. */
+GPtrArray *
+pumpkin_startup_history_load(const char *path)
+{
+  GPtrArray *records = g_ptr_array_new_with_free_func((GDestroyNotify)pumpkin_startup_record_free);
+  g_autofree char *contents = NULL;
+  if (path == NULL || !g_file_get_contents(path, &contents, NULL, NULL)) {
+    return records;
+  }
+  g_auto(GStrv) lines = g_strsplit(contents, "\n", -1);
+  for (guint i = 0; lines[i] != NULL; i++) {
+    if (lines[i][0] == '\0' || lines[i][0] == '#') {
+      continue;
+    }
+    g_auto(GStrv) fields = g_strsplit(lines[i], "\t", 6);
+    if (g_strv_length(fields) < 5) {
+      continue;
+    }
+    PumpkinStartupRecord *record = g_new0(PumpkinStartupRecord, 1);
+    record->started_at = g_ascii_strtoll(fields[0], NULL, 10);
+    record->build_id = g_strdup(fields[1]);
+    record->ready_ms = (guint)g_ascii_strtoull(fields[2], NULL, 10);
+    record->world_ms = (guint)g_ascii_strtoull(fields[3], NULL, 10);
+    record->steady_rss = g_ascii_strtoull(fields[4], NULL, 10);
+    record->build_label = g_strdup(fields[5] != NULL ? fields[5] : "");
+    g_ptr_array_add(records, record);
+  }
+  return records;
+}
+
+gboolean
+pumpkin_startup_history_save(const char *path, GPtrArray *records, GError **error)
+{
+  GString *out = g_string_new("# started_at\tbuild_id\tready_ms\tworld_ms\tsteady_rss\tbuild_label\n");
+  for (guint i = 0; records != NULL && i < records->len; i++) {
+    PumpkinStartupRecord *record = g_ptr_array_index(records, i);
+    g_autofree char *label = g_strdelimit(g_strdup(record->build_label), "\t\n", ' ');
+    g_string_append_printf(out, "%" G_GINT64_FORMAT "\t%s\t%u\t%u\t%" G_GUINT64_FORMAT "\t%s\n",
+                           record->started_at, record->build_id, record->ready_ms, record->world_ms,
+                           record->steady_rss, label);
+  }
+  gboolean ok = g_file_set_contents(path, out->str, (gssize)out->len, error);
+  g_string_free(out, TRUE);
+  return ok;
+}
+
+void
+pumpkin_startup_history_append(GPtrArray *records, PumpkinStartupRecord *record)
+{
+  g_ptr_array_add(records, record);
+  if (records->len > STARTUP_HISTORY_MAX_RECORDS) {
+    g_ptr_array_remove_range(records, 0, records->len - STARTUP_HISTORY_MAX_RECORDS);
+  }
+}
+
+void
+pumpkin_startup_build_free(PumpkinStartupBuild *build)
+{
+  if (build == NULL) {
+    return;
+  }
+  g_free(build->build_id);
+  g_free(build->build_label);
+  g_free(build);
+}
+
+static int
+compare_guint64(gconstpointer a, gconstpointer b)
+{
+  guint64 va = *(const guint64 *)a;
+  guint64 vb = *(const guint64 *)b;
+  return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+/* Medians, so one cold-cache boot does not make a build look slow. Zero means "not measured". */
+static guint64
+median_nonzero(GArray *values)
+{
+  if (values->len == 0) {
+    return 0;
+  }
+  g_array_sort(values, compare_guint64);
+  guint mid = values->len / 2;
+  if (values->len % 2 == 1) {
+    return g_array_index(values, guint64, mid);
+  }
+  return (g_array_index(values, guint64, mid - 1) + g_array_index(values, guint64, mid)) / 2;
+}
+
+static void
+append_nonzero(GArray *values, guint64 value)
+{
+  if (value > 0) {
+    g_array_append_val(values, value);
+  }
+}
+
+/* Builds come back oldest first, ordered by their most recent run. */
+GPtrArray *
+pumpkin_startup_history_by_build(GPtrArray *records)
+{
+  GPtrArray *builds = g_ptr_array_new_with_free_func((GDestroyNotify)pumpkin_startup_build_free);
+  g_autoptr(GHashTable) seen = g_hash_table_new(g_str_hash, g_str_equal);
+  for (guint i = records != NULL ? records->len : 0; i > 0; i--) {
+    PumpkinStartupRecord *record = g_ptr_array_index(records, i - 1);
+    if (g_hash_table_contains(seen, record->build_id)) {
+      continue;
+    }
+    g_hash_table_add(seen, record->build_id);
+
+    g_autoptr(GArray) ready = g_array_new(FALSE, FALSE, sizeof(guint64));
+    g_autoptr(GArray) world = g_array_new(FALSE, FALSE, sizeof(guint64));
+    g_autoptr(GArray) rss = g_array_new(FALSE, FALSE, sizeof(guint64));
+    PumpkinStartupBuild *build = g_new0(PumpkinStartupBuild, 1);
+    build->build_id = g_strdup(record->build_id);
+    build->build_label = g_strdup(record->build_label);
+    build->last_started_at = record->started_at;
+    for (guint j = 0; j < records->len; j++) {
+      PumpkinStartupRecord *run = g_ptr_array_index(records, j);
+      if (g_strcmp0(run->build_id, record->build_id) != 0) {
+        continue;
+      }
+      build->runs++;
+      append_nonzero(ready, run->ready_ms);
+      append_nonzero(world, run->world_ms);
+      append_nonzero(rss, run->steady_rss);
+    }
+    build->ready_ms = (guint)median_nonzero(ready);
+    build->world_ms = (guint)median_nonzero(world);
+    build->steady_rss = median_nonzero(rss);
+    g_ptr_array_insert(builds, 0, build);
+  }
+  return builds;
+}
+
+static gboolean
+regressed(guint64 previous, guint64 current, double threshold, double *out_ratio)
+{
+  if (previous == 0 || current == 0) {
+    return FALSE;
+  }
+  *out_ratio = (double)current / (double)previous - 1.0;
+  return *out_ratio > threshold;
+}
+
+char *
+pumpkin_startup_build_regression(const PumpkinStartupBuild *previous,
+                                  const PumpkinStartupBuild *build,
+                                  double threshold)
+{
+  if (previous == NULL || build == NULL) {
+    return NULL;
+  }
+  GString *out = g_string_new(NULL);
+  double ratio = 0.0;
+  if (regressed(previous->ready_ms, build->ready_ms, threshold, &ratio)) {
+    g_string_append_printf(out, "startup %.0f%% slower", ratio * 100.0);
+  }
+  if (regressed(previous->world_ms, build->world_ms, threshold, &ratio)) {
+    g_string_append_printf(out, "%sworld load %.0f%% slower", out->len > 0 ? ", " : "", ratio * 100.0);
+  }
+  if (regressed(previous->steady_rss, build->steady_rss, threshold, &ratio)) {
+    g_string_append_printf(out, "%ssteady RSS %.0f%% higher", out->len > 0 ? ", " : "", ratio * 100.0);
+  }
+  if (out->len == 0) {
+    g_string_free(out, TRUE);
+    return NULL;
+  }
+  return g_string_free(out, FALSE);
+}
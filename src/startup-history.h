@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glib.h>
+
+typedef struct {
+  gint64 started_at;
+  char *build_id;
+  char *build_label;
+  guint ready_ms;
+  guint world_ms;
+  guint64 steady_rss;
+} PumpkinStartupRecord;
+
+typedef struct {
+  char *build_id;
+  char *build_label;
+  guint runs;
+  gint64 last_started_at;
+  guint ready_ms;
+  guint world_ms;
+  guint64 steady_rss;
+} PumpkinStartupBuild;
+
+PumpkinStartupRecord *pumpkin_startup_record_new(const char *build_id, const char *build_label);
+void pumpkin_startup_record_free(PumpkinStartupRecord *record);
+GPtrArray *pumpkin_startup_history_load(const char *path);
+gboolean pumpkin_startup_history_save(const char *path, GPtrArray *records, GError **error);
+void pumpkin_startup_history_append(GPtrArray *records, PumpkinStartupRecord *record);
+void pumpkin_startup_build_free(PumpkinStartupBuild *build);
+GPtrArray *pumpkin_startup_history_by_build(GPtrArray *records);
+char *pumpkin_startup_build_regression(const PumpkinStartupBuild *previous,
+                                       const PumpkinStartupBuild *build,
+                                       double threshold);
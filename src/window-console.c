@@ -436,6 +436,21 @@ format_console_line(PumpkinWindow *self, const char *line, ConsoleLevel *out_lev
   return g_strdup_printf("[%s] %s", timestamp_text, message);
 }
 
+char *
+console_tail_text(PumpkinWindow *self, PumpkinServer *server, int max_lines)
+{
+  GtkTextBuffer *buffer = self->console_buffers != NULL ? g_hash_table_lookup(self->console_buffers, server) : NULL;
+  if (buffer == NULL) {
+    return NULL;
+  }
+  int line_count = gtk_text_buffer_get_line_count(buffer);
+  GtkTextIter start;
+  GtkTextIter end;
+  gtk_text_buffer_get_iter_at_line(buffer, &start, MAX(0, line_count - max_lines - 1));
+  gtk_text_buffer_get_end_iter(buffer, &end);
+  return gtk_text_buffer_get_text(buffer, &start, &end, FALSE);
+}
+
 void
 append_console_line(PumpkinWindow *self, PumpkinServer *server, const char *line)
 {
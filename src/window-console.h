@@ -4,6 +4,7 @@
 
 gboolean console_level_matches_log_filter(ConsoleLevel level, int level_index);
 gboolean is_auto_poll_noise_line(const char *line);
+char *console_tail_text(PumpkinWindow *self, PumpkinServer *server, int max_lines);
 void append_console_line(PumpkinWindow *self, PumpkinServer *server, const char *line);
 void append_log(PumpkinWindow *self, const char *line);
 void append_log_for_server(PumpkinWindow *self, PumpkinServer *server, const char *line);
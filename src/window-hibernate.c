@@ -0,0 +1,535 @@
+#include "window-hibernate.h"
+#include "window-console.h"
+#include "window-lifecycle.h"
+#include "window-player-data.h"
+#include "window-protocol.h"
+
+typedef struct {
+  PumpkinWindow *self;
+  PumpkinServer *server;
+  gint64 idle_since;
+  gint64 last_probe_at;
+  gboolean probe_in_flight;
+  gboolean stopping;
+  char *status_json;
+  PumpkinWakeListener *listener;
+  PumpkinWakeListener *waking;
+  unsigned long long last_ticks;
+  gint64 last_ticks_at;
+  double idle_cpu_pct;
+  gboolean frozen;
+  gboolean freeze_failed;
+  guint thaw_source_id;
+  GHashTable *baseline_cookies;
+  guint64 rss_before;
+  guint64 rss_after;
+} HibernationEntry;
+
+typedef struct {
+  PumpkinWindow *self;
+  char *server_id;
+  int pid;
+  char *cgroup_path;
+  guint64 anon_bytes;
+  guint64 rss_after;
+  char *method;
+  char *error;
+} ReclaimJob;
+
+typedef struct {
+  PumpkinWindow *self;
+  char *server_id;
+  int port;
+  int players;
+  char *status_json;
+  gboolean ok;
+} HibernationProbe;
+
+static void
+release_listener(HibernationEntry *entry)
+{
+  if (entry->listener == NULL) {
+    return;
+  }
+  pumpkin_wake_listener_stop(entry->listener);
+  g_clear_pointer(&entry->listener, pumpkin_wake_listener_unref);
+}
+
+static void
+release_waking(HibernationEntry *entry, gboolean ready)
+{
+  if (entry->waking == NULL) {
+    return;
+  }
+  pumpkin_wake_listener_release(entry->waking, ready);
+  g_clear_pointer(&entry->waking, pumpkin_wake_listener_unref);
+}
+
+static void
+clear_frozen(HibernationEntry *entry)
+{
+  if (entry->thaw_source_id != 0) {
+    g_source_remove(entry->thaw_source_id);
+    entry->thaw_source_id = 0;
+  }
+  g_clear_pointer(&entry->baseline_cookies, g_hash_table_unref);
+  if (entry->frozen && pumpkin_server_get_frozen(entry->server)) {
+    pumpkin_server_set_frozen(entry->server, FALSE, NULL);
+  }
+  entry->frozen = FALSE;
+  entry->rss_before = 0;
+  entry->rss_after = 0;
+}
+
+void
+hibernation_free_entry(gpointer data)
+{
+  HibernationEntry *entry = data;
+  if (entry == NULL) {
+    return;
+  }
+  release_listener(entry);
+  release_waking(entry, FALSE);
+  clear_frozen(entry);
+  g_clear_object(&entry->server);
+  g_free(entry->status_json);
+  g_free(entry);
+}
+
+static HibernationEntry *
+lookup_entry(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL || self->hibernations == NULL) {
+    return NULL;
+  }
+  const char *id = pumpkin_server_get_id(server);
+  return id != NULL ? g_hash_table_lookup(self->hibernations, id) : NULL;
+}
+
+static void
+probe_free(HibernationProbe *probe)
+{
+  g_clear_object(&probe->self);
+  g_free(probe->server_id);
+  g_free(probe->status_json);
+  g_free(probe);
+}
+
+static void
+probe_task(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+  HibernationProbe *probe = task_data;
+  int max_players = 0;
+  probe->ok = pumpkin_query_minecraft_status("127.0.0.1", probe->port, &probe->players, &max_players,
+                                             &probe->status_json);
+  g_task_return_boolean(task, probe->ok);
+}
+
+/* Idle CPU burn is what freezing saves, so keep a running figure while the server is empty. */
+static void
+sample_idle_cpu(HibernationEntry *entry, gint64 now_mono)
+{
+  sample_process_cpu(pumpkin_server_get_pid(entry->server), now_mono, &entry->last_ticks, &entry->last_ticks_at,
+                     &entry->idle_cpu_pct);
+}
+
+static void
+reclaim_job_free(ReclaimJob *job)
+{
+  g_clear_object(&job->self);
+  g_free(job->server_id);
+  g_free(job->cgroup_path);
+  g_free(job->method);
+  g_free(job->error);
+  g_free(job);
+}
+
+/* process_madvise needs CAP_SYS_NICE; memory.reclaim only needs a writable cgroup. */
+static void
+reclaim_task(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+  ReclaimJob *job = task_data;
+  g_autoptr(GError) error = NULL;
+  guint64 advised = 0;
+  if (pumpkin_process_pageout(job->pid, &advised, &error)) {
+    job->method = g_strdup("process_madvise");
+  } else if (job->cgroup_path != NULL && job->anon_bytes > 0) {
+    g_clear_error(&error);
+    if (pumpkin_cgroup_reclaim(job->cgroup_path, job->anon_bytes, &error)) {
+      job->method = g_strdup("memory.reclaim");
+    }
+  }
+  if (job->method == NULL) {
+    job->error = g_strdup(error != NULL ? error->message : "unknown error");
+  }
+  PumpkinProcessMemory memory = { 0 };
+  if (pumpkin_process_read_memory(job->pid, &memory)) {
+    job->rss_after = memory.rss;
+  }
+  g_task_return_boolean(task, job->method != NULL);
+}
+
+static void
+reclaim_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  (void)user_data;
+  ReclaimJob *job = g_task_get_task_data(G_TASK(res));
+  PumpkinWindow *self = job->self;
+  HibernationEntry *entry = self->hibernations != NULL ? g_hash_table_lookup(self->hibernations, job->server_id)
+                                                       : NULL;
+  if (entry == NULL || !entry->frozen) {
+    return;
+  }
+  if (job->method == NULL) {
+    g_autofree char *message = g_strdup_printf("[SMPK] Frozen, but memory could not be reclaimed: %s", job->error);
+    append_log_for_server(self, entry->server, message);
+    return;
+  }
+  if (job->rss_after > 0) {
+    entry->rss_after = job->rss_after;
+  }
+  guint64 saved = entry->rss_before > entry->rss_after ? entry->rss_before - entry->rss_after : 0;
+  g_autofree char *size = g_format_size_full(saved, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *message = g_strdup_printf("[SMPK] Reclaimed %s of resident memory via %s.", size, job->method);
+  append_log_for_server(self, entry->server, message);
+  queue_overview_refresh(self, FALSE);
+}
+
+static GHashTable *
+collect_connection_cookies(int port)
+{
+  GHashTable *cookies = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+  g_autoptr(GPtrArray) connections = pumpkin_tcp_list_connections(0, port, NULL);
+  for (guint i = 0; connections != NULL && i < connections->len; i++) {
+    PumpkinTcpConnection *connection = g_ptr_array_index(connections, i);
+    gint64 *key = g_new(gint64, 1);
+    *key = (gint64)connection->cookie;
+    g_hash_table_add(cookies, key);
+  }
+  return cookies;
+}
+
+static void
+thaw_server(PumpkinWindow *self, HibernationEntry *entry, const char *reason)
+{
+  if (!entry->frozen) {
+    return;
+  }
+  clear_frozen(entry);
+  entry->idle_since = 0;
+  entry->last_ticks_at = 0;
+  g_autofree char *message = g_strdup_printf("[SMPK] Thawed: %s.", reason);
+  append_log_for_server(self, entry->server, message);
+  queue_overview_refresh(self, self->current == entry->server);
+}
+
+/* New handshakes still complete in the kernel while the server is frozen and wait in its accept queue. */
+static gboolean
+freeze_watch_cb(gpointer data)
+{
+  HibernationEntry *entry = data;
+  int port = pumpkin_server_get_port(entry->server);
+  g_autoptr(GPtrArray) connections = pumpkin_tcp_list_connections(0, port, NULL);
+  for (guint i = 0; connections != NULL && i < connections->len; i++) {
+    PumpkinTcpConnection *connection = g_ptr_array_index(connections, i);
+    gint64 cookie = (gint64)connection->cookie;
+    if (entry->baseline_cookies == NULL || !g_hash_table_contains(entry->baseline_cookies, &cookie)) {
+      g_autofree char *reason = g_strdup_printf("connection from %s", connection->remote_ip);
+      entry->thaw_source_id = 0;
+      thaw_server(entry->self, entry, reason);
+      return G_SOURCE_REMOVE;
+    }
+  }
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+freeze_server(PumpkinWindow *self, HibernationEntry *entry)
+{
+  int pid = pumpkin_server_get_pid(entry->server);
+  int port = pumpkin_server_get_port(entry->server);
+  PumpkinProcessMemory memory = { 0 };
+  pumpkin_process_read_memory(pid, &memory);
+  GHashTable *baseline = collect_connection_cookies(port);
+
+  g_autoptr(GError) error = NULL;
+  if (!pumpkin_server_set_frozen(entry->server, TRUE, &error)) {
+    g_hash_table_unref(baseline);
+    entry->freeze_failed = TRUE;
+    g_autofree char *message = g_strdup_printf("[SMPK] Cannot freeze idle server: %s",
+                                               error != NULL ? error->message : "unknown error");
+    append_log_for_server(self, entry->server, message);
+    return;
+  }
+  entry->frozen = TRUE;
+  entry->baseline_cookies = baseline;
+  entry->rss_before = memory.rss;
+  entry->rss_after = memory.rss;
+  entry->thaw_source_id = g_timeout_add(FREEZE_WATCH_INTERVAL_MSEC, freeze_watch_cb, entry);
+
+  int minutes = pumpkin_server_get_freeze_minutes(entry->server);
+  g_autofree char *message = g_strdup_printf("[SMPK] No players for %d minute%s, freezing the server.",
+                                             minutes, minutes == 1 ? "" : "s");
+  append_log_for_server(self, entry->server, message);
+
+  ReclaimJob *job = g_new0(ReclaimJob, 1);
+  job->self = g_object_ref(self);
+  job->server_id = g_strdup(pumpkin_server_get_id(entry->server));
+  job->pid = pid;
+  job->cgroup_path = pumpkin_server_get_cgroup_path(entry->server);
+  job->anon_bytes = memory.anon;
+  GTask *task = g_task_new(NULL, NULL, reclaim_done, NULL);
+  g_task_set_task_data(task, job, (GDestroyNotify)reclaim_job_free);
+  g_task_run_in_thread(task, reclaim_task);
+  g_object_unref(task);
+  queue_overview_refresh(self, self->current == entry->server);
+}
+
+static void
+hibernate_server(PumpkinWindow *self, HibernationEntry *entry)
+{
+  int minutes = pumpkin_server_get_hibernate_minutes(entry->server);
+  g_autofree char *message = g_strdup_printf("[SMPK] No players for %d minute%s, hibernating until someone joins.",
+                                             minutes, minutes == 1 ? "" : "s");
+  append_log_for_server(self, entry->server, message);
+  clear_frozen(entry);
+  entry->stopping = TRUE;
+  entry->idle_since = 0;
+  if (!stop_server_internal(self, entry->server, FALSE)) {
+    entry->stopping = FALSE;
+  }
+}
+
+static void
+probe_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  (void)user_data;
+  HibernationProbe *probe = g_task_get_task_data(G_TASK(res));
+  PumpkinWindow *self = probe->self;
+  HibernationEntry *entry = self->hibernations != NULL ? g_hash_table_lookup(self->hibernations, probe->server_id)
+                                                       : NULL;
+  if (entry == NULL) {
+    return;
+  }
+  entry->probe_in_flight = FALSE;
+  if (!probe->ok || entry->stopping || !pumpkin_server_get_running(entry->server)) {
+    return;
+  }
+  g_free(entry->status_json);
+  entry->status_json = g_steal_pointer(&probe->status_json);
+  if (probe->players > 0) {
+    entry->idle_since = 0;
+    entry->freeze_failed = FALSE;
+    return;
+  }
+  gint64 now = g_get_monotonic_time();
+  if (entry->idle_since == 0) {
+    entry->idle_since = now;
+    return;
+  }
+  int hibernate_minutes = pumpkin_server_get_hibernate_minutes(entry->server);
+  int freeze_minutes = pumpkin_server_get_freeze_minutes(entry->server);
+  gint64 idle = now - entry->idle_since;
+  if (hibernate_minutes > 0 && idle >= (gint64)hibernate_minutes * 60 * G_USEC_PER_SEC) {
+    hibernate_server(self, entry);
+  } else if (freeze_minutes > 0 && !entry->freeze_failed && idle >= (gint64)freeze_minutes * 60 * G_USEC_PER_SEC) {
+    freeze_server(self, entry);
+  }
+}
+
+static void
+on_wake(gpointer user_data)
+{
+  HibernationEntry *entry = user_data;
+  PumpkinWindow *self = entry->self;
+  /* The port is closed now, but the joining player's socket stays held until the ready line. */
+  pumpkin_wake_listener_stop(entry->listener);
+  release_waking(entry, FALSE);
+  entry->waking = g_steal_pointer(&entry->listener);
+  append_log_for_server(self, entry->server, "[SMPK] Player joining, waking the server from hibernation.");
+  if (!start_server_internal(self, entry->server, FALSE, TRUE)) {
+    release_waking(entry, FALSE);
+  }
+  queue_overview_refresh(self, self->current == entry->server);
+}
+
+void
+update_hibernation(PumpkinWindow *self, gint64 now_mono)
+{
+  GListModel *model = get_server_model(self);
+  if (model == NULL || self->hibernations == NULL) {
+    return;
+  }
+
+  g_autoptr(GHashTable) seen = g_hash_table_new(g_str_hash, g_str_equal);
+  guint n = g_list_model_get_n_items(model);
+  for (guint i = 0; i < n; i++) {
+    g_autoptr(PumpkinServer) server = g_list_model_get_item(model, i);
+    const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+    if (id == NULL ||
+        (pumpkin_server_get_hibernate_minutes(server) <= 0 && pumpkin_server_get_freeze_minutes(server) <= 0)) {
+      continue;
+    }
+    HibernationEntry *entry = g_hash_table_lookup(self->hibernations, id);
+    if (entry == NULL) {
+      entry = g_new0(HibernationEntry, 1);
+      entry->self = self;
+      entry->server = g_object_ref(server);
+      g_hash_table_replace(self->hibernations, g_strdup(id), entry);
+    }
+    g_hash_table_add(seen, (gpointer)id);
+    /* A frozen server cannot answer pings; no new connection means nobody joined either. */
+    if (entry->frozen) {
+      int hibernate_minutes = pumpkin_server_get_hibernate_minutes(server);
+      if (pumpkin_server_get_freeze_minutes(server) <= 0) {
+        thaw_server(self, entry, "freezing was turned off");
+      } else if (hibernate_minutes > 0 && entry->idle_since > 0 &&
+                 now_mono - entry->idle_since >= (gint64)hibernate_minutes * 60 * G_USEC_PER_SEC) {
+        hibernate_server(self, entry);
+      }
+      continue;
+    }
+    if (entry->listener != NULL || entry->stopping || entry->probe_in_flight) {
+      continue;
+    }
+    if (!pumpkin_server_get_running(server)) {
+      entry->idle_since = 0;
+      continue;
+    }
+    if (entry->last_probe_at > 0 && (now_mono - entry->last_probe_at) < HIBERNATE_PROBE_INTERVAL_USEC) {
+      continue;
+    }
+    int port = pumpkin_server_get_port(server);
+    if (port <= 0) {
+      continue;
+    }
+    entry->last_probe_at = now_mono;
+    entry->probe_in_flight = TRUE;
+    sample_idle_cpu(entry, now_mono);
+    HibernationProbe *probe = g_new0(HibernationProbe, 1);
+    probe->self = g_object_ref(self);
+    probe->server_id = g_strdup(id);
+    probe->port = port;
+    GTask *task = g_task_new(NULL, NULL, probe_done, NULL);
+    g_task_set_task_data(task, probe, (GDestroyNotify)probe_free);
+    g_task_run_in_thread(task, probe_task);
+    g_object_unref(task);
+  }
+
+  /* Turning both tiers off or deleting the server thaws it and gives the port back. */
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, self->hibernations);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    if (!g_hash_table_contains(seen, key)) {
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+}
+
+/* Snapshot of banned-ips.json; the server is stopped while hibernating, so it cannot change underneath. */
+static GHashTable *
+load_banned_ips(PumpkinServer *server)
+{
+  g_autofree char *path = resolve_data_file(server, "banned-ips.json");
+  g_autoptr(GPtrArray) entries = load_player_entries_from_file(path);
+  GHashTable *banned = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  for (guint i = 0; entries != NULL && i < entries->len; i++) {
+    PlayerEntry *entry = g_ptr_array_index(entries, i);
+    if (entry->ip != NULL && *entry->ip != '\0') {
+      g_hash_table_add(banned, g_strdup(entry->ip));
+    }
+  }
+  return banned;
+}
+
+void
+hibernation_server_ready(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  if (entry != NULL) {
+    release_waking(entry, TRUE);
+  }
+}
+
+void
+hibernation_server_exited(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  if (entry == NULL) {
+    return;
+  }
+  release_waking(entry, FALSE);
+  clear_frozen(entry);
+  entry->last_ticks_at = 0;
+  if (!entry->stopping) {
+    return;
+  }
+  entry->stopping = FALSE;
+  int port = pumpkin_server_get_port(server);
+  g_autoptr(GHashTable) banned_ips = load_banned_ips(server);
+  g_autoptr(GError) error = NULL;
+  entry->listener = pumpkin_wake_listener_new(port, entry->status_json, pumpkin_server_get_proxy_protocol(server),
+                                              banned_ips, on_wake, entry, &error);
+  if (entry->listener == NULL) {
+    g_autofree char *message = g_strdup_printf("[SMPK] Hibernation cannot listen on port %d: %s",
+                                               port, error != NULL ? error->message : "unknown error");
+    append_log_for_server(self, server, message);
+  } else {
+    g_autofree char *message = g_strdup_printf("[SMPK] Hibernating. Listening on port %d to wake on join.", port);
+    append_log_for_server(self, server, message);
+  }
+  queue_overview_refresh(self, self->current == server);
+}
+
+void
+hibernation_release(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  if (entry != NULL) {
+    release_listener(entry);
+    entry->stopping = FALSE;
+    entry->idle_since = 0;
+  }
+}
+
+gboolean
+server_is_hibernating(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  return entry != NULL && entry->listener != NULL;
+}
+
+void
+hibernation_thaw(PumpkinWindow *self, PumpkinServer *server, const char *reason)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  if (entry != NULL) {
+    thaw_server(self, entry, reason);
+  }
+}
+
+gboolean
+server_is_frozen(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  return entry != NULL && entry->frozen;
+}
+
+char *
+format_freeze_savings(PumpkinWindow *self, PumpkinServer *server)
+{
+  HibernationEntry *entry = lookup_entry(self, server);
+  if (entry == NULL || !entry->frozen) {
+    return NULL;
+  }
+  guint64 saved = entry->rss_before > entry->rss_after ? entry->rss_before - entry->rss_after : 0;
+  g_autofree char *size = g_format_size_full(saved, G_FORMAT_SIZE_IEC_UNITS);
+  return g_strdup_printf("Frozen · saving %s RAM, %.1f%% CPU", size, entry->idle_cpu_pct);
+}
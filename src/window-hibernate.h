@@ -0,0 +1,13 @@
+#pragma once
+
+#include "window-internal.h"
+
+void hibernation_free_entry(gpointer data);
+void update_hibernation(PumpkinWindow *self, gint64 now_mono);
+void hibernation_server_ready(PumpkinWindow *self, PumpkinServer *server);
+void hibernation_server_exited(PumpkinWindow *self, PumpkinServer *server);
+void hibernation_release(PumpkinWindow *self, PumpkinServer *server);
+gboolean server_is_hibernating(PumpkinWindow *self, PumpkinServer *server);
+void hibernation_thaw(PumpkinWindow *self, PumpkinServer *server, const char *reason);
+gboolean server_is_frozen(PumpkinWindow *self, PumpkinServer *server);
+char *format_freeze_savings(PumpkinWindow *self, PumpkinServer *server);
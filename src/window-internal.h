@@ -2,7 +2,20 @@
 
 #include "window.h"
 #include "app-config.h"
+#include "cgroup.h"
 #include "server-store.h"
+#include "memory-trend.h"
+#include "net-diag.h"
+#include "launch-profile.h"
+#include "pressure.h"
+#include "process-stats.h"
+#include "search-index.h"
+#include "head-cache.h"
+#include "intern.h"
+#include "startup-history.h"
+#include "session-history.h"
+#include "player-index.h"
+#include "join-latency.h"
 
 #define DEFAULT_STATS_SAMPLE_MSEC 200
 #define STATS_SAMPLE_MSEC_MIN 2
@@ -10,6 +23,40 @@
 #define STATS_HISTORY_SECONDS 180
 #define STATS_SAMPLES ((STATS_HISTORY_SECONDS * 1000) / DEFAULT_STATS_SAMPLE_MSEC)
 #define PLAYER_STATE_FLUSH_INTERVAL_USEC (15 * G_USEC_PER_SEC)
+#define PLAYER_LIST_DIFF_MAX 64
+#define MEMORY_ROLLUP_INTERVAL_USEC (5 * G_USEC_PER_SEC)
+#define MEMORY_TREND_INTERVAL_USEC (10 * G_USEC_PER_SEC)
+#define MEMORY_LEAK_ALERT_SECONDS (48 * 3600)
+#define MEMORY_LEAK_RESTART_SECONDS (6 * 3600)
+#define MEMORY_LEAK_FORCE_RESTART_SECONDS (15 * 60)
+#define MEMORY_LEAK_PROBE_INTERVAL_USEC (60 * G_USEC_PER_SEC)
+#define PRESSURE_WINDOW_USEC 2000000
+#define PRESSURE_ALERT_HOLD_USEC (60 * G_USEC_PER_SEC)
+#define HIBERNATE_PROBE_INTERVAL_USEC (30 * G_USEC_PER_SEC)
+#define HIBERNATE_MINUTES_MAX 1440
+#define FREEZE_MINUTES_MAX 1440
+#define WATCHDOG_SECONDS_MIN 15
+#define WATCHDOG_SECONDS_MAX 3600
+#define FREEZE_WATCH_INTERVAL_MSEC 1000
+#define START_QUEUE_READY_TIMEOUT_USEC (180 * G_USEC_PER_SEC)
+#define START_ADMIT_CPU_PRESSURE 40.0
+#define START_ADMIT_IO_PRESSURE 30.0
+#define WATCHDOG_PROBE_INTERVAL_USEC (10 * G_USEC_PER_SEC)
+#define WATCHDOG_PING_SLOW_USEC (2 * G_USEC_PER_SEC)
+#define WATCHDOG_TPS_STALL 2.0
+#define WATCHDOG_BACKOFF_BASE_SECONDS 10
+#define WATCHDOG_BACKOFF_MAX_SECONDS 600
+#define WATCHDOG_BACKOFF_RESET_USEC (30 * 60 * G_USEC_PER_SEC)
+#define WATCHDOG_HISTORY_LINES 30
+#define WATCHDOG_CONSOLE_TAIL_LINES 200
+#define STARTUP_STEADY_RSS_DELAY_USEC (5 * 60 * G_USEC_PER_SEC)
+#define STARTUP_REGRESSION_THRESHOLD 0.20
+#define STARTUP_HISTORY_VISIBLE_BUILDS 8
+#define SESSION_PEAK_WINDOW_DAYS 365
+#define JOIN_ATTEMPT_TIMEOUT_USEC (2 * 60 * G_USEC_PER_SEC)
+#define JOIN_PENDING_MAX 256
+#define JOIN_REGRESSION_THRESHOLD 0.20
+#define JOIN_LATENCY_VISIBLE_BUILDS 8
 #define CONSOLE_MAX_LINES 5000
 #define NETWORK_PROXY_JAVA_PORT 25565
 #define NETWORK_PROXY_BEDROCK_PORT 19132
@@ -83,11 +130,12 @@ typedef enum {
   CONSOLE_LEVEL_SMPK
 } ConsoleLevel;
 
+/* String fields are atoms from intern.h. */
 typedef struct {
-  char *key;
-  char *name;
-  char *uuid;
-  char *last_ip;
+  const char *key;
+  const char *name;
+  const char *uuid;
+  const char *last_ip;
   gboolean ip_banned_hint;
   PlayerPlatform platform;
   gboolean online;
@@ -97,20 +145,17 @@ typedef struct {
   gint64 session_started_mono;
 } PlayerState;
 
+typedef struct _PlayerWatch PlayerWatch;
+typedef struct _PlayerJournal PlayerJournal;
+
 typedef struct {
   int field;
   gboolean ascending;
   GHashTable *op_level_map;
+  PumpkinSearchIndex *search_index;
   gint64 now_unix;
 } PlayerSortSettings;
 
-typedef struct {
-  PumpkinWindow *self;
-  PumpkinServer *server;
-  char *uuid_key;
-  char *cache_path;
-} PlayerHeadDownloadContext;
-
 typedef struct {
   char *id;
   char *name;
@@ -158,12 +203,44 @@ typedef struct {
   GPtrArray *servers;
 } DdnsSyncRequest;
 
+typedef struct {
+  PumpkinProcessMemory memory;
+  gint64 sampled_at;
+  int pid;
+} MemoryRollupEntry;
+
+typedef struct {
+  PumpkinMemoryTrend *trend;
+  PumpkinMemoryTrendEstimate estimate;
+  gint64 seconds_to_limit;
+  gboolean limit_is_host;
+  gboolean alert;
+  gboolean probe_in_flight;
+  gboolean restart_scheduled;
+  gint64 last_probe_at;
+  int pid;
+} MemoryTrendEntry;
+
+typedef struct {
+  PumpkinWindow *self;
+  char *server_id;
+  char *path;
+  PumpkinPressureResource resource;
+  gboolean full;
+  int fd;
+  guint source_id;
+  gint64 last_event_at;
+  double last_stall_pct;
+} PressureWatch;
+
 typedef struct {
   char *public_ipv4;
   GPtrArray *results;
 } DdnsSyncResult;
 
 char *normalized_key(const char *text);
+void clear_box_children(GtkBox *box);
+void refresh_player_list(PumpkinWindow *self);
 void invalidate_player_list_signature(PumpkinWindow *self);
 
 struct _PumpkinWindow {
@@ -215,7 +292,7 @@ struct _PumpkinWindow {
 
   GtkListBox *plugin_list;
   GtkListBox *world_list;
-  GtkListBox *player_list;
+  GtkListView *player_list;
   GtkSearchEntry *player_search;
   GtkDropDown *player_sort_dropdown;
   GtkToggleButton *btn_player_sort_order;
@@ -237,11 +314,50 @@ struct _PumpkinWindow {
   GtkBox *stats_row;
   GtkDrawingArea *stats_graph_usage;
   GtkDrawingArea *stats_graph_players;
-  GtkDrawingArea *stats_graph_disk;
+  GtkDrawingArea *stats_graph_tps;
   GtkLabel *label_stats_cpu;
   GtkLabel *label_stats_ram;
-  GtkLabel *label_stats_disk;
+  GtkLabel *label_stats_tps;
   GtkLabel *label_stats_players;
+  GtkBox *stats_io_section;
+  GtkDrawingArea *stats_graph_io;
+  GtkDrawingArea *stats_graph_faults;
+  GtkLabel *label_stats_io_read;
+  GtkLabel *label_stats_io_write;
+  GtkLabel *label_stats_faults_major;
+  GtkLabel *label_stats_faults_minor;
+  GtkBox *stats_net_section;
+  GtkDrawingArea *stats_graph_net;
+  GtkLabel *label_stats_net_rx;
+  GtkLabel *label_stats_net_tx;
+  GtkLabel *label_stats_net_conns;
+  GtkBox *stats_sched_section;
+  GtkDrawingArea *stats_graph_sched;
+  GtkDrawingArea *stats_graph_ctx;
+  GtkLabel *label_stats_sched_wait;
+  GtkLabel *label_stats_ctx_voluntary;
+  GtkLabel *label_stats_ctx_involuntary;
+  GtkBox *stats_mem_section;
+  GtkDrawingArea *stats_graph_mem;
+  GtkLabel *label_stats_mem_anon;
+  GtkLabel *label_stats_mem_file;
+  GtkLabel *label_stats_mem_shmem;
+  GtkLabel *label_stats_mem_swap;
+  GtkLabel *label_stats_mem_pss;
+  GtkBox *stats_psi_section;
+  GtkDrawingArea *stats_graph_psi_host;
+  GtkDrawingArea *stats_graph_psi_server;
+  GtkLabel *label_stats_psi_host_memory;
+  GtkLabel *label_stats_psi_host_cpu;
+  GtkLabel *label_stats_psi_host_io;
+  GtkLabel *label_stats_psi_memory;
+  GtkLabel *label_stats_psi_cpu;
+  GtkLabel *label_stats_psi_io;
+  GtkLabel *label_stats_psi_alert;
+  GtkBox *stats_startup_history_box;
+  GtkDrawingArea *stats_player_heatmap;
+  GtkLabel *stats_player_peaks;
+  GtkBox *stats_join_latency_box;
   GtkRevealer *console_warning_revealer;
   GtkLabel *console_warning_label;
   GtkLabel *label_resource_limits;
@@ -318,8 +434,55 @@ struct _PumpkinWindow {
   long clk_tck;
   double stats_cpu[STATS_SAMPLES];
   double stats_ram_mb[STATS_SAMPLES];
-  double stats_disk_mb[STATS_SAMPLES];
+  double stats_tps[STATS_SAMPLES];
   double stats_players[STATS_SAMPLES];
+  double stats_io_read_mb[STATS_SAMPLES];
+  double stats_io_write_mb[STATS_SAMPLES];
+  double stats_faults_major[STATS_SAMPLES];
+  double stats_faults_minor[STATS_SAMPLES];
+  PumpkinProcessIo last_proc_io;
+  gint64 last_proc_io_at;
+  int last_proc_io_pid;
+  double stats_net_rx_kb[STATS_SAMPLES];
+  double stats_net_tx_kb[STATS_SAMPLES];
+  PumpkinTcpSampler *tcp_sampler;
+  PumpkinTcpSample last_tcp_sample;
+  gint64 last_tcp_sample_at;
+  GHashTable *player_ping_by_ip;
+  double stats_sched_wait_ms[STATS_SAMPLES];
+  double stats_ctx_voluntary[STATS_SAMPLES];
+  double stats_ctx_involuntary[STATS_SAMPLES];
+  PumpkinSchedSampler *sched_sampler;
+  PumpkinProcessSched last_proc_sched;
+  gint64 last_proc_sched_at;
+  int last_proc_sched_pid;
+  double stats_mem_anon_mb[STATS_SAMPLES];
+  double stats_mem_file_mb[STATS_SAMPLES];
+  double stats_mem_shmem_mb[STATS_SAMPLES];
+  double stats_mem_swap_mb[STATS_SAMPLES];
+  double stats_mem_pss_mb[STATS_SAMPLES];
+  GHashTable *memory_rollup_by_server;
+  GHashTable *memory_trends;
+  gint64 last_memory_trend_at;
+  GHashTable *pending_restart_servers;
+  double stats_psi_host[PUMPKIN_PRESSURE_COUNT][STATS_SAMPLES];
+  double stats_psi_server[PUMPKIN_PRESSURE_COUNT][STATS_SAMPLES];
+  PumpkinPressure last_host_pressure[PUMPKIN_PRESSURE_COUNT];
+  PumpkinPressure last_server_pressure[PUMPKIN_PRESSURE_COUNT];
+  gboolean last_server_pressure_valid;
+  gint64 last_pressure_sample_at;
+  GPtrArray *pressure_watches;
+  gboolean host_pressure_armed;
+  GHashTable *hibernations;
+  GPtrArray *start_queue;
+  guint start_queue_source_id;
+  gint64 start_batch_began_at;
+  guint start_batch_total;
+  guint start_batch_failed;
+  guint start_batch_timed_out;
+  GHashTable *watchdogs;
+  GHashTable *startup_runs;
+  GHashTable *join_trackers;
   int stats_index;
   int stats_count;
   double last_tps;
@@ -354,13 +517,25 @@ struct _PumpkinWindow {
   GtkEntry *entry_stats_sample_msec;
   GtkEntry *entry_max_cpu_cores;
   GtkEntry *entry_max_ram_mb;
+  GtkEntry *entry_cpu_weight;
+  GtkEntry *entry_io_weight;
   GtkLabel *label_java_port_hint;
   GtkLabel *label_bedrock_port_hint;
   GtkLabel *label_max_players_hint;
   GtkLabel *label_stats_sample_hint;
   GtkLabel *label_max_cpu_hint;
   GtkLabel *label_max_ram_hint;
+  GtkLabel *label_cpu_set;
+  GtkDropDown *drop_launch_profile;
+  GtkLabel *label_launch_profile;
   GtkSwitch *switch_auto_restart;
+  GtkSwitch *switch_leak_restart;
+  GtkEntry *entry_hibernate_minutes;
+  GtkEntry *entry_freeze_minutes;
+  GtkEntry *entry_watchdog_seconds;
+  GtkSwitch *switch_watchdog_restart;
+  GtkEntry *entry_start_concurrency;
+  GtkEntry *entry_avatar_url;
   GtkEntry *entry_auto_restart_delay;
   GtkSwitch *switch_auto_update;
   GtkSwitch *switch_auto_update_schedule;
@@ -412,11 +587,28 @@ struct _PumpkinWindow {
   PumpkinServer *current;
   PumpkinConfig *config;
   guint players_refresh_id;
+  PlayerWatch *player_watch;
+  guint64 player_ingest_generation;
+  guint64 player_lookup_generation;
+  GHashTable *player_whitelist_set;
+  GHashTable *player_banned_reason_map;
+  GHashTable *player_banned_ip_reason_map;
+  GHashTable *player_op_level_map;
   gboolean player_list_signature_valid;
-  guint64 player_list_signature;
-  guint player_list_signature_count;
+  guint64 player_list_lookup_generation;
+  gint64 player_list_minute;
+  GHashTable *player_list_dirty_keys;
   gboolean player_list_pointer_inside;
   gint64 player_list_interaction_until;
+  GListStore *player_store;
+  GHashTable *player_items;
+  GHashTable *player_bound_items;
+  GtkFilter *player_filter;
+  GtkSorter *player_sorter;
+  char *player_list_query;
+  int player_list_sort_field;
+  gboolean player_list_sort_ascending;
+  PumpkinSearchIndex *player_search_index;
   int player_sort_field;
   gboolean player_sort_ascending;
   GHashTable *live_player_names;
@@ -425,7 +617,10 @@ struct _PumpkinWindow {
   GHashTable *player_states_by_uuid;
   GHashTable *player_states_by_name;
   GHashTable *deleted_player_keys;
-  GHashTable *player_head_downloads;
+  PlayerJournal *player_journal;
+  GHashTable *session_trackers;
+  PumpkinHeadCache *player_heads;
+  guint player_heads_refresh_id;
   GHashTable *console_buffers;
   GHashTable *server_running_hints;
   GPtrArray *command_history;
@@ -433,7 +628,11 @@ struct _PumpkinWindow {
   char *command_history_draft;
   GPtrArray *networks;
   GHashTable *expanded_network_ids;
+  PumpkinPlayerIndex *network_players;
+  gint64 network_players_flushed_at;
   GtkBox *network_details_members_box;
+  GtkSearchEntry *network_details_player_search;
+  GtkLabel *network_details_players;
   GtkProgressBar *network_details_progress;
   char *network_details_network_id;
   guint overview_refresh_idle_id;
@@ -452,10 +651,16 @@ void ensure_server_log_handler(PumpkinWindow *self, PumpkinServer *server);
 void append_log(PumpkinWindow *self, const char *line);
 void append_log_for_server(PumpkinWindow *self, PumpkinServer *server, const char *line);
 void set_details_error(PumpkinWindow *self, const char *message);
+void set_details_status(PumpkinWindow *self, const char *message, guint timeout_seconds);
 void clear_auto_update_countdown(PumpkinWindow *self);
 void queue_overview_refresh(PumpkinWindow *self, gboolean include_details);
 gboolean start_after_delay(gpointer data);
 void set_console_warning(PumpkinWindow *self, const char *message, gboolean visible);
 GListModel *get_server_model(PumpkinWindow *self);
+char *format_unix_time(PumpkinWindow *self, gint64 unix_ts);
+char *format_duration(guint64 seconds);
+char *extract_name_before_suffix(const char *line, const char *suffix);
+gboolean read_process_stats(int pid, unsigned long long *proc_ticks, unsigned long long *rss_bytes);
+void sample_process_cpu(int pid, gint64 now_mono, unsigned long long *last_ticks, gint64 *last_ticks_at, double *cpu_pct);
 char *normalized_key(const char *text);
 void update_settings_form(PumpkinWindow *self);
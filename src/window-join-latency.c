@@ -0,0 +1,347 @@
+#include "window-join-latency.h"
+#include "window-players.h"
+
+#include <string.h>
+
+typedef struct {
+  char *ip;
+  char *name_key;
+  gint64 accepted_at;
+  gint64 login_at;
+} JoinAttempt;
+
+typedef struct {
+  char *history_path;
+  GPtrArray *builds;
+  GQueue attempts;
+  gboolean dirty;
+} JoinTracker;
+
+static void
+join_attempt_free(JoinAttempt *attempt)
+{
+  if (attempt == NULL) {
+    return;
+  }
+  g_free(attempt->ip);
+  g_free(attempt->name_key);
+  g_free(attempt);
+}
+
+void
+join_tracker_free(gpointer data)
+{
+  JoinTracker *tracker = data;
+  if (tracker == NULL) {
+    return;
+  }
+  g_queue_clear_full(&tracker->attempts, (GDestroyNotify)join_attempt_free);
+  g_ptr_array_unref(tracker->builds);
+  g_free(tracker->history_path);
+  g_free(tracker);
+}
+
+static char *
+history_path(PumpkinServer *server)
+{
+  const char *root = pumpkin_server_get_root_dir(server);
+  return root != NULL ? g_build_filename(root, "join-latency.tsv", NULL) : NULL;
+}
+
+static JoinTracker *
+lookup_tracker(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+  if (self->join_trackers == NULL || id == NULL) {
+    return NULL;
+  }
+  JoinTracker *tracker = g_hash_table_lookup(self->join_trackers, id);
+  if (tracker == NULL) {
+    tracker = g_new0(JoinTracker, 1);
+    tracker->history_path = history_path(server);
+    tracker->builds = pumpkin_join_history_load(tracker->history_path);
+    g_queue_init(&tracker->attempts);
+    g_hash_table_replace(self->join_trackers, g_strdup(id), tracker);
+  }
+  return tracker;
+}
+
+static void
+expire_attempts(JoinTracker *tracker, gint64 now)
+{
+  while (!g_queue_is_empty(&tracker->attempts)) {
+    JoinAttempt *attempt = g_queue_peek_head(&tracker->attempts);
+    gint64 started = attempt->accepted_at > 0 ? attempt->accepted_at : attempt->login_at;
+    if (now - started < JOIN_ATTEMPT_TIMEOUT_USEC && tracker->attempts.length <= JOIN_PENDING_MAX) {
+      break;
+    }
+    join_attempt_free(g_queue_pop_head(&tracker->attempts));
+  }
+}
+
+static JoinAttempt *
+find_attempt(JoinTracker *tracker, const char *ip, const char *name_key)
+{
+  for (GList *link = tracker->attempts.head; link != NULL; link = link->next) {
+    JoinAttempt *attempt = link->data;
+    if (ip != NULL && attempt->name_key == NULL && g_strcmp0(attempt->ip, ip) == 0) {
+      return attempt;
+    }
+    if (name_key != NULL && g_strcmp0(attempt->name_key, name_key) == 0) {
+      return attempt;
+    }
+  }
+  return NULL;
+}
+
+/* Servers that log no login line give nothing to pair a join with, so it takes the oldest unclaimed connection. */
+static JoinAttempt *
+oldest_unclaimed(JoinTracker *tracker)
+{
+  for (GList *link = tracker->attempts.head; link != NULL; link = link->next) {
+    JoinAttempt *attempt = link->data;
+    if (attempt->name_key == NULL && attempt->accepted_at > 0) {
+      return attempt;
+    }
+  }
+  return NULL;
+}
+
+static guint
+elapsed_ms(gint64 from, gint64 to)
+{
+  return (guint)MAX(0, (to - from) / 1000);
+}
+
+static void
+record_join(PumpkinWindow *self, PumpkinServer *server, JoinTracker *tracker, JoinAttempt *attempt, gint64 now)
+{
+  PumpkinJoinBuild *build = pumpkin_join_history_touch(tracker->builds,
+                                                       pumpkin_server_get_installed_build_id(server),
+                                                       pumpkin_server_get_installed_build_label(server));
+  if (attempt->accepted_at > 0) {
+    pumpkin_latency_histogram_add(&build->stages[PUMPKIN_JOIN_STAGE_TOTAL], elapsed_ms(attempt->accepted_at, now));
+  }
+  if (attempt->accepted_at > 0 && attempt->login_at > 0) {
+    pumpkin_latency_histogram_add(&build->stages[PUMPKIN_JOIN_STAGE_LOGIN],
+                                  elapsed_ms(attempt->accepted_at, attempt->login_at));
+  }
+  if (attempt->login_at > 0) {
+    pumpkin_latency_histogram_add(&build->stages[PUMPKIN_JOIN_STAGE_SPAWN], elapsed_ms(attempt->login_at, now));
+  }
+  tracker->dirty = TRUE;
+  if (self->current == server) {
+    refresh_join_latency(self);
+  }
+}
+
+static char *
+accepted_ip(const char *line)
+{
+  g_autofree char *lower = g_ascii_strdown(line, -1);
+  const char *pos = strstr(lower, "accepted connection from");
+  if (pos == NULL) {
+    return NULL;
+  }
+  const char *edition = strstr(pos, "edition:");
+  const char *addr = edition != NULL ? edition + strlen("edition:") : pos + strlen("accepted connection from");
+  while (*addr == ' ') {
+    addr++;
+  }
+  const char *end = addr;
+  while (*end != '\0' && !g_ascii_isspace(*end)) {
+    end++;
+  }
+  g_autofree char *token = g_strndup(addr, (gsize)(end - addr));
+  return extract_ip_from_socket_text(token);
+}
+
+/*
+ * Stages are stamped when the line reaches the app: connection accepted, "name[/ip] logged in", then
+ * "joined the game" once the player spawns. Runs for every server, so it only looks at those shapes.
+ * Expects the line with ANSI codes already stripped.
+ */
+void
+join_latency_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line)
+{
+  if (line == NULL) {
+    return;
+  }
+  gboolean exited = g_strcmp0(line, "Server process exited") == 0;
+  gboolean accepted = strstr(line, "ccepted connection") != NULL;
+  gboolean logged_in = strstr(line, " logged in") != NULL && strstr(line, "[/") != NULL;
+  gboolean joined = strstr(line, " joined the game") != NULL;
+  gboolean left = strstr(line, " left the game") != NULL;
+  if (!exited && !accepted && !logged_in && !joined && !left) {
+    return;
+  }
+  JoinTracker *tracker = lookup_tracker(self, server);
+  if (tracker == NULL) {
+    return;
+  }
+  gint64 now = g_get_monotonic_time();
+  expire_attempts(tracker, now);
+  if (exited) {
+    g_queue_clear_full(&tracker->attempts, (GDestroyNotify)join_attempt_free);
+    return;
+  }
+
+  if (accepted) {
+    char *ip = accepted_ip(line);
+    if (ip != NULL) {
+      JoinAttempt *attempt = g_new0(JoinAttempt, 1);
+      attempt->ip = ip;
+      attempt->accepted_at = now;
+      g_queue_push_tail(&tracker->attempts, attempt);
+    }
+    return;
+  }
+
+  if (logged_in) {
+    g_autofree char *name = extract_name_before_suffix(line, "[/");
+    g_autofree char *name_key = normalized_key(name);
+    if (name_key == NULL) {
+      return;
+    }
+    const char *addr = strstr(line, "[/") + 2;
+    const char *addr_end = strchr(addr, ']');
+    g_autofree char *socket = addr_end != NULL ? g_strndup(addr, (gsize)(addr_end - addr)) : NULL;
+    g_autofree char *ip = extract_ip_from_socket_text(socket);
+    JoinAttempt *attempt = find_attempt(tracker, ip, NULL);
+    if (attempt == NULL) {
+      attempt = g_new0(JoinAttempt, 1);
+      g_queue_push_tail(&tracker->attempts, attempt);
+    }
+    attempt->name_key = g_steal_pointer(&name_key);
+    attempt->login_at = now;
+    return;
+  }
+
+  g_autofree char *name = extract_name_before_suffix(line, joined ? " joined the game" : " left the game");
+  g_autofree char *name_key = normalized_key(name);
+  if (name_key == NULL) {
+    return;
+  }
+  JoinAttempt *attempt = find_attempt(tracker, NULL, name_key);
+  if (joined && attempt == NULL) {
+    attempt = oldest_unclaimed(tracker);
+  }
+  if (attempt == NULL) {
+    return;
+  }
+  if (joined) {
+    record_join(self, server, tracker, attempt, now);
+  }
+  g_queue_remove(&tracker->attempts, attempt);
+  join_attempt_free(attempt);
+}
+
+void
+join_latency_flush(PumpkinWindow *self)
+{
+  if (self->join_trackers == NULL) {
+    return;
+  }
+  GHashTableIter iter;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->join_trackers);
+  while (g_hash_table_iter_next(&iter, NULL, &value)) {
+    JoinTracker *tracker = value;
+    if (!tracker->dirty || tracker->history_path == NULL) {
+      continue;
+    }
+    g_autoptr(GError) error = NULL;
+    if (!pumpkin_join_history_save(tracker->history_path, tracker->builds, &error)) {
+      g_warning("Failed to save join latency: %s", error != NULL ? error->message : "unknown error");
+      continue;
+    }
+    tracker->dirty = FALSE;
+  }
+}
+
+static GtkWidget *
+latency_cell(const char *text, int width_chars)
+{
+  GtkWidget *label = gtk_label_new(text);
+  gtk_label_set_xalign(GTK_LABEL(label), 0.0);
+  gtk_label_set_width_chars(GTK_LABEL(label), width_chars);
+  return label;
+}
+
+static char *
+format_latency(const PumpkinLatencyHistogram *histogram, double percentile)
+{
+  guint ms = pumpkin_latency_histogram_percentile(histogram, percentile);
+  if (histogram->count == 0) {
+    return g_strdup("--");
+  }
+  return ms < 1000 ? g_strdup_printf("%u ms", ms) : g_strdup_printf("%.1f s", ms / 1000.0);
+}
+
+static const char *
+build_title(const PumpkinJoinBuild *build)
+{
+  return build->build_label != NULL && *build->build_label != '\0' ? build->build_label : build->build_id;
+}
+
+void
+refresh_join_latency(PumpkinWindow *self)
+{
+  if (self->stats_join_latency_box == NULL) {
+    return;
+  }
+  clear_box_children(self->stats_join_latency_box);
+  const char *id = self->current != NULL ? pumpkin_server_get_id(self->current) : NULL;
+  JoinTracker *tracker = self->join_trackers != NULL && id != NULL ? g_hash_table_lookup(self->join_trackers, id)
+                                                                    : NULL;
+  g_autofree char *path = tracker == NULL && self->current != NULL ? history_path(self->current) : NULL;
+  g_autoptr(GPtrArray) loaded = tracker == NULL ? pumpkin_join_history_load(path) : NULL;
+  g_autoptr(GPtrArray) builds = pumpkin_join_history_by_install(tracker != NULL ? tracker->builds : loaded);
+  if (builds->len == 0) {
+    GtkWidget *empty = gtk_label_new("No joins recorded yet.");
+    gtk_label_set_xalign(GTK_LABEL(empty), 0.0);
+    gtk_widget_add_css_class(empty, "dim-label");
+    gtk_box_append(self->stats_join_latency_box, empty);
+    return;
+  }
+
+  guint first = builds->len > JOIN_LATENCY_VISIBLE_BUILDS ? builds->len - JOIN_LATENCY_VISIBLE_BUILDS : 0;
+  for (guint i = builds->len; i > first; i--) {
+    PumpkinJoinBuild *build = g_ptr_array_index(builds, i - 1);
+    PumpkinJoinBuild *previous = i >= 2 ? g_ptr_array_index(builds, i - 2) : NULL;
+    const PumpkinLatencyHistogram *total = &build->stages[PUMPKIN_JOIN_STAGE_TOTAL];
+    g_autofree char *p50 = format_latency(total, 0.50);
+    g_autofree char *p99 = format_latency(total, 0.99);
+    g_autofree char *login = format_latency(&build->stages[PUMPKIN_JOIN_STAGE_LOGIN], 0.50);
+    g_autofree char *spawn = format_latency(&build->stages[PUMPKIN_JOIN_STAGE_SPAWN], 0.50);
+    g_autofree char *joins = g_strdup_printf("%" G_GUINT64_FORMAT " join%s", total->count,
+                                             total->count == 1 ? "" : "s");
+    g_autofree char *regression = pumpkin_join_build_regression(previous, build, JOIN_REGRESSION_THRESHOLD);
+
+    GtkWidget *row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    GtkWidget *title = latency_cell(build_title(build), 18);
+    gtk_label_set_ellipsize(GTK_LABEL(title), PANGO_ELLIPSIZE_END);
+    gtk_widget_set_tooltip_text(title, build->build_id);
+    gtk_box_append(GTK_BOX(row), title);
+    gtk_box_append(GTK_BOX(row), latency_cell(p50, 8));
+    gtk_box_append(GTK_BOX(row), latency_cell(p99, 8));
+    GtkWidget *stages = latency_cell(NULL, 22);
+    g_autofree char *stages_text = g_strdup_printf("login %s · spawn %s", login, spawn);
+    gtk_label_set_text(GTK_LABEL(stages), stages_text);
+    gtk_widget_add_css_class(stages, "dim-label");
+    gtk_box_append(GTK_BOX(row), stages);
+    GtkWidget *joins_label = latency_cell(joins, 9);
+    gtk_widget_add_css_class(joins_label, "dim-label");
+    gtk_box_append(GTK_BOX(row), joins_label);
+    if (regression != NULL) {
+      GtkWidget *chip = gtk_label_new("Regressed");
+      gtk_widget_add_css_class(chip, "status-badge");
+      gtk_widget_add_css_class(chip, "warning-badge");
+      gtk_widget_set_valign(chip, GTK_ALIGN_CENTER);
+      g_autofree char *tooltip = g_strdup_printf("Compared with %s: %s", build_title(previous), regression);
+      gtk_widget_set_tooltip_text(chip, tooltip);
+      gtk_box_append(GTK_BOX(row), chip);
+    }
+    gtk_box_append(self->stats_join_latency_box, row);
+  }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "window-internal.h"
+
+void join_tracker_free(gpointer data);
+void join_latency_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line);
+void join_latency_flush(PumpkinWindow *self);
+void refresh_join_latency(PumpkinWindow *self);
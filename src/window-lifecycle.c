@@ -1,4 +1,7 @@
 #include "window-lifecycle.h"
+#include "window-hibernate.h"
+#include "window-start-queue.h"
+#include "window-networks.h"
 
 static gboolean
 server_running_hint(PumpkinWindow *self, PumpkinServer *server)
@@ -43,6 +46,7 @@ start_server_internal(PumpkinWindow *self,
   if (server_is_running_ui(self, server)) {
     return FALSE;
   }
+  hibernation_release(self, server);
   if (!server_has_installation(self, server)) {
     if (from_network_action) {
       append_log_for_server(self, server, "[SMPK] Cannot start: Pumpkin is not installed.");
@@ -86,6 +90,7 @@ start_server_internal(PumpkinWindow *self,
   }
 
   g_autoptr(GError) error = NULL;
+  sync_server_cgroup_group(self, server);
   if (!pumpkin_server_start(server, &error)) {
     if (from_network_action) {
       if (error != NULL) {
@@ -126,7 +131,11 @@ stop_server_internal(PumpkinWindow *self,
                      PumpkinServer *server,
                      gboolean from_network_action)
 {
-  if (self == NULL || server == NULL || !server_is_running_ui(self, server)) {
+  if (self == NULL || server == NULL) {
+    return FALSE;
+  }
+  start_queue_cancel(self, server);
+  if (!server_is_running_ui(self, server)) {
     return FALSE;
   }
 
@@ -148,6 +157,24 @@ stop_server_internal(PumpkinWindow *self,
   return TRUE;
 }
 
+gboolean
+restart_server_internal(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL) {
+    return FALSE;
+  }
+  if (server == self->current) {
+    on_details_restart(NULL, self);
+    return TRUE;
+  }
+  if (!pumpkin_server_get_running(server)) {
+    return start_server_internal(self, server, FALSE, FALSE);
+  }
+  /* Started again from on_log_line once the process has exited. */
+  g_hash_table_add(self->pending_restart_servers, g_object_ref(server));
+  return stop_server_internal(self, server, FALSE);
+}
+
 gboolean
 restart_after_delay(gpointer data)
 {
@@ -157,6 +184,7 @@ restart_after_delay(gpointer data)
   self->restart_delay_id = 0;
   self->restart_requested = FALSE;
   g_autoptr(GError) error = NULL;
+  sync_server_cgroup_group(self, server);
   if (!pumpkin_server_start(server, &error)) {
     append_log(self, error->message);
     if (self->current == server) {
@@ -0,0 +1,226 @@
+#include "window-network-players.h"
+#include "window-networks.h"
+
+#include <string.h>
+#include <time.h>
+
+static char *
+index_path(PumpkinWindow *self)
+{
+  const char *base = self->store != NULL ? pumpkin_server_store_get_base_dir(self->store) : NULL;
+  return base != NULL && *base != '\0' ? g_build_filename(base, "network-players.tsv", NULL) : NULL;
+}
+
+void
+network_players_load(PumpkinWindow *self)
+{
+  g_clear_pointer(&self->network_players, pumpkin_player_index_free);
+  self->network_players = pumpkin_player_index_new();
+  g_autofree char *path = index_path(self);
+  pumpkin_player_index_load(self->network_players, path);
+}
+
+void
+network_players_save(PumpkinWindow *self)
+{
+  g_autofree char *path = index_path(self);
+  if (self->network_players == NULL || path == NULL) {
+    return;
+  }
+  g_autoptr(GError) error = NULL;
+  if (!pumpkin_player_index_save(self->network_players, path, &error)) {
+    g_warning("Failed to save network player index: %s", error != NULL ? error->message : "unknown error");
+  }
+  self->network_players_flushed_at = g_get_monotonic_time();
+}
+
+void
+network_players_close(PumpkinWindow *self)
+{
+  if (self->network_players == NULL) {
+    return;
+  }
+  pumpkin_player_index_server_stopped(self->network_players, NULL, (gint64)time(NULL));
+  network_players_save(self);
+  g_clear_pointer(&self->network_players, pumpkin_player_index_free);
+}
+
+static const char *
+member_id(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+  return id != NULL && server_in_any_network(self, id) ? id : NULL;
+}
+
+/* Selecting a member loads its tracking file anyway; folding it in covers playtime from before the index existed. */
+void
+network_players_seed(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = member_id(self, server);
+  if (self->network_players == NULL || self->player_states == NULL || id == NULL) {
+    return;
+  }
+  GHashTableIter iter;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->player_states);
+  while (g_hash_table_iter_next(&iter, NULL, &value)) {
+    PlayerState *state = value;
+    pumpkin_player_index_seed(self->network_players, id, state->uuid, state->name, state->playtime_seconds,
+                              state->last_online_unix);
+  }
+}
+
+static gboolean
+note_uuid_line(PumpkinWindow *self, const char *check)
+{
+  const char *uuid_pos = strstr(check, "UUID: ");
+  const char *name_pos = strstr(check, "name=");
+  if (uuid_pos == NULL || name_pos == NULL) {
+    return FALSE;
+  }
+  uuid_pos += strlen("UUID: ");
+  name_pos += strlen("name=");
+  const char *uuid_end = uuid_pos;
+  while (*uuid_end != '\0' && !g_ascii_isspace(*uuid_end)) {
+    uuid_end++;
+  }
+  const char *name_end = name_pos;
+  while (*name_end != '\0' && *name_end != ' ' && *name_end != ',' && *name_end != ')') {
+    name_end++;
+  }
+  if (uuid_end == uuid_pos || name_end == name_pos) {
+    return FALSE;
+  }
+  g_autofree char *uuid = g_strndup(uuid_pos, (gsize)(uuid_end - uuid_pos));
+  g_autofree char *name = g_strndup(name_pos, (gsize)(name_end - name_pos));
+  pumpkin_player_index_learn(self->network_players, uuid, name);
+  return TRUE;
+}
+
+/* Runs for every member server, not only the selected one, so it only matches the four line shapes it needs.
+ * Expects the line with ANSI codes already stripped. */
+void
+network_players_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line)
+{
+  const char *id = member_id(self, server);
+  if (self->network_players == NULL || id == NULL || line == NULL) {
+    return;
+  }
+  gint64 now = (gint64)time(NULL);
+  if (g_strcmp0(line, "Server process exited") == 0) {
+    pumpkin_player_index_server_stopped(self->network_players, id, now);
+    refresh_network_players(self);
+    return;
+  }
+  if (strstr(line, "joined the game") == NULL && strstr(line, "left the game") == NULL &&
+      strstr(line, "logged in") == NULL && strstr(line, "UUID: ") == NULL) {
+    return;
+  }
+
+  if (note_uuid_line(self, line)) {
+    return;
+  }
+  g_autofree char *joined = extract_name_before_suffix(line, " joined the game");
+  if (joined == NULL && strstr(line, " logged in") != NULL) {
+    joined = extract_name_before_suffix(line, "[/");
+  }
+  if (joined != NULL) {
+    pumpkin_player_index_join(self->network_players, id, joined, now);
+    refresh_network_players(self);
+    return;
+  }
+  g_autofree char *left = extract_name_before_suffix(line, " left the game");
+  if (left != NULL) {
+    pumpkin_player_index_leave(self->network_players, id, left, now);
+    refresh_network_players(self);
+  }
+}
+
+static char *
+server_label(PumpkinWindow *self, const char *server_id)
+{
+  g_autoptr(PumpkinServer) server = find_server_by_id(self, server_id);
+  return g_strdup(server != NULL ? pumpkin_server_get_name(server) : server_id);
+}
+
+static char *
+describe_player(PumpkinWindow *self, ServerNetwork *network, const PumpkinPlayerIndexEntry *entry, gint64 now)
+{
+  g_autoptr(GString) online = g_string_new(NULL);
+  gint64 online_since = 0;
+  guint64 playtime = 0;
+  guint servers = 0;
+  const PumpkinPlayerIndexServer *last = NULL;
+  const PumpkinPlayerIndexServer *proxy = NULL;
+  for (guint i = 0; i < entry->servers->len; i++) {
+    const PumpkinPlayerIndexServer *record = &g_array_index(entry->servers, PumpkinPlayerIndexServer, i);
+    if (!network_has_member(network, record->server_id)) {
+      continue;
+    }
+    servers++;
+    playtime += pumpkin_player_index_server_playtime(record, now);
+    if (last == NULL || record->last_seen > last->last_seen) {
+      last = record;
+    }
+    if (record->online_since == 0) {
+      continue;
+    }
+    /* Behind a proxy the player shows up on the proxy and a backend; the backend is the useful answer. */
+    if (g_strcmp0(record->server_id, network->proxy_server_id) == 0) {
+      proxy = record;
+      continue;
+    }
+    g_autofree char *server_name = server_label(self, record->server_id);
+    g_string_append_printf(online, "%s%s", online->len > 0 ? ", " : "", server_name);
+    online_since = online_since > 0 ? MIN(online_since, record->online_since) : record->online_since;
+  }
+  if (online->len == 0 && proxy != NULL) {
+    g_autofree char *server_name = server_label(self, proxy->server_id);
+    g_string_append(online, server_name);
+    online_since = proxy->online_since;
+  }
+  const char *name = entry->name != NULL ? entry->name : entry->uuid;
+  if (servers == 0) {
+    return g_strdup_printf("%s has not played on this network.", name);
+  }
+  g_autofree char *total = format_duration(playtime);
+  if (online->len > 0) {
+    g_autofree char *since = format_unix_time(self, online_since);
+    return g_strdup_printf("%s is on %s since %s. %s played across %u server%s.", name, online->str, since, total,
+                           servers, servers == 1 ? "" : "s");
+  }
+  g_autofree char *where = server_label(self, last->server_id);
+  g_autofree char *seen = format_unix_time(self, last->last_seen);
+  return g_strdup_printf("%s is offline, last seen on %s at %s. %s played across %u server%s.", name, where, seen,
+                         total, servers, servers == 1 ? "" : "s");
+}
+
+void
+refresh_network_players(PumpkinWindow *self)
+{
+  if (self->network_details_players == NULL || self->network_players == NULL ||
+      self->network_details_network_id == NULL) {
+    return;
+  }
+  ServerNetwork *network = find_network_by_id(self, self->network_details_network_id);
+  if (network == NULL) {
+    return;
+  }
+  gint64 now = (gint64)time(NULL);
+  const char *query = self->network_details_player_search != NULL
+                        ? gtk_editable_get_text(GTK_EDITABLE(self->network_details_player_search))
+                        : NULL;
+  g_autofree char *text = NULL;
+  if (query != NULL && *query != '\0') {
+    const PumpkinPlayerIndexEntry *entry = pumpkin_player_index_find(self->network_players, query);
+    text = entry != NULL ? describe_player(self, network, entry, now)
+                         : g_strdup_printf("No player named \"%s\" has been seen on this network.", query);
+  } else {
+    PumpkinPlayerIndexTotals totals;
+    pumpkin_player_index_totals(self->network_players, network->member_server_ids, now, &totals);
+    g_autofree char *playtime = format_duration(totals.playtime_seconds);
+    text = g_strdup_printf("%u player%s seen · %u online · %s played across the network", totals.players,
+                           totals.players == 1 ? "" : "s", totals.online, playtime);
+  }
+  gtk_label_set_text(self->network_details_players, text);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "window-internal.h"
+
+void network_players_load(PumpkinWindow *self);
+void network_players_save(PumpkinWindow *self);
+void network_players_close(PumpkinWindow *self);
+void network_players_seed(PumpkinWindow *self, PumpkinServer *server);
+void network_players_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line);
+void refresh_network_players(PumpkinWindow *self);
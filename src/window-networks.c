@@ -137,6 +137,42 @@ network_includes_server(ServerNetwork *network, PumpkinServer *server)
   return FALSE;
 }
 
+void
+sync_server_cgroup_group(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL) {
+    return;
+  }
+  const char *group_id = NULL;
+  for (guint i = 0; self->networks != NULL && i < self->networks->len; i++) {
+    ServerNetwork *network = g_ptr_array_index(self->networks, i);
+    if (network != NULL && network_includes_server(network, server)) {
+      group_id = network->id;
+      break;
+    }
+  }
+  pumpkin_server_set_cgroup_group(server, group_id);
+}
+
+const char *
+network_proxy_for_server(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL) {
+    return NULL;
+  }
+  for (guint i = 0; self->networks != NULL && i < self->networks->len; i++) {
+    ServerNetwork *network = g_ptr_array_index(self->networks, i);
+    if (network == NULL || network->proxy_server_id == NULL || *network->proxy_server_id == '\0' ||
+        !network_includes_server(network, server)) {
+      continue;
+    }
+    if (g_strcmp0(network->proxy_server_id, pumpkin_server_get_id(server)) != 0) {
+      return network->proxy_server_id;
+    }
+  }
+  return NULL;
+}
+
 gboolean
 server_in_any_network(PumpkinWindow *self, const char *server_id)
 {
@@ -9,6 +9,8 @@ char *network_config_path(PumpkinWindow *self);
 ServerNetwork *find_network_by_id(PumpkinWindow *self, const char *id);
 gboolean network_has_member(ServerNetwork *network, const char *server_id);
 gboolean network_includes_server(ServerNetwork *network, PumpkinServer *server);
+void sync_server_cgroup_group(PumpkinWindow *self, PumpkinServer *server);
+const char *network_proxy_for_server(PumpkinWindow *self, PumpkinServer *server);
 gboolean server_in_any_network(PumpkinWindow *self, const char *server_id);
 void network_add_member(ServerNetwork *network, const char *server_id);
 void network_remove_member(ServerNetwork *network, const char *server_id);
@@ -1,4 +1,5 @@
 #include "window-parse.h"
+#include "cgroup.h"
 
 #include <limits.h>
 #include <stdlib.h>
@@ -152,3 +153,14 @@ pumpkin_parse_limit_entry(GtkEntry *entry, int max_value)
   }
   return value;
 }
+
+int
+pumpkin_parse_weight_entry(GtkEntry *entry)
+{
+  int value = 0;
+  gboolean has_value = FALSE;
+  if (entry == NULL || !pumpkin_parse_optional_positive_int(entry, &value, &has_value) || !has_value) {
+    return PUMPKIN_CGROUP_WEIGHT_DEFAULT;
+  }
+  return CLAMP(value, PUMPKIN_CGROUP_WEIGHT_MIN, PUMPKIN_CGROUP_WEIGHT_MAX);
+}
@@ -11,3 +11,4 @@ gboolean pumpkin_parse_optional_positive_int(GtkEntry *entry, int *out_value, gb
 gboolean pumpkin_parse_clock_time_text(const char *text, int *out_hour, int *out_minute);
 gboolean pumpkin_parse_clock_time_entry(GtkEntry *entry, int *out_hour, int *out_minute);
 int pumpkin_parse_limit_entry(GtkEntry *entry, int max_value);
+int pumpkin_parse_weight_entry(GtkEntry *entry);
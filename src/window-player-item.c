@@ -0,0 +1,78 @@
+#include "window-player-item.h"
+
+struct _PumpkinPlayerItem {
+  GObject parent_instance;
+  PlayerRowInfo *info;
+  guint position;
+};
+
+G_DEFINE_FINAL_TYPE(PumpkinPlayerItem, pumpkin_player_item, G_TYPE_OBJECT)
+
+void
+player_row_info_free(PlayerRowInfo *info)
+{
+  if (info == NULL) {
+    return;
+  }
+  pumpkin_intern_unref(info->key);
+  pumpkin_intern_unref(info->name);
+  pumpkin_intern_unref(info->uuid);
+  pumpkin_intern_unref(info->last_ip);
+  g_free(info->ban_reason);
+  g_free(info->ip_ban_reason);
+  g_free(info->reason_text);
+  g_free(info->sort_name);
+  g_free(info);
+}
+
+static void
+pumpkin_player_item_finalize(GObject *object)
+{
+  PumpkinPlayerItem *self = PUMPKIN_PLAYER_ITEM(object);
+  g_clear_pointer(&self->info, player_row_info_free);
+  G_OBJECT_CLASS(pumpkin_player_item_parent_class)->finalize(object);
+}
+
+static void
+pumpkin_player_item_class_init(PumpkinPlayerItemClass *class)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS(class);
+  object_class->finalize = pumpkin_player_item_finalize;
+}
+
+static void
+pumpkin_player_item_init(PumpkinPlayerItem *self)
+{
+  (void)self;
+}
+
+/* Item info is an immutable snapshot; a changed player gets a new item so the list view rebinds its row. */
+PumpkinPlayerItem *
+pumpkin_player_item_new(PlayerRowInfo *info)
+{
+  PumpkinPlayerItem *self = g_object_new(PUMPKIN_TYPE_PLAYER_ITEM, NULL);
+  self->info = info;
+  return self;
+}
+
+const PlayerRowInfo *
+pumpkin_player_item_get_info(PumpkinPlayerItem *self)
+{
+  g_return_val_if_fail(PUMPKIN_IS_PLAYER_ITEM(self), NULL);
+  return self->info;
+}
+
+/* Index in the unsorted store, kept by the window so a changed player is replaced without searching. */
+guint
+pumpkin_player_item_get_position(PumpkinPlayerItem *self)
+{
+  g_return_val_if_fail(PUMPKIN_IS_PLAYER_ITEM(self), 0);
+  return self->position;
+}
+
+void
+pumpkin_player_item_set_position(PumpkinPlayerItem *self, guint position)
+{
+  g_return_if_fail(PUMPKIN_IS_PLAYER_ITEM(self));
+  self->position = position;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "window-internal.h"
+
+G_BEGIN_DECLS
+
+/* Identity fields share the PlayerState atoms. */
+typedef struct {
+  const char *key;
+  const char *name;
+  const char *uuid;
+  const char *last_ip;
+  char *ban_reason;
+  char *ip_ban_reason;
+  char *reason_text;
+  char *sort_name;
+  PlayerPlatform platform;
+  gboolean online;
+  gboolean whitelisted;
+  gboolean banned;
+  gboolean ip_banned;
+  int op_level;
+  gint64 first_joined_unix;
+  gint64 last_online_unix;
+  guint64 playtime_seconds;
+  guint64 signature;
+} PlayerRowInfo;
+
+void player_row_info_free(PlayerRowInfo *info);
+
+#define PUMPKIN_TYPE_PLAYER_ITEM (pumpkin_player_item_get_type())
+G_DECLARE_FINAL_TYPE(PumpkinPlayerItem, pumpkin_player_item, PUMPKIN, PLAYER_ITEM, GObject)
+
+PumpkinPlayerItem *pumpkin_player_item_new(PlayerRowInfo *info);
+const PlayerRowInfo *pumpkin_player_item_get_info(PumpkinPlayerItem *self);
+guint pumpkin_player_item_get_position(PumpkinPlayerItem *self);
+void pumpkin_player_item_set_position(PumpkinPlayerItem *self, guint position);
+
+G_END_DECLS
@@ -0,0 +1,440 @@
+#include "window-player-journal.h"
+#include "window-players.h"
+
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * player-tracking.snapshot holds one PUT per tracked player plus the tombstones; player-tracking.journal
+ * holds what changed since. Records are [type u8][length u32][payload][checksum u32], little endian.
+ * Every record is absolute, so replaying a journal over a snapshot it was already folded into is harmless.
+ */
+#define JOURNAL_MAGIC "SMPKPTJ1"
+#define JOURNAL_MAGIC_LEN 8
+#define JOURNAL_COMPACT_MIN_BYTES (256 * 1024)
+
+typedef enum {
+  RECORD_PUT = 1,
+  RECORD_DROP,
+  RECORD_TOMBSTONE,
+  RECORD_UNTOMBSTONE
+} RecordType;
+
+struct _PlayerJournal {
+  char *snapshot_path;
+  char *journal_path;
+  GHashTable *saved;
+  GHashTable *deleted;
+  gsize snapshot_bytes;
+  gsize journal_bytes;
+  gboolean needs_compact;
+};
+
+typedef struct {
+  const guint8 *pos;
+  const guint8 *end;
+} RecordReader;
+
+void
+player_journal_free(PlayerJournal *journal)
+{
+  if (journal == NULL) {
+    return;
+  }
+  g_free(journal->snapshot_path);
+  g_free(journal->journal_path);
+  g_clear_pointer(&journal->saved, g_hash_table_unref);
+  g_clear_pointer(&journal->deleted, g_hash_table_unref);
+  g_free(journal);
+}
+
+static guint64
+fnv1a(const guint8 *data, gsize len, guint64 hash)
+{
+  for (gsize i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static guint32
+record_checksum(guint8 type, const guint8 *payload, gsize len)
+{
+  guint64 hash = fnv1a(&type, 1, 14695981039346656037ULL);
+  return (guint32)fnv1a(payload, len, hash);
+}
+
+static void
+put_u32(GByteArray *out, guint32 value)
+{
+  guint8 bytes[4] = { value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, (value >> 24) & 0xff };
+  g_byte_array_append(out, bytes, sizeof(bytes));
+}
+
+static void
+put_u64(GByteArray *out, guint64 value)
+{
+  put_u32(out, (guint32)value);
+  put_u32(out, (guint32)(value >> 32));
+}
+
+static void
+put_string(GByteArray *out, const char *text)
+{
+  guint32 len = text != NULL ? (guint32)strlen(text) : 0;
+  put_u32(out, len);
+  if (len > 0) {
+    g_byte_array_append(out, (const guint8 *)text, len);
+  }
+}
+
+static gboolean
+get_u32(RecordReader *reader, guint32 *out)
+{
+  if (reader->end - reader->pos < 4) {
+    return FALSE;
+  }
+  *out = (guint32)reader->pos[0] | ((guint32)reader->pos[1] << 8) | ((guint32)reader->pos[2] << 16) |
+         ((guint32)reader->pos[3] << 24);
+  reader->pos += 4;
+  return TRUE;
+}
+
+static gboolean
+get_u64(RecordReader *reader, guint64 *out)
+{
+  guint32 low = 0;
+  guint32 high = 0;
+  if (!get_u32(reader, &low) || !get_u32(reader, &high)) {
+    return FALSE;
+  }
+  *out = (guint64)low | ((guint64)high << 32);
+  return TRUE;
+}
+
+static gboolean
+get_string(RecordReader *reader, char **out)
+{
+  guint32 len = 0;
+  if (!get_u32(reader, &len) || (gsize)(reader->end - reader->pos) < len) {
+    return FALSE;
+  }
+  *out = len > 0 ? g_strndup((const char *)reader->pos, len) : NULL;
+  reader->pos += len;
+  return TRUE;
+}
+
+static gboolean
+get_atom(RecordReader *reader, const char **out)
+{
+  char *text = NULL;
+  if (!get_string(reader, &text)) {
+    return FALSE;
+  }
+  *out = pumpkin_intern_take(text);
+  return TRUE;
+}
+
+static void
+encode_state(GByteArray *out, const char *key, const PlayerState *state)
+{
+  put_string(out, key);
+  put_string(out, state->name);
+  put_string(out, state->uuid);
+  put_string(out, state->last_ip);
+  put_u32(out, (guint32)state->platform);
+  put_u64(out, (guint64)state->first_joined_unix);
+  put_u64(out, (guint64)state->last_online_unix);
+  put_u64(out, player_state_effective_playtime(state));
+}
+
+static PlayerState *
+decode_state(RecordReader *reader)
+{
+  PlayerState *state = g_new0(PlayerState, 1);
+  guint32 platform = 0;
+  guint64 first_joined = 0;
+  guint64 last_online = 0;
+  if (!get_atom(reader, &state->key) || !get_atom(reader, &state->name) ||
+      !get_atom(reader, &state->uuid) || !get_atom(reader, &state->last_ip) ||
+      !get_u32(reader, &platform) || !get_u64(reader, &first_joined) || !get_u64(reader, &last_online) ||
+      !get_u64(reader, &state->playtime_seconds) || state->key == NULL) {
+    player_state_free(state);
+    return NULL;
+  }
+  state->platform = platform <= PLAYER_PLATFORM_BEDROCK ? (PlayerPlatform)platform : PLAYER_PLATFORM_UNKNOWN;
+  state->first_joined_unix = (gint64)first_joined;
+  state->last_online_unix = (gint64)last_online;
+  return state;
+}
+
+static void
+append_record(GByteArray *out, RecordType type, GByteArray *payload)
+{
+  guint8 type_byte = (guint8)type;
+  g_byte_array_append(out, &type_byte, 1);
+  put_u32(out, payload->len);
+  g_byte_array_append(out, payload->data, payload->len);
+  put_u32(out, record_checksum(type_byte, payload->data, payload->len));
+}
+
+static void
+append_key_record(GByteArray *out, GByteArray *payload, RecordType type, const char *key)
+{
+  g_byte_array_set_size(payload, 0);
+  put_string(payload, key);
+  append_record(out, type, payload);
+}
+
+static void
+remember_saved(PlayerJournal *journal, const char *key, guint64 hash)
+{
+  guint64 *boxed = g_new(guint64, 1);
+  *boxed = hash;
+  g_hash_table_replace(journal->saved, g_strdup(key), boxed);
+}
+
+/* Returns FALSE when the file ends in a torn or corrupt record; everything before it has been applied. */
+static gboolean
+replay_file(const char *path, GHashTable *states, GHashTable *deleted, gsize *out_len)
+{
+  g_autofree char *contents = NULL;
+  gsize len = 0;
+  *out_len = 0;
+  if (!g_file_get_contents(path, &contents, &len, NULL)) {
+    return TRUE;
+  }
+  *out_len = len;
+  if (len < JOURNAL_MAGIC_LEN || memcmp(contents, JOURNAL_MAGIC, JOURNAL_MAGIC_LEN) != 0) {
+    return len == 0;
+  }
+
+  RecordReader reader = { (const guint8 *)contents + JOURNAL_MAGIC_LEN, (const guint8 *)contents + len };
+  while (reader.pos < reader.end) {
+    guint8 type = *reader.pos++;
+    guint32 payload_len = 0;
+    guint32 checksum = 0;
+    if (!get_u32(&reader, &payload_len) || (gsize)(reader.end - reader.pos) < (gsize)payload_len + 4) {
+      return FALSE;
+    }
+    RecordReader payload = { reader.pos, reader.pos + payload_len };
+    reader.pos += payload_len;
+    get_u32(&reader, &checksum);
+    if (checksum != record_checksum(type, payload.pos, payload_len)) {
+      return FALSE;
+    }
+
+    if (type == RECORD_PUT) {
+      PlayerState *state = decode_state(&payload);
+      if (state != NULL) {
+        g_hash_table_replace(states, g_strdup(state->key), state);
+      }
+      continue;
+    }
+    g_autofree char *key = NULL;
+    if (!get_string(&payload, &key) || key == NULL) {
+      continue;
+    }
+    if (type == RECORD_DROP) {
+      g_hash_table_remove(states, key);
+    } else if (type == RECORD_TOMBSTONE) {
+      g_hash_table_add(deleted, g_steal_pointer(&key));
+    } else if (type == RECORD_UNTOMBSTONE) {
+      g_hash_table_remove(deleted, key);
+    }
+  }
+  return TRUE;
+}
+
+static PlayerJournal *
+journal_for_server(PumpkinWindow *self, PumpkinServer *server)
+{
+  g_autofree char *data_dir = server != NULL ? pumpkin_server_get_data_dir(server) : NULL;
+  if (data_dir == NULL) {
+    return NULL;
+  }
+  g_autofree char *snapshot_path = g_build_filename(data_dir, "player-tracking.snapshot", NULL);
+  if (self->player_journal != NULL && g_strcmp0(self->player_journal->snapshot_path, snapshot_path) == 0) {
+    return self->player_journal;
+  }
+
+  g_clear_pointer(&self->player_journal, player_journal_free);
+  PlayerJournal *journal = g_new0(PlayerJournal, 1);
+  journal->snapshot_path = g_steal_pointer(&snapshot_path);
+  journal->journal_path = g_build_filename(data_dir, "player-tracking.journal", NULL);
+  journal->saved = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  journal->deleted = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  journal->needs_compact = TRUE;
+  self->player_journal = journal;
+  return journal;
+}
+
+/* FALSE means there is nothing on disk yet, so the caller can fall back to player-tracking.ini. */
+gboolean
+player_journal_load(PumpkinWindow *self, PumpkinServer *server)
+{
+  g_clear_pointer(&self->player_journal, player_journal_free);
+  PlayerJournal *journal = journal_for_server(self, server);
+  if (journal == NULL || (!g_file_test(journal->snapshot_path, G_FILE_TEST_EXISTS) &&
+                          !g_file_test(journal->journal_path, G_FILE_TEST_EXISTS))) {
+    return FALSE;
+  }
+
+  g_autoptr(GHashTable) states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                                       (GDestroyNotify)player_state_free);
+  gboolean intact = replay_file(journal->snapshot_path, states, journal->deleted, &journal->snapshot_bytes);
+  intact = replay_file(journal->journal_path, states, journal->deleted, &journal->journal_bytes) && intact;
+  journal->needs_compact = !intact;
+
+  g_autoptr(GByteArray) payload = g_byte_array_new();
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, states);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    PlayerState *state = value;
+    g_hash_table_iter_steal(&iter);
+    g_free(key);
+    g_byte_array_set_size(payload, 0);
+    encode_state(payload, state->key, state);
+    remember_saved(journal, state->key, fnv1a(payload->data, payload->len, 14695981039346656037ULL));
+    player_states_add_loaded(self, state);
+  }
+
+  g_hash_table_iter_init(&iter, journal->deleted);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    g_hash_table_add(self->deleted_player_keys, (gpointer)pumpkin_intern(key));
+  }
+  self->player_state_dirty = journal->needs_compact;
+  return TRUE;
+}
+
+static gboolean
+write_snapshot(PumpkinWindow *self, PlayerJournal *journal)
+{
+  g_autoptr(GByteArray) out = g_byte_array_new();
+  g_autoptr(GByteArray) payload = g_byte_array_new();
+  g_byte_array_append(out, (const guint8 *)JOURNAL_MAGIC, JOURNAL_MAGIC_LEN);
+
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->player_states);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    g_byte_array_set_size(payload, 0);
+    encode_state(payload, key, value);
+    append_record(out, RECORD_PUT, payload);
+  }
+  g_hash_table_iter_init(&iter, journal->deleted);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    append_key_record(out, payload, RECORD_TOMBSTONE, key);
+  }
+
+  g_autoptr(GError) error = NULL;
+  if (!g_file_set_contents(journal->snapshot_path, (const char *)out->data, (gssize)out->len, &error)) {
+    g_warning("Failed to write player snapshot: %s", error != NULL ? error->message : "unknown error");
+    return FALSE;
+  }
+  journal->snapshot_bytes = out->len;
+  /* Truncate rather than remove: a journal that survives would replay stale records over the new snapshot. */
+  if (!g_file_set_contents(journal->journal_path, JOURNAL_MAGIC, JOURNAL_MAGIC_LEN, &error)) {
+    g_warning("Failed to reset player journal: %s", error != NULL ? error->message : "unknown error");
+    if (g_remove(journal->journal_path) != 0 && g_file_test(journal->journal_path, G_FILE_TEST_EXISTS)) {
+      journal->needs_compact = TRUE;
+      return FALSE;
+    }
+    journal->journal_bytes = 0;
+  } else {
+    journal->journal_bytes = JOURNAL_MAGIC_LEN;
+  }
+  journal->needs_compact = FALSE;
+  return TRUE;
+}
+
+static gboolean
+append_journal(PlayerJournal *journal, GByteArray *records)
+{
+  FILE *fp = fopen(journal->journal_path, "ab");
+  if (fp == NULL) {
+    return FALSE;
+  }
+  gboolean ok = TRUE;
+  if (journal->journal_bytes == 0) {
+    ok = fwrite(JOURNAL_MAGIC, 1, JOURNAL_MAGIC_LEN, fp) == JOURNAL_MAGIC_LEN;
+    journal->journal_bytes = JOURNAL_MAGIC_LEN;
+  }
+  ok = ok && fwrite(records->data, 1, records->len, fp) == records->len;
+  ok = fclose(fp) == 0 && ok;
+  journal->journal_bytes += records->len;
+  return ok;
+}
+
+/*
+ * Diffs the in-memory players against what was last written and appends only the differences.
+ * Online players change every flush because their playtime grows; everyone else costs nothing.
+ */
+gboolean
+player_journal_save(PumpkinWindow *self, PumpkinServer *server)
+{
+  PlayerJournal *journal = journal_for_server(self, server);
+  if (journal == NULL || self->player_states == NULL) {
+    return FALSE;
+  }
+
+  g_autoptr(GByteArray) records = g_byte_array_new();
+  g_autoptr(GByteArray) payload = g_byte_array_new();
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->player_states);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    g_byte_array_set_size(payload, 0);
+    encode_state(payload, key, value);
+    guint64 hash = fnv1a(payload->data, payload->len, 14695981039346656037ULL);
+    guint64 *saved = g_hash_table_lookup(journal->saved, key);
+    if (saved == NULL || *saved != hash) {
+      append_record(records, RECORD_PUT, payload);
+      remember_saved(journal, key, hash);
+    }
+  }
+  g_hash_table_iter_init(&iter, journal->saved);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    if (!g_hash_table_contains(self->player_states, pumpkin_intern_peek(key))) {
+      append_key_record(records, payload, RECORD_DROP, key);
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+
+  if (self->deleted_player_keys != NULL) {
+    g_hash_table_iter_init(&iter, self->deleted_player_keys);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+      if (!g_hash_table_contains(journal->deleted, key)) {
+        append_key_record(records, payload, RECORD_TOMBSTONE, key);
+        g_hash_table_add(journal->deleted, g_strdup(key));
+      }
+    }
+    g_hash_table_iter_init(&iter, journal->deleted);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+      if (!g_hash_table_contains(self->deleted_player_keys, pumpkin_intern_peek(key))) {
+        append_key_record(records, payload, RECORD_UNTOMBSTONE, key);
+        g_hash_table_iter_remove(&iter);
+      }
+    }
+  }
+
+  if (journal->needs_compact ||
+      journal->journal_bytes + records->len > MAX((gsize)JOURNAL_COMPACT_MIN_BYTES, journal->snapshot_bytes)) {
+    return write_snapshot(self, journal);
+  }
+  if (records->len == 0) {
+    return TRUE;
+  }
+  if (!append_journal(journal, records)) {
+    g_warning("Failed to append to %s; rewriting the player snapshot instead", journal->journal_path);
+    journal->needs_compact = TRUE;
+    return write_snapshot(self, journal);
+  }
+  return TRUE;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "window-internal.h"
+
+void player_journal_free(PlayerJournal *journal);
+gboolean player_journal_load(PumpkinWindow *self, PumpkinServer *server);
+gboolean player_journal_save(PumpkinWindow *self, PumpkinServer *server);
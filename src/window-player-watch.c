@@ -0,0 +1,200 @@
+#include "window-player-watch.h"
+#include "window-player-data.h"
+
+static const char *player_data_names[PLAYER_DATA_COUNT] = {
+  "usercache.json",
+  "whitelist.json",
+  "ops.json",
+  "banned-players.json",
+  "banned-ips.json"
+};
+
+typedef struct {
+  gboolean dirty;
+  GPtrArray *entries;
+} PlayerDataCache;
+
+struct _PlayerWatch {
+  PumpkinWindow *self;
+  PumpkinServer *server;
+  GPtrArray *monitors;
+  gboolean active;
+  guint64 generation;
+  guint refresh_idle_id;
+  PlayerDataCache files[PLAYER_DATA_COUNT];
+};
+
+static void
+mark_all_dirty(PlayerWatch *watch)
+{
+  for (int i = 0; i < PLAYER_DATA_COUNT; i++) {
+    watch->files[i].dirty = TRUE;
+  }
+  watch->generation++;
+}
+
+static void
+player_watch_free(PlayerWatch *watch)
+{
+  if (watch == NULL) {
+    return;
+  }
+  if (watch->refresh_idle_id != 0) {
+    g_source_remove(watch->refresh_idle_id);
+  }
+  for (guint i = 0; watch->monitors != NULL && i < watch->monitors->len; i++) {
+    GFileMonitor *monitor = g_ptr_array_index(watch->monitors, i);
+    g_signal_handlers_disconnect_by_data(monitor, watch);
+    g_file_monitor_cancel(monitor);
+  }
+  g_clear_pointer(&watch->monitors, g_ptr_array_unref);
+  for (int i = 0; i < PLAYER_DATA_COUNT; i++) {
+    g_clear_pointer(&watch->files[i].entries, g_ptr_array_unref);
+  }
+  g_clear_object(&watch->server);
+  g_free(watch);
+}
+
+static gboolean
+refresh_idle_cb(gpointer data)
+{
+  PlayerWatch *watch = data;
+  watch->refresh_idle_id = 0;
+  if (watch->self->current == watch->server) {
+    refresh_player_list(watch->self);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+note_changed_name(PlayerWatch *watch, GFile *file)
+{
+  if (file == NULL) {
+    return FALSE;
+  }
+  g_autofree char *name = g_file_get_basename(file);
+  for (int i = 0; i < PLAYER_DATA_COUNT; i++) {
+    if (g_strcmp0(name, player_data_names[i]) == 0) {
+      watch->files[i].dirty = TRUE;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static void
+on_player_data_changed(GFileMonitor *monitor,
+                       GFile *file,
+                       GFile *other_file,
+                       GFileMonitorEvent event,
+                       gpointer user_data)
+{
+  PlayerWatch *watch = user_data;
+  if (event == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED || event == G_FILE_MONITOR_EVENT_PRE_UNMOUNT) {
+    return;
+  }
+  gboolean players_dir = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(monitor), "players-dir"));
+  gboolean relevant = note_changed_name(watch, file);
+  relevant = note_changed_name(watch, other_file) || relevant;
+  if (!relevant && !players_dir) {
+    return;
+  }
+  watch->generation++;
+  if (watch->refresh_idle_id == 0) {
+    watch->refresh_idle_id = g_idle_add(refresh_idle_cb, watch);
+  }
+}
+
+static gboolean
+add_monitor(PlayerWatch *watch, const char *path, gboolean players_dir)
+{
+  g_autoptr(GFile) dir = g_file_new_for_path(path);
+  g_autoptr(GError) error = NULL;
+  GFileMonitor *monitor = g_file_monitor_directory(dir, G_FILE_MONITOR_NONE, NULL, &error);
+  if (monitor == NULL) {
+    g_debug("Cannot watch %s: %s", path, error != NULL ? error->message : "unknown error");
+    return FALSE;
+  }
+  g_object_set_data(G_OBJECT(monitor), "players-dir", GINT_TO_POINTER(players_dir));
+  g_signal_connect(monitor, "changed", G_CALLBACK(on_player_data_changed), watch);
+  g_ptr_array_add(watch->monitors, monitor);
+  return TRUE;
+}
+
+/* The json files live in either the data dir or its data/ subdir, so both are watched. */
+void
+player_watch_set_server(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self->player_watch != NULL && self->player_watch->server == server) {
+    return;
+  }
+  g_clear_pointer(&self->player_watch, player_watch_free);
+  self->player_ingest_generation = 0;
+  self->player_lookup_generation = 0;
+  if (server == NULL) {
+    return;
+  }
+
+  PlayerWatch *watch = g_new0(PlayerWatch, 1);
+  watch->self = self;
+  watch->server = g_object_ref(server);
+  watch->monitors = g_ptr_array_new_with_free_func(g_object_unref);
+  mark_all_dirty(watch);
+
+  g_autofree char *data_dir = pumpkin_server_get_data_dir(server);
+  g_autofree char *data_subdir = g_build_filename(data_dir, "data", NULL);
+  g_autofree char *players_dir = pumpkin_server_get_players_dir(server);
+  g_autofree char *world_players = g_build_filename(data_dir, "world", "playerdata", NULL);
+  watch->active = add_monitor(watch, data_dir, FALSE) &&
+                  add_monitor(watch, data_subdir, FALSE) &&
+                  add_monitor(watch, players_dir, TRUE) &&
+                  add_monitor(watch, world_players, TRUE);
+  self->player_watch = watch;
+}
+
+void
+player_watch_invalidate(PumpkinWindow *self)
+{
+  if (self->player_watch != NULL) {
+    mark_all_dirty(self->player_watch);
+  }
+}
+
+/* Without working monitors every call counts as a change, which is the old rescan behaviour. */
+guint64
+player_watch_get_generation(PumpkinWindow *self)
+{
+  PlayerWatch *watch = self->player_watch;
+  if (watch == NULL) {
+    return 0;
+  }
+  if (!watch->active) {
+    mark_all_dirty(watch);
+  }
+  return watch->generation;
+}
+
+static PlayerDataCache *
+load_file(PumpkinWindow *self, PlayerDataFile file)
+{
+  PlayerWatch *watch = self->player_watch;
+  if (watch == NULL || file < 0 || file >= PLAYER_DATA_COUNT) {
+    return NULL;
+  }
+  PlayerDataCache *cache = &watch->files[file];
+  if (!cache->dirty) {
+    return cache;
+  }
+  cache->dirty = FALSE;
+  g_clear_pointer(&cache->entries, g_ptr_array_unref);
+  g_autofree char *path = resolve_data_file(watch->server, player_data_names[file]);
+  cache->entries = load_player_entries_from_file(path);
+  return cache;
+}
+
+GPtrArray *
+player_watch_get_entries(PumpkinWindow *self, PlayerDataFile file)
+{
+  PlayerDataCache *cache = load_file(self, file);
+  return cache != NULL ? cache->entries : NULL;
+}
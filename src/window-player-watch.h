@@ -0,0 +1,17 @@
+#pragma once
+
+#include "window-internal.h"
+
+typedef enum {
+  PLAYER_DATA_USERCACHE = 0,
+  PLAYER_DATA_WHITELIST,
+  PLAYER_DATA_OPS,
+  PLAYER_DATA_BANNED_PLAYERS,
+  PLAYER_DATA_BANNED_IPS,
+  PLAYER_DATA_COUNT
+} PlayerDataFile;
+
+void player_watch_set_server(PumpkinWindow *self, PumpkinServer *server);
+void player_watch_invalidate(PumpkinWindow *self);
+guint64 player_watch_get_generation(PumpkinWindow *self);
+GPtrArray *player_watch_get_entries(PumpkinWindow *self, PlayerDataFile file);
@@ -1,4 +1,6 @@
 #include "window-players.h"
+#include "window-player-journal.h"
+#include "window-sessions.h"
 
 #include <glib/gstdio.h>
 #include <time.h>
@@ -22,10 +24,10 @@ player_state_free(PlayerState *state)
   if (state == NULL) {
     return;
   }
-  g_clear_pointer(&state->key, g_free);
-  g_clear_pointer(&state->name, g_free);
-  g_clear_pointer(&state->uuid, g_free);
-  g_clear_pointer(&state->last_ip, g_free);
+  pumpkin_intern_unref(state->key);
+  pumpkin_intern_unref(state->name);
+  pumpkin_intern_unref(state->uuid);
+  pumpkin_intern_unref(state->last_ip);
   g_free(state);
 }
 
@@ -54,6 +56,19 @@ player_states_set_dirty(PumpkinWindow *self)
   self->player_state_dirty = TRUE;
 }
 
+/* Also queues the player's row for the next list refresh. */
+void
+player_state_changed(PumpkinWindow *self, const PlayerState *state)
+{
+  if (self == NULL) {
+    return;
+  }
+  if (state != NULL && state->key != NULL && self->player_list_dirty_keys != NULL) {
+    g_hash_table_add(self->player_list_dirty_keys, (gpointer)pumpkin_intern_ref(state->key));
+  }
+  player_states_set_dirty(self);
+}
+
 static void
 repoint_player_indexes(PumpkinWindow *self, PlayerState *from_state, PlayerState *to_state)
 {
@@ -94,25 +109,21 @@ merge_player_states(PumpkinWindow *self, PlayerState *dst, PlayerState *src)
   }
 
   if ((dst->name == NULL || dst->name[0] == '\0') && src->name != NULL && src->name[0] != '\0') {
-    g_free(dst->name);
-    dst->name = g_strdup(src->name);
+    pumpkin_intern_assign(&dst->name, src->name);
   }
   if ((dst->uuid == NULL || dst->uuid[0] == '\0') && src->uuid != NULL && src->uuid[0] != '\0') {
-    g_free(dst->uuid);
-    dst->uuid = g_strdup(src->uuid);
+    pumpkin_intern_assign(&dst->uuid, src->uuid);
   }
   if (dst->platform == PLAYER_PLATFORM_UNKNOWN && src->platform != PLAYER_PLATFORM_UNKNOWN) {
     dst->platform = src->platform;
   }
   if ((dst->last_ip == NULL || dst->last_ip[0] == '\0') &&
       src->last_ip != NULL && src->last_ip[0] != '\0') {
-    g_free(dst->last_ip);
-    dst->last_ip = g_strdup(src->last_ip);
+    pumpkin_intern_assign(&dst->last_ip, src->last_ip);
   } else if (src->last_ip != NULL && src->last_ip[0] != '\0' &&
              src->last_online_unix >= dst->last_online_unix &&
              g_strcmp0(dst->last_ip, src->last_ip) != 0) {
-    g_free(dst->last_ip);
-    dst->last_ip = g_strdup(src->last_ip);
+    pumpkin_intern_assign(&dst->last_ip, src->last_ip);
   }
   dst->ip_banned_hint = dst->ip_banned_hint || src->ip_banned_hint;
   if (dst->first_joined_unix <= 0 ||
@@ -137,10 +148,13 @@ merge_player_states(PumpkinWindow *self, PlayerState *dst, PlayerState *src)
   }
 
   repoint_player_indexes(self, src, dst);
+  pumpkin_search_index_remove(self->player_search_index, src->key);
+  player_search_index_update(self, dst);
+  player_state_changed(self, src);
+  player_state_changed(self, dst);
   if (self->player_states != NULL && src->key != NULL) {
     g_hash_table_remove(self->player_states, src->key);
   }
-  player_states_set_dirty(self);
 }
 
 void
@@ -155,16 +169,29 @@ allow_deleted_player_tracking(PumpkinWindow *self, const char *uuid, const char
   g_autofree char *name_key = normalized_key(name);
 
   if (uuid_key != NULL) {
-    changed = g_hash_table_remove(self->deleted_player_keys, uuid_key) || changed;
+    changed = g_hash_table_remove(self->deleted_player_keys, pumpkin_intern_peek(uuid_key)) || changed;
   }
   if (name_key != NULL) {
-    changed = g_hash_table_remove(self->deleted_player_keys, name_key) || changed;
+    changed = g_hash_table_remove(self->deleted_player_keys, pumpkin_intern_peek(name_key)) || changed;
   }
   if (changed) {
     player_states_set_dirty(self);
   }
 }
 
+/* Call after changing a player's name, uuid or last ip; unchanged players cost three normalizations. */
+void
+player_search_index_update(PumpkinWindow *self, const PlayerState *state)
+{
+  if (self == NULL || state == NULL || self->player_search_index == NULL) {
+    return;
+  }
+  g_autofree char *name_key = normalized_key(state->name);
+  g_autofree char *uuid_key = normalized_key(state->uuid);
+  g_autofree char *ip_key = normalized_key(state->last_ip);
+  pumpkin_search_index_set(self->player_search_index, state->key, name_key, uuid_key, ip_key);
+}
+
 PlayerState *
 ensure_player_state(PumpkinWindow *self, const char *uuid, const char *name, gboolean create)
 {
@@ -175,10 +202,10 @@ ensure_player_state(PumpkinWindow *self, const char *uuid, const char *name, gbo
   g_autofree char *uuid_key = normalized_key(uuid);
   g_autofree char *name_key = normalized_key(name);
   if (self->deleted_player_keys != NULL) {
-    if (uuid_key != NULL && g_hash_table_contains(self->deleted_player_keys, uuid_key)) {
+    if (uuid_key != NULL && g_hash_table_contains(self->deleted_player_keys, pumpkin_intern_peek(uuid_key))) {
       return NULL;
     }
-    if (name_key != NULL && g_hash_table_contains(self->deleted_player_keys, name_key)) {
+    if (name_key != NULL && g_hash_table_contains(self->deleted_player_keys, pumpkin_intern_peek(name_key))) {
       return NULL;
     }
   }
@@ -186,10 +213,10 @@ ensure_player_state(PumpkinWindow *self, const char *uuid, const char *name, gbo
   PlayerState *state_by_name = NULL;
 
   if (uuid_key != NULL && self->player_states_by_uuid != NULL) {
-    state_by_uuid = g_hash_table_lookup(self->player_states_by_uuid, uuid_key);
+    state_by_uuid = g_hash_table_lookup(self->player_states_by_uuid, pumpkin_intern_peek(uuid_key));
   }
   if (name_key != NULL && self->player_states_by_name != NULL) {
-    state_by_name = g_hash_table_lookup(self->player_states_by_name, name_key);
+    state_by_name = g_hash_table_lookup(self->player_states_by_name, pumpkin_intern_peek(name_key));
   }
 
   PlayerState *state = NULL;
@@ -206,35 +233,34 @@ ensure_player_state(PumpkinWindow *self, const char *uuid, const char *name, gbo
       return NULL;
     }
     state = g_new0(PlayerState, 1);
-    state->key = g_strdup(key);
-    g_hash_table_insert(self->player_states, g_strdup(key), state);
-    player_states_set_dirty(self);
+    state->key = pumpkin_intern(key);
+    g_hash_table_insert(self->player_states, (gpointer)pumpkin_intern_ref(state->key), state);
+    player_state_changed(self, state);
   } else {
     return NULL;
   }
 
   if (state != NULL && uuid != NULL && *uuid != '\0') {
     if (state->uuid == NULL || *state->uuid == '\0') {
-      g_free(state->uuid);
-      state->uuid = g_strdup(uuid);
-      player_states_set_dirty(self);
+      pumpkin_intern_assign(&state->uuid, uuid);
+      player_state_changed(self, state);
     }
     if (uuid_key != NULL && self->player_states_by_uuid != NULL) {
-      g_hash_table_replace(self->player_states_by_uuid, g_strdup(uuid_key), state);
+      g_hash_table_replace(self->player_states_by_uuid, (gpointer)pumpkin_intern(uuid_key), state);
     }
   }
 
   if (state != NULL && name != NULL && *name != '\0') {
     if (state->name == NULL || g_strcmp0(state->name, name) != 0) {
-      g_free(state->name);
-      state->name = g_strdup(name);
-      player_states_set_dirty(self);
+      pumpkin_intern_assign(&state->name, name);
+      player_state_changed(self, state);
     }
     if (name_key != NULL && self->player_states_by_name != NULL) {
-      g_hash_table_replace(self->player_states_by_name, g_strdup(name_key), state);
+      g_hash_table_replace(self->player_states_by_name, (gpointer)pumpkin_intern(name_key), state);
     }
   }
 
+  player_search_index_update(self, state);
   return state;
 }
 
@@ -254,6 +280,7 @@ player_state_mark_online(PumpkinWindow *self, PlayerState *state, PlayerPlatform
     if (state->first_joined_unix <= 0) {
       state->first_joined_unix = now_unix;
     }
+    sessions_note_online(self, state);
   }
   if (now_unix > state->last_online_unix) {
     state->last_online_unix = now_unix;
@@ -261,10 +288,10 @@ player_state_mark_online(PumpkinWindow *self, PlayerState *state, PlayerPlatform
   if (self->live_player_names != NULL) {
     const char *presence = state->name != NULL ? state->name : state->uuid;
     if (presence != NULL && *presence != '\0') {
-      g_hash_table_replace(self->live_player_names, g_strdup(presence), g_strdup(presence));
+      g_hash_table_add(self->live_player_names, (gpointer)pumpkin_intern_ref(presence));
     }
   }
-  player_states_set_dirty(self);
+  player_state_changed(self, state);
 }
 
 void
@@ -286,8 +313,9 @@ player_state_mark_offline(PumpkinWindow *self, PlayerState *state)
     if (now_unix > state->last_online_unix) {
       state->last_online_unix = now_unix;
     }
-    player_states_set_dirty(self);
+    player_state_changed(self, state);
   }
+  sessions_note_offline(self, state);
 
   if (self->live_player_names != NULL) {
     if (state->name != NULL) {
@@ -356,6 +384,7 @@ player_states_clear(PumpkinWindow *self)
   if (self->player_states_by_name != NULL) {
     g_hash_table_remove_all(self->player_states_by_name);
   }
+  pumpkin_search_index_clear(self->player_search_index);
   if (self->deleted_player_keys != NULL) {
     g_hash_table_remove_all(self->deleted_player_keys);
   }
@@ -363,6 +392,24 @@ player_states_clear(PumpkinWindow *self)
   invalidate_player_list_signature(self);
 }
 
+void
+player_states_add_loaded(PumpkinWindow *self, PlayerState *state)
+{
+  state->online = FALSE;
+  state->session_started_mono = 0;
+  g_hash_table_replace(self->player_states, (gpointer)pumpkin_intern_ref(state->key), state);
+
+  g_autofree char *uuid_key = normalized_key(state->uuid);
+  if (uuid_key != NULL) {
+    g_hash_table_replace(self->player_states_by_uuid, (gpointer)pumpkin_intern(uuid_key), state);
+  }
+  g_autofree char *name_key = normalized_key(state->name);
+  if (name_key != NULL) {
+    g_hash_table_replace(self->player_states_by_name, (gpointer)pumpkin_intern(name_key), state);
+  }
+  player_search_index_update(self, state);
+}
+
 void
 player_states_load(PumpkinWindow *self, PumpkinServer *server)
 {
@@ -373,6 +420,10 @@ player_states_load(PumpkinWindow *self, PumpkinServer *server)
   if (server == NULL) {
     return;
   }
+  if (player_journal_load(self, server)) {
+    invalidate_player_list_signature(self);
+    return;
+  }
 
   g_autofree char *path = player_tracking_file(server);
   if (path == NULL || !g_file_test(path, G_FILE_TEST_EXISTS)) {
@@ -396,7 +447,7 @@ player_states_load(PumpkinWindow *self, PumpkinServer *server)
       g_autofree char *stored = g_key_file_get_string(key_file, "__deleted", entry_key, NULL);
       g_autofree char *normalized = normalized_key(stored);
       if (normalized != NULL) {
-        g_hash_table_add(self->deleted_player_keys, g_strdup(normalized));
+        g_hash_table_add(self->deleted_player_keys, (gpointer)pumpkin_intern(normalized));
       }
     }
   }
@@ -413,10 +464,10 @@ player_states_load(PumpkinWindow *self, PumpkinServer *server)
     }
 
     PlayerState *state = g_new0(PlayerState, 1);
-    state->key = g_strdup(group);
-    state->name = g_key_file_get_string(key_file, group, "name", NULL);
-    state->uuid = g_key_file_get_string(key_file, group, "uuid", NULL);
-    state->last_ip = g_key_file_get_string(key_file, group, "last_ip", NULL);
+    state->key = pumpkin_intern(group);
+    state->name = pumpkin_intern_take(g_key_file_get_string(key_file, group, "name", NULL));
+    state->uuid = pumpkin_intern_take(g_key_file_get_string(key_file, group, "uuid", NULL));
+    state->last_ip = pumpkin_intern_take(g_key_file_get_string(key_file, group, "last_ip", NULL));
     state->platform = (PlayerPlatform)g_key_file_get_integer(key_file, group, "platform", NULL);
     if (state->platform < PLAYER_PLATFORM_UNKNOWN || state->platform > PLAYER_PLATFORM_BEDROCK) {
       state->platform = PLAYER_PLATFORM_UNKNOWN;
@@ -425,21 +476,10 @@ player_states_load(PumpkinWindow *self, PumpkinServer *server)
     state->last_online_unix = g_key_file_get_int64(key_file, group, "last_online_unix", NULL);
     gint64 saved_playtime = g_key_file_get_int64(key_file, group, "playtime_seconds", NULL);
     state->playtime_seconds = saved_playtime > 0 ? (guint64)saved_playtime : 0;
-    state->online = FALSE;
-    state->session_started_mono = 0;
-
-    g_hash_table_insert(self->player_states, g_strdup(group), state);
-
-    g_autofree char *uuid_key = normalized_key(state->uuid);
-    if (uuid_key != NULL) {
-      g_hash_table_replace(self->player_states_by_uuid, g_strdup(uuid_key), state);
-    }
-    g_autofree char *name_key = normalized_key(state->name);
-    if (name_key != NULL) {
-      g_hash_table_replace(self->player_states_by_name, g_strdup(name_key), state);
-    }
+    player_states_add_loaded(self, state);
   }
-  self->player_state_dirty = FALSE;
+  /* Migrates the old key file into the journal on the next flush. */
+  self->player_state_dirty = groups_len > 0;
   invalidate_player_list_signature(self);
 }
 
@@ -449,61 +489,8 @@ player_states_save(PumpkinWindow *self, PumpkinServer *server)
   if (self == NULL || server == NULL || self->player_states == NULL || !self->player_state_dirty) {
     return;
   }
-
-  g_autoptr(GKeyFile) key_file = g_key_file_new();
-  GHashTableIter iter;
-  gpointer key = NULL;
-  gpointer value = NULL;
-  g_hash_table_iter_init(&iter, self->player_states);
-  while (g_hash_table_iter_next(&iter, &key, &value)) {
-    const char *section = key;
-    PlayerState *state = value;
-    if (section == NULL || state == NULL) {
-      continue;
-    }
-    if (state->name != NULL) {
-      g_key_file_set_string(key_file, section, "name", state->name);
-    }
-    if (state->uuid != NULL) {
-      g_key_file_set_string(key_file, section, "uuid", state->uuid);
-    }
-    if (state->last_ip != NULL && *state->last_ip != '\0') {
-      g_key_file_set_string(key_file, section, "last_ip", state->last_ip);
-    }
-    g_key_file_set_integer(key_file, section, "platform", (int)state->platform);
-    g_key_file_set_int64(key_file, section, "first_joined_unix", state->first_joined_unix);
-    g_key_file_set_int64(key_file, section, "last_online_unix", state->last_online_unix);
-    g_key_file_set_int64(key_file, section, "playtime_seconds",
-                         (gint64)player_state_effective_playtime(state));
-  }
-
-  if (self->deleted_player_keys != NULL && g_hash_table_size(self->deleted_player_keys) > 0) {
-    GHashTableIter deleted_iter;
-    gpointer deleted_key = NULL;
-    gpointer deleted_value = NULL;
-    guint index = 0;
-    g_hash_table_iter_init(&deleted_iter, self->deleted_player_keys);
-    while (g_hash_table_iter_next(&deleted_iter, &deleted_key, &deleted_value)) {
-      const char *deleted_token = deleted_key;
-      if (deleted_token == NULL || *deleted_token == '\0') {
-        continue;
-      }
-      g_autofree char *entry_key = g_strdup_printf("k%u", index++);
-      g_key_file_set_string(key_file, "__deleted", entry_key, deleted_token);
-    }
-  }
-
-  gsize out_len = 0;
-  g_autofree char *serialized = g_key_file_to_data(key_file, &out_len, NULL);
-  if (serialized == NULL) {
-    return;
-  }
-
-  g_autofree char *path = player_tracking_file(server);
-  if (path == NULL) {
-    return;
-  }
-  if (g_file_set_contents(path, serialized, (gssize)out_len, NULL)) {
+  sessions_flush(self);
+  if (player_journal_save(self, server)) {
     self->player_state_dirty = FALSE;
     self->last_player_state_flush_at = g_get_monotonic_time();
   }
@@ -597,7 +584,7 @@ remember_platform_hint_for_ip(PumpkinWindow *self, const char *ip, PlayerPlatfor
   if (ip_key == NULL || *ip_key == '\0') {
     return;
   }
-  g_hash_table_replace(self->platform_hint_by_ip, g_strdup(ip_key), GINT_TO_POINTER((int)platform));
+  g_hash_table_replace(self->platform_hint_by_ip, (gpointer)pumpkin_intern(ip_key), GINT_TO_POINTER((int)platform));
 }
 
 PlayerPlatform
@@ -610,7 +597,7 @@ platform_hint_for_ip(PumpkinWindow *self, const char *ip)
   if (ip_key == NULL || *ip_key == '\0') {
     return PLAYER_PLATFORM_UNKNOWN;
   }
-  gpointer raw = g_hash_table_lookup(self->platform_hint_by_ip, ip_key);
+  gpointer raw = g_hash_table_lookup(self->platform_hint_by_ip, pumpkin_intern_peek(ip_key));
   int value = GPOINTER_TO_INT(raw);
   if (value < PLAYER_PLATFORM_UNKNOWN || value > PLAYER_PLATFORM_BEDROCK) {
     return PLAYER_PLATFORM_UNKNOWN;
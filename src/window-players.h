@@ -5,6 +5,8 @@
 void player_state_free(PlayerState *state);
 guint64 player_state_effective_playtime(const PlayerState *state);
 void player_states_set_dirty(PumpkinWindow *self);
+void player_state_changed(PumpkinWindow *self, const PlayerState *state);
+void player_search_index_update(PumpkinWindow *self, const PlayerState *state);
 void allow_deleted_player_tracking(PumpkinWindow *self, const char *uuid, const char *name);
 PlayerState *ensure_player_state(PumpkinWindow *self, const char *uuid, const char *name, gboolean create);
 void player_state_mark_online(PumpkinWindow *self, PlayerState *state, PlayerPlatform platform_hint);
@@ -12,6 +14,7 @@ void player_state_mark_offline(PumpkinWindow *self, PlayerState *state);
 void player_states_mark_all_offline(PumpkinWindow *self);
 int player_online_count(PumpkinWindow *self);
 void player_states_clear(PumpkinWindow *self);
+void player_states_add_loaded(PumpkinWindow *self, PlayerState *state);
 void player_states_load(PumpkinWindow *self, PumpkinServer *server);
 void player_states_save(PumpkinWindow *self, PumpkinServer *server);
 PlayerPlatform platform_from_line(const char *line);
@@ -145,6 +145,12 @@ parse_slp_players_json(const char *json, int *out_players, int *out_max_players)
 
 gboolean
 pumpkin_query_minecraft_players(const char *host, int port, int *out_players, int *out_max_players)
+{
+  return pumpkin_query_minecraft_status(host, port, out_players, out_max_players, NULL);
+}
+
+gboolean
+pumpkin_query_minecraft_status(const char *host, int port, int *out_players, int *out_max_players, char **out_json)
 {
   if (host == NULL || port <= 0 || out_players == NULL || out_max_players == NULL) {
     return FALSE;
@@ -231,7 +237,13 @@ pumpkin_query_minecraft_players(const char *host, int port, int *out_players, in
   }
 
   g_autofree char *json = g_strndup((const char *)(packet_data + offset), (gsize)json_len);
-  return parse_slp_players_json(json, out_players, out_max_players);
+  if (!parse_slp_players_json(json, out_players, out_max_players)) {
+    return FALSE;
+  }
+  if (out_json != NULL) {
+    *out_json = g_steal_pointer(&json);
+  }
+  return TRUE;
 }
 
 gboolean
@@ -282,6 +294,20 @@ pumpkin_parse_player_list_snapshot_line(const char *line, int *out_count, char *
   return TRUE;
 }
 
+/* Matches vanilla-style "Preparing spawn area" completion as well as Pumpkin's world load messages. */
+gboolean
+pumpkin_is_world_load_line(const char *line)
+{
+  if (line == NULL) {
+    return FALSE;
+  }
+  g_autofree char *lower = g_ascii_strdown(line, -1);
+  if (strstr(lower, "world") == NULL && strstr(lower, "spawn area") == NULL) {
+    return FALSE;
+  }
+  return strstr(lower, "loaded") != NULL || strstr(lower, "generated") != NULL || strstr(lower, "100%") != NULL;
+}
+
 gboolean
 pumpkin_parse_tps_from_line(const char *line, double *out)
 {
@@ -324,3 +350,450 @@ pumpkin_parse_tps_from_line(const char *line, double *out)
   *out = value;
   return TRUE;
 }
+
+#define WAKE_LISTENER_IO_TIMEOUT_SECONDS 10
+#define WAKE_LISTENER_MAX_THREADS 4
+#define WAKE_LISTENER_START_TIMEOUT_USEC (120 * G_USEC_PER_SEC)
+#define WAKE_LISTENER_CONNECT_TIMEOUT_USEC (15 * G_USEC_PER_SEC)
+#define WAKE_LISTENER_CONNECT_RETRY_USEC (250 * 1000)
+
+struct _PumpkinWakeListener {
+  gint ref_count;
+  GSocketService *service;
+  int port;
+  gboolean proxy_protocol;
+  GHashTable *banned_ips;
+  char *status_json;
+  GMutex lock;
+  GCond released_cond;
+  int released;
+  PumpkinWakeCallback callback;
+  gpointer user_data;
+  gint woken;
+  gint closed;
+  gint active;
+};
+
+typedef struct {
+  guint32 id;
+  GByteArray *raw;
+  guint8 *payload;
+  gsize length;
+} SlpPacket;
+
+static void
+slp_packet_clear(SlpPacket *packet)
+{
+  g_clear_pointer(&packet->raw, g_byte_array_unref);
+  g_clear_pointer(&packet->payload, g_free);
+}
+
+/* Keeps the exact bytes read so a ping can be echoed back and a login replayed to the real server. */
+static gboolean
+slp_read_packet(GInputStream *stream, SlpPacket *packet)
+{
+  memset(packet, 0, sizeof(*packet));
+  guint32 length = 0;
+  if (!slp_read_varint_stream(stream, &length) || length == 0 || length > 32768) {
+    return FALSE;
+  }
+  packet->payload = g_malloc0(length);
+  if (!slp_read_exact(stream, packet->payload, length)) {
+    slp_packet_clear(packet);
+    return FALSE;
+  }
+  packet->length = length;
+  packet->raw = g_byte_array_new();
+  slp_varint_append(packet->raw, length);
+  g_byte_array_append(packet->raw, packet->payload, length);
+  gsize offset = 0;
+  if (!slp_read_varint_buffer(packet->payload, length, &offset, &packet->id)) {
+    slp_packet_clear(packet);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/* Status responses and login disconnects share the same shape: packet 0x00 carrying one JSON string. */
+static gboolean
+slp_write_json(GOutputStream *output, const char *json)
+{
+  g_autoptr(GByteArray) payload = g_byte_array_new();
+  slp_varint_append(payload, 0x00);
+  slp_varint_append(payload, (guint32)strlen(json));
+  g_byte_array_append(payload, (const guint8 *)json, strlen(json));
+  g_autoptr(GByteArray) packet = g_byte_array_new();
+  slp_varint_append(packet, payload->len);
+  g_byte_array_append(packet, payload->data, payload->len);
+  gsize written = 0;
+  return g_output_stream_write_all(output, packet->data, packet->len, &written, NULL, NULL) &&
+         written == packet->len;
+}
+
+PumpkinWakeListener *
+pumpkin_wake_listener_ref(PumpkinWakeListener *self)
+{
+  g_atomic_int_inc(&self->ref_count);
+  return self;
+}
+
+void
+pumpkin_wake_listener_unref(PumpkinWakeListener *self)
+{
+  if (self == NULL || !g_atomic_int_dec_and_test(&self->ref_count)) {
+    return;
+  }
+  g_clear_object(&self->service);
+  g_clear_pointer(&self->banned_ips, g_hash_table_unref);
+  g_mutex_clear(&self->lock);
+  g_cond_clear(&self->released_cond);
+  g_free(self->status_json);
+  g_free(self);
+}
+
+/* Main context only: GSocketListener is not thread-safe. */
+static void
+wake_listener_close(PumpkinWakeListener *self)
+{
+  if (g_atomic_int_get(&self->closed)) {
+    return;
+  }
+  g_socket_service_stop(self->service);
+  g_socket_listener_close(G_SOCKET_LISTENER(self->service));
+  g_atomic_int_set(&self->closed, 1);
+}
+
+static gboolean
+wake_listener_dispatch(gpointer data)
+{
+  PumpkinWakeListener *self = data;
+  wake_listener_close(self);
+  g_mutex_lock(&self->lock);
+  PumpkinWakeCallback callback = self->callback;
+  gpointer user_data = self->user_data;
+  self->callback = NULL;
+  g_mutex_unlock(&self->lock);
+  if (callback != NULL) {
+    callback(user_data);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+static void
+wake_splice_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  gboolean *done = user_data;
+  g_io_stream_splice_finish(res, NULL);
+  *done = TRUE;
+}
+
+/* Blocks until the server printed its ready line, failed to start, or never came up. */
+static gboolean
+wake_wait_released(PumpkinWakeListener *self)
+{
+  gint64 deadline = g_get_monotonic_time() + WAKE_LISTENER_START_TIMEOUT_USEC;
+  g_mutex_lock(&self->lock);
+  while (self->released == 0) {
+    if (!g_cond_wait_until(&self->released_cond, &self->lock, deadline)) {
+      break;
+    }
+  }
+  gboolean ready = self->released > 0;
+  g_mutex_unlock(&self->lock);
+  return ready;
+}
+
+/* The ready line can be printed just before the port is bound, so retry briefly. */
+static GSocketConnection *
+wake_connect_upstream(PumpkinWakeListener *self)
+{
+  gint64 deadline = g_get_monotonic_time() + WAKE_LISTENER_CONNECT_TIMEOUT_USEC;
+  g_autoptr(GSocketClient) client = g_socket_client_new();
+  g_socket_client_set_timeout(client, 1);
+  while (g_get_monotonic_time() < deadline) {
+    GSocketConnection *upstream = g_socket_client_connect_to_host(client, "127.0.0.1", self->port, NULL, NULL);
+    if (upstream != NULL) {
+      return upstream;
+    }
+    g_usleep(WAKE_LISTENER_CONNECT_RETRY_USEC);
+  }
+  return NULL;
+}
+
+static char *
+wake_client_ip(GSocketConnection *connection)
+{
+  g_autoptr(GSocketAddress) remote = g_socket_connection_get_remote_address(connection, NULL);
+  if (remote == NULL || !G_IS_INET_SOCKET_ADDRESS(remote)) {
+    return NULL;
+  }
+  g_autofree char *text =
+    g_inet_address_to_string(g_inet_socket_address_get_address(G_INET_SOCKET_ADDRESS(remote)));
+  if (text != NULL && g_str_has_prefix(text, "::ffff:") && strchr(text + 7, '.') != NULL) {
+    return g_strdup(text + 7);
+  }
+  return g_steal_pointer(&text);
+}
+
+/* PROXY protocol v1, so the server logs and bans by the player's address rather than 127.0.0.1. */
+static char *
+wake_proxy_header(GSocketConnection *connection)
+{
+  g_autoptr(GSocketAddress) remote = g_socket_connection_get_remote_address(connection, NULL);
+  g_autoptr(GSocketAddress) local = g_socket_connection_get_local_address(connection, NULL);
+  if (remote == NULL || local == NULL || !G_IS_INET_SOCKET_ADDRESS(remote) || !G_IS_INET_SOCKET_ADDRESS(local)) {
+    return g_strdup("PROXY UNKNOWN\r\n");
+  }
+  GInetAddress *source = g_inet_socket_address_get_address(G_INET_SOCKET_ADDRESS(remote));
+  GInetAddress *destination = g_inet_socket_address_get_address(G_INET_SOCKET_ADDRESS(local));
+  g_autofree char *source_text = g_inet_address_to_string(source);
+  g_autofree char *destination_text = g_inet_address_to_string(destination);
+  return g_strdup_printf("PROXY %s %s %s %u %u\r\n",
+                         g_inet_address_get_family(source) == G_SOCKET_FAMILY_IPV6 ? "TCP6" : "TCP4",
+                         source_text, destination_text,
+                         g_inet_socket_address_get_port(G_INET_SOCKET_ADDRESS(remote)),
+                         g_inet_socket_address_get_port(G_INET_SOCKET_ADDRESS(local)));
+}
+
+/* Relays on a private context so game traffic never runs on the UI thread. */
+static void
+wake_relay(GSocketConnection *connection, GSocketConnection *upstream)
+{
+  g_autoptr(GMainContext) context = g_main_context_new();
+  g_main_context_push_thread_default(context);
+  gboolean done = FALSE;
+  g_io_stream_splice_async(G_IO_STREAM(connection), G_IO_STREAM(upstream),
+                           G_IO_STREAM_SPLICE_CLOSE_STREAM1 | G_IO_STREAM_SPLICE_CLOSE_STREAM2,
+                           G_PRIORITY_DEFAULT, NULL, wake_splice_done, &done);
+  while (!done) {
+    g_main_context_iteration(context, TRUE);
+  }
+  g_main_context_pop_thread_default(context);
+}
+
+static char *
+wake_status_json(PumpkinWakeListener *self, guint32 protocol)
+{
+  if (self->status_json != NULL) {
+    return g_strdup(self->status_json);
+  }
+  return g_strdup_printf("{\"version\":{\"name\":\"Pumpkin\",\"protocol\":%u},"
+                         "\"players\":{\"max\":0,\"online\":0},"
+                         "\"description\":{\"text\":\"Sleeping, join to wake the server\"}}",
+                         protocol);
+}
+
+static void
+wake_listener_serve(PumpkinWakeListener *self, GSocketConnection *connection)
+{
+  GSocket *socket = g_socket_connection_get_socket(connection);
+  g_socket_set_timeout(socket, WAKE_LISTENER_IO_TIMEOUT_SECONDS);
+  GInputStream *input = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+  GOutputStream *output = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+
+  SlpPacket handshake;
+  if (!slp_read_packet(input, &handshake)) {
+    return;
+  }
+  gsize offset = 0;
+  guint32 id = 0;
+  guint32 protocol = 0;
+  guint32 address_length = 0;
+  guint32 next_state = 0;
+  gboolean valid = slp_read_varint_buffer(handshake.payload, handshake.length, &offset, &id) &&
+                   id == 0x00 &&
+                   slp_read_varint_buffer(handshake.payload, handshake.length, &offset, &protocol) &&
+                   slp_read_varint_buffer(handshake.payload, handshake.length, &offset, &address_length) &&
+                   offset + address_length + 2 <= handshake.length;
+  if (valid) {
+    offset += address_length + 2;
+    valid = slp_read_varint_buffer(handshake.payload, handshake.length, &offset, &next_state);
+  }
+  if (!valid) {
+    slp_packet_clear(&handshake);
+    return;
+  }
+
+  if (next_state == 1) {
+    slp_packet_clear(&handshake);
+    SlpPacket packet;
+    while (slp_read_packet(input, &packet)) {
+      gboolean ok = TRUE;
+      if (packet.id == 0x00) {
+        g_autofree char *json = wake_status_json(self, protocol);
+        ok = slp_write_json(output, json);
+      } else if (packet.id == 0x01) {
+        gsize written = 0;
+        g_output_stream_write_all(output, packet.raw->data, packet.raw->len, &written, NULL, NULL);
+        ok = FALSE;
+      }
+      slp_packet_clear(&packet);
+      if (!ok) {
+        break;
+      }
+    }
+    return;
+  }
+
+  if (g_atomic_int_compare_and_exchange(&self->woken, 0, 1)) {
+    g_main_context_invoke_full(NULL, G_PRIORITY_DEFAULT, wake_listener_dispatch,
+                               pumpkin_wake_listener_ref(self),
+                               (GDestroyNotify)pumpkin_wake_listener_unref);
+  }
+  /* Without a PROXY header the server only sees 127.0.0.1, so IP bans are enforced here instead. */
+  g_autofree char *client_ip = wake_client_ip(connection);
+  if (!self->proxy_protocol && client_ip != NULL && self->banned_ips != NULL &&
+      g_hash_table_contains(self->banned_ips, client_ip)) {
+    SlpPacket login_start;
+    if (slp_read_packet(input, &login_start)) {
+      slp_packet_clear(&login_start);
+    }
+    slp_write_json(output, "{\"text\":\"Your IP address is banned from this server.\"}");
+    slp_packet_clear(&handshake);
+    return;
+  }
+
+  /* Clients wait for the login response, so hold the socket while the server boots. */
+  g_socket_set_timeout(socket, 0);
+  GSocketConnection *upstream = wake_wait_released(self) ? wake_connect_upstream(self) : NULL;
+  if (upstream == NULL) {
+    slp_packet_clear(&handshake);
+    g_io_stream_close(G_IO_STREAM(connection), NULL, NULL);
+    return;
+  }
+  GOutputStream *upstream_output = g_io_stream_get_output_stream(G_IO_STREAM(upstream));
+  g_autofree char *proxy_header = self->proxy_protocol ? wake_proxy_header(connection) : NULL;
+  gsize written = 0;
+  gboolean ok = proxy_header == NULL ||
+                g_output_stream_write_all(upstream_output, proxy_header, strlen(proxy_header), &written, NULL, NULL);
+  ok = ok && g_output_stream_write_all(upstream_output, handshake.raw->data, handshake.raw->len, &written, NULL, NULL);
+  slp_packet_clear(&handshake);
+  if (ok) {
+    wake_relay(connection, upstream);
+  }
+  g_io_stream_close(G_IO_STREAM(upstream), NULL, NULL);
+  g_object_unref(upstream);
+}
+
+static gboolean
+wake_listener_run(GThreadedSocketService *service,
+                  GSocketConnection *connection,
+                  GObject *source_object,
+                  gpointer user_data)
+{
+  (void)service;
+  (void)source_object;
+  PumpkinWakeListener *self = user_data;
+  wake_listener_serve(self, connection);
+  g_atomic_int_add(&self->active, -1);
+  return TRUE;
+}
+
+/* Runs on the main context before the thread pool; refusing here keeps slow clients from queueing up. */
+static gboolean
+wake_listener_incoming(GSocketService *service,
+                       GSocketConnection *connection,
+                       GObject *source_object,
+                       gpointer user_data)
+{
+  (void)service;
+  (void)source_object;
+  PumpkinWakeListener *self = user_data;
+  if (g_atomic_int_get(&self->active) >= WAKE_LISTENER_MAX_THREADS) {
+    g_io_stream_close(G_IO_STREAM(connection), NULL, NULL);
+    return TRUE;
+  }
+  g_atomic_int_inc(&self->active);
+  return FALSE;
+}
+
+static void
+wake_listener_closure_notify(gpointer data, GClosure *closure)
+{
+  (void)closure;
+  pumpkin_wake_listener_unref(data);
+}
+
+static char *
+wake_listener_sleeping_status(const char *json)
+{
+  if (json == NULL) {
+    return NULL;
+  }
+  g_autoptr(GRegex) online_re = g_regex_new("\"online\"\\s*:\\s*[0-9]+", 0, 0, NULL);
+  g_autoptr(GRegex) sample_re = g_regex_new(",?\\s*\"sample\"\\s*:\\s*\\[[^\\]]*\\]", 0, 0, NULL);
+  g_autofree char *offline = g_regex_replace_literal(online_re, json, -1, 0, "\"online\":0", 0, NULL);
+  if (offline == NULL) {
+    return NULL;
+  }
+  return g_regex_replace_literal(sample_re, offline, -1, 0, "", 0, NULL);
+}
+
+PumpkinWakeListener *
+pumpkin_wake_listener_new(int port,
+                          const char *status_json,
+                          gboolean proxy_protocol,
+                          GHashTable *banned_ips,
+                          PumpkinWakeCallback callback,
+                          gpointer user_data,
+                          GError **error)
+{
+  GSocketService *service = g_threaded_socket_service_new(WAKE_LISTENER_MAX_THREADS);
+  if (!g_socket_listener_add_inet_port(G_SOCKET_LISTENER(service), (guint16)port, NULL, error)) {
+    g_object_unref(service);
+    return NULL;
+  }
+  PumpkinWakeListener *self = g_new0(PumpkinWakeListener, 1);
+  self->ref_count = 1;
+  self->service = service;
+  self->port = port;
+  self->proxy_protocol = proxy_protocol;
+  self->banned_ips = banned_ips != NULL ? g_hash_table_ref(banned_ips) : NULL;
+  self->status_json = wake_listener_sleeping_status(status_json);
+  g_mutex_init(&self->lock);
+  g_cond_init(&self->released_cond);
+  self->callback = callback;
+  self->user_data = user_data;
+  /* The handler's reference keeps running connection threads safe; stop() drops it. */
+  g_signal_connect_data(service, "run", G_CALLBACK(wake_listener_run), pumpkin_wake_listener_ref(self),
+                        wake_listener_closure_notify, 0);
+  g_signal_connect(service, "incoming", G_CALLBACK(wake_listener_incoming), self);
+  g_socket_service_start(service);
+  return self;
+}
+
+void
+pumpkin_wake_listener_stop(PumpkinWakeListener *self)
+{
+  if (self == NULL) {
+    return;
+  }
+  g_mutex_lock(&self->lock);
+  self->callback = NULL;
+  self->user_data = NULL;
+  g_mutex_unlock(&self->lock);
+  wake_listener_close(self);
+  g_signal_handlers_disconnect_by_data(self->service, self);
+}
+
+/* Lets held logins through once the server is ready, or closes them when it did not come up. */
+void
+pumpkin_wake_listener_release(PumpkinWakeListener *self, gboolean ready)
+{
+  if (self == NULL) {
+    return;
+  }
+  g_mutex_lock(&self->lock);
+  if (self->released == 0) {
+    self->released = ready ? 1 : -1;
+  }
+  g_cond_broadcast(&self->released_cond);
+  g_mutex_unlock(&self->lock);
+}
+
+gboolean
+pumpkin_wake_listener_get_woken(PumpkinWakeListener *self)
+{
+  return self != NULL && g_atomic_int_get(&self->woken);
+}
@@ -4,6 +4,28 @@
 
 char *pumpkin_strip_ansi(const char *line);
 gboolean pumpkin_query_minecraft_players(const char *host, int port, int *out_players, int *out_max_players);
+gboolean pumpkin_query_minecraft_status(const char *host,
+                                        int port,
+                                        int *out_players,
+                                        int *out_max_players,
+                                        char **out_json);
 gboolean pumpkin_is_player_list_snapshot_line(const char *line);
 gboolean pumpkin_parse_player_list_snapshot_line(const char *line, int *out_count, char **out_names_csv);
+gboolean pumpkin_is_world_load_line(const char *line);
 gboolean pumpkin_parse_tps_from_line(const char *line, double *out);
+
+typedef struct _PumpkinWakeListener PumpkinWakeListener;
+typedef void (*PumpkinWakeCallback)(gpointer user_data);
+
+PumpkinWakeListener *pumpkin_wake_listener_new(int port,
+                                               const char *status_json,
+                                               gboolean proxy_protocol,
+                                               GHashTable *banned_ips,
+                                               PumpkinWakeCallback callback,
+                                               gpointer user_data,
+                                               GError **error);
+PumpkinWakeListener *pumpkin_wake_listener_ref(PumpkinWakeListener *self);
+void pumpkin_wake_listener_unref(PumpkinWakeListener *self);
+void pumpkin_wake_listener_stop(PumpkinWakeListener *self);
+void pumpkin_wake_listener_release(PumpkinWakeListener *self, gboolean ready);
+gboolean pumpkin_wake_listener_get_woken(PumpkinWakeListener *self);
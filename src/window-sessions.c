@@ -0,0 +1,220 @@
+#include "window-sessions.h"
+
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+  PumpkinSessionHistory *history;
+  GHashTable *online;
+} SessionTracker;
+
+void
+session_tracker_free(gpointer data)
+{
+  SessionTracker *tracker = data;
+  if (tracker == NULL) {
+    return;
+  }
+  pumpkin_session_history_end(tracker->history, (gint64)time(NULL));
+  g_autoptr(GError) error = NULL;
+  if (!pumpkin_session_history_flush(tracker->history, &error)) {
+    g_warning("Failed to save session aggregates: %s", error != NULL ? error->message : "unknown error");
+  }
+  pumpkin_session_history_free(tracker->history);
+  g_hash_table_unref(tracker->online);
+  g_free(tracker);
+}
+
+/*
+ * A server's watch starts the first time the app sees it and lasts until the window closes, so switching
+ * servers does not break it. Players the window already knows are online are carried into the opening record.
+ */
+static SessionTracker *
+lookup_tracker(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+  if (self->session_trackers == NULL || id == NULL) {
+    return NULL;
+  }
+  SessionTracker *tracker = g_hash_table_lookup(self->session_trackers, id);
+  if (tracker != NULL) {
+    return tracker;
+  }
+  g_autofree char *data_dir = pumpkin_server_get_data_dir(server);
+  if (data_dir == NULL) {
+    return NULL;
+  }
+  tracker = g_new0(SessionTracker, 1);
+  tracker->history = pumpkin_session_history_open(data_dir);
+  tracker->online = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  if (server == self->current && self->live_player_names != NULL) {
+    GHashTableIter iter;
+    gpointer key = NULL;
+    g_hash_table_iter_init(&iter, self->live_player_names);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+      char *name_key = normalized_key(key);
+      if (name_key != NULL) {
+        g_hash_table_add(tracker->online, name_key);
+      }
+    }
+  }
+  pumpkin_session_history_begin(tracker->history, (gint64)time(NULL), g_hash_table_size(tracker->online));
+  g_hash_table_replace(self->session_trackers, g_strdup(id), tracker);
+  return tracker;
+}
+
+static void
+tracker_join(SessionTracker *tracker, const char *name, gint64 at)
+{
+  char *name_key = normalized_key(name);
+  if (name_key == NULL) {
+    return;
+  }
+  if (g_hash_table_add(tracker->online, name_key)) {
+    pumpkin_session_history_join(tracker->history, at, name_key);
+  }
+}
+
+static gboolean
+tracker_leave(SessionTracker *tracker, const char *name, gint64 at)
+{
+  g_autofree char *name_key = normalized_key(name);
+  if (name_key == NULL || !g_hash_table_remove(tracker->online, name_key)) {
+    return FALSE;
+  }
+  pumpkin_session_history_leave(tracker->history, at, name_key);
+  return TRUE;
+}
+
+void
+sessions_open(PumpkinWindow *self, PumpkinServer *server)
+{
+  lookup_tracker(self, server);
+  refresh_session_stats(self);
+}
+
+void
+sessions_close(PumpkinWindow *self)
+{
+  g_clear_pointer(&self->session_trackers, g_hash_table_unref);
+}
+
+/* Runs for every server's log, not just the selected one, so unselected servers are still recorded. */
+void
+sessions_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line)
+{
+  if (line == NULL) {
+    return;
+  }
+  gboolean exited = g_strcmp0(line, "Server process exited") == 0;
+  if (!exited && strstr(line, " the game") == NULL) {
+    return;
+  }
+  g_autofree char *joined = exited ? NULL : extract_name_before_suffix(line, " joined the game");
+  g_autofree char *left = exited || joined != NULL ? NULL : extract_name_before_suffix(line, " left the game");
+  if (!exited && joined == NULL && left == NULL) {
+    return;
+  }
+  SessionTracker *tracker = lookup_tracker(self, server);
+  if (tracker == NULL) {
+    return;
+  }
+
+  gint64 now = (gint64)time(NULL);
+  if (exited) {
+    GHashTableIter iter;
+    gpointer key = NULL;
+    g_hash_table_iter_init(&iter, tracker->online);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+      pumpkin_session_history_leave(tracker->history, now, key);
+      g_hash_table_iter_remove(&iter);
+    }
+  } else if (joined != NULL) {
+    tracker_join(tracker, joined, now);
+  } else {
+    tracker_leave(tracker, left, now);
+  }
+  if (server == self->current) {
+    refresh_session_stats(self);
+  }
+}
+
+/* Players first seen through a list snapshot joined before the app was watching; count them from now. */
+void
+sessions_note_online(PumpkinWindow *self, const PlayerState *state)
+{
+  SessionTracker *tracker = lookup_tracker(self, self->current);
+  if (tracker == NULL || state == NULL || state->name == NULL) {
+    return;
+  }
+  guint before = g_hash_table_size(tracker->online);
+  tracker_join(tracker, state->name, (gint64)time(NULL));
+  if (g_hash_table_size(tracker->online) != before) {
+    refresh_session_stats(self);
+  }
+}
+
+/* Closes sessions that ended without a "left the game" line, such as snapshot diffs and kicks. */
+void
+sessions_note_offline(PumpkinWindow *self, const PlayerState *state)
+{
+  SessionTracker *tracker = lookup_tracker(self, self->current);
+  if (tracker == NULL || state == NULL || state->name == NULL) {
+    return;
+  }
+  if (tracker_leave(tracker, state->name, (gint64)time(NULL))) {
+    refresh_session_stats(self);
+  }
+}
+
+void
+sessions_flush(PumpkinWindow *self)
+{
+  if (self->session_trackers == NULL) {
+    return;
+  }
+  GHashTableIter iter;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->session_trackers);
+  while (g_hash_table_iter_next(&iter, NULL, &value)) {
+    SessionTracker *tracker = value;
+    g_autoptr(GError) error = NULL;
+    if (!pumpkin_session_history_flush(tracker->history, &error)) {
+      g_warning("Failed to save session aggregates: %s", error != NULL ? error->message : "unknown error");
+    }
+  }
+}
+
+PumpkinSessionHistory *
+sessions_current_history(PumpkinWindow *self)
+{
+  const char *id = self->current != NULL ? pumpkin_server_get_id(self->current) : NULL;
+  SessionTracker *tracker = self->session_trackers != NULL && id != NULL
+                              ? g_hash_table_lookup(self->session_trackers, id)
+                              : NULL;
+  return tracker != NULL ? tracker->history : NULL;
+}
+
+void
+refresh_session_stats(PumpkinWindow *self)
+{
+  if (self->stats_player_heatmap != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_player_heatmap));
+  }
+  if (self->stats_player_peaks == NULL) {
+    return;
+  }
+  PumpkinSessionPeaks peaks = { 0 };
+  PumpkinSessionHistory *history = sessions_current_history(self);
+  if (history != NULL) {
+    pumpkin_session_history_peaks(history, (gint64)time(NULL), SESSION_PEAK_WINDOW_DAYS, &peaks);
+  }
+  if (peaks.days == 0) {
+    gtk_label_set_text(self->stats_player_peaks, "No sessions recorded yet.");
+    return;
+  }
+  g_autofree char *text = g_strdup_printf("Daily peak over %u watched day%s: median %u, p95 %u, p99 %u, max %u players.",
+                                          peaks.days, peaks.days == 1 ? "" : "s", peaks.p50, peaks.p95,
+                                          peaks.p99, peaks.max);
+  gtk_label_set_text(self->stats_player_peaks, text);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "window-internal.h"
+
+void session_tracker_free(gpointer data);
+void sessions_open(PumpkinWindow *self, PumpkinServer *server);
+void sessions_close(PumpkinWindow *self);
+void sessions_note_line(PumpkinWindow *self, PumpkinServer *server, const char *line);
+void sessions_note_online(PumpkinWindow *self, const PlayerState *state);
+void sessions_note_offline(PumpkinWindow *self, const PlayerState *state);
+void sessions_flush(PumpkinWindow *self);
+PumpkinSessionHistory *sessions_current_history(PumpkinWindow *self);
+void refresh_session_stats(PumpkinWindow *self);
@@ -0,0 +1,239 @@
+#include "window-start-queue.h"
+#include "window-console.h"
+#include "window-lifecycle.h"
+
+typedef struct {
+  PumpkinServer *server;
+  StartQueueFunc start;
+  char *after_id;
+  gint64 queued_at;
+  gint64 started_at;
+} StartQueueItem;
+
+static void start_queue_pump(PumpkinWindow *self);
+
+void
+start_queue_item_free(gpointer data)
+{
+  StartQueueItem *item = data;
+  if (item == NULL) {
+    return;
+  }
+  g_clear_object(&item->server);
+  g_free(item->after_id);
+  g_free(item);
+}
+
+static StartQueueItem *
+find_item(PumpkinWindow *self, PumpkinServer *server, guint *out_index)
+{
+  if (self->start_queue == NULL || server == NULL) {
+    return NULL;
+  }
+  for (guint i = 0; i < self->start_queue->len; i++) {
+    StartQueueItem *item = g_ptr_array_index(self->start_queue, i);
+    if (item->server == server) {
+      if (out_index != NULL) {
+        *out_index = i;
+      }
+      return item;
+    }
+  }
+  return NULL;
+}
+
+static gboolean
+server_id_queued(PumpkinWindow *self, const char *server_id)
+{
+  for (guint i = 0; i < self->start_queue->len; i++) {
+    StartQueueItem *item = g_ptr_array_index(self->start_queue, i);
+    if (g_strcmp0(pumpkin_server_get_id(item->server), server_id) == 0) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/* Boots are CPU and disk heavy, so hold back the next one while the host is already stalling. */
+static gboolean
+host_too_busy(void)
+{
+  if (pumpkin_pressure_supported()) {
+    PumpkinPressure cpu = { 0 };
+    PumpkinPressure io = { 0 };
+    g_autofree char *cpu_path = pumpkin_pressure_path(NULL, PUMPKIN_PRESSURE_CPU);
+    g_autofree char *io_path = pumpkin_pressure_path(NULL, PUMPKIN_PRESSURE_IO);
+    return (pumpkin_pressure_read(cpu_path, &cpu) && cpu.some_avg10 >= START_ADMIT_CPU_PRESSURE) ||
+           (pumpkin_pressure_read(io_path, &io) && io.some_avg10 >= START_ADMIT_IO_PRESSURE);
+  }
+  g_autofree char *loadavg = NULL;
+  if (!g_file_get_contents("/proc/loadavg", &loadavg, NULL, NULL)) {
+    return FALSE;
+  }
+  return g_ascii_strtod(loadavg, NULL) >= (double)g_get_num_processors();
+}
+
+static void
+finish_item(PumpkinWindow *self, guint index, gboolean ready)
+{
+  if (!ready) {
+    self->start_batch_failed++;
+  }
+  g_ptr_array_remove_index(self->start_queue, index);
+  if (self->start_queue->len > 0) {
+    return;
+  }
+
+  double seconds = (double)(g_get_monotonic_time() - self->start_batch_began_at) / (double)G_USEC_PER_SEC;
+  guint ready_count = self->start_batch_total - self->start_batch_failed;
+  g_autofree char *message = NULL;
+  if (self->start_batch_timed_out > 0) {
+    message = g_strdup_printf("%u of %u queued servers ready after %.1f s, %u without a ready line.",
+                              ready_count, self->start_batch_total, seconds, self->start_batch_timed_out);
+  } else if (self->start_batch_failed > 0) {
+    message = g_strdup_printf("%u of %u queued servers ready after %.1f s.", ready_count, self->start_batch_total, seconds);
+  } else {
+    message = g_strdup_printf("All %u queued servers ready after %.1f s.", self->start_batch_total, seconds);
+  }
+  g_autofree char *line = g_strdup_printf("[SMPK] %s", message);
+  append_log(self, line);
+  set_details_status(self, message, 5);
+  self->start_batch_total = 0;
+  self->start_batch_failed = 0;
+  self->start_batch_timed_out = 0;
+  self->start_batch_began_at = 0;
+}
+
+static gboolean
+start_queue_tick(gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  start_queue_pump(self);
+  if (self->start_queue == NULL || self->start_queue->len == 0) {
+    self->start_queue_source_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+start_queue_pump(PumpkinWindow *self)
+{
+  if (self->start_queue == NULL) {
+    return;
+  }
+  gint64 now = g_get_monotonic_time();
+  guint booting = 0;
+  for (guint i = self->start_queue->len; i > 0; i--) {
+    StartQueueItem *item = g_ptr_array_index(self->start_queue, i - 1);
+    if (item->started_at == 0) {
+      continue;
+    }
+    /* Servers that never print a ready line must not hold their slot forever. */
+    if (now - item->started_at >= START_QUEUE_READY_TIMEOUT_USEC) {
+      append_log_for_server(self, item->server, "[SMPK] No ready line seen, releasing its start slot.");
+      self->start_batch_timed_out++;
+      finish_item(self, i - 1, FALSE);
+      continue;
+    }
+    booting++;
+  }
+
+  guint limit = self->config != NULL ? (guint)pumpkin_config_get_start_concurrency(self->config)
+                                     : PUMPKIN_START_CONCURRENCY_DEFAULT;
+  for (guint i = 0; i < self->start_queue->len;) {
+    StartQueueItem *item = g_ptr_array_index(self->start_queue, i);
+    if (item->started_at != 0 || (item->after_id != NULL && server_id_queued(self, item->after_id))) {
+      i++;
+      continue;
+    }
+    if (limit > 0 && booting >= limit) {
+      break;
+    }
+    if (booting > 0 && host_too_busy()) {
+      break;
+    }
+    if (server_is_running_ui(self, item->server) || !item->start(self, item->server)) {
+      finish_item(self, i, server_is_running_ui(self, item->server));
+      continue;
+    }
+    item->started_at = g_get_monotonic_time();
+    double waited = (double)(item->started_at - item->queued_at) / (double)G_USEC_PER_SEC;
+    if (waited >= 1.0) {
+      g_autofree char *message = g_strdup_printf("[SMPK] Admitted from the start queue after %.0f s.", waited);
+      append_log_for_server(self, item->server, message);
+    }
+    booting++;
+    i++;
+  }
+  queue_overview_refresh(self, FALSE);
+}
+
+void
+start_queue_enqueue(PumpkinWindow *self, PumpkinServer *server, StartQueueFunc start, const char *after_id)
+{
+  if (self == NULL || server == NULL || start == NULL || self->start_queue == NULL ||
+      find_item(self, server, NULL) != NULL) {
+    return;
+  }
+  StartQueueItem *item = g_new0(StartQueueItem, 1);
+  item->server = g_object_ref(server);
+  item->start = start;
+  item->after_id = after_id != NULL && *after_id != '\0' ? g_strdup(after_id) : NULL;
+  item->queued_at = g_get_monotonic_time();
+  if (self->start_queue->len == 0) {
+    self->start_batch_began_at = item->queued_at;
+  }
+  self->start_batch_total++;
+  g_ptr_array_add(self->start_queue, item);
+
+  start_queue_pump(self);
+  if (self->start_queue->len > 0 && self->start_queue_source_id == 0) {
+    self->start_queue_source_id = g_timeout_add_seconds(1, start_queue_tick, self);
+  }
+}
+
+void
+start_queue_server_ready(PumpkinWindow *self, PumpkinServer *server)
+{
+  guint index = 0;
+  StartQueueItem *item = find_item(self, server, &index);
+  if (item == NULL || item->started_at == 0) {
+    return;
+  }
+  double seconds = (double)(g_get_monotonic_time() - item->started_at) / (double)G_USEC_PER_SEC;
+  g_autofree char *message = g_strdup_printf("[SMPK] Ready %.1f s after start.", seconds);
+  append_log_for_server(self, server, message);
+  finish_item(self, index, TRUE);
+  start_queue_pump(self);
+}
+
+void
+start_queue_server_exited(PumpkinWindow *self, PumpkinServer *server)
+{
+  guint index = 0;
+  StartQueueItem *item = find_item(self, server, &index);
+  if (item == NULL || item->started_at == 0) {
+    return;
+  }
+  finish_item(self, index, FALSE);
+  start_queue_pump(self);
+}
+
+void
+start_queue_cancel(PumpkinWindow *self, PumpkinServer *server)
+{
+  guint index = 0;
+  StartQueueItem *item = find_item(self, server, &index);
+  if (item != NULL && item->started_at == 0) {
+    finish_item(self, index, FALSE);
+    start_queue_pump(self);
+  }
+}
+
+gboolean
+start_queue_is_waiting(PumpkinWindow *self, PumpkinServer *server)
+{
+  StartQueueItem *item = find_item(self, server, NULL);
+  return item != NULL && item->started_at == 0;
+}
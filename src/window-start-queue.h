@@ -0,0 +1,12 @@
+#pragma once
+
+#include "window-internal.h"
+
+typedef gboolean (*StartQueueFunc)(PumpkinWindow *self, PumpkinServer *server);
+
+void start_queue_item_free(gpointer data);
+void start_queue_enqueue(PumpkinWindow *self, PumpkinServer *server, StartQueueFunc start, const char *after_id);
+void start_queue_server_ready(PumpkinWindow *self, PumpkinServer *server);
+void start_queue_server_exited(PumpkinWindow *self, PumpkinServer *server);
+void start_queue_cancel(PumpkinWindow *self, PumpkinServer *server);
+gboolean start_queue_is_waiting(PumpkinWindow *self, PumpkinServer *server);
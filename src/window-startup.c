@@ -0,0 +1,221 @@
+#include "window-startup.h"
+#include "window-console.h"
+#include "window-protocol.h"
+
+typedef struct {
+  gint64 spawned_at;
+  gint64 ready_at;
+  gboolean ready;
+  gboolean rss_recorded;
+  PumpkinStartupRecord *record;
+} StartupRun;
+
+void
+startup_run_free(gpointer data)
+{
+  StartupRun *run = data;
+  if (run == NULL) {
+    return;
+  }
+  pumpkin_startup_record_free(run->record);
+  g_free(run);
+}
+
+static char *
+history_path(PumpkinServer *server)
+{
+  const char *root = pumpkin_server_get_root_dir(server);
+  return root != NULL ? g_build_filename(root, "startup-history.tsv", NULL) : NULL;
+}
+
+/* The server stamps every spawn, including its own auto-restarts, so a changed stamp means a new run. */
+static StartupRun *
+lookup_run(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+  gint64 spawned_at = server != NULL ? pumpkin_server_get_started_at(server) : 0;
+  if (self->startup_runs == NULL || id == NULL || spawned_at <= 0 || !pumpkin_server_get_running(server)) {
+    return NULL;
+  }
+  StartupRun *run = g_hash_table_lookup(self->startup_runs, id);
+  if (run != NULL && run->spawned_at == spawned_at) {
+    return run;
+  }
+  run = g_new0(StartupRun, 1);
+  run->spawned_at = spawned_at;
+  run->record = pumpkin_startup_record_new(pumpkin_server_get_installed_build_id(server),
+                                           pumpkin_server_get_installed_build_label(server));
+  g_hash_table_replace(self->startup_runs, g_strdup(id), run);
+  return run;
+}
+
+static const char *
+build_title(const PumpkinStartupBuild *build)
+{
+  return build->build_label != NULL && *build->build_label != '\0' ? build->build_label : build->build_id;
+}
+
+/* Rewrites the run in place once its steady-state RSS arrives, so each start is one line. */
+static void
+save_run(PumpkinWindow *self, PumpkinServer *server, StartupRun *run)
+{
+  g_autofree char *path = history_path(server);
+  if (path == NULL) {
+    return;
+  }
+  g_autoptr(GPtrArray) records = pumpkin_startup_history_load(path);
+  PumpkinStartupRecord *existing = NULL;
+  for (guint i = records->len; i > 0 && existing == NULL; i--) {
+    PumpkinStartupRecord *record = g_ptr_array_index(records, i - 1);
+    if (record->started_at == run->record->started_at && g_strcmp0(record->build_id, run->record->build_id) == 0) {
+      existing = record;
+    }
+  }
+  if (existing != NULL) {
+    existing->ready_ms = run->record->ready_ms;
+    existing->world_ms = run->record->world_ms;
+    existing->steady_rss = run->record->steady_rss;
+  } else {
+    PumpkinStartupRecord *copy = pumpkin_startup_record_new(run->record->build_id, run->record->build_label);
+    copy->started_at = run->record->started_at;
+    copy->ready_ms = run->record->ready_ms;
+    copy->world_ms = run->record->world_ms;
+    copy->steady_rss = run->record->steady_rss;
+    pumpkin_startup_history_append(records, copy);
+  }
+  g_autoptr(GError) error = NULL;
+  if (!pumpkin_startup_history_save(path, records, &error)) {
+    g_warning("Failed to save startup history: %s", error != NULL ? error->message : "unknown error");
+    return;
+  }
+
+  g_autoptr(GPtrArray) builds = pumpkin_startup_history_by_build(records);
+  if (builds->len >= 2) {
+    PumpkinStartupBuild *build = g_ptr_array_index(builds, builds->len - 1);
+    PumpkinStartupBuild *previous = g_ptr_array_index(builds, builds->len - 2);
+    g_autofree char *regression = g_strcmp0(build->build_id, run->record->build_id) == 0
+                                    ? pumpkin_startup_build_regression(previous, build, STARTUP_REGRESSION_THRESHOLD)
+                                    : NULL;
+    if (regression != NULL) {
+      g_autofree char *message = g_strdup_printf("[SMPK] Build %s regressed against %s: %s.", build_title(build),
+                                                 build_title(previous), regression);
+      append_log_for_server(self, server, message);
+    }
+  }
+  if (self->current == server) {
+    refresh_startup_history(self);
+  }
+}
+
+void
+startup_note_log_line(PumpkinWindow *self, PumpkinServer *server, const char *line)
+{
+  StartupRun *run = lookup_run(self, server);
+  if (run == NULL || run->record->world_ms > 0 || !pumpkin_is_world_load_line(line)) {
+    return;
+  }
+  run->record->world_ms = (guint)MAX(1, (g_get_monotonic_time() - run->spawned_at) / 1000);
+}
+
+void
+startup_server_ready(PumpkinWindow *self, PumpkinServer *server)
+{
+  StartupRun *run = lookup_run(self, server);
+  if (run == NULL || run->ready) {
+    return;
+  }
+  run->ready = TRUE;
+  run->ready_at = g_get_monotonic_time();
+  run->record->ready_ms = (guint)MAX(1, (run->ready_at - run->spawned_at) / 1000);
+  save_run(self, server, run);
+}
+
+void
+startup_note_rss(PumpkinWindow *self, PumpkinServer *server, guint64 rss, gint64 now_mono)
+{
+  StartupRun *run = lookup_run(self, server);
+  if (run == NULL || !run->ready || run->rss_recorded || rss == 0 ||
+      now_mono - run->ready_at < STARTUP_STEADY_RSS_DELAY_USEC) {
+    return;
+  }
+  run->rss_recorded = TRUE;
+  run->record->steady_rss = rss;
+  save_run(self, server, run);
+}
+
+void
+startup_server_exited(PumpkinWindow *self, PumpkinServer *server)
+{
+  const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+  if (self->startup_runs != NULL && id != NULL) {
+    g_hash_table_remove(self->startup_runs, id);
+  }
+}
+
+static GtkWidget *
+history_cell(const char *text, int width_chars)
+{
+  GtkWidget *label = gtk_label_new(text);
+  gtk_label_set_xalign(GTK_LABEL(label), 0.0);
+  gtk_label_set_width_chars(GTK_LABEL(label), width_chars);
+  return label;
+}
+
+static char *
+format_millis(guint ms)
+{
+  return ms > 0 ? g_strdup_printf("%.1f s", ms / 1000.0) : g_strdup("--");
+}
+
+void
+refresh_startup_history(PumpkinWindow *self)
+{
+  if (self->stats_startup_history_box == NULL) {
+    return;
+  }
+  clear_box_children(self->stats_startup_history_box);
+  g_autofree char *path = self->current != NULL ? history_path(self->current) : NULL;
+  g_autoptr(GPtrArray) records = pumpkin_startup_history_load(path);
+  g_autoptr(GPtrArray) builds = pumpkin_startup_history_by_build(records);
+  if (builds->len == 0) {
+    GtkWidget *empty = gtk_label_new("No starts recorded yet.");
+    gtk_label_set_xalign(GTK_LABEL(empty), 0.0);
+    gtk_widget_add_css_class(empty, "dim-label");
+    gtk_box_append(self->stats_startup_history_box, empty);
+    return;
+  }
+
+  guint first = builds->len > STARTUP_HISTORY_VISIBLE_BUILDS ? builds->len - STARTUP_HISTORY_VISIBLE_BUILDS : 0;
+  for (guint i = builds->len; i > first; i--) {
+    PumpkinStartupBuild *build = g_ptr_array_index(builds, i - 1);
+    PumpkinStartupBuild *previous = i >= 2 ? g_ptr_array_index(builds, i - 2) : NULL;
+    g_autofree char *ready = format_millis(build->ready_ms);
+    g_autofree char *world = format_millis(build->world_ms);
+    g_autofree char *rss = build->steady_rss > 0 ? g_format_size_full(build->steady_rss, G_FORMAT_SIZE_IEC_UNITS)
+                                                 : g_strdup("--");
+    g_autofree char *runs = g_strdup_printf("%u run%s", build->runs, build->runs == 1 ? "" : "s");
+    g_autofree char *regression = pumpkin_startup_build_regression(previous, build, STARTUP_REGRESSION_THRESHOLD);
+
+    GtkWidget *row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    GtkWidget *title = history_cell(build_title(build), 18);
+    gtk_label_set_ellipsize(GTK_LABEL(title), PANGO_ELLIPSIZE_END);
+    gtk_widget_set_tooltip_text(title, build->build_id);
+    gtk_box_append(GTK_BOX(row), title);
+    gtk_box_append(GTK_BOX(row), history_cell(ready, 8));
+    gtk_box_append(GTK_BOX(row), history_cell(world, 8));
+    gtk_box_append(GTK_BOX(row), history_cell(rss, 10));
+    GtkWidget *runs_label = history_cell(runs, 7);
+    gtk_widget_add_css_class(runs_label, "dim-label");
+    gtk_box_append(GTK_BOX(row), runs_label);
+    if (regression != NULL) {
+      GtkWidget *chip = gtk_label_new("Regressed");
+      gtk_widget_add_css_class(chip, "status-badge");
+      gtk_widget_add_css_class(chip, "warning-badge");
+      gtk_widget_set_valign(chip, GTK_ALIGN_CENTER);
+      g_autofree char *tooltip = g_strdup_printf("Compared with %s: %s", build_title(previous), regression);
+      gtk_widget_set_tooltip_text(chip, tooltip);
+      gtk_box_append(GTK_BOX(row), chip);
+    }
+    gtk_box_append(self->stats_startup_history_box, row);
+  }
+}
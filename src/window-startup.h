@@ -0,0 +1,10 @@
+#pragma once
+
+#include "window-internal.h"
+
+void startup_run_free(gpointer data);
+void startup_note_log_line(PumpkinWindow *self, PumpkinServer *server, const char *line);
+void startup_server_ready(PumpkinWindow *self, PumpkinServer *server);
+void startup_note_rss(PumpkinWindow *self, PumpkinServer *server, guint64 rss, gint64 now_mono);
+void startup_server_exited(PumpkinWindow *self, PumpkinServer *server);
+void refresh_startup_history(PumpkinWindow *self);
@@ -0,0 +1,447 @@
+#include "window-watchdog.h"
+#include "window-console.h"
+#include "window-hibernate.h"
+#include "window-lifecycle.h"
+#include "window-protocol.h"
+
+#include <glib/gstdio.h>
+
+typedef struct {
+  PumpkinWindow *self;
+  PumpkinServer *server;
+  gint64 last_probe_at;
+  gboolean probe_in_flight;
+  gboolean ping_seen;
+  gint64 stall_since;
+  gboolean captured;
+  gboolean kill_pending;
+  guint restart_source_id;
+  guint restarts;
+  guint restart_delay_msec;
+  gint64 last_restart_at;
+  unsigned long long last_ticks;
+  gint64 last_ticks_at;
+  double cpu_pct;
+  GQueue *history;
+} WatchdogEntry;
+
+typedef struct {
+  PumpkinWindow *self;
+  char *server_id;
+  int port;
+  gboolean ok;
+  gint64 latency_usec;
+} WatchdogProbe;
+
+typedef struct {
+  PumpkinWindow *self;
+  char *server_id;
+  int pid;
+  char *bundle_dir;
+  char *cgroup_path;
+  char *summary;
+  char *console;
+  char *error;
+} WatchdogCapture;
+
+static void
+clear_restart(WatchdogEntry *entry)
+{
+  if (entry->restart_source_id != 0) {
+    g_source_remove(entry->restart_source_id);
+    entry->restart_source_id = 0;
+  }
+}
+
+void
+watchdog_free_entry(gpointer data)
+{
+  WatchdogEntry *entry = data;
+  if (entry == NULL) {
+    return;
+  }
+  clear_restart(entry);
+  g_clear_object(&entry->server);
+  if (entry->history != NULL) {
+    g_queue_free_full(entry->history, g_free);
+  }
+  g_free(entry);
+}
+
+static WatchdogEntry *
+lookup_entry(PumpkinWindow *self, const char *id)
+{
+  if (self == NULL || id == NULL || self->watchdogs == NULL) {
+    return NULL;
+  }
+  return g_hash_table_lookup(self->watchdogs, id);
+}
+
+static void
+probe_free(WatchdogProbe *probe)
+{
+  g_clear_object(&probe->self);
+  g_free(probe->server_id);
+  g_free(probe);
+}
+
+static void
+probe_task(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+  WatchdogProbe *probe = task_data;
+  int players = 0;
+  int max_players = 0;
+  gint64 started = g_get_monotonic_time();
+  probe->ok = pumpkin_query_minecraft_status("127.0.0.1", probe->port, &players, &max_players, NULL);
+  probe->latency_usec = g_get_monotonic_time() - started;
+  g_task_return_boolean(task, probe->ok);
+}
+
+static void
+sample_cpu(WatchdogEntry *entry, gint64 now_mono)
+{
+  sample_process_cpu(pumpkin_server_get_pid(entry->server), now_mono, &entry->last_ticks, &entry->last_ticks_at,
+                     &entry->cpu_pct);
+}
+
+static void
+push_history(WatchdogEntry *entry, char *line)
+{
+  if (entry->history == NULL) {
+    entry->history = g_queue_new();
+  }
+  g_queue_push_tail(entry->history, line);
+  while (g_queue_get_length(entry->history) > WATCHDOG_HISTORY_LINES) {
+    g_free(g_queue_pop_head(entry->history));
+  }
+}
+
+static guint
+backoff_seconds(guint restarts)
+{
+  guint delay = WATCHDOG_BACKOFF_BASE_SECONDS;
+  for (guint i = 0; i < restarts && delay < WATCHDOG_BACKOFF_MAX_SECONDS; i++) {
+    delay *= 2;
+  }
+  return MIN(delay, WATCHDOG_BACKOFF_MAX_SECONDS);
+}
+
+static void
+capture_free(WatchdogCapture *capture)
+{
+  g_clear_object(&capture->self);
+  g_free(capture->server_id);
+  g_free(capture->bundle_dir);
+  g_free(capture->cgroup_path);
+  g_free(capture->summary);
+  g_free(capture->console);
+  g_free(capture->error);
+  g_free(capture);
+}
+
+static void
+append_pressure(GString *out, const char *label, const char *cgroup_dir)
+{
+  for (int i = 0; i < PUMPKIN_PRESSURE_COUNT; i++) {
+    g_autofree char *path = pumpkin_pressure_path(cgroup_dir, (PumpkinPressureResource)i);
+    PumpkinPressure pressure = { 0 };
+    if (!pumpkin_pressure_read(path, &pressure)) {
+      continue;
+    }
+    g_string_append_printf(out, "%s %s: some avg10=%.2f avg60=%.2f, full avg10=%.2f avg60=%.2f\n",
+                           label, pumpkin_pressure_resource_name((PumpkinPressureResource)i),
+                           pressure.some_avg10, pressure.some_avg60, pressure.full_avg10, pressure.full_avg60);
+  }
+}
+
+static char *
+collect_metrics(WatchdogCapture *capture)
+{
+  GString *out = g_string_new(NULL);
+  PumpkinProcessMemory memory = { 0 };
+  if (pumpkin_process_read_memory(capture->pid, &memory)) {
+    g_string_append_printf(out,
+                           "memory: rss=%" G_GUINT64_FORMAT " pss=%" G_GUINT64_FORMAT " anon=%" G_GUINT64_FORMAT
+                           " file=%" G_GUINT64_FORMAT " swap=%" G_GUINT64_FORMAT "\n",
+                           memory.rss, memory.pss, memory.anon, memory.file, memory.swap);
+  }
+  PumpkinProcessIo io = { 0 };
+  if (pumpkin_process_read_io(capture->pid, &io)) {
+    g_string_append_printf(out,
+                           "io: read=%" G_GUINT64_FORMAT " write=%" G_GUINT64_FORMAT " minflt=%" G_GUINT64_FORMAT
+                           " majflt=%" G_GUINT64_FORMAT "\n",
+                           io.read_bytes, io.write_bytes, io.minor_faults, io.major_faults);
+  }
+  PumpkinProcessSched sched = { 0 };
+  if (pumpkin_process_read_sched(capture->pid, &sched)) {
+    g_string_append_printf(out,
+                           "sched: run_ns=%" G_GUINT64_FORMAT " wait_ns=%" G_GUINT64_FORMAT
+                           " voluntary=%" G_GUINT64_FORMAT " involuntary=%" G_GUINT64_FORMAT " threads=%u\n",
+                           sched.run_ns, sched.wait_ns, sched.voluntary_switches, sched.involuntary_switches,
+                           sched.threads);
+  }
+  if (capture->cgroup_path != NULL) {
+    append_pressure(out, "cgroup", capture->cgroup_path);
+  }
+  append_pressure(out, "host", NULL);
+  return g_string_free(out, FALSE);
+}
+
+static gboolean
+write_bundle_file(const char *dir, const char *name, const char *contents, GError **error)
+{
+  g_autofree char *path = g_build_filename(dir, name, NULL);
+  return g_file_set_contents(path, contents != NULL ? contents : "", -1, error);
+}
+
+/* Stacks are read while the server is still wedged; they are useless once it has been killed. */
+static void
+capture_task(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+  WatchdogCapture *capture = task_data;
+  if (g_mkdir_with_parents(capture->bundle_dir, 0755) != 0) {
+    capture->error = g_strdup_printf("Failed to create %s", capture->bundle_dir);
+    g_task_return_boolean(task, FALSE);
+    return;
+  }
+  g_autofree char *threads = pumpkin_process_dump_threads(capture->pid);
+  g_autofree char *metrics = collect_metrics(capture);
+  g_autoptr(GError) error = NULL;
+  if (!write_bundle_file(capture->bundle_dir, "summary.txt", capture->summary, &error) ||
+      !write_bundle_file(capture->bundle_dir, "threads.txt", threads, &error) ||
+      !write_bundle_file(capture->bundle_dir, "metrics.txt", metrics, &error) ||
+      !write_bundle_file(capture->bundle_dir, "console.log", capture->console, &error)) {
+    capture->error = g_strdup(error->message);
+  }
+  g_task_return_boolean(task, capture->error == NULL);
+}
+
+static void
+capture_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  (void)user_data;
+  WatchdogCapture *capture = g_task_get_task_data(G_TASK(res));
+  PumpkinWindow *self = capture->self;
+  WatchdogEntry *entry = lookup_entry(self, capture->server_id);
+  if (entry == NULL) {
+    return;
+  }
+  g_autofree char *message = NULL;
+  if (capture->error != NULL) {
+    message = g_strdup_printf("[SMPK] Watchdog: failed to write diagnostics: %s", capture->error);
+  } else {
+    message = g_strdup_printf("[SMPK] Watchdog: diagnostics saved to %s", capture->bundle_dir);
+  }
+  append_log_for_server(self, entry->server, message);
+
+  if (!pumpkin_server_get_watchdog_restart(entry->server) || !pumpkin_server_get_running(entry->server) ||
+      entry->stall_since == 0) {
+    return;
+  }
+  if (entry->last_restart_at > 0 && g_get_monotonic_time() - entry->last_restart_at >= WATCHDOG_BACKOFF_RESET_USEC) {
+    entry->restarts = 0;
+  }
+  /* Jitter keeps servers stalled by the same host hiccup from restarting in lockstep. */
+  entry->restart_delay_msec = (guint)(backoff_seconds(entry->restarts) * 1000 * g_random_double_range(0.8, 1.2));
+  g_autofree char *kill_message = g_strdup_printf("[SMPK] Watchdog: killing the stalled server, restarting in %.1f s.",
+                                                  entry->restart_delay_msec / 1000.0);
+  append_log_for_server(self, entry->server, kill_message);
+  entry->kill_pending = TRUE;
+  pumpkin_server_kill(entry->server);
+}
+
+static void
+capture_diagnostics(PumpkinWindow *self, WatchdogEntry *entry, gint64 stalled_usec)
+{
+  g_autoptr(GDateTime) now = g_date_time_new_now_local();
+  g_autofree char *stamp = g_date_time_format(now, "%Y%m%d-%H%M%S");
+  g_autofree char *dir_name = g_strdup_printf("stall-%s", stamp);
+  g_autofree char *diagnostics_dir = pumpkin_server_get_diagnostics_dir(entry->server);
+  g_autofree char *when = g_date_time_format(now, "%Y-%m-%d %H:%M:%S");
+
+  GString *summary = g_string_new(NULL);
+  g_string_append_printf(summary, "server: %s (%s)\n", pumpkin_server_get_name(entry->server),
+                         pumpkin_server_get_id(entry->server));
+  g_string_append_printf(summary, "captured: %s\n", when);
+  g_string_append_printf(summary, "pid: %d\n", pumpkin_server_get_pid(entry->server));
+  g_string_append_printf(summary, "stalled for: %" G_GINT64_FORMAT " s (threshold %d s)\n",
+                         stalled_usec / G_USEC_PER_SEC, pumpkin_server_get_watchdog_seconds(entry->server));
+  g_string_append_printf(summary, "process cpu: %.1f%%\n", entry->cpu_pct);
+  if (self->current == entry->server && self->last_tps_valid) {
+    g_string_append_printf(summary, "last tps: %.2f\n", self->last_tps);
+  }
+  g_string_append(summary, "\nrecent probes:\n");
+  for (GList *l = entry->history != NULL ? entry->history->head : NULL; l != NULL; l = l->next) {
+    g_string_append_printf(summary, "%s\n", (const char *)l->data);
+  }
+
+  WatchdogCapture *capture = g_new0(WatchdogCapture, 1);
+  capture->self = g_object_ref(self);
+  capture->server_id = g_strdup(pumpkin_server_get_id(entry->server));
+  capture->pid = pumpkin_server_get_pid(entry->server);
+  capture->bundle_dir = g_build_filename(diagnostics_dir, dir_name, NULL);
+  capture->cgroup_path = pumpkin_server_get_cgroup_path(entry->server);
+  capture->summary = g_string_free(summary, FALSE);
+  capture->console = console_tail_text(self, entry->server, WATCHDOG_CONSOLE_TAIL_LINES);
+  GTask *task = g_task_new(NULL, NULL, capture_done, NULL);
+  g_task_set_task_data(task, capture, (GDestroyNotify)capture_free);
+  g_task_run_in_thread(task, capture_task);
+  g_object_unref(task);
+}
+
+static void
+probe_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  (void)user_data;
+  WatchdogProbe *probe = g_task_get_task_data(G_TASK(res));
+  PumpkinWindow *self = probe->self;
+  WatchdogEntry *entry = lookup_entry(self, probe->server_id);
+  if (entry == NULL) {
+    return;
+  }
+  entry->probe_in_flight = FALSE;
+  if (entry->kill_pending || !pumpkin_server_get_running(entry->server) || server_is_frozen(self, entry->server)) {
+    return;
+  }
+
+  /* A server that never answered may still be generating its world; only count it once it has. */
+  gboolean tps_stalled = self->current == entry->server && self->last_tps_valid && self->last_tps < WATCHDOG_TPS_STALL;
+  gboolean ping_stalled = entry->ping_seen && (!probe->ok || probe->latency_usec > WATCHDOG_PING_SLOW_USEC);
+  if (probe->ok) {
+    entry->ping_seen = TRUE;
+  }
+  g_autoptr(GDateTime) now_local = g_date_time_new_now_local();
+  g_autofree char *clock = g_date_time_format(now_local, "%H:%M:%S");
+  g_autofree char *tps = self->current == entry->server && self->last_tps_valid
+                           ? g_strdup_printf("%.1f", self->last_tps)
+                           : g_strdup("-");
+  g_autofree char *ping = probe->ok ? g_strdup_printf("%" G_GINT64_FORMAT " ms", probe->latency_usec / 1000)
+                                    : g_strdup("failed");
+  push_history(entry, g_strdup_printf("%s ping %s, cpu %.1f%%, tps %s", clock, ping, entry->cpu_pct, tps));
+
+  gint64 now = g_get_monotonic_time();
+  if (!tps_stalled && !ping_stalled) {
+    if (entry->stall_since != 0 && entry->captured) {
+      append_log_for_server(self, entry->server, "[SMPK] Watchdog: server is responsive again.");
+    }
+    entry->stall_since = 0;
+    entry->captured = FALSE;
+    return;
+  }
+  if (entry->stall_since == 0) {
+    entry->stall_since = now;
+  }
+  gint64 stalled = now - entry->stall_since;
+  if (entry->captured || stalled < (gint64)pumpkin_server_get_watchdog_seconds(entry->server) * G_USEC_PER_SEC) {
+    return;
+  }
+  entry->captured = TRUE;
+  g_autofree char *message = g_strdup_printf("[SMPK] Watchdog: server stalled for %" G_GINT64_FORMAT
+                                             " s (ping %s, cpu %.1f%%, tps %s), capturing diagnostics.",
+                                             stalled / G_USEC_PER_SEC, ping, entry->cpu_pct, tps);
+  append_log_for_server(self, entry->server, message);
+  capture_diagnostics(self, entry, stalled);
+}
+
+static gboolean
+restart_cb(gpointer data)
+{
+  WatchdogEntry *entry = data;
+  entry->restart_source_id = 0;
+  PumpkinWindow *self = entry->self;
+  if (!pumpkin_server_get_running(entry->server)) {
+    append_log_for_server(self, entry->server, "[SMPK] Watchdog: restarting the server.");
+    start_server_internal(self, entry->server, FALSE, self->current == entry->server);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+void
+update_watchdogs(PumpkinWindow *self, gint64 now_mono)
+{
+  GListModel *model = get_server_model(self);
+  if (model == NULL || self->watchdogs == NULL) {
+    return;
+  }
+
+  g_autoptr(GHashTable) seen = g_hash_table_new(g_str_hash, g_str_equal);
+  guint n = g_list_model_get_n_items(model);
+  for (guint i = 0; i < n; i++) {
+    g_autoptr(PumpkinServer) server = g_list_model_get_item(model, i);
+    const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+    if (id == NULL || pumpkin_server_get_watchdog_seconds(server) <= 0) {
+      continue;
+    }
+    WatchdogEntry *entry = g_hash_table_lookup(self->watchdogs, id);
+    if (entry == NULL) {
+      entry = g_new0(WatchdogEntry, 1);
+      entry->self = self;
+      entry->server = g_object_ref(server);
+      g_hash_table_replace(self->watchdogs, g_strdup(id), entry);
+    }
+    g_hash_table_add(seen, (gpointer)id);
+    if (entry->probe_in_flight || entry->kill_pending || !pumpkin_server_get_running(server)) {
+      continue;
+    }
+    /* Frozen on purpose is not a stall. */
+    if (server_is_frozen(self, server)) {
+      entry->stall_since = 0;
+      entry->last_ticks_at = 0;
+      continue;
+    }
+    if (entry->last_probe_at > 0 && (now_mono - entry->last_probe_at) < WATCHDOG_PROBE_INTERVAL_USEC) {
+      continue;
+    }
+    int port = pumpkin_server_get_port(server);
+    if (port <= 0) {
+      continue;
+    }
+    entry->last_probe_at = now_mono;
+    entry->probe_in_flight = TRUE;
+    sample_cpu(entry, now_mono);
+    WatchdogProbe *probe = g_new0(WatchdogProbe, 1);
+    probe->self = g_object_ref(self);
+    probe->server_id = g_strdup(id);
+    probe->port = port;
+    GTask *task = g_task_new(NULL, NULL, probe_done, NULL);
+    g_task_set_task_data(task, probe, (GDestroyNotify)probe_free);
+    g_task_run_in_thread(task, probe_task);
+    g_object_unref(task);
+  }
+
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, self->watchdogs);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    if (!g_hash_table_contains(seen, key)) {
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+}
+
+void
+watchdog_server_exited(PumpkinWindow *self, PumpkinServer *server)
+{
+  WatchdogEntry *entry = server != NULL ? lookup_entry(self, pumpkin_server_get_id(server)) : NULL;
+  if (entry == NULL) {
+    return;
+  }
+  entry->ping_seen = FALSE;
+  entry->stall_since = 0;
+  entry->captured = FALSE;
+  entry->last_ticks_at = 0;
+  if (!entry->kill_pending) {
+    return;
+  }
+  entry->kill_pending = FALSE;
+  clear_restart(entry);
+  entry->restarts++;
+  entry->last_restart_at = g_get_monotonic_time();
+  entry->restart_source_id = g_timeout_add(entry->restart_delay_msec, restart_cb, entry);
+}
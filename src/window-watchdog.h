@@ -0,0 +1,7 @@
+#pragma once
+
+#include "window-internal.h"
+
+void watchdog_free_entry(gpointer data);
+void update_watchdogs(PumpkinWindow *self, gint64 now_mono);
+void watchdog_server_exited(PumpkinWindow *self, PumpkinServer *server);
@@ -3,12 +3,22 @@
 
 #include "download.h"
 #include "window-console.h"
+#include "window-hibernate.h"
 #include "window-lifecycle.h"
 #include "window-networks.h"
 #include "window-player-data.h"
+#include "window-player-watch.h"
+#include "window-player-journal.h"
+#include "window-player-item.h"
 #include "window-players.h"
 #include "window-parse.h"
 #include "window-protocol.h"
+#include "window-start-queue.h"
+#include "window-startup.h"
+#include "window-sessions.h"
+#include "window-network-players.h"
+#include "window-join-latency.h"
+#include "window-watchdog.h"
 
 #include <gio/gio.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
@@ -31,6 +41,7 @@
 #include <limits.h>
 #include <string.h>
 #if !defined(G_OS_WIN32)
+#include <glib-unix.h>
 #include <unistd.h>
 #endif
 #include <time.h>
@@ -109,6 +120,7 @@ static void on_import_server(GtkButton *button, PumpkinWindow *self);
 static void on_import_server_done(GObject *source, GAsyncResult *res, gpointer user_data);
 static void on_details_back(GtkButton *button, PumpkinWindow *self);
 static void on_network_details_back(GtkButton *button, PumpkinWindow *self);
+static void on_network_details_player_search_changed(GtkSearchEntry *entry, PumpkinWindow *self);
 static void on_download_progress(goffset current, goffset total, gpointer user_data);
 static void on_details_install(GtkButton *button, PumpkinWindow *self);
 static void on_details_update(GtkButton *button, PumpkinWindow *self);
@@ -133,7 +145,7 @@ static void on_save_general_settings(GtkButton *button, PumpkinWindow *self);
 static void on_reset_general_settings(GtkButton *button, PumpkinWindow *self);
 static void on_reset_server_settings(GtkButton *button, PumpkinWindow *self);
 static void mark_settings_dirty(PumpkinWindow *self);
-static void set_details_status(PumpkinWindow *self, const char *message, guint timeout_seconds);
+static const char *selected_launch_profile(PumpkinWindow *self);
 static void on_clear_cache(GtkButton *button, PumpkinWindow *self);
 static char *cache_dir_for_config(PumpkinWindow *self);
 static char *cache_path_for_download(PumpkinWindow *self, const char *url, const char *build_identity);
@@ -179,7 +191,6 @@ static void refresh_plugin_list(PumpkinWindow *self);
 static void on_world_delete_clicked(GtkButton *button, PumpkinWindow *self);
 static void on_world_delete_confirmed(GObject *dialog, GAsyncResult *res, gpointer user_data);
 static void refresh_world_list(PumpkinWindow *self);
-static void refresh_player_list(PumpkinWindow *self);
 static void refresh_whitelist_list(PumpkinWindow *self);
 static void refresh_banned_list(PumpkinWindow *self);
 static gboolean refresh_players_tick(gpointer user_data);
@@ -187,7 +198,7 @@ static gboolean delete_player_tracking(PumpkinWindow *self,
                                        const char *state_key,
                                        const char *name,
                                        const char *uuid);
-static void on_player_row_activated(GtkListBox *box, GtkListBoxRow *row, PumpkinWindow *self);
+static void on_player_list_activate(GtkListView *view, guint position, PumpkinWindow *self);
 static void on_player_action_confirmed(GObject *dialog, GAsyncResult *res, gpointer user_data);
 static void on_player_ban_reason_confirmed(GObject *dialog, GAsyncResult *res, gpointer user_data);
 static void on_player_pardon_ip_manual_confirmed(GObject *dialog, GAsyncResult *res, gpointer user_data);
@@ -268,8 +279,6 @@ static void set_stats_graphs_disabled(PumpkinWindow *self, gboolean disabled);
 static void on_open_server_root(GtkButton *button, PumpkinWindow *self);
 static void select_server_row(PumpkinWindow *self, PumpkinServer *server);
 static void ingest_players_from_disk(PumpkinWindow *self);
-static char *format_unix_time(PumpkinWindow *self, gint64 unix_ts);
-static char *format_duration(guint64 seconds);
 static char *relative_time_label(gint64 unix_ts);
 static const char *date_time_pattern_for_config(PumpkinWindow *self);
 static char *normalize_build_label(PumpkinWindow *self, const char *label);
@@ -278,13 +287,18 @@ static GPtrArray *build_ip_unban_candidates(const char *raw_ip);
 static gboolean refresh_player_list_deferred(gpointer data);
 static gboolean send_pardon_ip_for_player(PumpkinWindow *self, const char *raw_ip, const char *state_key);
 static void set_player_head_image(PumpkinWindow *self, GtkImage *image, const char *uuid);
-static void on_player_head_download_done(GObject *source, GAsyncResult *res, gpointer user_data);
 static char *command_history_file(PumpkinServer *server);
 static void command_history_load(PumpkinWindow *self, PumpkinServer *server);
 static gboolean server_download_active(PumpkinWindow *self, PumpkinServer *server);
 static gboolean any_download_active(PumpkinWindow *self);
 static guint network_update_actionable_count(PumpkinWindow *self, ServerNetwork *network);
 static void auto_start_context_free(AutoStartContext *ctx);
+static GtkWidget *create_overview_memory_breakdown(PumpkinWindow *self, PumpkinServer *server);
+static MemoryTrendEntry *lookup_memory_trend(PumpkinWindow *self, PumpkinServer *server);
+static char *format_memory_trend_alert(MemoryTrendEntry *entry);
+static PressureWatch *lookup_pressure_alert(PumpkinWindow *self, PumpkinServer *server);
+static char *format_pressure_alert(PressureWatch *watch);
+static const char *pressure_resource_title(PumpkinPressureResource resource);
 static gboolean auto_start_server_timeout_cb(gpointer user_data);
 #if defined(G_OS_WIN32)
 static void apply_windows_titlebar_theme(PumpkinWindow *self);
@@ -370,7 +384,7 @@ set_details_error(PumpkinWindow *self, const char *message)
   }
 }
 
-static void
+void
 set_details_status(PumpkinWindow *self, const char *message, guint timeout_seconds)
 {
   if (self->details_status == NULL) {
@@ -627,6 +641,18 @@ on_popover_server_picked(GtkButton *btn, PumpkinWindow *self)
   }
 }
 
+static int
+start_concurrency_from_entry(PumpkinWindow *self)
+{
+  int value = 0;
+  gboolean has_value = FALSE;
+  if (self->entry_start_concurrency == NULL ||
+      !pumpkin_parse_optional_positive_int(self->entry_start_concurrency, &value, &has_value) || !has_value) {
+    return PUMPKIN_START_CONCURRENCY_DEFAULT;
+  }
+  return CLAMP(value, 0, PUMPKIN_START_CONCURRENCY_MAX);
+}
+
 static void
 update_autostart_sensitivity(PumpkinWindow *self)
 {
@@ -678,6 +704,13 @@ on_save_general_settings(GtkButton *button, PumpkinWindow *self)
   if (self->switch_auto_start_servers != NULL) {
     pumpkin_config_set_auto_start_servers_enabled(self->config, gtk_switch_get_active(self->switch_auto_start_servers));
   }
+  if (self->entry_start_concurrency != NULL) {
+    pumpkin_config_set_start_concurrency(self->config, start_concurrency_from_entry(self));
+  }
+  if (self->entry_avatar_url != NULL) {
+    pumpkin_config_set_avatar_url(self->config, gtk_editable_get_text(GTK_EDITABLE(self->entry_avatar_url)));
+    pumpkin_head_cache_set_base_url(self->player_heads, pumpkin_config_get_avatar_url(self->config));
+  }
   if (self->drop_date_format != NULL) {
     pumpkin_config_set_date_format(self->config, (PumpkinDateFormat)gtk_drop_down_get_selected(self->drop_date_format));
   }
@@ -736,6 +769,13 @@ on_reset_general_response(AdwAlertDialog *dialog, const char *response, PumpkinW
   if (self->switch_auto_start_servers != NULL) {
     gtk_switch_set_active(self->switch_auto_start_servers, FALSE);
   }
+  if (self->entry_start_concurrency != NULL) {
+    g_autofree char *concurrency = g_strdup_printf("%d", PUMPKIN_START_CONCURRENCY_DEFAULT);
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_start_concurrency), concurrency);
+  }
+  if (self->entry_avatar_url != NULL) {
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_avatar_url), "");
+  }
   if (self->switch_run_in_background != NULL) {
     gtk_switch_set_active(self->switch_run_in_background, TRUE);
   }
@@ -1007,6 +1047,14 @@ global_switches_match(PumpkinWindow *self)
       pumpkin_config_get_auto_start_servers_enabled(self->config) != gtk_switch_get_active(self->switch_auto_start_servers)) {
     return FALSE;
   }
+  if (self->entry_start_concurrency != NULL &&
+      pumpkin_config_get_start_concurrency(self->config) != start_concurrency_from_entry(self)) {
+    return FALSE;
+  }
+  if (self->entry_avatar_url != NULL &&
+      !pumpkin_entry_matches_string(self->entry_avatar_url, pumpkin_config_get_avatar_url(self->config))) {
+    return FALSE;
+  }
   if (self->drop_date_format != NULL &&
       (int)pumpkin_config_get_date_format(self->config) != (int)gtk_drop_down_get_selected(self->drop_date_format)) {
     return FALSE;
@@ -1052,6 +1100,14 @@ settings_match_server(PumpkinWindow *self)
   if (pumpkin_parse_limit_entry(self->entry_max_ram_mb, sys_ram_mb) != pumpkin_server_get_max_ram_mb(server)) {
     return FALSE;
   }
+  if (pumpkin_parse_weight_entry(self->entry_cpu_weight) != pumpkin_server_get_cpu_weight(server) ||
+      pumpkin_parse_weight_entry(self->entry_io_weight) != pumpkin_server_get_io_weight(server)) {
+    return FALSE;
+  }
+  if (self->drop_launch_profile != NULL &&
+      g_strcmp0(selected_launch_profile(self), pumpkin_server_get_launch_profile(server)) != 0) {
+    return FALSE;
+  }
   if (self->switch_auto_restart != NULL &&
       pumpkin_server_get_auto_restart(server) != gtk_switch_get_active(self->switch_auto_restart)) {
     return FALSE;
@@ -1059,6 +1115,19 @@ settings_match_server(PumpkinWindow *self)
   if (!pumpkin_entry_matches_int(self->entry_auto_restart_delay, pumpkin_server_get_auto_restart_delay(server))) {
     return FALSE;
   }
+  if (self->switch_leak_restart != NULL &&
+      pumpkin_server_get_leak_restart(server) != gtk_switch_get_active(self->switch_leak_restart)) {
+    return FALSE;
+  }
+  if (!pumpkin_entry_matches_int(self->entry_hibernate_minutes, pumpkin_server_get_hibernate_minutes(server)) ||
+      !pumpkin_entry_matches_int(self->entry_freeze_minutes, pumpkin_server_get_freeze_minutes(server)) ||
+      !pumpkin_entry_matches_int(self->entry_watchdog_seconds, pumpkin_server_get_watchdog_seconds(server))) {
+    return FALSE;
+  }
+  if (self->switch_watchdog_restart != NULL &&
+      pumpkin_server_get_watchdog_restart(server) != gtk_switch_get_active(self->switch_watchdog_restart)) {
+    return FALSE;
+  }
   if (self->switch_auto_update != NULL &&
       pumpkin_server_get_auto_update_enabled(server) != gtk_switch_get_active(self->switch_auto_update)) {
     return FALSE;
@@ -1574,6 +1643,55 @@ validate_settings_limits(PumpkinWindow *self)
     }
   }
 
+  gboolean weight_invalid = FALSE;
+  GtkEntry *weight_entries[] = { self->entry_cpu_weight, self->entry_io_weight };
+  for (guint i = 0; i < G_N_ELEMENTS(weight_entries); i++) {
+    if (weight_entries[i] == NULL) {
+      continue;
+    }
+    int weight = 0;
+    gboolean weight_has = FALSE;
+    gboolean invalid = !pumpkin_parse_optional_positive_int(weight_entries[i], &weight, &weight_has) ||
+                       (weight_has && (weight < 1 || weight > 10000));
+    if (invalid) {
+      gtk_widget_add_css_class(GTK_WIDGET(weight_entries[i]), "error");
+      weight_invalid = TRUE;
+    } else {
+      gtk_widget_remove_css_class(GTK_WIDGET(weight_entries[i]), "error");
+    }
+  }
+
+  gboolean idle_invalid = FALSE;
+  GtkEntry *idle_entries[] = { self->entry_hibernate_minutes, self->entry_freeze_minutes };
+  int idle_max[] = { HIBERNATE_MINUTES_MAX, FREEZE_MINUTES_MAX };
+  for (guint i = 0; i < G_N_ELEMENTS(idle_entries); i++) {
+    if (idle_entries[i] == NULL) {
+      continue;
+    }
+    int minutes = 0;
+    gboolean minutes_has = FALSE;
+    gboolean invalid = !pumpkin_parse_optional_positive_int(idle_entries[i], &minutes, &minutes_has) ||
+                       (minutes_has && minutes > idle_max[i]);
+    if (invalid) {
+      gtk_widget_add_css_class(GTK_WIDGET(idle_entries[i]), "error");
+      idle_invalid = TRUE;
+    } else {
+      gtk_widget_remove_css_class(GTK_WIDGET(idle_entries[i]), "error");
+    }
+  }
+  if (self->entry_watchdog_seconds != NULL) {
+    int seconds = 0;
+    gboolean seconds_has = FALSE;
+    gboolean invalid = !pumpkin_parse_optional_positive_int(self->entry_watchdog_seconds, &seconds, &seconds_has) ||
+                       (seconds_has && (seconds < WATCHDOG_SECONDS_MIN || seconds > WATCHDOG_SECONDS_MAX));
+    if (invalid) {
+      gtk_widget_add_css_class(GTK_WIDGET(self->entry_watchdog_seconds), "error");
+      idle_invalid = TRUE;
+    } else {
+      gtk_widget_remove_css_class(GTK_WIDGET(self->entry_watchdog_seconds), "error");
+    }
+  }
+
   if (cpu_invalid) {
     gtk_widget_add_css_class(GTK_WIDGET(self->entry_max_cpu_cores), "error");
   } else {
@@ -1720,7 +1838,7 @@ validate_settings_limits(PumpkinWindow *self)
 
   self->settings_invalid = cpu_invalid || ram_invalid || port_invalid || bedrock_port_invalid ||
                            players_invalid || stats_sample_invalid || rcon_port_invalid || rcon_host_invalid ||
-                           auto_update_time_invalid;
+                           auto_update_time_invalid || weight_invalid || idle_invalid;
   update_auto_update_controls_sensitivity(self);
   update_save_button(self);
 }
@@ -2056,6 +2174,7 @@ on_log_line(PumpkinServer *server, const char *line, PumpkinWindow *self)
       g_strcmp0(line, "Server process exited") != 0 &&
       g_strcmp0(line, "Auto-restart scheduled") != 0) {
     set_server_running_hint(self, server, TRUE);
+    startup_note_log_line(self, server, check);
   }
   if (check != NULL &&
       (strstr(check, "Server is now running") != NULL ||
@@ -2065,9 +2184,20 @@ on_log_line(PumpkinServer *server, const char *line, PumpkinWindow *self)
        strstr(check, "Done") != NULL ||
        strstr(check, "Listening") != NULL)) {
     set_server_running_hint(self, server, TRUE);
+    start_queue_server_ready(self, server);
+    startup_server_ready(self, server);
+    hibernation_server_ready(self, server);
   }
+  gboolean pending_restart = FALSE;
   if (line != NULL && g_strcmp0(line, "Server process exited") == 0) {
     set_server_running_hint(self, server, FALSE);
+    hibernation_server_exited(self, server);
+    watchdog_server_exited(self, server);
+    startup_server_exited(self, server);
+    start_queue_server_exited(self, server);
+    /* Leak-triggered restarts are acted on here whether or not the server is selected. */
+    pending_restart = self->pending_restart_servers != NULL &&
+                      g_hash_table_remove(self->pending_restart_servers, server);
   }
   gboolean tps_line = FALSE;
   gboolean list_line = FALSE;
@@ -2097,11 +2227,17 @@ on_log_line(PumpkinServer *server, const char *line, PumpkinWindow *self)
   if (!internal_line && !suppress_auto_line) {
     append_console_line(self, server, line);
   }
+  network_players_note_line(self, server, check);
+  sessions_note_line(self, server, check);
+  join_latency_note_line(self, server, check);
   if (!is_current) {
     if (line != NULL && g_strcmp0(line, "Server process exited") == 0) {
       if (self->auto_update_server == server) {
         clear_auto_update_countdown(self);
       }
+      if (pending_restart) {
+        start_server_internal(self, server, FALSE, FALSE);
+      }
       queue_overview_refresh(self, FALSE);
     }
     return;
@@ -2136,7 +2272,7 @@ on_log_line(PumpkinServer *server, const char *line, PumpkinWindow *self)
     self->pending_bedrock_platform_hints = 0;
 
     if (!self->restart_requested) {
-      if (!self->user_stop_requested) {
+      if (!self->user_stop_requested && !pending_restart) {
         set_console_warning(self, "Server stopped unexpectedly.", TRUE);
       } else {
         set_console_warning(self, NULL, FALSE);
@@ -2154,6 +2290,8 @@ on_log_line(PumpkinServer *server, const char *line, PumpkinWindow *self)
         g_source_remove(self->restart_delay_id);
       }
       self->restart_delay_id = g_timeout_add(0, restart_after_delay, ctx);
+    } else if (pending_restart) {
+      start_server_internal(self, server, FALSE, TRUE);
     }
   }
 }
@@ -2346,18 +2484,18 @@ delete_player_tracking(PumpkinWindow *self, const char *state_key, const char *n
 
   PlayerState *state = NULL;
   if (state_key != NULL && *state_key != '\0') {
-    state = g_hash_table_lookup(self->player_states, state_key);
+    state = g_hash_table_lookup(self->player_states, pumpkin_intern_peek(state_key));
   }
   if (state == NULL && uuid != NULL && *uuid != '\0' && self->player_states_by_uuid != NULL) {
     g_autofree char *uuid_key = normalized_key(uuid);
     if (uuid_key != NULL) {
-      state = g_hash_table_lookup(self->player_states_by_uuid, uuid_key);
+      state = g_hash_table_lookup(self->player_states_by_uuid, pumpkin_intern_peek(uuid_key));
     }
   }
   if (state == NULL && name != NULL && *name != '\0' && self->player_states_by_name != NULL) {
     g_autofree char *name_key = normalized_key(name);
     if (name_key != NULL) {
-      state = g_hash_table_lookup(self->player_states_by_name, name_key);
+      state = g_hash_table_lookup(self->player_states_by_name, pumpkin_intern_peek(name_key));
     }
   }
   if (state == NULL) {
@@ -2372,30 +2510,31 @@ delete_player_tracking(PumpkinWindow *self, const char *state_key, const char *n
     g_autofree char *norm_name = normalized_key(name_copy);
     g_autofree char *norm_uuid = normalized_key(uuid_copy);
     if (norm_key != NULL) {
-      g_hash_table_add(self->deleted_player_keys, g_strdup(norm_key));
+      g_hash_table_add(self->deleted_player_keys, (gpointer)pumpkin_intern(norm_key));
     }
     if (norm_name != NULL) {
-      g_hash_table_add(self->deleted_player_keys, g_strdup(norm_name));
+      g_hash_table_add(self->deleted_player_keys, (gpointer)pumpkin_intern(norm_name));
     }
     if (norm_uuid != NULL) {
-      g_hash_table_add(self->deleted_player_keys, g_strdup(norm_uuid));
+      g_hash_table_add(self->deleted_player_keys, (gpointer)pumpkin_intern(norm_uuid));
     }
   }
 
   if (self->live_player_names != NULL) {
     if (name_copy != NULL) {
-      g_hash_table_remove(self->live_player_names, name_copy);
+      g_hash_table_remove(self->live_player_names, pumpkin_intern_peek(name_copy));
     }
     if (uuid_copy != NULL) {
-      g_hash_table_remove(self->live_player_names, uuid_copy);
+      g_hash_table_remove(self->live_player_names, pumpkin_intern_peek(uuid_copy));
     }
   }
 
   player_state_remove_from_index_table(self->player_states_by_uuid, state);
   player_state_remove_from_index_table(self->player_states_by_name, state);
 
+  pumpkin_search_index_remove(self->player_search_index, key_copy);
   if (key_copy != NULL) {
-    g_hash_table_remove(self->player_states, key_copy);
+    g_hash_table_remove(self->player_states, pumpkin_intern_peek(key_copy));
   } else {
     GHashTableIter iter;
     gpointer key = NULL;
@@ -2411,14 +2550,7 @@ delete_player_tracking(PumpkinWindow *self, const char *state_key, const char *n
 
   if (uuid_copy != NULL && *uuid_copy != '\0') {
     g_autofree char *uuid_key = normalized_key(uuid_copy);
-    if (uuid_key != NULL) {
-      if (self->player_head_downloads != NULL) {
-        g_hash_table_remove(self->player_head_downloads, uuid_key);
-      }
-      g_autofree char *data_dir = pumpkin_server_get_data_dir(self->current);
-      g_autofree char *cache_path = g_strdup_printf("%s/cache/player-heads/%s.png", data_dir, uuid_key);
-      g_remove(cache_path);
-    }
+    pumpkin_head_cache_forget(self->player_heads, uuid_key);
   }
 
   player_states_set_dirty(self);
@@ -2542,7 +2674,7 @@ send_pardon_ip_for_player(PumpkinWindow *self, const char *raw_ip, const char *s
   }
 
   if (sent_any && state_key != NULL && self->player_states != NULL) {
-    PlayerState *state = g_hash_table_lookup(self->player_states, state_key);
+    PlayerState *state = g_hash_table_lookup(self->player_states, pumpkin_intern_peek(state_key));
     if (state != NULL && state->ip_banned_hint) {
       state->ip_banned_hint = FALSE;
     }
@@ -2627,7 +2759,7 @@ normalize_build_label(PumpkinWindow *self, const char *label)
   return g_strdup(label);
 }
 
-static char *
+char *
 format_duration(guint64 seconds)
 {
   guint64 days = seconds / 86400;
@@ -2649,7 +2781,7 @@ format_duration(guint64 seconds)
   return g_strdup_printf("%" G_GUINT64_FORMAT "s", secs);
 }
 
-static char *
+char *
 format_unix_time(PumpkinWindow *self, gint64 unix_ts)
 {
   if (unix_ts <= 0) {
@@ -3287,7 +3419,7 @@ preferred_max_players(PumpkinWindow *self, PumpkinServer *server)
   return configured;
 }
 
-static char *
+char *
 extract_name_before_suffix(const char *line, const char *suffix)
 {
   if (line == NULL || suffix == NULL || *suffix == '\0') {
@@ -3373,22 +3505,17 @@ is_uuid_string(const char *text)
 }
 
 static void
-load_player_name_map(GHashTable *map, PumpkinServer *server)
+load_player_name_map(GHashTable *map, PumpkinWindow *self)
 {
-  const char *files[] = {
-    "usercache.json",
-    "whitelist.json",
-    "ops.json",
-    "banned-players.json",
-    NULL
+  const PlayerDataFile files[] = {
+    PLAYER_DATA_USERCACHE,
+    PLAYER_DATA_WHITELIST,
+    PLAYER_DATA_OPS,
+    PLAYER_DATA_BANNED_PLAYERS
   };
 
-  for (int i = 0; files[i] != NULL; i++) {
-    g_autofree char *path = resolve_data_file(server, files[i]);
-    g_autofree char *contents = NULL;
-    if (g_file_get_contents(path, &contents, NULL, NULL)) {
-      add_name_uuid_pairs(map, contents);
-    }
+  for (guint i = 0; i < G_N_ELEMENTS(files); i++) {
+    add_name_uuid_pairs(map, player_watch_get_entries(self, files[i]));
   }
 }
 
@@ -3398,10 +3525,15 @@ ingest_players_from_disk(PumpkinWindow *self)
   if (self == NULL || self->current == NULL || self->player_states == NULL) {
     return;
   }
+  /* The player directories are only rescanned after the watcher has seen something change. */
+  guint64 generation = player_watch_get_generation(self);
+  if (generation != 0 && generation == self->player_ingest_generation) {
+    return;
+  }
+  self->player_ingest_generation = generation;
 
-  gboolean changed = FALSE;
   g_autoptr(GHashTable) name_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  load_player_name_map(name_map, self->current);
+  load_player_name_map(name_map, self);
 
   GHashTableIter map_iter;
   gpointer map_key = NULL;
@@ -3464,6 +3596,7 @@ ingest_players_from_disk(PumpkinWindow *self)
     }
 
     time_t mtime = player_last_seen_mtime(players_dir, world_players, entry, token);
+    gboolean changed = FALSE;
     if (state->first_joined_unix <= 0 && mtime > 0) {
       state->first_joined_unix = (gint64)mtime;
       changed = TRUE;
@@ -3472,10 +3605,9 @@ ingest_players_from_disk(PumpkinWindow *self)
       state->last_online_unix = (gint64)mtime;
       changed = TRUE;
     }
-  }
-
-  if (changed) {
-    player_states_set_dirty(self);
+    if (changed) {
+      player_state_changed(self, state);
+    }
   }
 }
 
@@ -4047,6 +4179,90 @@ network_startable_count(PumpkinWindow *self, ServerNetwork *network)
   return startable;
 }
 
+static const char *
+selected_launch_profile(PumpkinWindow *self)
+{
+  if (self->drop_launch_profile == NULL) {
+    return NULL;
+  }
+  GtkStringObject *item = gtk_drop_down_get_selected_item(self->drop_launch_profile);
+  return item != NULL ? gtk_string_object_get_string(item) : NULL;
+}
+
+static void
+update_launch_profile_label(PumpkinWindow *self)
+{
+  if (self->label_launch_profile == NULL) {
+    return;
+  }
+  GPtrArray *profiles = self->current != NULL ? pumpkin_server_get_launch_profiles(self->current) : NULL;
+  const PumpkinLaunchProfile *profile = pumpkin_launch_profiles_lookup(profiles, selected_launch_profile(self));
+  if (profile == NULL) {
+    gtk_label_set_text(self->label_launch_profile, "Launch profile: --");
+    return;
+  }
+  g_autofree char *described = pumpkin_launch_profile_describe(profile);
+  g_autofree char *library = pumpkin_launch_profile_resolve_allocator(profile);
+  g_autofree char *text = profile->allocator != PUMPKIN_ALLOCATOR_SYSTEM && library == NULL
+                            ? g_strdup_printf("%s Allocator library not found, the system allocator will be used.",
+                                              described)
+                            : g_strdup(described);
+  gtk_label_set_text(self->label_launch_profile, text);
+}
+
+static void
+update_launch_profile_controls(PumpkinWindow *self)
+{
+  if (self->drop_launch_profile == NULL) {
+    return;
+  }
+  GPtrArray *profiles = self->current != NULL ? pumpkin_server_get_launch_profiles(self->current) : NULL;
+  GtkStringList *names = gtk_string_list_new(NULL);
+  guint selected = 0;
+  for (guint i = 0; profiles != NULL && i < profiles->len; i++) {
+    const PumpkinLaunchProfile *profile = g_ptr_array_index(profiles, i);
+    gtk_string_list_append(names, profile->name);
+    if (g_strcmp0(profile->name, pumpkin_server_get_launch_profile(self->current)) == 0) {
+      selected = i;
+    }
+  }
+  gtk_drop_down_set_model(self->drop_launch_profile, G_LIST_MODEL(names));
+  g_object_unref(names);
+  gtk_drop_down_set_selected(self->drop_launch_profile, selected);
+  gtk_widget_set_sensitive(GTK_WIDGET(self->drop_launch_profile), self->current != NULL);
+  update_launch_profile_label(self);
+}
+
+static void
+on_launch_profile_changed(GObject *object, GParamSpec *pspec, PumpkinWindow *self)
+{
+  (void)object;
+  (void)pspec;
+  update_launch_profile_label(self);
+  mark_settings_dirty(self);
+}
+
+static void
+update_cpu_set_label(PumpkinWindow *self)
+{
+  if (self->label_cpu_set == NULL) {
+    return;
+  }
+  if (self->current == NULL) {
+    gtk_label_set_text(self->label_cpu_set, "Assigned CPUs: --");
+    return;
+  }
+  g_autofree char *described = pumpkin_server_describe_cpu_set(self->current);
+  if (described != NULL) {
+    g_autofree char *text = g_strdup_printf("Assigned %s.", described);
+    gtk_label_set_text(self->label_cpu_set, text);
+  } else if (pumpkin_server_get_max_cpu_cores(self->current) > 0) {
+    gtk_label_set_text(self->label_cpu_set, "Cores are assigned when the server starts.");
+  } else {
+    gtk_label_set_text(self->label_cpu_set, "No core limit, runs on all CPUs.");
+  }
+}
+
 static gboolean
 refresh_overview_list_idle(gpointer user_data)
 {
@@ -4056,6 +4272,7 @@ refresh_overview_list_idle(gpointer user_data)
   }
   self->overview_refresh_idle_id = 0;
   refresh_overview_list(self);
+  update_cpu_set_label(self);
   if (self->overview_refresh_needs_details) {
     self->overview_refresh_needs_details = FALSE;
     update_details(self);
@@ -4104,7 +4321,7 @@ queue_network_details_refresh(PumpkinWindow *self)
     g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, refresh_network_details_idle, g_object_ref(self), g_object_unref);
 }
 
-static void
+void
 clear_box_children(GtkBox *box)
 {
   if (box == NULL) {
@@ -4254,6 +4471,7 @@ refresh_network_details_dialog(PumpkinWindow *self)
                                             players_total,
                                             proxy_name);
   gtk_label_set_text(self->network_details_status, status);
+  refresh_network_players(self);
 
   if (self->btn_network_details_start != NULL) {
     gtk_widget_set_sensitive(GTK_WIDGET(self->btn_network_details_start),
@@ -4338,12 +4556,15 @@ on_overview_network_start_all_clicked(GtkButton *button, gpointer user_data)
   self->suppress_warning_beep_until = g_get_monotonic_time() + (15 * G_USEC_PER_SEC);
   apply_network_auto_ports(self, network);
 
-  guint started = 0;
+  /* Backends wait in the queue until the proxy reports ready. */
+  guint queued = 0;
   PumpkinServer *proxy_server = NULL;
   if (network->proxy_server_id != NULL && *network->proxy_server_id != '\0') {
     proxy_server = find_server_by_id(self, network->proxy_server_id);
-    if (proxy_server != NULL && start_server_from_network(self, proxy_server)) {
-      started++;
+    if (proxy_server != NULL && !server_is_running_ui(self, proxy_server) &&
+        server_has_installation(self, proxy_server)) {
+      start_queue_enqueue(self, proxy_server, start_server_from_network, NULL);
+      queued++;
     }
   }
 
@@ -4356,18 +4577,21 @@ on_overview_network_start_all_clicked(GtkButton *button, gpointer user_data)
     if (proxy_server != NULL && server == proxy_server) {
       continue;
     }
-    if (start_server_from_network(self, server)) {
-      started++;
+    if (server_is_running_ui(self, server) || !server_has_installation(self, server)) {
+      continue;
     }
+    start_queue_enqueue(self, server, start_server_from_network,
+                        proxy_server != NULL ? network->proxy_server_id : NULL);
+    queued++;
   }
   if (proxy_server != NULL) {
     g_object_unref(proxy_server);
   }
 
-  if (started == 0) {
+  if (queued == 0) {
     set_details_status(self, "No additional servers could be started.", 3);
   } else {
-    g_autofree char *msg = g_strdup_printf("Started %u network server(s).", started);
+    g_autofree char *msg = g_strdup_printf("Starting %u network server(s).", queued);
     set_details_status(self, msg, 3);
   }
   queue_overview_refresh(self, TRUE);
@@ -5088,9 +5312,21 @@ create_overview_server_card(PumpkinWindow *self,
   if (download_active) {
     status_text = "Updating";
     status_css = "server-state-updating";
+  } else if (start_queue_is_waiting(self, server)) {
+    status_text = "Queued";
+    status_css = "server-state-updating";
+  } else if (!running && pumpkin_server_get_degraded(server)) {
+    status_text = "Degraded";
+    status_css = "server-state-degraded";
+  } else if (running && server_is_frozen(self, server)) {
+    status_text = "Frozen";
+    status_css = "server-state-frozen";
   } else if (running) {
     status_text = "Running";
     status_css = "server-state-running";
+  } else if (server_is_hibernating(self, server)) {
+    status_text = "Hibernating";
+    status_css = "server-state-hibernating";
   }
 
   GtkWidget *card = gtk_frame_new(NULL);
@@ -5105,6 +5341,15 @@ create_overview_server_card(PumpkinWindow *self,
 
   gboolean detailed_card = (self->config != NULL) &&
                            pumpkin_config_get_detailed_overview_cards(self->config);
+  g_autofree char *memory_alert = running ? format_memory_trend_alert(lookup_memory_trend(self, server)) : NULL;
+  PressureWatch *pressure_alert = running ? lookup_pressure_alert(self, server) : NULL;
+  g_autofree char *pressure_text = format_pressure_alert(pressure_alert);
+  g_autofree char *freeze_text = running ? format_freeze_savings(self, server) : NULL;
+  g_autofree char *crash_text = !running && pumpkin_server_get_degraded(server)
+                                  ? g_strdup_printf("Crash loop: %u crashes within 10 minutes, auto-restart paused. "
+                                                    "Reports are in the crashes folder.",
+                                                    pumpkin_server_get_recent_crashes(server))
+                                  : NULL;
 
   GtkWidget *icon = create_server_icon_widget(server);
   gtk_widget_set_valign(icon, GTK_ALIGN_CENTER);
@@ -5145,6 +5390,37 @@ create_overview_server_card(PumpkinWindow *self,
     gtk_box_append(GTK_BOX(vbox), title);
     gtk_box_append(GTK_BOX(vbox), sub);
     gtk_box_append(GTK_BOX(vbox), meta_row);
+    GtkWidget *memory_breakdown = running ? create_overview_memory_breakdown(self, server) : NULL;
+    if (memory_breakdown != NULL) {
+      gtk_box_append(GTK_BOX(vbox), memory_breakdown);
+    }
+    if (memory_alert != NULL) {
+      GtkWidget *alert_label = gtk_label_new(memory_alert);
+      gtk_label_set_xalign(GTK_LABEL(alert_label), 0.0);
+      gtk_label_set_wrap(GTK_LABEL(alert_label), TRUE);
+      gtk_widget_add_css_class(alert_label, "overview-memory-alert");
+      gtk_box_append(GTK_BOX(vbox), alert_label);
+    }
+    if (pressure_text != NULL) {
+      GtkWidget *pressure_label = gtk_label_new(pressure_text);
+      gtk_label_set_xalign(GTK_LABEL(pressure_label), 0.0);
+      gtk_label_set_wrap(GTK_LABEL(pressure_label), TRUE);
+      gtk_widget_add_css_class(pressure_label, "overview-memory-alert");
+      gtk_box_append(GTK_BOX(vbox), pressure_label);
+    }
+    if (freeze_text != NULL) {
+      GtkWidget *freeze_label = gtk_label_new(freeze_text);
+      gtk_label_set_xalign(GTK_LABEL(freeze_label), 0.0);
+      gtk_widget_add_css_class(freeze_label, "dim-label");
+      gtk_box_append(GTK_BOX(vbox), freeze_label);
+    }
+    if (crash_text != NULL) {
+      GtkWidget *crash_label = gtk_label_new(crash_text);
+      gtk_label_set_xalign(GTK_LABEL(crash_label), 0.0);
+      gtk_label_set_wrap(GTK_LABEL(crash_label), TRUE);
+      gtk_widget_add_css_class(crash_label, "overview-memory-alert");
+      gtk_box_append(GTK_BOX(vbox), crash_label);
+    }
   } else {
     GtkWidget *title_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
     gtk_widget_set_halign(title_row, GTK_ALIGN_START);
@@ -5154,6 +5430,38 @@ create_overview_server_card(PumpkinWindow *self,
     gtk_widget_set_valign(title, GTK_ALIGN_CENTER);
     gtk_box_append(GTK_BOX(title_row), title);
     gtk_box_prepend(GTK_BOX(title_row), status_dot);
+    if (memory_alert != NULL) {
+      GtkWidget *alert_chip = gtk_label_new("Memory leak");
+      gtk_widget_add_css_class(alert_chip, "status-badge");
+      gtk_widget_add_css_class(alert_chip, "warning-badge");
+      gtk_widget_set_valign(alert_chip, GTK_ALIGN_CENTER);
+      gtk_widget_set_tooltip_text(alert_chip, memory_alert);
+      gtk_box_append(GTK_BOX(title_row), alert_chip);
+    }
+    if (pressure_text != NULL) {
+      g_autofree char *chip_text = g_strdup_printf("%s pressure", pressure_resource_title(pressure_alert->resource));
+      GtkWidget *pressure_chip = gtk_label_new(chip_text);
+      gtk_widget_add_css_class(pressure_chip, "status-badge");
+      gtk_widget_add_css_class(pressure_chip, "warning-badge");
+      gtk_widget_set_valign(pressure_chip, GTK_ALIGN_CENTER);
+      gtk_widget_set_tooltip_text(pressure_chip, pressure_text);
+      gtk_box_append(GTK_BOX(title_row), pressure_chip);
+    }
+    if (freeze_text != NULL) {
+      GtkWidget *freeze_chip = gtk_label_new("Frozen");
+      gtk_widget_add_css_class(freeze_chip, "status-badge");
+      gtk_widget_set_valign(freeze_chip, GTK_ALIGN_CENTER);
+      gtk_widget_set_tooltip_text(freeze_chip, freeze_text);
+      gtk_box_append(GTK_BOX(title_row), freeze_chip);
+    }
+    if (crash_text != NULL) {
+      GtkWidget *crash_chip = gtk_label_new("Crash loop");
+      gtk_widget_add_css_class(crash_chip, "status-badge");
+      gtk_widget_add_css_class(crash_chip, "warning-badge");
+      gtk_widget_set_valign(crash_chip, GTK_ALIGN_CENTER);
+      gtk_widget_set_tooltip_text(crash_chip, crash_text);
+      gtk_box_append(GTK_BOX(title_row), crash_chip);
+    }
     gtk_box_append(GTK_BOX(vbox), title_row);
   }
   gtk_widget_set_hexpand(vbox, TRUE);
@@ -6307,7 +6615,7 @@ stats_graph_draw_players(GtkDrawingArea *area, cairo_t *cr, int width, int heigh
 }
 
 static void
-stats_graph_draw_disk(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+stats_graph_draw_tps(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
 {
   PumpkinWindow *self = PUMPKIN_WINDOW(data);
   (void)area;
@@ -6342,134 +6650,695 @@ stats_graph_draw_disk(GtkDrawingArea *area, cairo_t *cr, int width, int height,
   draw_stats_axis_labels(cr, left, top, right, bottom, width, height, 4, "20", "10", "0", &muted_fg);
   draw_time_axis_labels(self, cr, left, top, right, bottom, width, height, &muted_fg);
 
-  draw_stats_series(self, cr, self->stats_disk_mb, STATS_SAMPLES, self->stats_count, 20.0,
+  draw_stats_series(self, cr, self->stats_tps, STATS_SAMPLES, self->stats_count, 20.0,
                     1, 0.35, 0.77, 0.45, left, top, right, bottom, width, height);
 }
 
-static void
-get_system_limits(int *max_cores, int *max_ram_mb)
+static double
+stats_nice_ceiling(double value)
 {
-  if (max_cores != NULL) {
-    int cores = g_get_num_processors();
-    *max_cores = cores > 0 ? cores : 0;
+  if (value <= 0.0) {
+    return 1.0;
   }
-  if (max_ram_mb != NULL) {
-    unsigned long long total = 0;
-    unsigned long long avail = 0;
-    if (read_system_mem(&total, &avail)) {
-      *max_ram_mb = (int)(total / (1024ULL * 1024ULL));
-    } else {
-      *max_ram_mb = 0;
-    }
+  double magnitude = pow(10.0, floor(log10(value)));
+  double normalized = value / magnitude;
+  if (normalized <= 1.0) {
+    return magnitude;
+  }
+  if (normalized <= 2.0) {
+    return 2.0 * magnitude;
   }
+  if (normalized <= 5.0) {
+    return 5.0 * magnitude;
+  }
+  return 10.0 * magnitude;
 }
 
-static void
-reset_stats_history(PumpkinWindow *self)
+static double
+stats_series_scale(PumpkinWindow *self, double *first, double *second, double floor_value)
 {
-  self->stats_index = 0;
-  self->stats_count = 0;
-  memset(self->stats_cpu, 0, sizeof(self->stats_cpu));
-  memset(self->stats_ram_mb, 0, sizeof(self->stats_ram_mb));
-  memset(self->stats_disk_mb, 0, sizeof(self->stats_disk_mb));
-  memset(self->stats_players, 0, sizeof(self->stats_players));
-  self->last_tps = 0.0;
-  self->last_tps_valid = FALSE;
-  self->tps_enabled = FALSE;
+  double max_seen = 0.0;
+  for (int i = 0; i < self->stats_count; i++) {
+    if (first != NULL) {
+      max_seen = fmax(max_seen, stats_get_sample(self, first, i));
+    }
+    if (second != NULL) {
+      max_seen = fmax(max_seen, stats_get_sample(self, second, i));
+    }
+  }
+  return stats_nice_ceiling(fmax(max_seen, floor_value));
 }
 
-static void
-set_stats_graphs_disabled(PumpkinWindow *self, gboolean disabled)
+static char *
+format_stats_axis_value(double value, const char *unit)
 {
-  if (self == NULL) {
-    return;
+  if (value >= 1000000.0) {
+    return g_strdup_printf("%.0fM%s", value / 1000000.0, unit);
   }
-
-  GtkWidget *graphs[3] = {
-    self->stats_graph_usage != NULL ? GTK_WIDGET(self->stats_graph_usage) : NULL,
-    self->stats_graph_players != NULL ? GTK_WIDGET(self->stats_graph_players) : NULL,
-    self->stats_graph_disk != NULL ? GTK_WIDGET(self->stats_graph_disk) : NULL
-  };
-
-  for (guint i = 0; i < G_N_ELEMENTS(graphs); i++) {
-    if (graphs[i] == NULL) {
-      continue;
-    }
-    if (disabled) {
-      gtk_widget_add_css_class(graphs[i], "stats-disabled");
-    } else {
-      gtk_widget_remove_css_class(graphs[i], "stats-disabled");
-    }
+  if (value >= 1000.0) {
+    return g_strdup_printf("%.0fk%s", value / 1000.0, unit);
+  }
+  if (value >= 10.0 || value == floor(value)) {
+    return g_strdup_printf("%.0f%s", value, unit);
   }
+  return g_strdup_printf("%.1f%s", value, unit);
 }
 
 static gboolean
-read_process_stats(int pid, unsigned long long *proc_ticks, unsigned long long *rss_bytes)
+stats_graph_prepare(PumpkinWindow *self, cairo_t *cr, int width, int height)
 {
-#if defined(G_OS_WIN32)
-  if (pid <= 0) {
-    return FALSE;
-  }
-  HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, (DWORD)pid);
-  if (process == NULL) {
-    return FALSE;
-  }
+  GdkRGBA fg = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA muted_fg = stats_color_with_alpha(fg, 0.78);
 
-  FILETIME create_time, exit_time, kernel_time, user_time;
-  if (!GetProcessTimes(process, &create_time, &exit_time, &kernel_time, &user_time)) {
-    CloseHandle(process);
+  cairo_save(cr);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.0);
+  cairo_rectangle(cr, 0, 0, width, height);
+  cairo_fill(cr);
+  cairo_restore(cr);
+
+  if (self->stats_count < 2) {
+    set_cairo_source_rgba(cr, &muted_fg);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 13.0);
+    cairo_move_to(cr, 12.0, 20.0);
+    cairo_show_text(cr, "Waiting for data…");
     return FALSE;
   }
-  ULARGE_INTEGER kernel_ul = { .LowPart = kernel_time.dwLowDateTime, .HighPart = kernel_time.dwHighDateTime };
-  ULARGE_INTEGER user_ul = { .LowPart = user_time.dwLowDateTime, .HighPart = user_time.dwHighDateTime };
-  *proc_ticks = kernel_ul.QuadPart + user_ul.QuadPart;
+  return TRUE;
+}
 
-  PROCESS_MEMORY_COUNTERS_EX mem = { 0 };
-  mem.cb = sizeof(mem);
-  if (GetProcessMemoryInfo(process, (PROCESS_MEMORY_COUNTERS *)&mem, sizeof(mem))) {
-    *rss_bytes = (unsigned long long)mem.WorkingSetSize;
-  }
+static void
+draw_stats_series_graph(PumpkinWindow *self, cairo_t *cr, int width, int height,
+                        double **series, const GdkRGBA *colors, int series_count,
+                        double floor_value, const char *unit)
+{
+  GdkRGBA fg = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA border = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA muted_fg = stats_color_with_alpha(fg, 0.78);
+  GdkRGBA muted_border = stats_color_with_alpha(border, 0.28);
 
-  CloseHandle(process);
-  return TRUE;
-#elif defined(__APPLE__)
-  if (pid <= 0) {
-    return FALSE;
-  }
-  struct proc_taskinfo info;
-  int ret = proc_pidinfo(pid, PROC_PIDTASKINFO, 0, &info, sizeof(info));
-  if (ret <= 0) {
-    return FALSE;
-  }
-  long ticks = sysconf(_SC_CLK_TCK);
-  if (ticks <= 0) {
-    ticks = 100;
+  if (!stats_graph_prepare(self, cr, width, height)) {
+    return;
   }
-  unsigned long long total_ns = info.pti_total_user + info.pti_total_system;
-  *proc_ticks = (total_ns * (unsigned long long)ticks) / 1000000000ULL;
-  *rss_bytes = (unsigned long long)info.pti_resident_size;
-  return TRUE;
-#else
-  if (pid <= 0) {
-    return FALSE;
+
+  double left = 44.0;
+  double top = 12.0;
+  double right = 12.0;
+  double bottom = 16.0;
+
+  double max_seen = floor_value;
+  for (int s = 0; s < series_count; s++) {
+    if (series[s] != NULL) {
+      max_seen = fmax(max_seen, stats_series_scale(self, series[s], NULL, floor_value));
+    }
   }
+  double scale = stats_nice_ceiling(max_seen);
+  g_autofree char *top_label = format_stats_axis_value(scale, unit);
+  g_autofree char *mid_label = format_stats_axis_value(scale / 2.0, unit);
+  g_autofree char *bottom_label = format_stats_axis_value(0.0, unit);
+  draw_stats_grid(cr, left, top, right, bottom, width, height, 4, &muted_border);
+  draw_stats_axis_labels(cr, left, top, right, bottom, width, height, 4,
+                         top_label, mid_label, bottom_label, &muted_fg);
+  draw_time_axis_labels(self, cr, left, top, right, bottom, width, height, &muted_fg);
 
-  g_autofree char *stat_path = g_strdup_printf("/proc/%d/stat", pid);
-  g_autofree char *contents = NULL;
-  if (!g_file_get_contents(stat_path, &contents, NULL, NULL)) {
-    return FALSE;
+  for (int s = 0; s < series_count; s++) {
+    if (series[s] == NULL) {
+      continue;
+    }
+    draw_stats_series(self, cr, series[s], STATS_SAMPLES, self->stats_count, scale, 5,
+                      colors[s].red, colors[s].green, colors[s].blue,
+                      left, top, right, bottom, width, height);
   }
+}
 
-  char *paren = strrchr(contents, ')');
-  if (paren == NULL) {
-    return FALSE;
+static void
+draw_stats_pair_graph(PumpkinWindow *self, cairo_t *cr, int width, int height,
+                      double *first, const GdkRGBA *first_color,
+                      double *second, const GdkRGBA *second_color,
+                      double floor_value, const char *unit)
+{
+  double *series[2] = { first, second };
+  GdkRGBA colors[2] = { { 0 }, { 0 } };
+  if (first_color != NULL) {
+    colors[0] = *first_color;
+  } else {
+    series[0] = NULL;
   }
-  char *p = paren + 1;
-  while (*p == ' ') {
-    p++;
+  if (second_color != NULL) {
+    colors[1] = *second_color;
+  } else {
+    series[1] = NULL;
   }
+  draw_stats_series_graph(self, cr, width, height, series, colors, 2, floor_value, unit);
+}
 
-  unsigned long long utime = 0;
+static void
+stats_graph_draw_io(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  GdkRGBA read_color = { .red = 0.25, .green = 0.72, .blue = 0.69, .alpha = 1.0 };
+  GdkRGBA write_color = { .red = 0.75, .green = 0.38, .blue = 0.80, .alpha = 1.0 };
+  draw_stats_pair_graph(self, cr, width, height,
+                        self->stats_io_read_mb, &read_color,
+                        self->stats_io_write_mb, &write_color,
+                        1.0, "M");
+}
+
+static void
+stats_graph_draw_faults(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  GdkRGBA major_color = { .red = 0.90, .green = 0.38, .blue = 0.0, .alpha = 1.0 };
+  GdkRGBA minor_color = { .red = 0.60, .green = 0.60, .blue = 0.59, .alpha = 1.0 };
+  draw_stats_pair_graph(self, cr, width, height,
+                        self->stats_faults_minor, &minor_color,
+                        self->stats_faults_major, &major_color,
+                        10.0, "");
+}
+
+static void
+stats_graph_draw_net(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  GdkRGBA rx_color = { .red = 0.21, .green = 0.52, .blue = 0.89, .alpha = 1.0 };
+  GdkRGBA tx_color = { .red = 0.96, .green = 0.76, .blue = 0.07, .alpha = 1.0 };
+  draw_stats_pair_graph(self, cr, width, height,
+                        self->stats_net_rx_kb, &rx_color,
+                        self->stats_net_tx_kb, &tx_color,
+                        16.0, "K");
+}
+
+static void
+stats_graph_draw_sched(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  GdkRGBA wait_color = { .red = 0.60, .green = 0.42, .blue = 0.27, .alpha = 1.0 };
+  draw_stats_pair_graph(self, cr, width, height,
+                        self->stats_sched_wait_ms, &wait_color,
+                        NULL, NULL,
+                        10.0, "ms");
+}
+
+static void
+stats_graph_draw_ctx(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  GdkRGBA voluntary_color = { .red = 0.18, .green = 0.76, .blue = 0.49, .alpha = 1.0 };
+  GdkRGBA involuntary_color = { .red = 0.75, .green = 0.11, .blue = 0.16, .alpha = 1.0 };
+  draw_stats_pair_graph(self, cr, width, height,
+                        self->stats_ctx_voluntary, &voluntary_color,
+                        self->stats_ctx_involuntary, &involuntary_color,
+                        100.0, "");
+}
+
+static void
+draw_stats_stacked_graph(PumpkinWindow *self, cairo_t *cr, int width, int height,
+                         double **layers, const GdkRGBA *colors, int layer_count,
+                         double *line, const GdkRGBA *line_color,
+                         double floor_value, const char *unit)
+{
+  GdkRGBA fg = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA border = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA muted_fg = stats_color_with_alpha(fg, 0.78);
+  GdkRGBA muted_border = stats_color_with_alpha(border, 0.28);
+
+  if (!stats_graph_prepare(self, cr, width, height)) {
+    return;
+  }
+
+  double left = 44.0;
+  double top = 12.0;
+  double right = 12.0;
+  double bottom = 16.0;
+  double graph_w = width - left - right;
+  double graph_h = height - top - bottom;
+
+  double max_seen = floor_value;
+  for (int i = 0; i < self->stats_count; i++) {
+    double total = 0.0;
+    for (int layer = 0; layer < layer_count; layer++) {
+      total += stats_get_sample(self, layers[layer], i);
+    }
+    max_seen = fmax(max_seen, total);
+    if (line != NULL) {
+      max_seen = fmax(max_seen, stats_get_sample(self, line, i));
+    }
+  }
+  double scale = stats_nice_ceiling(max_seen);
+
+  g_autofree char *top_label = format_stats_axis_value(scale, unit);
+  g_autofree char *mid_label = format_stats_axis_value(scale / 2.0, unit);
+  g_autofree char *bottom_label = format_stats_axis_value(0.0, unit);
+  draw_stats_grid(cr, left, top, right, bottom, width, height, 4, &muted_border);
+  draw_stats_axis_labels(cr, left, top, right, bottom, width, height, 4,
+                         top_label, mid_label, bottom_label, &muted_fg);
+  draw_time_axis_labels(self, cr, left, top, right, bottom, width, height, &muted_fg);
+
+  int start = STATS_SAMPLES - self->stats_count;
+  g_autofree double *base = g_new0(double, self->stats_count);
+  for (int layer = 0; layer < layer_count; layer++) {
+    for (int i = 0; i < self->stats_count; i++) {
+      double x = left + ((double)(start + i) / (double)(STATS_SAMPLES - 1)) * graph_w;
+      double y = top + (1.0 - fmin(base[i] + stats_get_sample(self, layers[layer], i), scale) / scale) * graph_h;
+      if (i == 0) {
+        cairo_move_to(cr, x, y);
+      } else {
+        cairo_line_to(cr, x, y);
+      }
+    }
+    for (int i = self->stats_count - 1; i >= 0; i--) {
+      double x = left + ((double)(start + i) / (double)(STATS_SAMPLES - 1)) * graph_w;
+      double y = top + (1.0 - fmin(base[i], scale) / scale) * graph_h;
+      cairo_line_to(cr, x, y);
+    }
+    cairo_close_path(cr);
+    GdkRGBA fill = stats_color_with_alpha(colors[layer], 0.55);
+    set_cairo_source_rgba(cr, &fill);
+    cairo_fill(cr);
+
+    for (int i = 0; i < self->stats_count; i++) {
+      base[i] += stats_get_sample(self, layers[layer], i);
+    }
+  }
+
+  if (line != NULL && line_color != NULL) {
+    draw_stats_series(self, cr, line, STATS_SAMPLES, self->stats_count, scale, 1,
+                      line_color->red, line_color->green, line_color->blue,
+                      left, top, right, bottom, width, height);
+  }
+}
+
+static void
+stats_graph_draw_mem(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  double *layers[] = {
+    self->stats_mem_anon_mb,
+    self->stats_mem_file_mb,
+    self->stats_mem_shmem_mb,
+    self->stats_mem_swap_mb
+  };
+  GdkRGBA colors[] = {
+    { .red = 0.38, .green = 0.21, .blue = 0.51, .alpha = 1.0 },
+    { .red = 0.15, .green = 0.64, .blue = 0.41, .alpha = 1.0 },
+    { .red = 0.90, .green = 0.65, .blue = 0.04, .alpha = 1.0 },
+    { .red = 0.65, .green = 0.11, .blue = 0.18, .alpha = 1.0 }
+  };
+  GdkRGBA pss_color = { .red = 0.47, .green = 0.47, .blue = 0.50, .alpha = 1.0 };
+  draw_stats_stacked_graph(self, cr, width, height, layers, colors, G_N_ELEMENTS(layers),
+                           self->stats_mem_pss_mb, &pss_color, 64.0, "M");
+}
+
+static const GdkRGBA pressure_colors[PUMPKIN_PRESSURE_COUNT] = {
+  { .red = 0.90, .green = 0.38, .blue = 0.00, .alpha = 1.0 },
+  { .red = 0.57, .green = 0.25, .blue = 0.67, .alpha = 1.0 },
+  { .red = 0.13, .green = 0.56, .blue = 0.64, .alpha = 1.0 }
+};
+
+static void
+stats_graph_draw_psi_host(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  double *series[PUMPKIN_PRESSURE_COUNT] = {
+    self->stats_psi_host[PUMPKIN_PRESSURE_CPU],
+    self->stats_psi_host[PUMPKIN_PRESSURE_MEMORY],
+    self->stats_psi_host[PUMPKIN_PRESSURE_IO]
+  };
+  draw_stats_series_graph(self, cr, width, height, series, pressure_colors, PUMPKIN_PRESSURE_COUNT, 5.0, "%");
+}
+
+static void
+stats_graph_draw_psi_server(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+
+  double *series[PUMPKIN_PRESSURE_COUNT] = {
+    self->stats_psi_server[PUMPKIN_PRESSURE_CPU],
+    self->stats_psi_server[PUMPKIN_PRESSURE_MEMORY],
+    self->stats_psi_server[PUMPKIN_PRESSURE_IO]
+  };
+  draw_stats_series_graph(self, cr, width, height, series, pressure_colors, PUMPKIN_PRESSURE_COUNT, 5.0, "%");
+}
+
+/* Rows are Monday to Sunday, columns local hours; shade is average concurrency relative to the busiest hour. */
+static void
+stats_graph_draw_player_heatmap(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  PumpkinWindow *self = PUMPKIN_WINDOW(data);
+  (void)area;
+  static const char *day_labels[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+
+  GdkRGBA fg = { .red = 0.45, .green = 0.45, .blue = 0.48, .alpha = 1.0 };
+  GdkRGBA muted_fg = stats_color_with_alpha(fg, 0.78);
+  GdkRGBA empty_cell = stats_color_with_alpha(fg, 0.10);
+
+  cairo_save(cr);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+  cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.0);
+  cairo_rectangle(cr, 0, 0, width, height);
+  cairo_fill(cr);
+  cairo_restore(cr);
+
+  double heat[PUMPKIN_SESSION_WEEK_HOURS];
+  cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+  PumpkinSessionHistory *history = sessions_current_history(self);
+  if (history == NULL || !pumpkin_session_history_heatmap(history, (gint64)time(NULL), heat)) {
+    set_cairo_source_rgba(cr, &muted_fg);
+    cairo_set_font_size(cr, 13.0);
+    cairo_move_to(cr, 12.0, 20.0);
+    cairo_show_text(cr, "Waiting for data…");
+    return;
+  }
+
+  double left = 36.0;
+  double top = 16.0;
+  double right = 12.0;
+  double bottom = 4.0;
+  double cell_w = (width - left - right) / 24.0;
+  double cell_h = (height - top - bottom) / 7.0;
+  if (cell_w <= 2.0 || cell_h <= 2.0) {
+    return;
+  }
+
+  double peak = 0.0;
+  for (int i = 0; i < PUMPKIN_SESSION_WEEK_HOURS; i++) {
+    peak = fmax(peak, heat[i]);
+  }
+
+  set_cairo_source_rgba(cr, &muted_fg);
+  cairo_set_font_size(cr, 11.0);
+  for (int day = 0; day < 7; day++) {
+    cairo_move_to(cr, 4.0, top + cell_h * day + cell_h / 2.0 + 4.0);
+    cairo_show_text(cr, day_labels[day]);
+  }
+  for (int hour = 0; hour < 24; hour += 6) {
+    g_autofree char *label = g_strdup_printf("%02d", hour);
+    cairo_move_to(cr, left + cell_w * hour, top - 4.0);
+    cairo_show_text(cr, label);
+  }
+
+  for (int day = 0; day < 7; day++) {
+    for (int hour = 0; hour < 24; hour++) {
+      double value = heat[day * 24 + hour];
+      if (value > 0.0 && peak > 0.0) {
+        cairo_set_source_rgba(cr, 0.95, 0.66, 0.26, 0.15 + 0.85 * (value / peak));
+      } else {
+        set_cairo_source_rgba(cr, &empty_cell);
+      }
+      cairo_rectangle(cr, left + cell_w * hour + 1.0, top + cell_h * day + 1.0, cell_w - 2.0, cell_h - 2.0);
+      cairo_fill(cr);
+    }
+  }
+}
+
+static gboolean
+lookup_server_memory_rollup(PumpkinWindow *self, PumpkinServer *server, PumpkinProcessMemory *out)
+{
+  if (self == NULL || server == NULL || self->memory_rollup_by_server == NULL) {
+    return FALSE;
+  }
+  const char *id = pumpkin_server_get_id(server);
+  int pid = pumpkin_server_get_pid(server);
+  if (id == NULL || pid <= 0) {
+    if (id != NULL) {
+      g_hash_table_remove(self->memory_rollup_by_server, id);
+    }
+    return FALSE;
+  }
+
+  gint64 now = g_get_monotonic_time();
+  MemoryRollupEntry *entry = g_hash_table_lookup(self->memory_rollup_by_server, id);
+  if (entry == NULL || entry->pid != pid || (now - entry->sampled_at) >= MEMORY_ROLLUP_INTERVAL_USEC) {
+    PumpkinProcessMemory memory;
+    if (!pumpkin_process_read_memory(pid, &memory)) {
+      g_hash_table_remove(self->memory_rollup_by_server, id);
+      return FALSE;
+    }
+    if (entry == NULL) {
+      entry = g_new0(MemoryRollupEntry, 1);
+      g_hash_table_replace(self->memory_rollup_by_server, g_strdup(id), entry);
+    }
+    entry->memory = memory;
+    entry->sampled_at = now;
+    entry->pid = pid;
+  }
+  if (out != NULL) {
+    *out = entry->memory;
+  }
+  return TRUE;
+}
+
+static void
+overview_memory_bar_draw(GtkDrawingArea *area, cairo_t *cr, int width, int height, gpointer data)
+{
+  const PumpkinProcessMemory *memory = data;
+  (void)area;
+  if (memory == NULL) {
+    return;
+  }
+  guint64 total = memory->rss + memory->swap;
+  if (total == 0) {
+    return;
+  }
+
+  guint64 parts[] = { memory->anon, memory->file, memory->shmem, memory->swap };
+  GdkRGBA colors[] = {
+    { .red = 0.38, .green = 0.21, .blue = 0.51, .alpha = 1.0 },
+    { .red = 0.15, .green = 0.64, .blue = 0.41, .alpha = 1.0 },
+    { .red = 0.90, .green = 0.65, .blue = 0.04, .alpha = 1.0 },
+    { .red = 0.65, .green = 0.11, .blue = 0.18, .alpha = 1.0 }
+  };
+  double x = 0.0;
+  for (guint i = 0; i < G_N_ELEMENTS(parts); i++) {
+    double w = (double)width * ((double)parts[i] / (double)total);
+    set_cairo_source_rgba(cr, &colors[i]);
+    cairo_rectangle(cr, x, 0, w, height);
+    cairo_fill(cr);
+    x += w;
+  }
+}
+
+static GtkWidget *
+create_overview_memory_breakdown(PumpkinWindow *self, PumpkinServer *server)
+{
+  PumpkinProcessMemory memory;
+  if (!lookup_server_memory_rollup(self, server, &memory)) {
+    return NULL;
+  }
+
+  g_autofree char *rss = g_format_size_full(memory.rss, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *anon = g_format_size_full(memory.anon, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *file = g_format_size_full(memory.file, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *shmem = g_format_size_full(memory.shmem, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *swap = g_format_size_full(memory.swap, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *pss = g_format_size_full(memory.pss, G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *text = g_strdup_printf("RAM %s · Anon %s · File %s · Shmem %s · Swap %s · PSS %s",
+                                          rss, anon, file, shmem, swap, pss);
+
+  GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
+  GtkWidget *label = gtk_label_new(text);
+  gtk_label_set_xalign(GTK_LABEL(label), 0.0);
+  gtk_label_set_wrap(GTK_LABEL(label), TRUE);
+  gtk_widget_add_css_class(label, "dim-label");
+  gtk_box_append(GTK_BOX(box), label);
+
+  GtkWidget *bar = gtk_drawing_area_new();
+  gtk_widget_set_size_request(bar, -1, 6);
+  gtk_widget_add_css_class(bar, "overview-memory-bar");
+  PumpkinProcessMemory *copy = g_new(PumpkinProcessMemory, 1);
+  *copy = memory;
+  g_object_set_data_full(G_OBJECT(bar), "memory-breakdown", copy, g_free);
+  gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(bar), overview_memory_bar_draw, copy, NULL);
+  gtk_box_append(GTK_BOX(box), bar);
+  return box;
+}
+
+static void
+get_system_limits(int *max_cores, int *max_ram_mb)
+{
+  if (max_cores != NULL) {
+    int cores = g_get_num_processors();
+    *max_cores = cores > 0 ? cores : 0;
+  }
+  if (max_ram_mb != NULL) {
+    unsigned long long total = 0;
+    unsigned long long avail = 0;
+    if (read_system_mem(&total, &avail)) {
+      *max_ram_mb = (int)(total / (1024ULL * 1024ULL));
+    } else {
+      *max_ram_mb = 0;
+    }
+  }
+}
+
+static void
+reset_stats_history(PumpkinWindow *self)
+{
+  self->stats_index = 0;
+  self->stats_count = 0;
+  memset(self->stats_cpu, 0, sizeof(self->stats_cpu));
+  memset(self->stats_ram_mb, 0, sizeof(self->stats_ram_mb));
+  memset(self->stats_tps, 0, sizeof(self->stats_tps));
+  memset(self->stats_players, 0, sizeof(self->stats_players));
+  memset(self->stats_io_read_mb, 0, sizeof(self->stats_io_read_mb));
+  memset(self->stats_io_write_mb, 0, sizeof(self->stats_io_write_mb));
+  memset(self->stats_faults_major, 0, sizeof(self->stats_faults_major));
+  memset(self->stats_faults_minor, 0, sizeof(self->stats_faults_minor));
+  self->last_proc_io_at = 0;
+  self->last_proc_io_pid = 0;
+  memset(self->stats_net_rx_kb, 0, sizeof(self->stats_net_rx_kb));
+  memset(self->stats_net_tx_kb, 0, sizeof(self->stats_net_tx_kb));
+  pumpkin_tcp_sample_clear(&self->last_tcp_sample);
+  memset(&self->last_tcp_sample, 0, sizeof(self->last_tcp_sample));
+  self->last_tcp_sample_at = 0;
+  pumpkin_tcp_sampler_reset(self->tcp_sampler);
+  if (self->player_ping_by_ip != NULL) {
+    g_hash_table_remove_all(self->player_ping_by_ip);
+  }
+  memset(self->stats_sched_wait_ms, 0, sizeof(self->stats_sched_wait_ms));
+  memset(self->stats_ctx_voluntary, 0, sizeof(self->stats_ctx_voluntary));
+  memset(self->stats_ctx_involuntary, 0, sizeof(self->stats_ctx_involuntary));
+  self->last_proc_sched_at = 0;
+  self->last_proc_sched_pid = 0;
+  memset(self->stats_mem_anon_mb, 0, sizeof(self->stats_mem_anon_mb));
+  memset(self->stats_mem_file_mb, 0, sizeof(self->stats_mem_file_mb));
+  memset(self->stats_mem_shmem_mb, 0, sizeof(self->stats_mem_shmem_mb));
+  memset(self->stats_mem_swap_mb, 0, sizeof(self->stats_mem_swap_mb));
+  memset(self->stats_mem_pss_mb, 0, sizeof(self->stats_mem_pss_mb));
+  memset(self->stats_psi_host, 0, sizeof(self->stats_psi_host));
+  memset(self->stats_psi_server, 0, sizeof(self->stats_psi_server));
+  self->last_server_pressure_valid = FALSE;
+  self->last_pressure_sample_at = 0;
+  self->last_tps = 0.0;
+  self->last_tps_valid = FALSE;
+  self->tps_enabled = FALSE;
+}
+
+static void
+set_stats_graphs_disabled(PumpkinWindow *self, gboolean disabled)
+{
+  if (self == NULL) {
+    return;
+  }
+
+  GtkWidget *graphs[11] = {
+    self->stats_graph_usage != NULL ? GTK_WIDGET(self->stats_graph_usage) : NULL,
+    self->stats_graph_players != NULL ? GTK_WIDGET(self->stats_graph_players) : NULL,
+    self->stats_graph_tps != NULL ? GTK_WIDGET(self->stats_graph_tps) : NULL,
+    self->stats_graph_io != NULL ? GTK_WIDGET(self->stats_graph_io) : NULL,
+    self->stats_graph_faults != NULL ? GTK_WIDGET(self->stats_graph_faults) : NULL,
+    self->stats_graph_net != NULL ? GTK_WIDGET(self->stats_graph_net) : NULL,
+    self->stats_graph_sched != NULL ? GTK_WIDGET(self->stats_graph_sched) : NULL,
+    self->stats_graph_ctx != NULL ? GTK_WIDGET(self->stats_graph_ctx) : NULL,
+    self->stats_graph_mem != NULL ? GTK_WIDGET(self->stats_graph_mem) : NULL,
+    self->stats_graph_psi_host != NULL ? GTK_WIDGET(self->stats_graph_psi_host) : NULL,
+    self->stats_graph_psi_server != NULL ? GTK_WIDGET(self->stats_graph_psi_server) : NULL
+  };
+
+  for (guint i = 0; i < G_N_ELEMENTS(graphs); i++) {
+    if (graphs[i] == NULL) {
+      continue;
+    }
+    if (disabled) {
+      gtk_widget_add_css_class(graphs[i], "stats-disabled");
+    } else {
+      gtk_widget_remove_css_class(graphs[i], "stats-disabled");
+    }
+  }
+}
+
+static double
+counter_rate(guint64 current, guint64 previous, double elapsed_seconds)
+{
+  if (current < previous || elapsed_seconds <= 0.0) {
+    return 0.0;
+  }
+  return (double)(current - previous) / elapsed_seconds;
+}
+
+gboolean
+read_process_stats(int pid, unsigned long long *proc_ticks, unsigned long long *rss_bytes)
+{
+#if defined(G_OS_WIN32)
+  if (pid <= 0) {
+    return FALSE;
+  }
+  HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE, (DWORD)pid);
+  if (process == NULL) {
+    return FALSE;
+  }
+
+  FILETIME create_time, exit_time, kernel_time, user_time;
+  if (!GetProcessTimes(process, &create_time, &exit_time, &kernel_time, &user_time)) {
+    CloseHandle(process);
+    return FALSE;
+  }
+  ULARGE_INTEGER kernel_ul = { .LowPart = kernel_time.dwLowDateTime, .HighPart = kernel_time.dwHighDateTime };
+  ULARGE_INTEGER user_ul = { .LowPart = user_time.dwLowDateTime, .HighPart = user_time.dwHighDateTime };
+  *proc_ticks = kernel_ul.QuadPart + user_ul.QuadPart;
+
+  PROCESS_MEMORY_COUNTERS_EX mem = { 0 };
+  mem.cb = sizeof(mem);
+  if (GetProcessMemoryInfo(process, (PROCESS_MEMORY_COUNTERS *)&mem, sizeof(mem))) {
+    *rss_bytes = (unsigned long long)mem.WorkingSetSize;
+  }
+
+  CloseHandle(process);
+  return TRUE;
+#elif defined(__APPLE__)
+  if (pid <= 0) {
+    return FALSE;
+  }
+  struct proc_taskinfo info;
+  int ret = proc_pidinfo(pid, PROC_PIDTASKINFO, 0, &info, sizeof(info));
+  if (ret <= 0) {
+    return FALSE;
+  }
+  long ticks = sysconf(_SC_CLK_TCK);
+  if (ticks <= 0) {
+    ticks = 100;
+  }
+  unsigned long long total_ns = info.pti_total_user + info.pti_total_system;
+  *proc_ticks = (total_ns * (unsigned long long)ticks) / 1000000000ULL;
+  *rss_bytes = (unsigned long long)info.pti_resident_size;
+  return TRUE;
+#else
+  if (pid <= 0) {
+    return FALSE;
+  }
+
+  g_autofree char *stat_path = g_strdup_printf("/proc/%d/stat", pid);
+  g_autofree char *contents = NULL;
+  if (!g_file_get_contents(stat_path, &contents, NULL, NULL)) {
+    return FALSE;
+  }
+
+  char *paren = strrchr(contents, ')');
+  if (paren == NULL) {
+    return FALSE;
+  }
+  char *p = paren + 1;
+  while (*p == ' ') {
+    p++;
+  }
+
+  unsigned long long utime = 0;
   unsigned long long stime = 0;
   int field = 3;
   char *saveptr = NULL;
@@ -6481,37 +7350,638 @@ read_process_stats(int pid, unsigned long long *proc_ticks, unsigned long long *
       stime = g_ascii_strtoull(token, NULL, 10);
       break;
     }
-    field++;
-    token = strtok_r(NULL, " ", &saveptr);
+    field++;
+    token = strtok_r(NULL, " ", &saveptr);
+  }
+  *proc_ticks = utime + stime;
+
+  g_autofree char *status_path = g_strdup_printf("/proc/%d/status", pid);
+  g_autofree char *status = NULL;
+  if (g_file_get_contents(status_path, &status, NULL, NULL)) {
+    char *line = status;
+    while (line != NULL && *line != '\0') {
+      char *next = strchr(line, '\n');
+      if (next != NULL) {
+        *next = '\0';
+      }
+      if (g_str_has_prefix(line, "VmRSS:")) {
+        unsigned long long kb = 0;
+        sscanf(line, "VmRSS: %llu kB", &kb);
+        *rss_bytes = kb * 1024ULL;
+        break;
+      }
+      if (next == NULL) {
+        break;
+      }
+      line = next + 1;
+    }
+  }
+
+  return TRUE;
+#endif
+}
+
+static double
+process_ticks_per_second(void)
+{
+#if defined(G_OS_WIN32)
+  return 10000000.0;
+#else
+  long ticks = sysconf(_SC_CLK_TCK);
+  return ticks > 0 ? (double)ticks : 100.0;
+#endif
+}
+
+/* Percent of one core used since the previous sample; a missing process resets the baseline. */
+void
+sample_process_cpu(int pid, gint64 now_mono, unsigned long long *last_ticks, gint64 *last_ticks_at, double *cpu_pct)
+{
+  unsigned long long ticks = 0;
+  unsigned long long rss = 0;
+  if (pid <= 0 || !read_process_stats(pid, &ticks, &rss)) {
+    *last_ticks_at = 0;
+    return;
+  }
+  if (*last_ticks_at > 0 && ticks >= *last_ticks && now_mono > *last_ticks_at) {
+    double seconds = (double)(now_mono - *last_ticks_at) / (double)G_USEC_PER_SEC;
+    *cpu_pct = (double)(ticks - *last_ticks) / process_ticks_per_second() / seconds * 100.0;
+  }
+  *last_ticks = ticks;
+  *last_ticks_at = now_mono;
+}
+
+static char *
+player_ping_key(const char *raw_ip)
+{
+  if (raw_ip == NULL || *raw_ip == '\0') {
+    return NULL;
+  }
+  g_autofree char *clean = extract_ip_from_socket_text(raw_ip);
+  return pumpkin_tcp_normalize_ip(clean != NULL ? clean : raw_ip);
+}
+
+static gboolean
+player_ping_lookup(PumpkinWindow *self, const char *raw_ip, guint *out_rtt_usec)
+{
+  if (self == NULL || self->player_ping_by_ip == NULL) {
+    return FALSE;
+  }
+  g_autofree char *key = player_ping_key(raw_ip);
+  gpointer value = NULL;
+  if (key == NULL || !g_hash_table_lookup_extended(self->player_ping_by_ip, key, NULL, &value)) {
+    return FALSE;
+  }
+  if (out_rtt_usec != NULL) {
+    *out_rtt_usec = GPOINTER_TO_UINT(value);
+  }
+  return TRUE;
+}
+
+static void
+update_player_ping_chip(PumpkinWindow *self, GtkWidget *chip, const char *raw_ip)
+{
+  if (chip == NULL) {
+    return;
+  }
+  guint rtt_usec = 0;
+  if (!player_ping_lookup(self, raw_ip, &rtt_usec)) {
+    gtk_widget_set_visible(chip, FALSE);
+    return;
+  }
+  g_autofree char *text = rtt_usec >= 1000
+                            ? g_strdup_printf("%u ms", (rtt_usec + 500) / 1000)
+                            : g_strdup("<1 ms");
+  gtk_label_set_text(GTK_LABEL(chip), text);
+  gtk_widget_remove_css_class(chip, "status-running");
+  gtk_widget_remove_css_class(chip, "warning-badge");
+  gtk_widget_remove_css_class(chip, "status-stopped");
+  if (rtt_usec >= 250000) {
+    gtk_widget_add_css_class(chip, "status-stopped");
+  } else if (rtt_usec >= 100000) {
+    gtk_widget_add_css_class(chip, "warning-badge");
+  } else {
+    gtk_widget_add_css_class(chip, "status-running");
+  }
+  gtk_widget_set_visible(chip, TRUE);
+}
+
+static void
+refresh_player_ping_chips(PumpkinWindow *self)
+{
+  if (self == NULL || self->player_bound_items == NULL) {
+    return;
+  }
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, self->player_bound_items);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    GtkListItem *list_item = key;
+    GtkWidget *chip = g_object_get_data(G_OBJECT(list_item), "player-ping-chip");
+    PumpkinPlayerItem *item = gtk_list_item_get_item(list_item);
+    if (chip != NULL && item != NULL && pumpkin_player_item_get_info(item)->online) {
+      update_player_ping_chip(self, chip, pumpkin_player_item_get_info(item)->last_ip);
+    }
+  }
+}
+
+static void
+update_tcp_sample(PumpkinWindow *self, int pid, gint64 now_mono)
+{
+  if (self->tcp_sampler == NULL) {
+    self->tcp_sampler = pumpkin_tcp_sampler_new();
+  }
+  pumpkin_tcp_sample_clear(&self->last_tcp_sample);
+  self->last_tcp_sample_at = now_mono;
+
+  int port = pumpkin_server_get_port(self->current);
+  PumpkinTcpSample sample;
+  gboolean ok = port > 0 && pumpkin_tcp_sampler_update(self->tcp_sampler, pid, port, now_mono, &sample);
+  if (self->player_ping_by_ip != NULL) {
+    g_hash_table_remove_all(self->player_ping_by_ip);
+  }
+  if (!ok) {
+    memset(&self->last_tcp_sample, 0, sizeof(self->last_tcp_sample));
+    refresh_player_ping_chips(self);
+    return;
+  }
+
+  /* Several connections from one address (NAT, proxies) report the best RTT. */
+  for (guint i = 0; i < sample.connections->len; i++) {
+    PumpkinTcpConnection *connection = g_ptr_array_index(sample.connections, i);
+    if (connection->remote_ip == NULL || connection->rtt_usec == 0) {
+      continue;
+    }
+    gpointer existing = NULL;
+    if (g_hash_table_lookup_extended(self->player_ping_by_ip, connection->remote_ip, NULL, &existing) &&
+        GPOINTER_TO_UINT(existing) <= connection->rtt_usec) {
+      continue;
+    }
+    g_hash_table_replace(self->player_ping_by_ip,
+                         g_strdup(connection->remote_ip),
+                         GUINT_TO_POINTER(connection->rtt_usec));
   }
-  *proc_ticks = utime + stime;
+  self->last_tcp_sample = sample;
+  refresh_player_ping_chips(self);
+}
 
-  g_autofree char *status_path = g_strdup_printf("/proc/%d/status", pid);
-  g_autofree char *status = NULL;
-  if (g_file_get_contents(status_path, &status, NULL, NULL)) {
-    char *line = status;
-    while (line != NULL && *line != '\0') {
-      char *next = strchr(line, '\n');
-      if (next != NULL) {
-        *next = '\0';
-      }
-      if (g_str_has_prefix(line, "VmRSS:")) {
-        unsigned long long kb = 0;
-        sscanf(line, "VmRSS: %llu kB", &kb);
-        *rss_bytes = kb * 1024ULL;
-        break;
+static void
+memory_trend_entry_free(MemoryTrendEntry *entry)
+{
+  if (entry == NULL) {
+    return;
+  }
+  pumpkin_memory_trend_free(entry->trend);
+  g_free(entry);
+}
+
+static MemoryTrendEntry *
+lookup_memory_trend(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL || self->memory_trends == NULL) {
+    return NULL;
+  }
+  const char *id = pumpkin_server_get_id(server);
+  return id != NULL ? g_hash_table_lookup(self->memory_trends, id) : NULL;
+}
+
+static char *
+format_memory_trend_alert(MemoryTrendEntry *entry)
+{
+  if (entry == NULL || !entry->alert) {
+    return NULL;
+  }
+  g_autofree char *rate = g_format_size_full((guint64)entry->estimate.slope_bytes_per_hour,
+                                             G_FORMAT_SIZE_IEC_UNITS);
+  g_autofree char *eta = format_duration((guint64)entry->seconds_to_limit);
+  return g_strdup_printf("Memory growing %s/h · %s limit in ~%s",
+                         rate,
+                         entry->limit_is_host ? "host RAM" : "RAM",
+                         eta);
+}
+
+static gboolean
+leak_restart_delayed_cb(gpointer data)
+{
+  RestartContext *ctx = data;
+  MemoryTrendEntry *entry = lookup_memory_trend(ctx->self, ctx->server);
+  if (entry != NULL) {
+    entry->restart_scheduled = FALSE;
+  }
+  if (pumpkin_server_get_running(ctx->server)) {
+    restart_server_internal(ctx->self, ctx->server);
+  }
+  g_object_unref(ctx->server);
+  g_object_unref(ctx->self);
+  g_free(ctx);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_leak_restart(PumpkinWindow *self, PumpkinServer *server, MemoryTrendEntry *entry, gboolean forced)
+{
+  if (entry->restart_scheduled) {
+    return;
+  }
+  entry->restart_scheduled = TRUE;
+  g_autofree char *alert = format_memory_trend_alert(entry);
+  g_autofree char *message = g_strdup_printf("[SMPK] %s; restarting %s.",
+                                             alert != NULL ? alert : "Memory is growing towards its limit",
+                                             forced ? "before the limit is reached" : "while the server is empty");
+  append_log_for_server(self, server, message);
+  if (forced) {
+    send_server_chat(server, "The server will restart in 30 seconds to free memory.");
+  }
+
+  RestartContext *ctx = g_new0(RestartContext, 1);
+  ctx->self = g_object_ref(self);
+  ctx->server = g_object_ref(server);
+  g_timeout_add_seconds(forced ? 30 : 0, leak_restart_delayed_cb, ctx);
+}
+
+static void
+leak_restart_probe_done(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  (void)source_object;
+  QueryPlayersContext *ctx = user_data;
+  PumpkinWindow *self = ctx->self;
+  g_autofree QueryResult *result = g_task_propagate_pointer(G_TASK(res), NULL);
+  MemoryTrendEntry *entry = lookup_memory_trend(self, ctx->server);
+  if (entry == NULL) {
+    return;
+  }
+  entry->probe_in_flight = FALSE;
+  if (result == NULL || !result->ok || result->players > 0) {
+    return;
+  }
+  if (entry->alert && pumpkin_server_get_running(ctx->server)) {
+    schedule_leak_restart(self, ctx->server, entry, FALSE);
+  }
+}
+
+/* Restart at the next empty moment, or unconditionally just before the limit. */
+static void
+maybe_schedule_leak_restart(PumpkinWindow *self, PumpkinServer *server, MemoryTrendEntry *entry, gint64 now_mono)
+{
+  if (!entry->alert || entry->restart_scheduled || entry->probe_in_flight ||
+      !pumpkin_server_get_leak_restart(server) ||
+      entry->seconds_to_limit > MEMORY_LEAK_RESTART_SECONDS) {
+    return;
+  }
+  if (entry->seconds_to_limit <= MEMORY_LEAK_FORCE_RESTART_SECONDS) {
+    schedule_leak_restart(self, server, entry, TRUE);
+    return;
+  }
+  if (server == self->current) {
+    if (get_overview_player_count(self, server) == 0) {
+      schedule_leak_restart(self, server, entry, FALSE);
+    }
+    return;
+  }
+  if (entry->last_probe_at > 0 && (now_mono - entry->last_probe_at) < MEMORY_LEAK_PROBE_INTERVAL_USEC) {
+    return;
+  }
+  int port = pumpkin_server_get_port(server);
+  if (port <= 0) {
+    return;
+  }
+  entry->last_probe_at = now_mono;
+  entry->probe_in_flight = TRUE;
+  QueryPlayersContext *ctx = g_new0(QueryPlayersContext, 1);
+  ctx->self = g_object_ref(self);
+  ctx->server = g_object_ref(server);
+  ctx->host = g_strdup("127.0.0.1");
+  ctx->port = port;
+
+  GTask *task = g_task_new(self, NULL, leak_restart_probe_done, ctx);
+  g_task_set_task_data(task, ctx, (GDestroyNotify)query_players_context_free);
+  g_task_run_in_thread(task, query_players_task);
+  g_object_unref(task);
+}
+
+static void
+update_memory_trends(PumpkinWindow *self, gint64 now_mono)
+{
+  GListModel *model = get_server_model(self);
+  if (model == NULL || self->memory_trends == NULL) {
+    return;
+  }
+
+  unsigned long long host_total = 0;
+  unsigned long long host_avail = 0;
+  read_system_mem(&host_total, &host_avail);
+
+  gboolean changed = FALSE;
+  guint n = g_list_model_get_n_items(model);
+  for (guint i = 0; i < n; i++) {
+    g_autoptr(PumpkinServer) server = g_list_model_get_item(model, i);
+    const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+    if (id == NULL) {
+      continue;
+    }
+    MemoryTrendEntry *entry = g_hash_table_lookup(self->memory_trends, id);
+    int pid = pumpkin_server_get_running(server) ? pumpkin_server_get_pid(server) : 0;
+    unsigned long long proc_ticks = 0;
+    unsigned long long rss = 0;
+    if (pid <= 0 || !read_process_stats(pid, &proc_ticks, &rss) || rss == 0) {
+      if (entry != NULL) {
+        changed = changed || entry->alert;
+        g_hash_table_remove(self->memory_trends, id);
       }
-      if (next == NULL) {
-        break;
+      continue;
+    }
+
+    if (entry == NULL) {
+      entry = g_new0(MemoryTrendEntry, 1);
+      entry->trend = pumpkin_memory_trend_new();
+      g_hash_table_replace(self->memory_trends, g_strdup(id), entry);
+    }
+    if (entry->pid != pid) {
+      pumpkin_memory_trend_reset(entry->trend);
+      entry->pid = pid;
+    }
+    pumpkin_server_note_rss(server, rss);
+    startup_note_rss(self, server, rss, now_mono);
+    pumpkin_memory_trend_add(entry->trend, now_mono, rss);
+    pumpkin_memory_trend_estimate(entry->trend, &entry->estimate);
+
+    int max_ram_mb = pumpkin_server_get_max_ram_mb(server);
+    guint64 limit = max_ram_mb > 0 ? (guint64)max_ram_mb * 1024ULL * 1024ULL : (guint64)host_total;
+    entry->limit_is_host = max_ram_mb <= 0;
+    entry->seconds_to_limit = entry->estimate.leaking
+                                ? pumpkin_memory_trend_seconds_to_limit(&entry->estimate, limit)
+                                : -1;
+    gboolean alert = entry->seconds_to_limit >= 0 && entry->seconds_to_limit <= MEMORY_LEAK_ALERT_SECONDS;
+    if (alert != entry->alert) {
+      entry->alert = alert;
+      changed = TRUE;
+      if (alert) {
+        g_autofree char *text = format_memory_trend_alert(entry);
+        g_autofree char *message = g_strdup_printf("[SMPK] %s.", text);
+        append_log_for_server(self, server, message);
       }
-      line = next + 1;
     }
+    maybe_schedule_leak_restart(self, server, entry, now_mono);
   }
 
-  return TRUE;
+  if (changed) {
+    queue_overview_refresh(self, FALSE);
+  }
+}
+
+typedef struct {
+  PumpkinPressureResource resource;
+  gboolean full;
+  guint stall_usec;
+} PressureTriggerSpec;
+
+/* Thresholds are stall time within one PRESSURE_WINDOW_USEC window. */
+static const PressureTriggerSpec pressure_trigger_specs[] = {
+  { PUMPKIN_PRESSURE_MEMORY, FALSE, PRESSURE_WINDOW_USEC / 10 },
+  { PUMPKIN_PRESSURE_MEMORY, TRUE, PRESSURE_WINDOW_USEC / 20 },
+  { PUMPKIN_PRESSURE_CPU, FALSE, PRESSURE_WINDOW_USEC / 5 },
+  { PUMPKIN_PRESSURE_IO, TRUE, PRESSURE_WINDOW_USEC / 20 }
+};
+
+static const char *
+pressure_resource_title(PumpkinPressureResource resource)
+{
+  switch (resource) {
+    case PUMPKIN_PRESSURE_CPU:
+      return "CPU";
+    case PUMPKIN_PRESSURE_MEMORY:
+      return "Memory";
+    case PUMPKIN_PRESSURE_IO:
+      return "I/O";
+    default:
+      return "";
+  }
+}
+
+static void
+pressure_watch_free(PressureWatch *watch)
+{
+  if (watch == NULL) {
+    return;
+  }
+  if (watch->source_id != 0) {
+    g_source_remove(watch->source_id);
+  }
+#if !defined(G_OS_WIN32)
+  if (watch->fd >= 0) {
+    close(watch->fd);
+  }
+#endif
+  g_free(watch->server_id);
+  g_free(watch->path);
+  g_free(watch);
+}
+
+static PressureWatch *
+lookup_pressure_alert(PumpkinWindow *self, PumpkinServer *server)
+{
+  if (self == NULL || server == NULL || self->pressure_watches == NULL) {
+    return NULL;
+  }
+  const char *id = pumpkin_server_get_id(server);
+  gint64 now = g_get_monotonic_time();
+  PressureWatch *latest = NULL;
+  for (guint i = 0; i < self->pressure_watches->len; i++) {
+    PressureWatch *watch = g_ptr_array_index(self->pressure_watches, i);
+    if (g_strcmp0(watch->server_id, id) != 0 || watch->last_event_at == 0 ||
+        (now - watch->last_event_at) >= PRESSURE_ALERT_HOLD_USEC) {
+      continue;
+    }
+    if (latest == NULL || watch->last_event_at > latest->last_event_at) {
+      latest = watch;
+    }
+  }
+  return latest;
+}
+
+static char *
+format_pressure_alert(PressureWatch *watch)
+{
+  if (watch == NULL) {
+    return NULL;
+  }
+  return g_strdup_printf("%s%s pressure · tasks %s stalled %.1f%% of the last 10 s",
+                         watch->server_id == NULL ? "Host " : "",
+                         pressure_resource_title(watch->resource),
+                         watch->full ? "fully" : "partly",
+                         watch->last_stall_pct);
+}
+
+#if !defined(G_OS_WIN32)
+static gboolean
+pressure_watch_cb(int fd, GIOCondition condition, gpointer data)
+{
+  PressureWatch *watch = data;
+  PumpkinWindow *self = watch->self;
+  (void)fd;
+
+  if ((condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL)) != 0) {
+    /* The cgroup went away with its server. */
+    watch->source_id = 0;
+    g_ptr_array_remove(self->pressure_watches, watch);
+    return G_SOURCE_REMOVE;
+  }
+
+  gint64 now = g_get_monotonic_time();
+  gboolean was_active = watch->last_event_at > 0 && (now - watch->last_event_at) < PRESSURE_ALERT_HOLD_USEC;
+  watch->last_event_at = now;
+  PumpkinPressure pressure;
+  if (pumpkin_pressure_read(watch->path, &pressure)) {
+    watch->last_stall_pct = watch->full ? pressure.full_avg10 : pressure.some_avg10;
+  }
+  if (was_active) {
+    return G_SOURCE_CONTINUE;
+  }
+
+  g_autofree char *alert = format_pressure_alert(watch);
+  g_autofree char *message = g_strdup_printf("[SMPK] %s.", alert);
+  if (watch->server_id == NULL) {
+    append_log(self, message);
+    set_details_status(self, alert, 8);
+    return G_SOURCE_CONTINUE;
+  }
+
+  PumpkinServer *server = find_server_by_id(self, watch->server_id);
+  if (server != NULL) {
+    append_log_for_server(self, server, message);
+    set_details_status_for_server(self, server, alert, 8);
+  }
+  queue_overview_refresh(self, FALSE);
+  return G_SOURCE_CONTINUE;
+}
+#endif
+
+static void
+add_pressure_watches(PumpkinWindow *self, const char *server_id, const char *cgroup_dir)
+{
+#if !defined(G_OS_WIN32)
+  for (guint i = 0; i < G_N_ELEMENTS(pressure_trigger_specs); i++) {
+    const PressureTriggerSpec *spec = &pressure_trigger_specs[i];
+    g_autofree char *path = pumpkin_pressure_path(cgroup_dir, spec->resource);
+    g_autoptr(GError) error = NULL;
+    int fd = pumpkin_pressure_trigger_open(path, spec->full, spec->stall_usec, PRESSURE_WINDOW_USEC, &error);
+    if (fd < 0) {
+      g_debug("Pressure trigger unavailable: %s", error != NULL ? error->message : path);
+      continue;
+    }
+    PressureWatch *watch = g_new0(PressureWatch, 1);
+    watch->self = self;
+    watch->server_id = g_strdup(server_id);
+    watch->path = g_steal_pointer(&path);
+    watch->resource = spec->resource;
+    watch->full = spec->full;
+    watch->fd = fd;
+    watch->source_id = g_unix_fd_add(fd, G_IO_PRI | G_IO_ERR, pressure_watch_cb, watch);
+    g_ptr_array_add(self->pressure_watches, watch);
+  }
+#else
+  (void)self;
+  (void)server_id;
+  (void)cgroup_dir;
 #endif
 }
 
+/* Host triggers are armed once; per-server ones follow the servers' cgroups. */
+static void
+sync_pressure_watches(PumpkinWindow *self)
+{
+  if (self->pressure_watches == NULL || !pumpkin_pressure_supported()) {
+    return;
+  }
+  if (!self->host_pressure_armed) {
+    self->host_pressure_armed = TRUE;
+    add_pressure_watches(self, NULL, NULL);
+  }
+
+  GListModel *model = get_server_model(self);
+  g_autoptr(GHashTable) cgroups = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  guint n = model != NULL ? g_list_model_get_n_items(model) : 0;
+  for (guint i = 0; i < n; i++) {
+    g_autoptr(PumpkinServer) server = g_list_model_get_item(model, i);
+    const char *id = server != NULL ? pumpkin_server_get_id(server) : NULL;
+    if (id == NULL || !pumpkin_server_get_running(server)) {
+      continue;
+    }
+    char *dir = pumpkin_server_get_cgroup_path(server);
+    if (dir != NULL) {
+      g_hash_table_replace(cgroups, g_strdup(id), dir);
+    }
+  }
+
+  gboolean changed = FALSE;
+  for (guint i = self->pressure_watches->len; i > 0; i--) {
+    PressureWatch *watch = g_ptr_array_index(self->pressure_watches, i - 1);
+    if (watch->server_id == NULL) {
+      continue;
+    }
+    const char *dir = g_hash_table_lookup(cgroups, watch->server_id);
+    if (dir != NULL && g_str_has_prefix(watch->path, dir)) {
+      g_hash_table_remove(cgroups, watch->server_id);
+      continue;
+    }
+    changed = changed || watch->last_event_at > 0;
+    g_ptr_array_remove_index(self->pressure_watches, i - 1);
+  }
+
+  GHashTableIter iter;
+  gpointer key = NULL;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, cgroups);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    add_pressure_watches(self, key, value);
+  }
+  if (changed) {
+    queue_overview_refresh(self, FALSE);
+  }
+}
+
+static double
+pressure_stall_rate(guint64 total, guint64 previous, double elapsed_usec)
+{
+  if (elapsed_usec <= 0.0 || total < previous) {
+    return 0.0;
+  }
+  return CLAMP((double)(total - previous) / elapsed_usec * 100.0, 0.0, 100.0);
+}
+
+/* Stall percentages come from total deltas so short spikes show up between avg10 updates. */
+static gboolean
+sample_pressure(PumpkinWindow *self, gint64 now_mono, double *host_out, double *server_out)
+{
+  double elapsed = self->last_pressure_sample_at > 0 ? (double)(now_mono - self->last_pressure_sample_at) : 0.0;
+  g_autofree char *cgroup_dir = self->current != NULL ? pumpkin_server_get_cgroup_path(self->current) : NULL;
+  gboolean server_valid = cgroup_dir != NULL;
+  for (int r = 0; r < PUMPKIN_PRESSURE_COUNT; r++) {
+    g_autofree char *host_path = pumpkin_pressure_path(NULL, r);
+    PumpkinPressure host;
+    if (pumpkin_pressure_read(host_path, &host)) {
+      host_out[r] = pressure_stall_rate(host.some_total_usec, self->last_host_pressure[r].some_total_usec, elapsed);
+      self->last_host_pressure[r] = host;
+    } else {
+      host_out[r] = 0.0;
+    }
+
+    PumpkinPressure server = { 0 };
+    if (server_valid) {
+      g_autofree char *server_path = pumpkin_pressure_path(cgroup_dir, r);
+      server_valid = pumpkin_pressure_read(server_path, &server);
+    }
+    server_out[r] = server_valid && self->last_server_pressure_valid
+                      ? pressure_stall_rate(server.some_total_usec,
+                                            self->last_server_pressure[r].some_total_usec,
+                                            elapsed)
+                      : 0.0;
+    self->last_server_pressure[r] = server;
+  }
+  self->last_server_pressure_valid = server_valid;
+  self->last_pressure_sample_at = now_mono;
+  return server_valid;
+}
+
 static gboolean
 update_stats_tick(gpointer data)
 {
@@ -6638,6 +8108,11 @@ update_stats_tick(gpointer data)
       (now_mono - self->last_player_state_flush_at) >= PLAYER_STATE_FLUSH_INTERVAL_USEC) {
     player_states_save(self, self->current);
   }
+  if ((now_mono - self->network_players_flushed_at) >= PLAYER_STATE_FLUSH_INTERVAL_USEC) {
+    network_players_save(self);
+    sessions_flush(self);
+    join_latency_flush(self);
+  }
 
   if (pid != self->last_proc_pid) {
     self->last_proc_jiffies = 0;
@@ -6667,6 +8142,99 @@ update_stats_tick(gpointer data)
     }
   }
 
+  double io_read_rate = 0.0;
+  double io_write_rate = 0.0;
+  double io_read_ops = 0.0;
+  double io_write_ops = 0.0;
+  double faults_major_rate = 0.0;
+  double faults_minor_rate = 0.0;
+  gboolean io_valid = FALSE;
+  PumpkinProcessIo proc_io;
+  if (server_running && pid > 0 && pumpkin_process_read_io(pid, &proc_io)) {
+    if (pid == self->last_proc_io_pid && self->last_proc_io_at > 0 && now_mono > self->last_proc_io_at) {
+      double elapsed = (double)(now_mono - self->last_proc_io_at) / (double)G_USEC_PER_SEC;
+      io_read_rate = counter_rate(proc_io.read_bytes, self->last_proc_io.read_bytes, elapsed);
+      io_write_rate = counter_rate(proc_io.write_bytes, self->last_proc_io.write_bytes, elapsed);
+      io_read_ops = counter_rate(proc_io.read_syscalls, self->last_proc_io.read_syscalls, elapsed);
+      io_write_ops = counter_rate(proc_io.write_syscalls, self->last_proc_io.write_syscalls, elapsed);
+      faults_major_rate = counter_rate(proc_io.major_faults, self->last_proc_io.major_faults, elapsed);
+      faults_minor_rate = counter_rate(proc_io.minor_faults, self->last_proc_io.minor_faults, elapsed);
+      io_valid = TRUE;
+    }
+    self->last_proc_io = proc_io;
+    self->last_proc_io_at = now_mono;
+    self->last_proc_io_pid = pid;
+  } else {
+    self->last_proc_io_at = 0;
+    self->last_proc_io_pid = 0;
+  }
+
+  double sched_wait_ms = 0.0;
+  double sched_wait_share = 0.0;
+  double ctx_voluntary_rate = 0.0;
+  double ctx_involuntary_rate = 0.0;
+  gboolean sched_valid = FALSE;
+  PumpkinProcessSched proc_sched;
+  if (self->sched_sampler == NULL) {
+    self->sched_sampler = pumpkin_sched_sampler_new();
+  }
+  if (server_running && pid > 0 && pumpkin_sched_sampler_read(self->sched_sampler, pid, &proc_sched)) {
+    if (pid == self->last_proc_sched_pid && self->last_proc_sched_at > 0 && now_mono > self->last_proc_sched_at) {
+      double elapsed = (double)(now_mono - self->last_proc_sched_at) / (double)G_USEC_PER_SEC;
+      double wait_ns = counter_rate(proc_sched.wait_ns, self->last_proc_sched.wait_ns, elapsed);
+      double run_ns = counter_rate(proc_sched.run_ns, self->last_proc_sched.run_ns, elapsed);
+      sched_wait_ms = wait_ns / 1000000.0;
+      if (wait_ns + run_ns > 0.0) {
+        sched_wait_share = wait_ns / (wait_ns + run_ns) * 100.0;
+      }
+      ctx_voluntary_rate = counter_rate(proc_sched.voluntary_switches,
+                                        self->last_proc_sched.voluntary_switches, elapsed);
+      ctx_involuntary_rate = counter_rate(proc_sched.involuntary_switches,
+                                          self->last_proc_sched.involuntary_switches, elapsed);
+      sched_valid = TRUE;
+    }
+    self->last_proc_sched = proc_sched;
+    self->last_proc_sched_at = now_mono;
+    self->last_proc_sched_pid = pid;
+  } else {
+    self->last_proc_sched_at = 0;
+    self->last_proc_sched_pid = 0;
+  }
+
+  PumpkinProcessMemory proc_memory = { 0 };
+  gboolean memory_valid = server_running && pid > 0 &&
+                          lookup_server_memory_rollup(self, self->current, &proc_memory);
+
+  if (self->last_memory_trend_at == 0 || (now_mono - self->last_memory_trend_at) >= MEMORY_TREND_INTERVAL_USEC) {
+    self->last_memory_trend_at = now_mono;
+    update_memory_trends(self, now_mono);
+    sync_pressure_watches(self);
+    update_hibernation(self, now_mono);
+    update_watchdogs(self, now_mono);
+  }
+
+  double psi_host[PUMPKIN_PRESSURE_COUNT] = { 0 };
+  double psi_server[PUMPKIN_PRESSURE_COUNT] = { 0 };
+  gboolean psi_valid = pumpkin_pressure_supported();
+  gboolean psi_server_valid = psi_valid && server_running && sample_pressure(self, now_mono, psi_host, psi_server);
+
+  /* sock_diag dumps every socket on the host, so it runs at most once a second. */
+  if (server_running && pid > 0 && pumpkin_tcp_diag_supported()) {
+    if (self->last_tcp_sample_at == 0 || (now_mono - self->last_tcp_sample_at) >= G_USEC_PER_SEC) {
+      update_tcp_sample(self, pid, now_mono);
+    }
+  } else if (self->last_tcp_sample_at != 0) {
+    pumpkin_tcp_sample_clear(&self->last_tcp_sample);
+    memset(&self->last_tcp_sample, 0, sizeof(self->last_tcp_sample));
+    self->last_tcp_sample_at = 0;
+    pumpkin_tcp_sampler_reset(self->tcp_sampler);
+    if (self->player_ping_by_ip != NULL) {
+      g_hash_table_remove_all(self->player_ping_by_ip);
+    }
+    refresh_player_ping_chips(self);
+  }
+  gboolean net_valid = self->last_tcp_sample.rates_valid;
+
   if (server_running && pid > 0 && rss > 0) {
     g_autofree char *rss_str = g_format_size_full(rss, G_FORMAT_SIZE_IEC_UNITS);
     g_autofree char *ram = g_strdup_printf("Pumpkin RAM: %s", rss_str);
@@ -6711,34 +8279,76 @@ update_stats_tick(gpointer data)
       } else if (tps_value > 20.0) {
         tps_value = 20.0;
       }
-      self->stats_disk_mb[self->stats_index] = tps_value;
+      self->stats_tps[self->stats_index] = tps_value;
     } else if (self->stats_count > 0) {
       int last_idx = self->stats_index - 1;
       if (last_idx < 0) {
         last_idx = STATS_SAMPLES - 1;
       }
-      self->stats_disk_mb[self->stats_index] = self->stats_disk_mb[last_idx];
+      self->stats_tps[self->stats_index] = self->stats_tps[last_idx];
     } else {
-      self->stats_disk_mb[self->stats_index] = 0.0;
+      self->stats_tps[self->stats_index] = 0.0;
     }
 
     self->stats_cpu[self->stats_index] = proc_cpu;
     self->stats_ram_mb[self->stats_index] = ram_pct;
     self->stats_players[self->stats_index] = (double)players_count;
+    self->stats_io_read_mb[self->stats_index] = io_read_rate / (1024.0 * 1024.0);
+    self->stats_io_write_mb[self->stats_index] = io_write_rate / (1024.0 * 1024.0);
+    self->stats_faults_major[self->stats_index] = faults_major_rate;
+    self->stats_faults_minor[self->stats_index] = faults_minor_rate;
+    self->stats_net_rx_kb[self->stats_index] = self->last_tcp_sample.rx_bytes_per_sec / 1024.0;
+    self->stats_net_tx_kb[self->stats_index] = self->last_tcp_sample.tx_bytes_per_sec / 1024.0;
+    self->stats_sched_wait_ms[self->stats_index] = sched_wait_ms;
+    self->stats_ctx_voluntary[self->stats_index] = ctx_voluntary_rate;
+    self->stats_ctx_involuntary[self->stats_index] = ctx_involuntary_rate;
+    self->stats_mem_anon_mb[self->stats_index] = (double)proc_memory.anon / (1024.0 * 1024.0);
+    self->stats_mem_file_mb[self->stats_index] = (double)proc_memory.file / (1024.0 * 1024.0);
+    self->stats_mem_shmem_mb[self->stats_index] = (double)proc_memory.shmem / (1024.0 * 1024.0);
+    self->stats_mem_swap_mb[self->stats_index] = (double)proc_memory.swap / (1024.0 * 1024.0);
+    self->stats_mem_pss_mb[self->stats_index] = (double)proc_memory.pss / (1024.0 * 1024.0);
+    for (int r = 0; r < PUMPKIN_PRESSURE_COUNT; r++) {
+      self->stats_psi_host[r][self->stats_index] = psi_host[r];
+      self->stats_psi_server[r][self->stats_index] = psi_server[r];
+    }
     self->stats_index = (self->stats_index + 1) % STATS_SAMPLES;
     if (self->stats_count < STATS_SAMPLES) {
       self->stats_count++;
     }
   }
-
-  if (self->stats_graph_usage != NULL) {
-    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_usage));
+
+  if (self->stats_graph_usage != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_usage));
+  }
+  if (self->stats_graph_players != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_players));
+  }
+  if (self->stats_graph_tps != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_tps));
+  }
+  if (self->stats_graph_io != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_io));
+  }
+  if (self->stats_graph_faults != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_faults));
+  }
+  if (self->stats_graph_net != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_net));
+  }
+  if (self->stats_graph_sched != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_sched));
+  }
+  if (self->stats_graph_ctx != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_ctx));
+  }
+  if (self->stats_graph_mem != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_mem));
   }
-  if (self->stats_graph_players != NULL) {
-    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_players));
+  if (self->stats_graph_psi_host != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_psi_host));
   }
-  if (self->stats_graph_disk != NULL) {
-    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_disk));
+  if (self->stats_graph_psi_server != NULL) {
+    gtk_widget_queue_draw(GTK_WIDGET(self->stats_graph_psi_server));
   }
 
   if (server_running) {
@@ -6761,12 +8371,12 @@ update_stats_tick(gpointer data)
         gtk_label_set_text(self->label_stats_ram, "RAM --");
       }
     }
-    if (self->label_stats_disk != NULL) {
+    if (self->label_stats_tps != NULL) {
       if (self->last_tps_valid) {
         g_autofree char *val = g_strdup_printf("TPS %.1f", self->last_tps);
-        gtk_label_set_text(self->label_stats_disk, val);
+        gtk_label_set_text(self->label_stats_tps, val);
       } else {
-        gtk_label_set_text(self->label_stats_disk, "TPS --");
+        gtk_label_set_text(self->label_stats_tps, "TPS --");
       }
     }
     if (self->label_stats_players != NULL) {
@@ -6778,6 +8388,143 @@ update_stats_tick(gpointer data)
       }
       gtk_label_set_text(self->label_stats_players, val);
     }
+    if (self->label_stats_io_read != NULL && self->label_stats_io_write != NULL) {
+      if (io_valid) {
+        g_autofree char *read_str = g_format_size_full((guint64)io_read_rate, G_FORMAT_SIZE_IEC_UNITS);
+        g_autofree char *write_str = g_format_size_full((guint64)io_write_rate, G_FORMAT_SIZE_IEC_UNITS);
+        g_autofree char *read_val = g_strdup_printf("Disk read %s/s (%.0f ops/s)", read_str, io_read_ops);
+        g_autofree char *write_val = g_strdup_printf("Disk write %s/s (%.0f ops/s)", write_str, io_write_ops);
+        gtk_label_set_text(self->label_stats_io_read, read_val);
+        gtk_label_set_text(self->label_stats_io_write, write_val);
+      } else {
+        gtk_label_set_text(self->label_stats_io_read, "Disk read --");
+        gtk_label_set_text(self->label_stats_io_write, "Disk write --");
+      }
+    }
+    if (self->label_stats_faults_major != NULL && self->label_stats_faults_minor != NULL) {
+      if (io_valid) {
+        g_autofree char *major_val = g_strdup_printf("Major faults %.0f/s", faults_major_rate);
+        g_autofree char *minor_val = g_strdup_printf("Minor faults %.0f/s", faults_minor_rate);
+        gtk_label_set_text(self->label_stats_faults_major, major_val);
+        gtk_label_set_text(self->label_stats_faults_minor, minor_val);
+      } else {
+        gtk_label_set_text(self->label_stats_faults_major, "Major faults --");
+        gtk_label_set_text(self->label_stats_faults_minor, "Minor faults --");
+      }
+    }
+    if (self->label_stats_net_rx != NULL && self->label_stats_net_tx != NULL) {
+      if (net_valid) {
+        g_autofree char *rx_str = g_format_size_full((guint64)self->last_tcp_sample.rx_bytes_per_sec,
+                                                     G_FORMAT_SIZE_IEC_UNITS);
+        g_autofree char *tx_str = g_format_size_full((guint64)self->last_tcp_sample.tx_bytes_per_sec,
+                                                     G_FORMAT_SIZE_IEC_UNITS);
+        g_autofree char *rx_val = g_strdup_printf("Net in %s/s", rx_str);
+        g_autofree char *tx_val = g_strdup_printf("Net out %s/s", tx_str);
+        gtk_label_set_text(self->label_stats_net_rx, rx_val);
+        gtk_label_set_text(self->label_stats_net_tx, tx_val);
+      } else {
+        gtk_label_set_text(self->label_stats_net_rx, "Net in --");
+        gtk_label_set_text(self->label_stats_net_tx, "Net out --");
+      }
+    }
+    if (self->label_stats_net_conns != NULL) {
+      if (self->last_tcp_sample.connections != NULL) {
+        g_autofree char *val = g_strdup_printf("%u connections · %u retransmits",
+                                               self->last_tcp_sample.connections->len,
+                                               self->last_tcp_sample.retransmits);
+        gtk_label_set_text(self->label_stats_net_conns, val);
+      } else {
+        gtk_label_set_text(self->label_stats_net_conns, "Connections --");
+      }
+    }
+    if (self->label_stats_sched_wait != NULL) {
+      if (sched_valid) {
+        g_autofree char *val = g_strdup_printf("Run-queue wait %.1f ms/s (%.0f%% of scheduled time)",
+                                               sched_wait_ms, sched_wait_share);
+        gtk_label_set_text(self->label_stats_sched_wait, val);
+      } else {
+        gtk_label_set_text(self->label_stats_sched_wait, "Run-queue wait --");
+      }
+    }
+    if (self->label_stats_ctx_voluntary != NULL && self->label_stats_ctx_involuntary != NULL) {
+      if (sched_valid) {
+        g_autofree char *voluntary_val = g_strdup_printf("Voluntary switches %.0f/s", ctx_voluntary_rate);
+        g_autofree char *involuntary_val = g_strdup_printf("Involuntary switches %.0f/s", ctx_involuntary_rate);
+        gtk_label_set_text(self->label_stats_ctx_voluntary, voluntary_val);
+        gtk_label_set_text(self->label_stats_ctx_involuntary, involuntary_val);
+      } else {
+        gtk_label_set_text(self->label_stats_ctx_voluntary, "Voluntary switches --");
+        gtk_label_set_text(self->label_stats_ctx_involuntary, "Involuntary switches --");
+      }
+    }
+    if (self->label_stats_mem_anon != NULL) {
+      struct {
+        GtkLabel *label;
+        const char *name;
+        guint64 value;
+      } memory_labels[] = {
+        { self->label_stats_mem_anon, "Anon", proc_memory.anon },
+        { self->label_stats_mem_file, "File", proc_memory.file },
+        { self->label_stats_mem_shmem, "Shmem", proc_memory.shmem },
+        { self->label_stats_mem_swap, "Swap", proc_memory.swap },
+        { self->label_stats_mem_pss, "PSS", proc_memory.pss }
+      };
+      for (guint i = 0; i < G_N_ELEMENTS(memory_labels); i++) {
+        if (memory_labels[i].label == NULL) {
+          continue;
+        }
+        if (memory_valid) {
+          g_autofree char *size = g_format_size_full(memory_labels[i].value, G_FORMAT_SIZE_IEC_UNITS);
+          g_autofree char *val = g_strdup_printf("%s %s", memory_labels[i].name, size);
+          gtk_label_set_text(memory_labels[i].label, val);
+        } else {
+          g_autofree char *val = g_strdup_printf("%s --", memory_labels[i].name);
+          gtk_label_set_text(memory_labels[i].label, val);
+        }
+      }
+    }
+    if (self->label_stats_psi_host_memory != NULL) {
+      GtkLabel *host_labels[PUMPKIN_PRESSURE_COUNT] = {
+        self->label_stats_psi_host_cpu,
+        self->label_stats_psi_host_memory,
+        self->label_stats_psi_host_io
+      };
+      GtkLabel *server_labels[PUMPKIN_PRESSURE_COUNT] = {
+        self->label_stats_psi_cpu,
+        self->label_stats_psi_memory,
+        self->label_stats_psi_io
+      };
+      for (int r = 0; r < PUMPKIN_PRESSURE_COUNT; r++) {
+        const char *title = pressure_resource_title(r);
+        if (host_labels[r] != NULL) {
+          g_autofree char *val = psi_valid
+                                   ? g_strdup_printf("Host %s %.1f%% · full %.1f%%", title,
+                                                     self->last_host_pressure[r].some_avg10,
+                                                     self->last_host_pressure[r].full_avg10)
+                                   : g_strdup_printf("Host %s --", title);
+          gtk_label_set_text(host_labels[r], val);
+        }
+        if (server_labels[r] != NULL) {
+          g_autofree char *val = psi_server_valid
+                                   ? g_strdup_printf("Server %s %.1f%% · full %.1f%%", title,
+                                                     self->last_server_pressure[r].some_avg10,
+                                                     self->last_server_pressure[r].full_avg10)
+                                   : g_strdup_printf("Server %s --", title);
+          gtk_label_set_text(server_labels[r], val);
+        }
+      }
+    }
+    if (self->label_stats_psi_alert != NULL) {
+      g_autofree char *alert = format_pressure_alert(lookup_pressure_alert(self, self->current));
+      if (alert != NULL) {
+        gtk_label_set_text(self->label_stats_psi_alert, alert);
+      } else if (!psi_server_valid) {
+        gtk_label_set_text(self->label_stats_psi_alert,
+                           "Per-server pressure needs resource limits enforced through cgroups.");
+      } else {
+        gtk_label_set_text(self->label_stats_psi_alert, "No stalls above the alert thresholds.");
+      }
+    }
   }
 
   if (now_mono - self->last_auto_update_eval_at >= G_USEC_PER_SEC) {
@@ -7091,6 +8838,57 @@ player_lookup_add_op_level(GHashTable *map, const char *name, const char *uuid,
   }
 }
 
+static void
+add_player_entries_to_lookup(GPtrArray *entries, GHashTable *set, GHashTable *reasons, GHashTable *ip_reasons,
+                             GHashTable *op_levels)
+{
+  for (guint i = 0; entries != NULL && i < entries->len; i++) {
+    PlayerEntry *entry = g_ptr_array_index(entries, i);
+    if (entry == NULL) {
+      continue;
+    }
+    if (set != NULL) {
+      player_lookup_add_set(set, entry->name, entry->uuid);
+    }
+    if (reasons != NULL) {
+      player_lookup_add_reason(reasons, entry->name, entry->uuid, entry->reason);
+    }
+    if (ip_reasons != NULL) {
+      player_lookup_add_ip_reason(ip_reasons, entry->ip, entry->reason);
+    }
+    if (op_levels != NULL) {
+      player_lookup_add_op_level(op_levels, entry->name, entry->uuid, entry->op_level);
+    }
+  }
+}
+
+/* Rebuilt only when the watcher reports a change to one of the json files. */
+static void
+ensure_player_lookup_maps(PumpkinWindow *self)
+{
+  guint64 generation = player_watch_get_generation(self);
+  if (self->player_whitelist_set != NULL && generation != 0 && generation == self->player_lookup_generation) {
+    return;
+  }
+  self->player_lookup_generation = generation;
+  g_clear_pointer(&self->player_whitelist_set, g_hash_table_unref);
+  g_clear_pointer(&self->player_banned_reason_map, g_hash_table_unref);
+  g_clear_pointer(&self->player_banned_ip_reason_map, g_hash_table_unref);
+  g_clear_pointer(&self->player_op_level_map, g_hash_table_unref);
+  self->player_whitelist_set = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  self->player_banned_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  self->player_banned_ip_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  self->player_op_level_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  add_player_entries_to_lookup(player_watch_get_entries(self, PLAYER_DATA_WHITELIST), self->player_whitelist_set,
+                               NULL, NULL, NULL);
+  add_player_entries_to_lookup(player_watch_get_entries(self, PLAYER_DATA_BANNED_PLAYERS), NULL,
+                               self->player_banned_reason_map, NULL, NULL);
+  add_player_entries_to_lookup(player_watch_get_entries(self, PLAYER_DATA_BANNED_IPS), NULL, NULL,
+                               self->player_banned_ip_reason_map, NULL);
+  add_player_entries_to_lookup(player_watch_get_entries(self, PLAYER_DATA_OPS), NULL, NULL, NULL,
+                               self->player_op_level_map);
+}
+
 static gboolean
 player_is_admin_from_op_level(int op_level)
 {
@@ -7132,149 +8930,163 @@ player_lookup_reason_for_ip_variants(GHashTable *map, const char *ip)
   return NULL;
 }
 
+/* Every chip a player row can show; rows are built once and only their labels change on rebind. */
+typedef struct {
+  GtkWidget *root;
+  GtkWidget *avatar;
+  GtkWidget *name_label;
+  GtkWidget *platform_chip;
+  GtkWidget *status_chip;
+  GtkWidget *whitelist_chip;
+  GtkWidget *ban_chip;
+  GtkWidget *ip_ban_chip;
+  GtkWidget *ping_chip;
+  GtkWidget *role_chip;
+  GtkWidget *meta_label;
+} PlayerRowWidgets;
+
+static GtkWidget *
+player_row_chip(GtkWidget *title_row, const char *text, const char *style)
+{
+  GtkWidget *chip = gtk_label_new(text);
+  gtk_widget_add_css_class(chip, "status-badge");
+  if (style != NULL) {
+    gtk_widget_add_css_class(chip, style);
+  }
+  gtk_box_append(GTK_BOX(title_row), chip);
+  return chip;
+}
+
 static void
-append_player_state_row(PumpkinWindow *self,
-                        GtkListBox *list,
-                        PlayerState *state,
-                        gboolean whitelisted,
-                        gboolean banned,
-                        const char *ban_reason,
-                        gboolean ip_banned,
-                        const char *ip_ban_reason,
-                        int op_level,
-                        gboolean interactive)
+set_css_class(GtkWidget *widget, const char *css_class, gboolean enabled)
 {
-  if (self == NULL || list == NULL || state == NULL) {
-    return;
+  if (enabled) {
+    gtk_widget_add_css_class(widget, css_class);
+  } else {
+    gtk_widget_remove_css_class(widget, css_class);
   }
+}
+
+static PlayerRowWidgets *
+player_row_widgets_new(void)
+{
+  PlayerRowWidgets *row = g_new0(PlayerRowWidgets, 1);
+  row->root = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+  gtk_widget_set_margin_top(row->root, 4);
+  gtk_widget_set_margin_bottom(row->root, 4);
+  gtk_widget_set_margin_start(row->root, 4);
+  gtk_widget_set_margin_end(row->root, 4);
+
+  row->avatar = gtk_image_new_from_icon_name("avatar-default-symbolic");
+  gtk_image_set_pixel_size(GTK_IMAGE(row->avatar), 32);
+  gtk_box_append(GTK_BOX(row->root), row->avatar);
+
+  GtkWidget *text_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
+  gtk_widget_set_hexpand(text_box, TRUE);
+
+  GtkWidget *title_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+  row->name_label = gtk_label_new(NULL);
+  gtk_label_set_xalign(GTK_LABEL(row->name_label), 0.0);
+  gtk_widget_set_hexpand(row->name_label, TRUE);
+  gtk_box_append(GTK_BOX(title_row), row->name_label);
+
+  row->platform_chip = player_row_chip(title_row, NULL, "player-platform-badge");
+  row->status_chip = player_row_chip(title_row, NULL, NULL);
+  row->whitelist_chip = player_row_chip(title_row, "Whitelisted", "status-running");
+  row->ban_chip = player_row_chip(title_row, "Banned", "status-stopped");
+  row->ip_ban_chip = player_row_chip(title_row, "IP Banned", "status-stopped");
+  row->ping_chip = player_row_chip(title_row, "", "player-ping-badge");
+  row->role_chip = player_row_chip(title_row, NULL, NULL);
+  gtk_box_append(GTK_BOX(text_box), title_row);
+
+  row->meta_label = gtk_label_new(NULL);
+  gtk_label_set_xalign(GTK_LABEL(row->meta_label), 0.0);
+  gtk_widget_add_css_class(row->meta_label, "dim-label");
+  gtk_box_append(GTK_BOX(text_box), row->meta_label);
+
+  gtk_box_append(GTK_BOX(row->root), text_box);
+  return row;
+}
 
-  const char *display_name = state->name != NULL && *state->name != '\0'
-                               ? state->name
-                               : (state->uuid != NULL ? state->uuid : "Unknown");
+static void
+player_row_widgets_update(PumpkinWindow *self, PlayerRowWidgets *row, const PlayerRowInfo *info)
+{
+  const char *display_name = info->name != NULL && *info->name != '\0'
+                               ? info->name
+                               : (info->uuid != NULL ? info->uuid : "Unknown");
+  const char *ban_reason = info->ban_reason;
+  const char *ip_ban_reason = info->ip_ban_reason;
+  gboolean banned = info->banned;
+  gboolean ip_banned = info->ip_banned;
 
-  g_autofree char *playtime = format_duration(player_state_effective_playtime(state));
-  g_autofree char *last_seen = state->online
+  g_autofree char *playtime = format_duration(info->playtime_seconds);
+  g_autofree char *last_seen = info->online
                                 ? g_strdup("Online now")
-                                : relative_time_label(state->last_online_unix);
-  g_autofree char *first_joined = format_unix_time(self, state->first_joined_unix);
+                                : relative_time_label(info->last_online_unix);
+  g_autofree char *first_joined = format_unix_time(self, info->first_joined_unix);
 
-  g_autofree char *meta = g_strdup_printf("Played %s · Last seen %s · First joined %s",
-                                          playtime, last_seen, first_joined);
+  GString *meta = g_string_new(NULL);
+  g_string_printf(meta, "Played %s · Last seen %s · First joined %s", playtime, last_seen, first_joined);
   if (banned && ban_reason != NULL && *ban_reason != '\0') {
-    g_autofree char *with_reason = g_strdup_printf("%s · Ban reason: %s", meta, ban_reason);
-    g_free(meta);
-    meta = g_strdup(with_reason);
+    g_string_append_printf(meta, " · Ban reason: %s", ban_reason);
   }
   if (ip_banned) {
     if (ip_ban_reason != NULL && *ip_ban_reason != '\0') {
-      g_autofree char *with_ip_reason = g_strdup_printf("%s · IP ban reason: %s", meta, ip_ban_reason);
-      g_free(meta);
-      meta = g_strdup(with_ip_reason);
+      g_string_append_printf(meta, " · IP ban reason: %s", ip_ban_reason);
     } else {
-      g_autofree char *with_ip = g_strdup_printf("%s · IP banned", meta);
-      g_free(meta);
-      meta = g_strdup(with_ip);
+      g_string_append(meta, " · IP banned");
     }
   }
-  gboolean is_op = op_level >= 0;
-  gboolean is_admin = player_is_admin_from_op_level(op_level);
+  gboolean is_op = info->op_level >= 0;
+  gboolean is_admin = player_is_admin_from_op_level(info->op_level);
 
-  GtkWidget *row = gtk_list_box_row_new();
-  GtkWidget *box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
-  gtk_widget_set_margin_top(box, 4);
-  gtk_widget_set_margin_bottom(box, 4);
-  gtk_widget_set_margin_start(box, 4);
-  gtk_widget_set_margin_end(box, 4);
-
-  GtkWidget *avatar = gtk_image_new_from_icon_name("avatar-default-symbolic");
-  gtk_image_set_pixel_size(GTK_IMAGE(avatar), 32);
-  set_player_head_image(self, GTK_IMAGE(avatar), state->uuid);
-  gtk_box_append(GTK_BOX(box), avatar);
+  set_player_head_image(self, GTK_IMAGE(row->avatar), info->uuid);
+  gtk_label_set_text(GTK_LABEL(row->name_label), display_name);
+  set_css_class(row->name_label, "dim-label", !info->online);
+  gtk_label_set_text(GTK_LABEL(row->platform_chip), platform_label(info->platform));
 
-  GtkWidget *text_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
-  gtk_widget_set_hexpand(text_box, TRUE);
+  gtk_label_set_text(GTK_LABEL(row->status_chip), info->online ? "Online" : "Offline");
+  set_css_class(row->status_chip, "status-running", info->online);
+  set_css_class(row->status_chip, "status-stopped", !info->online);
 
-  GtkWidget *title_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
-  GtkWidget *name_label = gtk_label_new(display_name);
-  gtk_label_set_xalign(GTK_LABEL(name_label), 0.0);
-  gtk_widget_set_hexpand(name_label, TRUE);
-  if (!state->online) {
-    gtk_widget_add_css_class(name_label, "dim-label");
-  }
-  gtk_box_append(GTK_BOX(title_row), name_label);
-
-  GtkWidget *platform_chip = gtk_label_new(platform_label(state->platform));
-  gtk_widget_add_css_class(platform_chip, "status-badge");
-  gtk_widget_add_css_class(platform_chip, "player-platform-badge");
-  gtk_box_append(GTK_BOX(title_row), platform_chip);
-
-  GtkWidget *status_chip = gtk_label_new(state->online ? "Online" : "Offline");
-  gtk_widget_add_css_class(status_chip, "status-badge");
-  gtk_widget_add_css_class(status_chip, state->online ? "status-running" : "status-stopped");
-  gtk_box_append(GTK_BOX(title_row), status_chip);
-
-  if (whitelisted) {
-    GtkWidget *whitelist_chip = gtk_label_new("Whitelisted");
-    gtk_widget_add_css_class(whitelist_chip, "status-badge");
-    gtk_widget_add_css_class(whitelist_chip, "status-running");
-    gtk_box_append(GTK_BOX(title_row), whitelist_chip);
-  }
-  if (banned) {
-    GtkWidget *ban_chip = gtk_label_new("Banned");
-    gtk_widget_add_css_class(ban_chip, "status-badge");
-    gtk_widget_add_css_class(ban_chip, "status-stopped");
-    gtk_box_append(GTK_BOX(title_row), ban_chip);
-  }
-  if (ip_banned) {
-    GtkWidget *ip_ban_chip = gtk_label_new("IP Banned");
-    gtk_widget_add_css_class(ip_ban_chip, "status-badge");
-    gtk_widget_add_css_class(ip_ban_chip, "status-stopped");
-    gtk_box_append(GTK_BOX(title_row), ip_ban_chip);
-  }
-  if (is_admin) {
-    GtkWidget *admin_chip = gtk_label_new("ADMIN");
-    gtk_widget_add_css_class(admin_chip, "status-badge");
-    gtk_widget_add_css_class(admin_chip, "warning-badge");
-    gtk_box_append(GTK_BOX(title_row), admin_chip);
-  } else if (is_op) {
-    GtkWidget *op_chip = gtk_label_new("OP");
-    gtk_widget_add_css_class(op_chip, "status-badge");
-    gtk_widget_add_css_class(op_chip, "status-running");
-    gtk_box_append(GTK_BOX(title_row), op_chip);
+  gtk_widget_set_visible(row->whitelist_chip, info->whitelisted);
+  gtk_widget_set_visible(row->ban_chip, banned);
+  gtk_widget_set_visible(row->ip_ban_chip, ip_banned);
+  if (info->online && info->last_ip != NULL && *info->last_ip != '\0') {
+    update_player_ping_chip(self, row->ping_chip, info->last_ip);
+  } else {
+    gtk_widget_set_visible(row->ping_chip, FALSE);
   }
 
-  gtk_box_append(GTK_BOX(text_box), title_row);
+  gtk_label_set_text(GTK_LABEL(row->role_chip), is_admin ? "ADMIN" : "OP");
+  set_css_class(row->role_chip, "warning-badge", is_admin);
+  set_css_class(row->role_chip, "status-running", !is_admin);
+  gtk_widget_set_visible(row->role_chip, is_op || is_admin);
 
-  GtkWidget *meta_label = gtk_label_new(meta);
-  gtk_label_set_xalign(GTK_LABEL(meta_label), 0.0);
-  gtk_widget_add_css_class(meta_label, "dim-label");
-  if (!state->online) {
-    gtk_widget_add_css_class(meta_label, "player-offline-meta");
-  }
-  gtk_box_append(GTK_BOX(text_box), meta_label);
+  gtk_label_set_text(GTK_LABEL(row->meta_label), meta->str);
+  set_css_class(row->meta_label, "player-offline-meta", !info->online);
+  g_string_free(meta, TRUE);
+}
 
-  gtk_box_append(GTK_BOX(box), text_box);
-  gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), box);
-  gtk_list_box_append(list, row);
+static GtkWidget *
+build_player_row(PumpkinWindow *self, const PlayerRowInfo *info)
+{
+  PlayerRowWidgets *row = player_row_widgets_new();
+  player_row_widgets_update(self, row, info);
+  GtkWidget *root = row->root;
+  g_free(row);
+  return root;
+}
 
-  if (interactive) {
-    if (state->name != NULL && *state->name != '\0') {
-      g_object_set_data_full(G_OBJECT(row), "player-name", g_strdup(state->name), g_free);
-    }
-    if (state->uuid != NULL) {
-      g_object_set_data_full(G_OBJECT(row), "player-uuid", g_strdup(state->uuid), g_free);
-    }
-    if (state->key != NULL) {
-      g_object_set_data_full(G_OBJECT(row), "player-key", g_strdup(state->key), g_free);
-    }
-    if (state->last_ip != NULL && *state->last_ip != '\0') {
-      g_object_set_data_full(G_OBJECT(row), "player-last-ip", g_strdup(state->last_ip), g_free);
-    }
-    g_object_set_data(G_OBJECT(row), "player-online", GINT_TO_POINTER(state->online ? 1 : 0));
-    g_object_set_data(G_OBJECT(row), "player-banned", GINT_TO_POINTER(banned ? 1 : 0));
-    g_object_set_data(G_OBJECT(row), "player-ip-banned", GINT_TO_POINTER(ip_banned ? 1 : 0));
-    g_object_set_data(G_OBJECT(row), "player-op-level", GINT_TO_POINTER(op_level + 1));
+static void
+append_player_state_row(PumpkinWindow *self, GtkListBox *list, const PlayerRowInfo *info)
+{
+  if (self == NULL || list == NULL || info == NULL) {
+    return;
   }
+  GtkWidget *row = gtk_list_box_row_new();
+  gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), build_player_row(self, info));
+  gtk_list_box_append(list, row);
 }
 
 static gint
@@ -7284,6 +9096,13 @@ player_state_sort_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
   const PlayerState *right = *(const PlayerState * const *)b;
   const PlayerSortSettings *settings = user_data;
 
+  if (settings != NULL && settings->search_index != NULL) {
+    PumpkinSearchRank left_rank = pumpkin_search_index_rank(settings->search_index, left->key);
+    PumpkinSearchRank right_rank = pumpkin_search_index_rank(settings->search_index, right->key);
+    if (left_rank != right_rank) {
+      return left_rank > right_rank ? -1 : 1;
+    }
+  }
   if (settings != NULL && settings->op_level_map != NULL) {
     gboolean left_admin = player_is_admin_from_op_level(
       player_lookup_op_level_for_state(settings->op_level_map, left));
@@ -7332,8 +9151,11 @@ invalidate_player_list_signature(PumpkinWindow *self)
     return;
   }
   self->player_list_signature_valid = FALSE;
-  self->player_list_signature = 0;
-  self->player_list_signature_count = 0;
+  self->player_list_lookup_generation = 0;
+  if (self->player_list_dirty_keys != NULL) {
+    g_hash_table_remove_all(self->player_list_dirty_keys);
+  }
+  self->player_ingest_generation = 0;
 }
 
 static void
@@ -7366,286 +9188,521 @@ player_list_signature_mix_str(guint64 signature, const char *text)
   return signature;
 }
 
-static void
-refresh_player_list(PumpkinWindow *self)
+static char *
+player_reason_text(const char *ban_reason, const char *ip_ban_reason)
 {
-  if (self == NULL || self->player_list == NULL) {
-    return;
-  }
-  if (self->current == NULL) {
-    clear_list_box(self->player_list);
-    invalidate_player_list_signature(self);
-    return;
+  g_autofree char *ban_reason_key = normalized_key(ban_reason);
+  g_autofree char *ip_ban_reason_key = normalized_key(ip_ban_reason);
+  if (ban_reason_key == NULL && ip_ban_reason_key == NULL) {
+    return NULL;
   }
+  return g_strjoin("\n",
+                   ban_reason_key != NULL ? ban_reason_key : "",
+                   ip_ban_reason_key != NULL ? ip_ban_reason_key : "",
+                   NULL);
+}
+
+static PlayerRowInfo *
+player_row_info_new(PlayerState *state,
+                    gboolean whitelisted,
+                    gboolean banned,
+                    const char *ban_reason,
+                    gboolean ip_banned,
+                    const char *ip_ban_reason,
+                    int op_level)
+{
+  PlayerRowInfo *info = g_new0(PlayerRowInfo, 1);
+  info->key = pumpkin_intern_ref(state->key);
+  info->name = pumpkin_intern_ref(state->name);
+  info->uuid = pumpkin_intern_ref(state->uuid);
+  info->last_ip = pumpkin_intern_ref(state->last_ip);
+  info->ban_reason = g_strdup(ban_reason);
+  info->ip_ban_reason = g_strdup(ip_ban_reason);
+  info->platform = state->platform;
+  info->online = state->online;
+  info->whitelisted = whitelisted;
+  info->banned = banned;
+  info->ip_banned = ip_banned;
+  info->op_level = op_level;
+  info->first_joined_unix = state->first_joined_unix;
+  info->last_online_unix = state->last_online_unix;
+  info->playtime_seconds = player_state_effective_playtime(state);
+
+  info->reason_text = player_reason_text(ban_reason, ip_ban_reason);
+  info->sort_name = g_ascii_strdown(state->name != NULL ? state->name : "", -1);
 
-  gint64 now_mono = g_get_monotonic_time();
-  if (self->player_list_pointer_inside || now_mono < self->player_list_interaction_until) {
-    return;
+  guint64 signature = 0xcbf29ce484222325ULL;
+  signature = player_list_signature_mix_str(signature, state->key);
+  signature = player_list_signature_mix_str(signature, state->name);
+  signature = player_list_signature_mix_str(signature, state->uuid);
+  signature = player_list_signature_mix_str(signature, state->last_ip);
+  signature = player_list_signature_mix_u64(signature, state->online ? 1 : 0);
+  signature = player_list_signature_mix_u64(signature, (guint64)state->platform);
+  signature = player_list_signature_mix_u64(signature, (guint64)state->first_joined_unix);
+  signature = player_list_signature_mix_u64(signature, (guint64)state->last_online_unix);
+  signature = player_list_signature_mix_u64(signature, info->playtime_seconds / 60);
+  signature = player_list_signature_mix_u64(signature, whitelisted ? 1 : 0);
+  signature = player_list_signature_mix_u64(signature, banned ? 1 : 0);
+  signature = player_list_signature_mix_u64(signature, ip_banned ? 1 : 0);
+  signature = player_list_signature_mix_u64(signature, (guint64)(op_level + 1));
+  signature = player_list_signature_mix_str(signature, ban_reason);
+  signature = player_list_signature_mix_str(signature, ip_ban_reason);
+  info->signature = signature;
+  return info;
+}
+
+/* Names, uuids and ips come from the search index; ban reasons are few and still matched by substring. */
+static PumpkinSearchRank
+player_search_rank(PumpkinWindow *self, const char *key, const char *reason_text)
+{
+  if (self->player_list_query == NULL) {
+    return PUMPKIN_SEARCH_RANK_NONE;
+  }
+  PumpkinSearchRank rank = pumpkin_search_index_rank(self->player_search_index, key);
+  if (rank == PUMPKIN_SEARCH_RANK_NONE && reason_text != NULL && strstr(reason_text, self->player_list_query) != NULL) {
+    rank = PUMPKIN_SEARCH_RANK_FIELD;
+  }
+  return rank;
+}
+
+/*
+ * Runs the search index once per query change. Prefix queries below PUMPKIN_SEARCH_MIN_FRAGMENT and
+ * fragment queries above it match differently, so narrowing is only reported within one side.
+ */
+static gboolean
+sync_player_search_query(PumpkinWindow *self, GtkFilterChange *out_change)
+{
+  const char *query = self->player_search != NULL
+                        ? gtk_editable_get_text(GTK_EDITABLE(self->player_search))
+                        : NULL;
+  g_autofree char *query_key = normalized_key(query);
+  if (g_strcmp0(query_key, self->player_list_query) == 0) {
+    return FALSE;
   }
 
-  ingest_players_from_disk(self);
-
-  g_autofree char *whitelist_path = resolve_data_file(self->current, "whitelist.json");
-  g_autoptr(GPtrArray) whitelist_entries = load_player_entries_from_file(whitelist_path);
-  g_autoptr(GHashTable) whitelist_set = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  if (whitelist_entries != NULL) {
-    for (guint i = 0; i < whitelist_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(whitelist_entries, i);
-      if (entry == NULL) {
-        continue;
+  if (out_change != NULL) {
+    gsize old_len = self->player_list_query != NULL ? strlen(self->player_list_query) : 0;
+    gsize new_len = query_key != NULL ? strlen(query_key) : 0;
+    gboolean same_mode = (old_len < PUMPKIN_SEARCH_MIN_FRAGMENT) == (new_len < PUMPKIN_SEARCH_MIN_FRAGMENT);
+    *out_change = GTK_FILTER_CHANGE_DIFFERENT;
+    if (self->player_list_query == NULL) {
+      *out_change = GTK_FILTER_CHANGE_MORE_STRICT;
+    } else if (query_key == NULL) {
+      *out_change = GTK_FILTER_CHANGE_LESS_STRICT;
+    } else if (same_mode && new_len < PUMPKIN_SEARCH_MIN_FRAGMENT) {
+      if (g_str_has_prefix(query_key, self->player_list_query)) {
+        *out_change = GTK_FILTER_CHANGE_MORE_STRICT;
+      } else if (g_str_has_prefix(self->player_list_query, query_key)) {
+        *out_change = GTK_FILTER_CHANGE_LESS_STRICT;
+      }
+    } else if (same_mode) {
+      if (strstr(query_key, self->player_list_query) != NULL) {
+        *out_change = GTK_FILTER_CHANGE_MORE_STRICT;
+      } else if (strstr(self->player_list_query, query_key) != NULL) {
+        *out_change = GTK_FILTER_CHANGE_LESS_STRICT;
       }
-      player_lookup_add_set(whitelist_set, entry->name, entry->uuid);
     }
   }
 
-  g_autofree char *banned_path = resolve_data_file(self->current, "banned-players.json");
-  g_autoptr(GPtrArray) banned_entries = load_player_entries_from_file(banned_path);
-  g_autoptr(GHashTable) banned_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  if (banned_entries != NULL) {
-    for (guint i = 0; i < banned_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(banned_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_reason(banned_reason_map, entry->name, entry->uuid, entry->reason);
-    }
+  g_free(self->player_list_query);
+  self->player_list_query = g_steal_pointer(&query_key);
+  pumpkin_search_index_query(self->player_search_index, self->player_list_query);
+  return TRUE;
+}
+
+static gboolean
+player_item_matches(gpointer item, gpointer user_data)
+{
+  PumpkinWindow *self = user_data;
+  if (self->player_list_query == NULL) {
+    return TRUE;
   }
+  const PlayerRowInfo *info = pumpkin_player_item_get_info(item);
+  return player_search_rank(self, info->key, info->reason_text) != PUMPKIN_SEARCH_RANK_NONE;
+}
 
-  g_autofree char *banned_ips_path = resolve_data_file(self->current, "banned-ips.json");
-  g_autoptr(GPtrArray) banned_ip_entries = load_player_entries_from_file(banned_ips_path);
-  g_autoptr(GHashTable) banned_ip_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  if (banned_ip_entries != NULL) {
-    for (guint i = 0; i < banned_ip_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(banned_ip_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_ip_reason(banned_ip_reason_map, entry->ip, entry->reason);
+static int
+compare_i64(gint64 left, gint64 right)
+{
+  return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+/* Same order as player_state_sort_cmp, but on keys captured when the item was built. */
+static int
+player_item_compare(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  PumpkinWindow *self = user_data;
+  const PlayerRowInfo *left = pumpkin_player_item_get_info((PumpkinPlayerItem *)a);
+  const PlayerRowInfo *right = pumpkin_player_item_get_info((PumpkinPlayerItem *)b);
+
+  if (self->player_list_query != NULL) {
+    PumpkinSearchRank left_rank = player_search_rank(self, left->key, left->reason_text);
+    PumpkinSearchRank right_rank = player_search_rank(self, right->key, right->reason_text);
+    if (left_rank != right_rank) {
+      return left_rank > right_rank ? -1 : 1;
     }
   }
+  gboolean left_admin = player_is_admin_from_op_level(left->op_level);
+  gboolean right_admin = player_is_admin_from_op_level(right->op_level);
+  if (left_admin != right_admin) {
+    return left_admin ? -1 : 1;
+  }
 
-  g_autofree char *ops_path = resolve_data_file(self->current, "ops.json");
-  g_autoptr(GPtrArray) ops_entries = load_player_entries_from_file(ops_path);
-  g_autoptr(GHashTable) op_level_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  if (ops_entries != NULL) {
-    for (guint i = 0; i < ops_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(ops_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_op_level(op_level_map, entry->name, entry->uuid, entry->op_level);
-    }
+  int cmp = 0;
+  if (self->player_list_sort_field == 1) {
+    cmp = left->playtime_seconds < right->playtime_seconds ? -1
+          : (left->playtime_seconds > right->playtime_seconds ? 1 : 0);
+  } else if (self->player_list_sort_field == 2) {
+    cmp = compare_i64(left->first_joined_unix, right->first_joined_unix);
+  } else if (self->player_list_sort_field == 3) {
+    cmp = strcmp(left->sort_name, right->sort_name);
+  } else {
+    cmp = compare_i64(left->online ? G_MAXINT64 : left->last_online_unix,
+                      right->online ? G_MAXINT64 : right->last_online_unix);
   }
+  if (cmp == 0) {
+    cmp = strcmp(left->sort_name, right->sort_name);
+  }
+  return self->player_list_sort_ascending ? cmp : -cmp;
+}
 
-  const char *query = self->player_search != NULL
-                        ? gtk_editable_get_text(GTK_EDITABLE(self->player_search))
-                        : NULL;
-  g_autofree char *query_key = normalized_key(query);
+static void
+on_player_item_setup(GtkSignalListItemFactory *factory, GtkListItem *list_item, PumpkinWindow *self)
+{
+  (void)factory;
+  (void)self;
+  PlayerRowWidgets *row = player_row_widgets_new();
+  gtk_list_item_set_child(list_item, row->root);
+  g_object_set_data_full(G_OBJECT(list_item), "player-row", row, g_free);
+  g_object_set_data(G_OBJECT(list_item), "player-avatar", row->avatar);
+  g_object_set_data(G_OBJECT(list_item), "player-ping-chip", row->ping_chip);
+}
 
-  PlayerSortSettings sort = {0};
-  sort.field = self->player_sort_field;
-  sort.ascending = self->player_sort_ascending;
-  sort.op_level_map = op_level_map;
-  sort.now_unix = (gint64)time(NULL);
+static void
+on_player_item_bind(GtkSignalListItemFactory *factory, GtkListItem *list_item, PumpkinWindow *self)
+{
+  (void)factory;
+  PumpkinPlayerItem *item = gtk_list_item_get_item(list_item);
+  PlayerRowWidgets *row = g_object_get_data(G_OBJECT(list_item), "player-row");
+  if (item == NULL || row == NULL) {
+    return;
+  }
+  player_row_widgets_update(self, row, pumpkin_player_item_get_info(item));
+  if (self->player_bound_items != NULL) {
+    g_hash_table_add(self->player_bound_items, list_item);
+  }
+}
 
-  g_autoptr(GPtrArray) states = g_ptr_array_new();
+static void
+on_player_item_unbind(GtkSignalListItemFactory *factory, GtkListItem *list_item, PumpkinWindow *self)
+{
+  (void)factory;
+  (void)list_item;
+  if (self->player_bound_items != NULL) {
+    g_hash_table_remove(self->player_bound_items, list_item);
+  }
+}
+
+static void
+refresh_bound_player_heads(PumpkinWindow *self, const char *uuid_key)
+{
+  if (self->player_bound_items == NULL || uuid_key == NULL) {
+    return;
+  }
   GHashTableIter iter;
   gpointer key = NULL;
-  gpointer value = NULL;
-  g_hash_table_iter_init(&iter, self->player_states);
-  while (g_hash_table_iter_next(&iter, &key, &value)) {
-    PlayerState *state = value;
-    if (state == NULL) {
+  g_hash_table_iter_init(&iter, self->player_bound_items);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    GtkListItem *list_item = key;
+    GtkWidget *avatar = g_object_get_data(G_OBJECT(list_item), "player-avatar");
+    PumpkinPlayerItem *item = gtk_list_item_get_item(list_item);
+    if (avatar == NULL || item == NULL) {
       continue;
     }
-    if (query_key != NULL && *query_key != '\0') {
-      g_autofree char *name_key = normalized_key(state->name);
-      g_autofree char *uuid_key = normalized_key(state->uuid);
-      g_autofree char *ip_key = normalized_key(state->last_ip);
-      const char *ban_reason = player_lookup_reason_for_state(banned_reason_map, state);
-      const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
-      g_autofree char *ban_reason_key = normalized_key(ban_reason);
-      g_autofree char *ip_ban_reason_key = normalized_key(ip_ban_reason);
-      gboolean match = FALSE;
-      if (name_key != NULL && strstr(name_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && uuid_key != NULL && strstr(uuid_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_key != NULL && strstr(ip_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ban_reason_key != NULL && strstr(ban_reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_ban_reason_key != NULL && strstr(ip_ban_reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match) {
-        continue;
-      }
+    const char *uuid = pumpkin_player_item_get_info(item)->uuid;
+    g_autofree char *item_key = normalized_key(uuid);
+    if (g_strcmp0(item_key, uuid_key) == 0) {
+      set_player_head_image(self, GTK_IMAGE(avatar), uuid);
     }
-    g_ptr_array_add(states, state);
   }
+}
 
-  g_ptr_array_sort_with_data(states, player_state_sort_cmp, &sort);
+static void
+setup_player_list_view(PumpkinWindow *self)
+{
+  self->player_store = g_list_store_new(PUMPKIN_TYPE_PLAYER_ITEM);
+  self->player_items = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+  self->player_list_dirty_keys = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                       (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->player_bound_items = g_hash_table_new(g_direct_hash, g_direct_equal);
+  self->player_list_sort_field = -1;
+  if (self->player_list == NULL) {
+    return;
+  }
 
-  guint64 signature = 0xcbf29ce484222325ULL;
-  signature = player_list_signature_mix_u64(signature, (guint64)sort.field);
-  signature = player_list_signature_mix_u64(signature, sort.ascending ? 1 : 0);
-  signature = player_list_signature_mix_str(signature, query_key);
-  for (guint i = 0; i < states->len; i++) {
-    PlayerState *state = g_ptr_array_index(states, i);
-    if (state == NULL) {
-      continue;
+  self->player_filter = GTK_FILTER(gtk_custom_filter_new(player_item_matches, self, NULL));
+  self->player_sorter = GTK_SORTER(gtk_custom_sorter_new(player_item_compare, self, NULL));
+  GtkFilterListModel *filtered = gtk_filter_list_model_new(G_LIST_MODEL(g_object_ref(self->player_store)),
+                                                           g_object_ref(self->player_filter));
+  GtkSortListModel *sorted = gtk_sort_list_model_new(G_LIST_MODEL(filtered), g_object_ref(self->player_sorter));
+  GtkNoSelection *selection = gtk_no_selection_new(G_LIST_MODEL(sorted));
+
+  GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+  g_signal_connect(factory, "setup", G_CALLBACK(on_player_item_setup), self);
+  g_signal_connect(factory, "bind", G_CALLBACK(on_player_item_bind), self);
+  g_signal_connect(factory, "unbind", G_CALLBACK(on_player_item_unbind), self);
+  gtk_list_view_set_factory(self->player_list, factory);
+  gtk_list_view_set_model(self->player_list, GTK_SELECTION_MODEL(selection));
+  g_object_unref(factory);
+  g_object_unref(selection);
+}
+
+/* Search and sort changes go to the filter and sorter; a query that only grows or shrinks narrows the work. */
+static void
+apply_player_list_view_settings(PumpkinWindow *self)
+{
+  GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+  if (sync_player_search_query(self, &change)) {
+    if (self->player_filter != NULL) {
+      gtk_filter_changed(self->player_filter, change);
+    }
+    if (self->player_sorter != NULL) {
+      gtk_sorter_changed(self->player_sorter, GTK_SORTER_CHANGE_DIFFERENT);
+    }
+  }
+
+  if (self->player_sort_field != self->player_list_sort_field ||
+      self->player_sort_ascending != self->player_list_sort_ascending) {
+    self->player_list_sort_field = self->player_sort_field;
+    self->player_list_sort_ascending = self->player_sort_ascending;
+    if (self->player_sorter != NULL) {
+      gtk_sorter_changed(self->player_sorter, GTK_SORTER_CHANGE_DIFFERENT);
+    }
+  }
+}
+
+static void
+clear_player_items(PumpkinWindow *self)
+{
+  if (self->player_store != NULL) {
+    g_list_store_remove_all(self->player_store);
+  }
+  if (self->player_items != NULL) {
+    g_hash_table_remove_all(self->player_items);
+  }
+}
+
+static PlayerRowInfo *
+player_row_info_for_state(PumpkinWindow *self, PlayerState *state)
+{
+  gboolean whitelisted = player_lookup_contains_state(self->player_whitelist_set, state);
+  const char *ban_reason = player_lookup_reason_for_state(self->player_banned_reason_map, state);
+  const char *ip_ban_reason = player_lookup_reason_for_ip_variants(self->player_banned_ip_reason_map, state->last_ip);
+  gboolean ip_banned = (ip_ban_reason != NULL) ||
+                       (state->ip_banned_hint && (state->last_ip == NULL || state->last_ip[0] == '\0'));
+  int op_level = player_lookup_op_level_for_state(self->player_op_level_map, state);
+  return player_row_info_new(state, whitelisted, ban_reason != NULL, ban_reason, ip_banned, ip_ban_reason, op_level);
+}
+
+/*
+ * The store is unsorted, so a removed player's slot is filled with the last item instead of shifting
+ * everything after it. Each item remembers its slot; no change has to search the store.
+ */
+static void
+player_store_remove(PumpkinWindow *self, PumpkinPlayerItem *item)
+{
+  guint position = pumpkin_player_item_get_position(item);
+  guint last = g_list_model_get_n_items(G_LIST_MODEL(self->player_store)) - 1;
+  if (position != last) {
+    PumpkinPlayerItem *moved = g_list_model_get_item(G_LIST_MODEL(self->player_store), last);
+    pumpkin_player_item_set_position(moved, position);
+    g_list_store_splice(self->player_store, position, 1, (gpointer *)&moved, 1);
+    g_object_unref(moved);
+  }
+  g_list_store_remove(self->player_store, last);
+}
+
+static void
+sync_player_item(PumpkinWindow *self, const char *key)
+{
+  PlayerState *state = g_hash_table_lookup(self->player_states, key);
+  PumpkinPlayerItem *existing = g_hash_table_lookup(self->player_items, key);
+  if (state == NULL) {
+    if (existing != NULL) {
+      player_store_remove(self, existing);
+      g_hash_table_remove(self->player_items, key);
     }
-    gboolean whitelisted = player_lookup_contains_state(whitelist_set, state);
-    const char *ban_reason = player_lookup_reason_for_state(banned_reason_map, state);
-    gboolean banned = (ban_reason != NULL);
-    const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
-    gboolean ip_banned = (ip_ban_reason != NULL) ||
-                         (state->ip_banned_hint && (state->last_ip == NULL || state->last_ip[0] == '\0'));
-    int op_level = player_lookup_op_level_for_state(op_level_map, state);
-    signature = player_list_signature_mix_str(signature, state->key);
-    signature = player_list_signature_mix_str(signature, state->name);
-    signature = player_list_signature_mix_str(signature, state->uuid);
-    signature = player_list_signature_mix_str(signature, state->last_ip);
-    signature = player_list_signature_mix_u64(signature, state->online ? 1 : 0);
-    signature = player_list_signature_mix_u64(signature, (guint64)state->platform);
-    signature = player_list_signature_mix_u64(signature, (guint64)state->first_joined_unix);
-    signature = player_list_signature_mix_u64(signature, whitelisted ? 1 : 0);
-    signature = player_list_signature_mix_u64(signature, banned ? 1 : 0);
-    signature = player_list_signature_mix_u64(signature, ip_banned ? 1 : 0);
-    signature = player_list_signature_mix_u64(signature, (guint64)(op_level + 1));
-    signature = player_list_signature_mix_u64(signature, player_is_admin_from_op_level(op_level) ? 1 : 0);
-    signature = player_list_signature_mix_str(signature, ban_reason);
-    signature = player_list_signature_mix_str(signature, ip_ban_reason);
-  }
-
-  if (self->player_list_signature_valid &&
-      self->player_list_signature == signature &&
-      self->player_list_signature_count == states->len) {
     return;
   }
-  self->player_list_signature_valid = TRUE;
-  self->player_list_signature = signature;
-  self->player_list_signature_count = states->len;
 
-  clear_list_box(self->player_list);
+  PlayerRowInfo *info = player_row_info_for_state(self, state);
+  if (existing != NULL && pumpkin_player_item_get_info(existing)->signature == info->signature) {
+    player_row_info_free(info);
+    return;
+  }
+  PumpkinPlayerItem *item = pumpkin_player_item_new(info);
+  if (existing != NULL) {
+    guint position = pumpkin_player_item_get_position(existing);
+    pumpkin_player_item_set_position(item, position);
+    g_list_store_splice(self->player_store, position, 1, (gpointer *)&item, 1);
+  } else {
+    pumpkin_player_item_set_position(item, g_list_model_get_n_items(G_LIST_MODEL(self->player_store)));
+    g_list_store_append(self->player_store, item);
+  }
+  g_hash_table_replace(self->player_items, g_strdup(info->key), item);
+}
 
-  for (guint i = 0; i < states->len; i++) {
-    PlayerState *state = g_ptr_array_index(states, i);
-    if (state == NULL) {
+/* Unchanged players keep their item, so after a full pass the list view still only rebinds what moved. */
+static void
+rebuild_player_items(PumpkinWindow *self)
+{
+  GHashTable *items = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_object_unref);
+  g_autoptr(GPtrArray) all = g_ptr_array_sized_new(g_hash_table_size(self->player_states));
+  GHashTableIter iter;
+  gpointer value = NULL;
+  g_hash_table_iter_init(&iter, self->player_states);
+  while (g_hash_table_iter_next(&iter, NULL, &value)) {
+    PlayerState *state = value;
+    if (state == NULL || state->key == NULL) {
       continue;
     }
-    gboolean whitelisted = player_lookup_contains_state(whitelist_set, state);
-    const char *ban_reason = player_lookup_reason_for_state(banned_reason_map, state);
-    gboolean banned = (ban_reason != NULL);
-    const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
-    gboolean ip_banned = (ip_ban_reason != NULL) ||
-                         (state->ip_banned_hint && (state->last_ip == NULL || state->last_ip[0] == '\0'));
-    int op_level = player_lookup_op_level_for_state(op_level_map, state);
-    append_player_state_row(self, self->player_list, state, whitelisted, banned, ban_reason,
-                            ip_banned, ip_ban_reason, op_level, TRUE);
+    PlayerRowInfo *info = player_row_info_for_state(self, state);
+    PumpkinPlayerItem *item = g_hash_table_lookup(self->player_items, state->key);
+    if (item != NULL && pumpkin_player_item_get_info(item)->signature == info->signature) {
+      player_row_info_free(info);
+      g_object_ref(item);
+    } else {
+      item = pumpkin_player_item_new(info);
+    }
+    pumpkin_player_item_set_position(item, all->len);
+    g_ptr_array_add(all, item);
+    g_hash_table_replace(items, g_strdup(state->key), item);
   }
-
-  refresh_whitelist_list(self);
-  refresh_banned_list(self);
+  g_list_store_splice(self->player_store, 0, g_list_model_get_n_items(G_LIST_MODEL(self->player_store)),
+                      all->pdata, all->len);
+  g_hash_table_unref(self->player_items);
+  self->player_items = items;
 }
 
+/*
+ * Only players whose state changed since the last refresh are rebuilt and spliced in place, so the sort
+ * model re-places just those rows. Bulk changes fall back to one pass over every player.
+ */
 static void
-player_head_download_context_free(PlayerHeadDownloadContext *ctx)
+sync_player_items(PumpkinWindow *self, gboolean full)
 {
-  if (ctx == NULL) {
-    return;
+  guint n_items = g_list_model_get_n_items(G_LIST_MODEL(self->player_store));
+  guint dirty = g_hash_table_size(self->player_list_dirty_keys);
+  if (full || dirty > MAX((guint)PLAYER_LIST_DIFF_MAX, n_items / 8)) {
+    rebuild_player_items(self);
+  } else {
+    GHashTableIter iter;
+    gpointer key = NULL;
+    g_hash_table_iter_init(&iter, self->player_list_dirty_keys);
+    while (g_hash_table_iter_next(&iter, &key, NULL)) {
+      sync_player_item(self, key);
+    }
   }
-  g_clear_object(&ctx->self);
-  g_clear_object(&ctx->server);
-  g_clear_pointer(&ctx->uuid_key, g_free);
-  g_clear_pointer(&ctx->cache_path, g_free);
-  g_free(ctx);
+  g_hash_table_remove_all(self->player_list_dirty_keys);
 }
 
+/* Online rows show a playtime that ticks every minute; offline rows do not move with the clock. */
 static void
-on_player_head_download_done(GObject *source, GAsyncResult *res, gpointer user_data)
+mark_online_player_rows(PumpkinWindow *self)
 {
-  (void)source;
-  PlayerHeadDownloadContext *ctx = user_data;
-  if (ctx == NULL) {
+  if (self->live_player_names == NULL) {
     return;
   }
-
-  gboolean ok = pumpkin_download_file_finish(res, NULL);
-  if (ctx->self->player_head_downloads != NULL && ctx->uuid_key != NULL) {
-    g_hash_table_remove(ctx->self->player_head_downloads, ctx->uuid_key);
-  }
-  if (ok && ctx->self->current != NULL && ctx->self->current == ctx->server) {
-    invalidate_player_list_signature(ctx->self);
-    refresh_player_list(ctx->self);
+  GHashTableIter iter;
+  gpointer key = NULL;
+  g_hash_table_iter_init(&iter, self->live_player_names);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    g_autofree char *lookup_key = normalized_key(key);
+    const char *atom = pumpkin_intern_peek(lookup_key);
+    PlayerState *state = atom != NULL ? g_hash_table_lookup(self->player_states_by_name, atom) : NULL;
+    if (state == NULL && atom != NULL) {
+      state = g_hash_table_lookup(self->player_states_by_uuid, atom);
+    }
+    if (state != NULL && state->online) {
+      g_hash_table_add(self->player_list_dirty_keys, (gpointer)pumpkin_intern_ref(state->key));
+    }
   }
-  player_head_download_context_free(ctx);
 }
 
-static void
-set_player_head_image(PumpkinWindow *self, GtkImage *image, const char *uuid)
+void
+refresh_player_list(PumpkinWindow *self)
 {
-  if (self == NULL || image == NULL || self->current == NULL || uuid == NULL || *uuid == '\0') {
-    gtk_image_set_from_icon_name(image, "avatar-default-symbolic");
+  if (self == NULL || self->player_list == NULL || self->player_store == NULL) {
     return;
   }
-
-  g_autofree char *uuid_key = normalized_key(uuid);
-  if (uuid_key == NULL) {
-    gtk_image_set_from_icon_name(image, "avatar-default-symbolic");
+  if (self->current == NULL) {
+    clear_player_items(self);
+    invalidate_player_list_signature(self);
     return;
   }
 
-  g_autofree char *data_dir = pumpkin_server_get_data_dir(self->current);
-  g_autofree char *cache_dir = g_build_filename(data_dir, "cache", "player-heads", NULL);
-  g_mkdir_with_parents(cache_dir, 0755);
-  g_autofree char *cache_path = g_strdup_printf("%s/%s.png", cache_dir, uuid_key);
-
-  if (g_file_test(cache_path, G_FILE_TEST_EXISTS)) {
-    g_autoptr(GError) error = NULL;
-    g_autoptr(GFile) file = g_file_new_for_path(cache_path);
-    g_autoptr(GdkTexture) texture = gdk_texture_new_from_file(file, &error);
-    if (texture != NULL) {
-      gtk_image_set_from_paintable(image, GDK_PAINTABLE(texture));
-      gtk_image_set_pixel_size(image, 32);
-      return;
-    }
+  apply_player_list_view_settings(self);
+  gint64 now_mono = g_get_monotonic_time();
+  if (self->player_list_pointer_inside || now_mono < self->player_list_interaction_until) {
+    return;
   }
 
-  gtk_image_set_from_icon_name(image, "avatar-default-symbolic");
-  gtk_image_set_pixel_size(image, 32);
+  ingest_players_from_disk(self);
+  ensure_player_lookup_maps(self);
 
-  if (self->player_head_downloads != NULL &&
-      g_hash_table_contains(self->player_head_downloads, uuid_key)) {
-    return;
+  gint64 minute = g_get_real_time() / (60 * G_USEC_PER_SEC);
+  if (minute != self->player_list_minute) {
+    self->player_list_minute = minute;
+    mark_online_player_rows(self);
   }
-  if (self->player_head_downloads != NULL) {
-    g_hash_table_add(self->player_head_downloads, g_strdup(uuid_key));
+  /* The whitelist, ban and op files can touch any row; otherwise only players marked changed are rebuilt. */
+  gboolean full = !self->player_list_signature_valid ||
+                  self->player_list_lookup_generation != self->player_lookup_generation;
+  if (!full && g_hash_table_size(self->player_list_dirty_keys) == 0) {
+    return;
   }
+  self->player_list_signature_valid = TRUE;
+  self->player_list_lookup_generation = self->player_lookup_generation;
 
-  g_autofree char *uuid_compact = g_strdup(uuid_key);
-  char *dst = uuid_compact;
-  for (char *src = uuid_compact; *src != '\0'; src++) {
-    if (*src != '-') {
-      *dst++ = *src;
-    }
+  sync_player_items(self, full);
+  refresh_whitelist_list(self);
+  refresh_banned_list(self);
+}
+
+static gboolean
+refresh_player_head_lists_cb(gpointer user_data)
+{
+  PumpkinWindow *self = user_data;
+  self->player_heads_refresh_id = 0;
+  if (self->current != NULL) {
+    refresh_whitelist_list(self);
+    refresh_banned_list(self);
   }
-  *dst = '\0';
+  return G_SOURCE_REMOVE;
+}
 
-  PlayerHeadDownloadContext *ctx = g_new0(PlayerHeadDownloadContext, 1);
-  ctx->self = g_object_ref(self);
-  ctx->server = g_object_ref(self->current);
-  ctx->uuid_key = g_strdup(uuid_key);
-  ctx->cache_path = g_strdup(cache_path);
+/* Visible list rows are patched in place; the small whitelist and ban lists rebuild once per burst. */
+static void
+on_player_head_ready(const char *uuid_key, gpointer user_data)
+{
+  PumpkinWindow *self = user_data;
+  refresh_bound_player_heads(self, uuid_key);
+  if (self->player_heads_refresh_id == 0) {
+    self->player_heads_refresh_id = g_timeout_add(250, refresh_player_head_lists_cb, self);
+  }
+}
 
-  g_autofree char *url = g_strdup_printf("https://crafatar.com/avatars/%s?size=64&overlay=true",
-                                         uuid_compact);
-  pumpkin_download_file_async(url, cache_path, NULL, NULL, NULL, on_player_head_download_done, ctx);
+static void
+set_player_head_image(PumpkinWindow *self, GtkImage *image, const char *uuid)
+{
+  gtk_image_set_pixel_size(image, 32);
+  g_autofree char *uuid_key = normalized_key(uuid);
+  GdkTexture *texture = self != NULL ? pumpkin_head_cache_lookup(self->player_heads, uuid_key) : NULL;
+  if (texture != NULL) {
+    gtk_image_set_from_paintable(image, GDK_PAINTABLE(texture));
+  } else {
+    gtk_image_set_from_icon_name(image, "avatar-default-symbolic");
+  }
 }
 
 static void
@@ -7655,61 +9712,21 @@ refresh_whitelist_list(PumpkinWindow *self)
   if (self->current == NULL) {
     return;
   }
-  ingest_players_from_disk(self);
-  const char *query = self->player_search != NULL
-                        ? gtk_editable_get_text(GTK_EDITABLE(self->player_search))
-                        : NULL;
-  g_autofree char *query_key = normalized_key(query);
-
-  g_autofree char *whitelist_path = resolve_data_file(self->current, "whitelist.json");
-  g_autoptr(GPtrArray) whitelist_entries = load_player_entries_from_file(whitelist_path);
+  apply_player_list_view_settings(self);
+  ensure_player_lookup_maps(self);
+  GPtrArray *whitelist_entries = player_watch_get_entries(self, PLAYER_DATA_WHITELIST);
   if (whitelist_entries == NULL) {
     return;
   }
-
-  g_autofree char *banned_path = resolve_data_file(self->current, "banned-players.json");
-  g_autoptr(GPtrArray) banned_entries = load_player_entries_from_file(banned_path);
-  g_autoptr(GHashTable) banned_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  if (banned_entries != NULL) {
-    for (guint i = 0; i < banned_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(banned_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_reason(banned_reason_map, entry->name, entry->uuid, entry->reason);
-    }
-  }
-
-  g_autofree char *banned_ips_path = resolve_data_file(self->current, "banned-ips.json");
-  g_autoptr(GPtrArray) banned_ip_entries = load_player_entries_from_file(banned_ips_path);
-  g_autoptr(GHashTable) banned_ip_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  if (banned_ip_entries != NULL) {
-    for (guint i = 0; i < banned_ip_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(banned_ip_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_ip_reason(banned_ip_reason_map, entry->ip, entry->reason);
-    }
-  }
-
-  g_autofree char *ops_path = resolve_data_file(self->current, "ops.json");
-  g_autoptr(GPtrArray) ops_entries = load_player_entries_from_file(ops_path);
-  g_autoptr(GHashTable) op_level_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  if (ops_entries != NULL) {
-    for (guint i = 0; i < ops_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(ops_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_op_level(op_level_map, entry->name, entry->uuid, entry->op_level);
-    }
-  }
+  GHashTable *banned_reason_map = self->player_banned_reason_map;
+  GHashTable *banned_ip_reason_map = self->player_banned_ip_reason_map;
+  GHashTable *op_level_map = self->player_op_level_map;
 
   PlayerSortSettings sort = {0};
   sort.field = self->player_sort_field;
   sort.ascending = self->player_sort_ascending;
   sort.op_level_map = op_level_map;
+  sort.search_index = self->player_list_query != NULL ? self->player_search_index : NULL;
   sort.now_unix = (gint64)time(NULL);
 
   g_autoptr(GPtrArray) states = g_ptr_array_new();
@@ -7724,32 +9741,11 @@ refresh_whitelist_list(PumpkinWindow *self)
       continue;
     }
 
-    const char *ban_reason = player_lookup_reason_for_state(banned_reason_map, state);
-    const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
-
-    if (query_key != NULL && *query_key != '\0') {
-      g_autofree char *name_key = normalized_key(state->name);
-      g_autofree char *uuid_key = normalized_key(state->uuid);
-      g_autofree char *ip_key = normalized_key(state->last_ip);
-      g_autofree char *reason_key = normalized_key(ban_reason);
-      g_autofree char *ip_reason_key = normalized_key(ip_ban_reason);
-      gboolean match = FALSE;
-      if (name_key != NULL && strstr(name_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && uuid_key != NULL && strstr(uuid_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_key != NULL && strstr(ip_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && reason_key != NULL && strstr(reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_reason_key != NULL && strstr(ip_reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match) {
+    if (self->player_list_query != NULL) {
+      const char *ban_reason = player_lookup_reason_for_state(banned_reason_map, state);
+      const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
+      g_autofree char *reason_text = player_reason_text(ban_reason, ip_ban_reason);
+      if (player_search_rank(self, state->key, reason_text) == PUMPKIN_SEARCH_RANK_NONE) {
         continue;
       }
     }
@@ -7771,8 +9767,9 @@ refresh_whitelist_list(PumpkinWindow *self)
                          (state->ip_banned_hint && (state->last_ip == NULL || state->last_ip[0] == '\0'));
     int op_level = player_lookup_op_level_for_state(op_level_map, state);
 
-    append_player_state_row(self, self->whitelist_list, state, TRUE, banned, ban_reason,
-                            ip_banned, ip_ban_reason, op_level, FALSE);
+    PlayerRowInfo *info = player_row_info_new(state, TRUE, banned, ban_reason, ip_banned, ip_ban_reason, op_level);
+    append_player_state_row(self, self->whitelist_list, info);
+    player_row_info_free(info);
   }
 }
 
@@ -7783,61 +9780,21 @@ refresh_banned_list(PumpkinWindow *self)
   if (self->current == NULL) {
     return;
   }
-  ingest_players_from_disk(self);
-  const char *query = self->player_search != NULL
-                        ? gtk_editable_get_text(GTK_EDITABLE(self->player_search))
-                        : NULL;
-  g_autofree char *query_key = normalized_key(query);
-
-  g_autofree char *banned_path = resolve_data_file(self->current, "banned-players.json");
-  g_autoptr(GPtrArray) banned_entries = load_player_entries_from_file(banned_path);
+  apply_player_list_view_settings(self);
+  ensure_player_lookup_maps(self);
+  GPtrArray *banned_entries = player_watch_get_entries(self, PLAYER_DATA_BANNED_PLAYERS);
   if (banned_entries == NULL) {
     return;
   }
-
-  g_autofree char *banned_ips_path = resolve_data_file(self->current, "banned-ips.json");
-  g_autoptr(GPtrArray) banned_ip_entries = load_player_entries_from_file(banned_ips_path);
-  g_autoptr(GHashTable) banned_ip_reason_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  if (banned_ip_entries != NULL) {
-    for (guint i = 0; i < banned_ip_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(banned_ip_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_ip_reason(banned_ip_reason_map, entry->ip, entry->reason);
-    }
-  }
-
-  g_autofree char *whitelist_path = resolve_data_file(self->current, "whitelist.json");
-  g_autoptr(GPtrArray) whitelist_entries = load_player_entries_from_file(whitelist_path);
-  g_autoptr(GHashTable) whitelist_set = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  if (whitelist_entries != NULL) {
-    for (guint i = 0; i < whitelist_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(whitelist_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_set(whitelist_set, entry->name, entry->uuid);
-    }
-  }
-
-  g_autofree char *ops_path = resolve_data_file(self->current, "ops.json");
-  g_autoptr(GPtrArray) ops_entries = load_player_entries_from_file(ops_path);
-  g_autoptr(GHashTable) op_level_map = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  if (ops_entries != NULL) {
-    for (guint i = 0; i < ops_entries->len; i++) {
-      PlayerEntry *entry = g_ptr_array_index(ops_entries, i);
-      if (entry == NULL) {
-        continue;
-      }
-      player_lookup_add_op_level(op_level_map, entry->name, entry->uuid, entry->op_level);
-    }
-  }
+  GHashTable *banned_ip_reason_map = self->player_banned_ip_reason_map;
+  GHashTable *whitelist_set = self->player_whitelist_set;
+  GHashTable *op_level_map = self->player_op_level_map;
 
   PlayerSortSettings sort = {0};
   sort.field = self->player_sort_field;
   sort.ascending = self->player_sort_ascending;
   sort.op_level_map = op_level_map;
+  sort.search_index = self->player_list_query != NULL ? self->player_search_index : NULL;
   sort.now_unix = (gint64)time(NULL);
 
   g_autoptr(GPtrArray) states = g_ptr_array_new();
@@ -7851,31 +9808,10 @@ refresh_banned_list(PumpkinWindow *self)
     if (state == NULL) {
       continue;
     }
-    const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
-
-    if (query_key != NULL && *query_key != '\0') {
-      g_autofree char *name_key = normalized_key(state->name);
-      g_autofree char *uuid_key = normalized_key(state->uuid);
-      g_autofree char *reason_key = normalized_key(entry->reason);
-      g_autofree char *ip_key = normalized_key(state->last_ip);
-      g_autofree char *ip_reason_key = normalized_key(ip_ban_reason);
-      gboolean match = FALSE;
-      if (name_key != NULL && strstr(name_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && uuid_key != NULL && strstr(uuid_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_key != NULL && strstr(ip_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && reason_key != NULL && strstr(reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match && ip_reason_key != NULL && strstr(ip_reason_key, query_key) != NULL) {
-        match = TRUE;
-      }
-      if (!match) {
+    if (self->player_list_query != NULL) {
+      const char *ip_ban_reason = player_lookup_reason_for_ip_variants(banned_ip_reason_map, state->last_ip);
+      g_autofree char *reason_text = player_reason_text(entry->reason, ip_ban_reason);
+      if (player_search_rank(self, state->key, reason_text) == PUMPKIN_SEARCH_RANK_NONE) {
         continue;
       }
     }
@@ -7910,8 +9846,10 @@ refresh_banned_list(PumpkinWindow *self)
       }
     }
 
-    append_player_state_row(self, self->banned_list, state, whitelisted, TRUE, ban_reason,
-                            ip_banned, ip_ban_reason, op_level, FALSE);
+    PlayerRowInfo *info = player_row_info_new(state, whitelisted, TRUE, ban_reason, ip_banned, ip_ban_reason,
+                                              op_level);
+    append_player_state_row(self, self->banned_list, info);
+    player_row_info_free(info);
   }
 }
 
@@ -7989,8 +9927,10 @@ refresh_active_player_section(PumpkinWindow *self)
                        ? adw_view_stack_get_visible_child_name(self->players_stack)
                        : NULL;
   if (g_strcmp0(page, "whitelisted") == 0) {
+    ingest_players_from_disk(self);
     refresh_whitelist_list(self);
   } else if (g_strcmp0(page, "bans") == 0) {
+    ingest_players_from_disk(self);
     refresh_banned_list(self);
   } else {
     refresh_player_list(self);
@@ -8094,7 +10034,7 @@ on_player_action_confirmed(GObject *dialog, GAsyncResult *res, gpointer user_dat
   gboolean has_name = (name != NULL && *name != '\0');
   PlayerState *selected_state = NULL;
   if (state_key != NULL && self->player_states != NULL) {
-    selected_state = g_hash_table_lookup(self->player_states, state_key);
+    selected_state = g_hash_table_lookup(self->player_states, pumpkin_intern_peek(state_key));
   }
 
   if (g_strcmp0(response, "delete_data") == 0) {
@@ -8395,19 +10335,19 @@ on_player_ban_reason_confirmed(GObject *dialog, GAsyncResult *res, gpointer user
   }
 
   if (g_strcmp0(command_name, "ban-ip") == 0 && state_key != NULL && self->player_states != NULL) {
-    PlayerState *state = g_hash_table_lookup(self->player_states, state_key);
+    PlayerState *state = g_hash_table_lookup(self->player_states, pumpkin_intern_peek(state_key));
     if (state != NULL) {
       state->ip_banned_hint = TRUE;
       if (target != NULL && g_hostname_is_ip_address(target) && g_strcmp0(state->last_ip, target) != 0) {
-        g_free(state->last_ip);
-        state->last_ip = g_strdup(target);
-        player_states_set_dirty(self);
+        pumpkin_intern_assign(&state->last_ip, target);
+        player_search_index_update(self, state);
+        player_state_changed(self, state);
       } else if ((state->last_ip == NULL || state->last_ip[0] == '\0')) {
         g_autofree char *resolved = pick_latest_banned_ip(self);
         if (resolved != NULL && *resolved != '\0' && g_strcmp0(state->last_ip, resolved) != 0) {
-          g_free(state->last_ip);
-          state->last_ip = g_strdup(resolved);
-          player_states_set_dirty(self);
+          pumpkin_intern_assign(&state->last_ip, resolved);
+          player_search_index_update(self, state);
+          player_state_changed(self, state);
         }
       }
     }
@@ -8451,29 +10391,31 @@ on_player_pardon_ip_manual_confirmed(GObject *dialog, GAsyncResult *res, gpointe
 }
 
 static void
-on_player_row_activated(GtkListBox *box, GtkListBoxRow *row, PumpkinWindow *self)
+on_player_list_activate(GtkListView *view, guint position, PumpkinWindow *self)
 {
-  (void)box;
-  if (row == NULL) {
+  GListModel *model = G_LIST_MODEL(gtk_list_view_get_model(view));
+  g_autoptr(PumpkinPlayerItem) item = model != NULL ? g_list_model_get_item(model, position) : NULL;
+  if (item == NULL) {
     return;
   }
   extend_player_list_interaction_freeze(self, 1500000);
 
-  const char *name = g_object_get_data(G_OBJECT(row), "player-name");
-  const char *uuid = g_object_get_data(G_OBJECT(row), "player-uuid");
-  const char *state_key = g_object_get_data(G_OBJECT(row), "player-key");
-  const char *last_ip = g_object_get_data(G_OBJECT(row), "player-last-ip");
-  gboolean is_online = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(row), "player-online")) != 0;
-  gboolean is_banned = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(row), "player-banned")) != 0;
-  gboolean is_ip_banned = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(row), "player-ip-banned")) != 0;
-  int op_level = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(row), "player-op-level")) - 1;
+  const PlayerRowInfo *info = pumpkin_player_item_get_info(item);
+  const char *name = info->name;
+  const char *uuid = info->uuid;
+  const char *state_key = info->key;
+  const char *last_ip = info->last_ip;
+  gboolean is_online = info->online;
+  gboolean is_banned = info->banned;
+  gboolean is_ip_banned = info->ip_banned;
+  int op_level = info->op_level;
   gboolean is_op = op_level >= 0;
   gboolean is_admin = player_is_admin_from_op_level(op_level);
   gboolean has_last_ip = (last_ip != NULL && *last_ip != '\0');
   gboolean has_name = (name != NULL && *name != '\0');
   PlayerState *state = NULL;
   if (state_key != NULL && self->player_states != NULL) {
-    state = g_hash_table_lookup(self->player_states, state_key);
+    state = g_hash_table_lookup(self->player_states, pumpkin_intern_peek(state_key));
   }
 
   const char *title = has_name ? name : "Player";
@@ -9402,18 +11344,41 @@ update_settings_form(PumpkinWindow *self)
     gtk_editable_set_text(GTK_EDITABLE(self->entry_stats_sample_msec), "");
     gtk_editable_set_text(GTK_EDITABLE(self->entry_max_cpu_cores), "");
     gtk_editable_set_text(GTK_EDITABLE(self->entry_max_ram_mb), "");
+    if (self->entry_cpu_weight != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_cpu_weight), "");
+    }
+    if (self->entry_io_weight != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_io_weight), "");
+    }
     gtk_editable_set_text(GTK_EDITABLE(self->entry_rcon_host), "");
     gtk_editable_set_text(GTK_EDITABLE(self->entry_rcon_port), "");
     gtk_editable_set_text(GTK_EDITABLE(self->entry_rcon_password), "");
     if (self->label_resource_limits != NULL) {
       gtk_label_set_text(self->label_resource_limits, "Max available: -- cores, -- MB RAM.");
     }
+    update_cpu_set_label(self);
+    update_launch_profile_controls(self);
     if (self->switch_auto_restart != NULL) {
       gtk_switch_set_active(self->switch_auto_restart, FALSE);
     }
     if (self->entry_auto_restart_delay != NULL) {
       gtk_editable_set_text(GTK_EDITABLE(self->entry_auto_restart_delay), "");
     }
+    if (self->switch_leak_restart != NULL) {
+      gtk_switch_set_active(self->switch_leak_restart, FALSE);
+    }
+    if (self->entry_hibernate_minutes != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_hibernate_minutes), "");
+    }
+    if (self->entry_freeze_minutes != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_freeze_minutes), "");
+    }
+    if (self->entry_watchdog_seconds != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_watchdog_seconds), "");
+    }
+    if (self->switch_watchdog_restart != NULL) {
+      gtk_switch_set_active(self->switch_watchdog_restart, FALSE);
+    }
     if (self->switch_auto_update != NULL) {
       gtk_switch_set_active(self->switch_auto_update, FALSE);
     }
@@ -9488,15 +11453,28 @@ update_settings_form(PumpkinWindow *self)
     gtk_editable_set_text(GTK_EDITABLE(self->entry_max_ram_mb), "");
   }
 
+  if (self->entry_cpu_weight != NULL) {
+    g_autofree char *cpu_weight = g_strdup_printf("%d", pumpkin_server_get_cpu_weight(self->current));
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_cpu_weight), cpu_weight);
+  }
+  if (self->entry_io_weight != NULL) {
+    g_autofree char *io_weight = g_strdup_printf("%d", pumpkin_server_get_io_weight(self->current));
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_io_weight), io_weight);
+  }
+
   if (self->label_resource_limits != NULL) {
     int sys_cores = 0;
     int sys_ram_mb = 0;
     get_system_limits(&sys_cores, &sys_ram_mb);
     g_autofree char *cores_str = sys_cores > 0 ? g_strdup_printf("%d", sys_cores) : g_strdup("--");
     g_autofree char *ram_str = sys_ram_mb > 0 ? g_strdup_printf("%d", sys_ram_mb) : g_strdup("--");
-    g_autofree char *limits = g_strdup_printf("Max available: %s cores, %s MB RAM.", cores_str, ram_str);
+    g_autofree char *limits = g_strdup_printf("Max available: %s cores, %s MB RAM. Enforced via %s.",
+                                              cores_str, ram_str,
+                                              pumpkin_cgroup_mode_label(pumpkin_cgroup_detect()));
     gtk_label_set_text(self->label_resource_limits, limits);
   }
+  update_cpu_set_label(self);
+  update_launch_profile_controls(self);
   gtk_editable_set_text(GTK_EDITABLE(self->entry_rcon_host), pumpkin_server_get_rcon_host(self->current));
 
   if (self->switch_auto_restart != NULL) {
@@ -9506,6 +11484,27 @@ update_settings_form(PumpkinWindow *self)
     g_autofree char *delay = g_strdup_printf("%d", pumpkin_server_get_auto_restart_delay(self->current));
     gtk_editable_set_text(GTK_EDITABLE(self->entry_auto_restart_delay), delay);
   }
+  if (self->switch_leak_restart != NULL) {
+    gtk_switch_set_active(self->switch_leak_restart, pumpkin_server_get_leak_restart(self->current));
+  }
+  if (self->entry_hibernate_minutes != NULL) {
+    int minutes = pumpkin_server_get_hibernate_minutes(self->current);
+    g_autofree char *text = minutes > 0 ? g_strdup_printf("%d", minutes) : g_strdup("");
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_hibernate_minutes), text);
+  }
+  if (self->entry_freeze_minutes != NULL) {
+    int minutes = pumpkin_server_get_freeze_minutes(self->current);
+    g_autofree char *text = minutes > 0 ? g_strdup_printf("%d", minutes) : g_strdup("");
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_freeze_minutes), text);
+  }
+  if (self->entry_watchdog_seconds != NULL) {
+    int seconds = pumpkin_server_get_watchdog_seconds(self->current);
+    g_autofree char *text = seconds > 0 ? g_strdup_printf("%d", seconds) : g_strdup("");
+    gtk_editable_set_text(GTK_EDITABLE(self->entry_watchdog_seconds), text);
+  }
+  if (self->switch_watchdog_restart != NULL) {
+    gtk_switch_set_active(self->switch_watchdog_restart, pumpkin_server_get_watchdog_restart(self->current));
+  }
   if (self->switch_auto_update != NULL) {
     gtk_switch_set_active(self->switch_auto_update,
                           pumpkin_server_get_auto_update_enabled(self->current));
@@ -9642,7 +11641,11 @@ select_server(PumpkinWindow *self, PumpkinServer *server)
   }
 
   self->current = server;
+  player_watch_set_server(self, server);
   pumpkin_server_store_set_selected(self->store, server);
+  hibernation_thaw(self, server, "opened in the app");
+  refresh_startup_history(self);
+  refresh_join_latency(self);
 
   if (server == NULL) {
     self->ui_state = UI_STATE_IDLE;
@@ -9674,16 +11677,15 @@ select_server(PumpkinWindow *self, PumpkinServer *server)
   self->pending_auto_list_lines = 0;
   self->pending_java_platform_hints = 0;
   self->pending_bedrock_platform_hints = 0;
-  if (self->player_head_downloads != NULL) {
-    g_hash_table_remove_all(self->player_head_downloads);
-  }
   invalidate_player_list_signature(self);
 
   if (server != NULL) {
     player_states_load(self, server);
+    network_players_seed(self, server);
   } else {
     player_states_clear(self);
   }
+  sessions_open(self, server);
   command_history_load(self, server);
 
   if (self->log_view != NULL) {
@@ -10816,6 +12818,7 @@ on_download_done(GObject *source, GAsyncResult *res, gpointer user_data)
         self->user_stop_requested = FALSE;
         set_console_warning(self, NULL, FALSE);
       }
+      sync_server_cgroup_group(self, server);
       if (!pumpkin_server_start(server, &start_error)) {
         set_details_status_for_server(self, server, "Update installed but restart failed", 5);
         if (self->current == server) {
@@ -10992,6 +12995,13 @@ on_network_details_back(GtkButton *button, PumpkinWindow *self)
   adw_view_stack_set_visible_child_name(self->view_stack, "overview");
 }
 
+static void
+on_network_details_player_search_changed(GtkSearchEntry *entry, PumpkinWindow *self)
+{
+  (void)entry;
+  refresh_network_players(self);
+}
+
 static void
 on_world_delete_clicked(GtkButton *button, PumpkinWindow *self)
 {
@@ -11537,6 +13547,13 @@ save_settings_impl(PumpkinWindow *self, gboolean restart_server)
     if (self->switch_auto_start_servers != NULL) {
       pumpkin_config_set_auto_start_servers_enabled(self->config, gtk_switch_get_active(self->switch_auto_start_servers));
     }
+    if (self->entry_start_concurrency != NULL) {
+      pumpkin_config_set_start_concurrency(self->config, start_concurrency_from_entry(self));
+    }
+    if (self->entry_avatar_url != NULL) {
+      pumpkin_config_set_avatar_url(self->config, gtk_editable_get_text(GTK_EDITABLE(self->entry_avatar_url)));
+      pumpkin_head_cache_set_base_url(self->player_heads, pumpkin_config_get_avatar_url(self->config));
+    }
     /* Save per-server auto-start settings from list */
     if (self->autostart_server_list != NULL && self->store != NULL) {
       GListModel *model = get_server_model(self);
@@ -11599,12 +13616,32 @@ save_settings_impl(PumpkinWindow *self, gboolean restart_server)
   int max_ram = pumpkin_parse_limit_entry(self->entry_max_ram_mb, sys_ram_mb);
   pumpkin_server_set_max_cpu_cores(self->current, max_cpu);
   pumpkin_server_set_max_ram_mb(self->current, max_ram);
+  pumpkin_server_set_cpu_weight(self->current, pumpkin_parse_weight_entry(self->entry_cpu_weight));
+  pumpkin_server_set_io_weight(self->current, pumpkin_parse_weight_entry(self->entry_io_weight));
+  if (self->drop_launch_profile != NULL) {
+    pumpkin_server_set_launch_profile(self->current, selected_launch_profile(self));
+  }
   if (self->switch_auto_restart != NULL) {
     pumpkin_server_set_auto_restart(self->current, gtk_switch_get_active(self->switch_auto_restart));
   }
   if (self->entry_auto_restart_delay != NULL) {
     pumpkin_server_set_auto_restart_delay(self->current, auto_restart_delay);
   }
+  if (self->switch_leak_restart != NULL) {
+    pumpkin_server_set_leak_restart(self->current, gtk_switch_get_active(self->switch_leak_restart));
+  }
+  if (self->entry_hibernate_minutes != NULL) {
+    pumpkin_server_set_hibernate_minutes(self->current, pumpkin_get_entry_int_value(self->entry_hibernate_minutes));
+  }
+  if (self->entry_freeze_minutes != NULL) {
+    pumpkin_server_set_freeze_minutes(self->current, pumpkin_get_entry_int_value(self->entry_freeze_minutes));
+  }
+  if (self->entry_watchdog_seconds != NULL) {
+    pumpkin_server_set_watchdog_seconds(self->current, pumpkin_get_entry_int_value(self->entry_watchdog_seconds));
+  }
+  if (self->switch_watchdog_restart != NULL) {
+    pumpkin_server_set_watchdog_restart(self->current, gtk_switch_get_active(self->switch_watchdog_restart));
+  }
   if (self->switch_auto_update != NULL) {
     pumpkin_server_set_auto_update_enabled(self->current, gtk_switch_get_active(self->switch_auto_update));
   }
@@ -11642,6 +13679,13 @@ save_settings_impl(PumpkinWindow *self, gboolean restart_server)
     }
   }
 
+  if (!restart_after_save && pumpkin_server_get_limits_live(self->current)) {
+    g_autoptr(GError) limits_error = NULL;
+    if (!pumpkin_server_apply_limits(self->current, &limits_error)) {
+      append_log(self, limits_error != NULL ? limits_error->message : "Failed to apply resource limits");
+    }
+  }
+
   if (self->config != NULL) {
     const char *download_url = gtk_editable_get_text(GTK_EDITABLE(self->entry_download_url));
     pumpkin_config_set_default_download_url(self->config, download_url);
@@ -11706,10 +13750,17 @@ server_settings_require_restart(PumpkinWindow *self)
   if (!pumpkin_entry_matches_int(self->entry_max_players, pumpkin_server_get_max_players(server))) {
     return TRUE;
   }
-  if (pumpkin_parse_limit_entry(self->entry_max_cpu_cores, sys_cores) != pumpkin_server_get_max_cpu_cores(server)) {
-    return TRUE;
+  /* cgroup limits are adjusted in place, only process limits need a fresh launch. */
+  if (!pumpkin_server_get_limits_live(server)) {
+    if (pumpkin_parse_limit_entry(self->entry_max_cpu_cores, sys_cores) != pumpkin_server_get_max_cpu_cores(server)) {
+      return TRUE;
+    }
+    if (pumpkin_parse_limit_entry(self->entry_max_ram_mb, sys_ram_mb) != pumpkin_server_get_max_ram_mb(server)) {
+      return TRUE;
+    }
   }
-  if (pumpkin_parse_limit_entry(self->entry_max_ram_mb, sys_ram_mb) != pumpkin_server_get_max_ram_mb(server)) {
+  if (self->drop_launch_profile != NULL &&
+      g_strcmp0(selected_launch_profile(self), pumpkin_server_get_launch_profile(server)) != 0) {
     return TRUE;
   }
   if (!pumpkin_entry_matches_string(self->entry_rcon_host, pumpkin_server_get_rcon_host(server))) {
@@ -11802,6 +13853,7 @@ pumpkin_window_init(PumpkinWindow *self)
 
   self->store = pumpkin_server_store_new();
   networks_load(self);
+  network_players_load(self);
   load_server_list(self);
 
   g_signal_connect(self->server_list, "row-selected", G_CALLBACK(on_server_selected), self);
@@ -11827,6 +13879,10 @@ pumpkin_window_init(PumpkinWindow *self)
   if (self->btn_network_details_back != NULL) {
     g_signal_connect(self->btn_network_details_back, "clicked", G_CALLBACK(on_network_details_back), self);
   }
+  if (self->network_details_player_search != NULL) {
+    g_signal_connect(self->network_details_player_search, "search-changed",
+                     G_CALLBACK(on_network_details_player_search_changed), self);
+  }
   g_signal_connect(self->btn_details_start, "clicked", G_CALLBACK(on_details_start), self);
   g_signal_connect(self->btn_details_stop, "clicked", G_CALLBACK(on_details_stop), self);
   g_signal_connect(self->btn_details_restart, "clicked", G_CALLBACK(on_details_restart), self);
@@ -11877,7 +13933,8 @@ pumpkin_window_init(PumpkinWindow *self)
   }
   g_signal_connect(self->btn_choose_icon, "clicked", G_CALLBACK(on_choose_icon), self);
   g_signal_connect(self->btn_reset_icon, "clicked", G_CALLBACK(on_reset_icon), self);
-  g_signal_connect(self->player_list, "row-activated", G_CALLBACK(on_player_row_activated), self);
+  setup_player_list_view(self);
+  g_signal_connect(self->player_list, "activate", G_CALLBACK(on_player_list_activate), self);
   if (self->player_list != NULL) {
     GtkEventController *motion = gtk_event_controller_motion_new();
     g_signal_connect(motion, "enter", G_CALLBACK(on_player_list_pointer_enter), self);
@@ -11958,6 +14015,15 @@ pumpkin_window_init(PumpkinWindow *self)
   if (self->entry_stats_sample_msec != NULL) {
     g_signal_connect(self->entry_stats_sample_msec, "changed", G_CALLBACK(on_settings_changed), self);
   }
+  if (self->entry_cpu_weight != NULL) {
+    g_signal_connect(self->entry_cpu_weight, "changed", G_CALLBACK(on_settings_changed), self);
+  }
+  if (self->entry_io_weight != NULL) {
+    g_signal_connect(self->entry_io_weight, "changed", G_CALLBACK(on_settings_changed), self);
+  }
+  if (self->drop_launch_profile != NULL) {
+    g_signal_connect(self->drop_launch_profile, "notify::selected", G_CALLBACK(on_launch_profile_changed), self);
+  }
   if (self->entry_max_cpu_cores != NULL) {
     g_signal_connect(self->entry_max_cpu_cores, "changed", G_CALLBACK(on_settings_changed), self);
   }
@@ -11976,6 +14042,15 @@ pumpkin_window_init(PumpkinWindow *self)
   if (self->entry_auto_restart_delay != NULL) {
     g_signal_connect(self->entry_auto_restart_delay, "changed", G_CALLBACK(on_settings_changed), self);
   }
+  if (self->entry_hibernate_minutes != NULL) {
+    g_signal_connect(self->entry_hibernate_minutes, "changed", G_CALLBACK(on_settings_changed), self);
+  }
+  if (self->entry_freeze_minutes != NULL) {
+    g_signal_connect(self->entry_freeze_minutes, "changed", G_CALLBACK(on_settings_changed), self);
+  }
+  if (self->entry_watchdog_seconds != NULL) {
+    g_signal_connect(self->entry_watchdog_seconds, "changed", G_CALLBACK(on_settings_changed), self);
+  }
   if (self->entry_auto_update_time != NULL) {
     g_signal_connect(self->entry_auto_update_time, "changed", G_CALLBACK(on_settings_changed), self);
   }
@@ -11983,6 +14058,14 @@ pumpkin_window_init(PumpkinWindow *self)
     g_signal_connect(self->switch_auto_restart, "notify::active",
                      G_CALLBACK(on_settings_switch_changed), self);
   }
+  if (self->switch_leak_restart != NULL) {
+    g_signal_connect(self->switch_leak_restart, "notify::active",
+                     G_CALLBACK(on_settings_switch_changed), self);
+  }
+  if (self->switch_watchdog_restart != NULL) {
+    g_signal_connect(self->switch_watchdog_restart, "notify::active",
+                     G_CALLBACK(on_settings_switch_changed), self);
+  }
   if (self->switch_auto_update != NULL) {
     g_signal_connect(self->switch_auto_update, "notify::active",
                      G_CALLBACK(on_settings_switch_changed), self);
@@ -12015,6 +14098,12 @@ pumpkin_window_init(PumpkinWindow *self)
     g_signal_connect(self->switch_auto_start_servers, "notify::active",
                      G_CALLBACK(on_settings_switch_changed), self);
   }
+  if (self->entry_start_concurrency != NULL) {
+    g_signal_connect(self->entry_start_concurrency, "changed", G_CALLBACK(on_settings_changed), self);
+  }
+  if (self->entry_avatar_url != NULL) {
+    g_signal_connect(self->entry_avatar_url, "changed", G_CALLBACK(on_settings_changed), self);
+  }
   if (self->drop_date_format != NULL) {
     g_signal_connect(self->drop_date_format, "notify::selected",
                      G_CALLBACK(on_settings_switch_changed), self);
@@ -12100,13 +14189,33 @@ pumpkin_window_init(PumpkinWindow *self)
   }
 
   self->config = pumpkin_config_load(NULL);
-  self->live_player_names = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
-  self->platform_hint_by_ip = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  self->player_states = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)player_state_free);
-  self->player_states_by_uuid = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  self->player_states_by_name = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  self->deleted_player_keys = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-  self->player_head_downloads = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  self->live_player_names = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                  (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->platform_hint_by_ip = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                    (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->player_ping_by_ip = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  self->memory_rollup_by_server = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  self->memory_trends = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                              (GDestroyNotify)memory_trend_entry_free);
+  self->pressure_watches = g_ptr_array_new_with_free_func((GDestroyNotify)pressure_watch_free);
+  self->hibernations = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, hibernation_free_entry);
+  self->watchdogs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, watchdog_free_entry);
+  self->startup_runs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, startup_run_free);
+  self->session_trackers = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, session_tracker_free);
+  self->join_trackers = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, join_tracker_free);
+  self->start_queue = g_ptr_array_new_with_free_func(start_queue_item_free);
+  self->pending_restart_servers = g_hash_table_new_full(g_direct_hash, g_direct_equal, g_object_unref, NULL);
+  self->player_states = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                              (GDestroyNotify)pumpkin_intern_unref, (GDestroyNotify)player_state_free);
+  self->player_states_by_uuid = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                      (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->player_states_by_name = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                      (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->player_search_index = pumpkin_search_index_new();
+  self->deleted_player_keys = g_hash_table_new_full(pumpkin_atom_hash, g_direct_equal,
+                                                    (GDestroyNotify)pumpkin_intern_unref, NULL);
+  self->player_heads = pumpkin_head_cache_new(on_player_head_ready, self);
+  pumpkin_head_cache_set_base_url(self->player_heads, pumpkin_config_get_avatar_url(self->config));
   self->player_state_dirty = FALSE;
   self->last_player_state_flush_at = g_get_monotonic_time();
   self->console_buffers = g_hash_table_new_full(g_direct_hash, g_direct_equal, g_object_unref, g_object_unref);
@@ -12157,6 +14266,13 @@ pumpkin_window_init(PumpkinWindow *self)
       gtk_switch_set_active(self->switch_auto_start_servers,
                             pumpkin_config_get_auto_start_servers_enabled(self->config));
     }
+    if (self->entry_start_concurrency != NULL) {
+      g_autofree char *concurrency = g_strdup_printf("%d", pumpkin_config_get_start_concurrency(self->config));
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_start_concurrency), concurrency);
+    }
+    if (self->entry_avatar_url != NULL) {
+      gtk_editable_set_text(GTK_EDITABLE(self->entry_avatar_url), pumpkin_config_get_avatar_url(self->config));
+    }
     if (self->drop_date_format != NULL) {
       gtk_drop_down_set_selected(self->drop_date_format, (guint)pumpkin_config_get_date_format(self->config));
     }
@@ -12213,8 +14329,50 @@ pumpkin_window_init(PumpkinWindow *self)
   if (self->stats_graph_players != NULL) {
     gtk_drawing_area_set_draw_func(self->stats_graph_players, stats_graph_draw_players, self, NULL);
   }
-  if (self->stats_graph_disk != NULL) {
-    gtk_drawing_area_set_draw_func(self->stats_graph_disk, stats_graph_draw_disk, self, NULL);
+  if (self->stats_graph_tps != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_tps, stats_graph_draw_tps, self, NULL);
+  }
+  if (self->stats_graph_io != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_io, stats_graph_draw_io, self, NULL);
+  }
+  if (self->stats_graph_faults != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_faults, stats_graph_draw_faults, self, NULL);
+  }
+  if (self->stats_io_section != NULL) {
+    gtk_widget_set_visible(GTK_WIDGET(self->stats_io_section), pumpkin_process_stats_supported());
+  }
+  if (self->stats_graph_net != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_net, stats_graph_draw_net, self, NULL);
+  }
+  if (self->stats_net_section != NULL) {
+    gtk_widget_set_visible(GTK_WIDGET(self->stats_net_section), pumpkin_tcp_diag_supported());
+  }
+  if (self->stats_graph_sched != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_sched, stats_graph_draw_sched, self, NULL);
+  }
+  if (self->stats_graph_ctx != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_ctx, stats_graph_draw_ctx, self, NULL);
+  }
+  if (self->stats_sched_section != NULL) {
+    gtk_widget_set_visible(GTK_WIDGET(self->stats_sched_section), pumpkin_process_stats_supported());
+  }
+  if (self->stats_graph_mem != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_mem, stats_graph_draw_mem, self, NULL);
+  }
+  if (self->stats_mem_section != NULL) {
+    gtk_widget_set_visible(GTK_WIDGET(self->stats_mem_section), pumpkin_process_stats_supported());
+  }
+  if (self->stats_graph_psi_host != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_psi_host, stats_graph_draw_psi_host, self, NULL);
+  }
+  if (self->stats_graph_psi_server != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_graph_psi_server, stats_graph_draw_psi_server, self, NULL);
+  }
+  if (self->stats_player_heatmap != NULL) {
+    gtk_drawing_area_set_draw_func(self->stats_player_heatmap, stats_graph_draw_player_heatmap, self, NULL);
+  }
+  if (self->stats_psi_section != NULL) {
+    gtk_widget_set_visible(GTK_WIDGET(self->stats_psi_section), pumpkin_pressure_supported());
   }
   restart_stats_refresh_timer(self);
 }
@@ -12227,6 +14385,9 @@ pumpkin_window_dispose(GObject *object)
     player_states_mark_all_offline(self);
     player_states_save(self, self->current);
   }
+  sessions_close(self);
+  network_players_close(self);
+  join_latency_flush(self);
   clear_network_details_dialog_tracking(self);
   if (self->config != NULL) {
     pumpkin_config_free(self->config);
@@ -12240,6 +14401,35 @@ pumpkin_window_dispose(GObject *object)
     g_hash_table_destroy(self->platform_hint_by_ip);
     self->platform_hint_by_ip = NULL;
   }
+  if (self->player_ping_by_ip != NULL) {
+    g_hash_table_destroy(self->player_ping_by_ip);
+    self->player_ping_by_ip = NULL;
+  }
+  pumpkin_tcp_sample_clear(&self->last_tcp_sample);
+  g_clear_pointer(&self->tcp_sampler, pumpkin_tcp_sampler_free);
+  g_clear_pointer(&self->sched_sampler, pumpkin_sched_sampler_free);
+  if (self->memory_rollup_by_server != NULL) {
+    g_hash_table_destroy(self->memory_rollup_by_server);
+    self->memory_rollup_by_server = NULL;
+  }
+  if (self->memory_trends != NULL) {
+    g_hash_table_destroy(self->memory_trends);
+    self->memory_trends = NULL;
+  }
+  g_clear_pointer(&self->pressure_watches, g_ptr_array_unref);
+  g_clear_pointer(&self->hibernations, g_hash_table_unref);
+  g_clear_pointer(&self->watchdogs, g_hash_table_unref);
+  g_clear_pointer(&self->startup_runs, g_hash_table_unref);
+  g_clear_pointer(&self->join_trackers, g_hash_table_unref);
+  if (self->start_queue_source_id != 0) {
+    g_source_remove(self->start_queue_source_id);
+    self->start_queue_source_id = 0;
+  }
+  g_clear_pointer(&self->start_queue, g_ptr_array_unref);
+  if (self->pending_restart_servers != NULL) {
+    g_hash_table_destroy(self->pending_restart_servers);
+    self->pending_restart_servers = NULL;
+  }
   if (self->console_buffers != NULL) {
     g_hash_table_destroy(self->console_buffers);
     self->console_buffers = NULL;
@@ -12274,10 +14464,21 @@ pumpkin_window_dispose(GObject *object)
     g_hash_table_destroy(self->download_progress_state);
     self->download_progress_state = NULL;
   }
+  if (self->player_list != NULL) {
+    gtk_list_view_set_model(self->player_list, NULL);
+  }
+  g_clear_pointer(&self->player_bound_items, g_hash_table_unref);
+  g_clear_pointer(&self->player_items, g_hash_table_unref);
+  g_clear_pointer(&self->player_list_dirty_keys, g_hash_table_unref);
+  g_clear_object(&self->player_store);
+  g_clear_object(&self->player_filter);
+  g_clear_object(&self->player_sorter);
+  g_clear_pointer(&self->player_list_query, g_free);
   if (self->player_states != NULL) {
     g_hash_table_destroy(self->player_states);
     self->player_states = NULL;
   }
+  g_clear_pointer(&self->player_journal, player_journal_free);
   if (self->player_states_by_uuid != NULL) {
     g_hash_table_destroy(self->player_states_by_uuid);
     self->player_states_by_uuid = NULL;
@@ -12286,14 +14487,16 @@ pumpkin_window_dispose(GObject *object)
     g_hash_table_destroy(self->player_states_by_name);
     self->player_states_by_name = NULL;
   }
+  g_clear_pointer(&self->player_search_index, pumpkin_search_index_free);
   if (self->deleted_player_keys != NULL) {
     g_hash_table_destroy(self->deleted_player_keys);
     self->deleted_player_keys = NULL;
   }
-  if (self->player_head_downloads != NULL) {
-    g_hash_table_destroy(self->player_head_downloads);
-    self->player_head_downloads = NULL;
+  if (self->player_heads_refresh_id != 0) {
+    g_source_remove(self->player_heads_refresh_id);
+    self->player_heads_refresh_id = 0;
   }
+  g_clear_pointer(&self->player_heads, pumpkin_head_cache_free);
   g_clear_pointer(&self->pending_details_page, g_free);
   g_clear_pointer(&self->pending_view_page, g_free);
   g_clear_pointer(&self->current_log_path, g_free);
@@ -12324,6 +14527,11 @@ pumpkin_window_dispose(GObject *object)
     g_source_remove(self->players_refresh_id);
     self->players_refresh_id = 0;
   }
+  player_watch_set_server(self, NULL);
+  g_clear_pointer(&self->player_whitelist_set, g_hash_table_unref);
+  g_clear_pointer(&self->player_banned_reason_map, g_hash_table_unref);
+  g_clear_pointer(&self->player_banned_ip_reason_map, g_hash_table_unref);
+  g_clear_pointer(&self->player_op_level_map, g_hash_table_unref);
   if (self->latest_poll_id != 0) {
     g_source_remove(self->latest_poll_id);
     self->latest_poll_id = 0;
@@ -12436,9 +14644,9 @@ update_live_player_names(PumpkinWindow *self, const char *line)
       allow_deleted_player_tracking(self, NULL, name);
       PlayerState *state = ensure_player_state(self, NULL, name, TRUE);
       if (state != NULL && ip != NULL && *ip != '\0' && g_strcmp0(state->last_ip, ip) != 0) {
-        g_free(state->last_ip);
-        state->last_ip = g_strdup(ip);
-        player_states_set_dirty(self);
+        pumpkin_intern_assign(&state->last_ip, ip);
+        player_search_index_update(self, state);
+        player_state_changed(self, state);
       }
       player_state_mark_online(self, state, platform_hint);
       return;
@@ -12578,7 +14786,7 @@ update_live_player_names(PumpkinWindow *self, const char *line)
     if (state != NULL) {
       player_state_mark_offline(self, state);
     } else {
-      g_hash_table_remove(self->live_player_names, left_name);
+      g_hash_table_remove(self->live_player_names, pumpkin_intern_peek(left_name));
     }
     return;
   }
@@ -12661,11 +14869,50 @@ pumpkin_window_class_init(PumpkinWindowClass *class)
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_row);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_usage);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_players);
-  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_disk);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_tps);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_cpu);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_ram);
-  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_disk);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_tps);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_players);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_io_section);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_io);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_faults);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_io_read);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_io_write);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_faults_major);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_faults_minor);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_net_section);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_net);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_net_rx);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_net_tx);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_net_conns);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_sched_section);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_sched);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_ctx);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_sched_wait);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_ctx_voluntary);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_ctx_involuntary);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_mem_section);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_mem);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_mem_anon);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_mem_file);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_mem_shmem);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_mem_swap);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_mem_pss);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_psi_section);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_psi_host);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_graph_psi_server);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_host_memory);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_host_cpu);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_host_io);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_memory);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_cpu);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_io);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_stats_psi_alert);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_startup_history_box);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_player_heatmap);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_player_peaks);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, stats_join_latency_box);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, console_warning_revealer);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, console_warning_label);
 
@@ -12700,6 +14947,8 @@ pumpkin_window_class_init(PumpkinWindowClass *class)
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, btn_details_check_updates);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, details_action_row);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, network_details_members_box);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, network_details_player_search);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, network_details_players);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, network_details_progress);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_command);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, btn_console_send);
@@ -12726,6 +14975,10 @@ pumpkin_window_class_init(PumpkinWindowClass *class)
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_stats_sample_msec);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_max_cpu_cores);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_max_ram_mb);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_cpu_weight);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_io_weight);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, drop_launch_profile);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_launch_profile);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_java_port_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_bedrock_port_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_max_players_hint);
@@ -12733,6 +14986,11 @@ pumpkin_window_class_init(PumpkinWindowClass *class)
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_max_cpu_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_max_ram_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_auto_restart);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_leak_restart);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_hibernate_minutes);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_freeze_minutes);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_watchdog_seconds);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_watchdog_restart);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_auto_restart_delay);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_auto_update);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_auto_update_schedule);
@@ -12755,12 +15013,15 @@ pumpkin_window_class_init(PumpkinWindowClass *class)
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_rcon_host_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_rcon_port_hint);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_resource_limits);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, label_cpu_set);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_use_cache);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_run_in_background);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_detailed_overview_cards);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_autostart_on_boot);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_start_minimized);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, switch_auto_start_servers);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_start_concurrency);
+  gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, entry_avatar_url);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, drop_date_format);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, drop_time_format);
   gtk_widget_class_bind_template_child(widget_class, PumpkinWindow, autostart_server_list);
@@ -12789,30 +15050,17 @@ auto_start_context_free(AutoStartContext *ctx)
 }
 
 static gboolean
-auto_start_server_timeout_cb(gpointer user_data)
+auto_start_server_now(PumpkinWindow *self, PumpkinServer *server)
 {
-  AutoStartContext *ctx = user_data;
-  if (ctx == NULL || ctx->self == NULL || ctx->server == NULL) {
-    auto_start_context_free(ctx);
-    return G_SOURCE_REMOVE;
-  }
-
-  PumpkinWindow *self = ctx->self;
-  PumpkinServer *server = ctx->server;
-  ensure_server_log_handler(self, server);
-
-  if (server_is_running_ui(self, server)) {
-    auto_start_context_free(ctx);
-    return G_SOURCE_REMOVE;
-  }
   if (!server_has_installation(self, server)) {
     append_log_for_server(self, server, "[SMPK] Auto-start skipped: Pumpkin is not installed.");
-    auto_start_context_free(ctx);
-    return G_SOURCE_REMOVE;
+    return FALSE;
   }
 
   g_autoptr(GError) error = NULL;
-  if (!pumpkin_server_start(server, &error)) {
+  sync_server_cgroup_group(self, server);
+  gboolean started = pumpkin_server_start(server, &error);
+  if (!started) {
     if (error != NULL) {
       append_log_for_server(self, server, error->message);
       if (self->current == server) {
@@ -12831,6 +15079,24 @@ auto_start_server_timeout_cb(gpointer user_data)
   }
 
   queue_overview_refresh(self, self->current == server);
+  return started;
+}
+
+static gboolean
+auto_start_server_timeout_cb(gpointer user_data)
+{
+  AutoStartContext *ctx = user_data;
+  if (ctx == NULL || ctx->self == NULL || ctx->server == NULL) {
+    auto_start_context_free(ctx);
+    return G_SOURCE_REMOVE;
+  }
+
+  PumpkinWindow *self = ctx->self;
+  PumpkinServer *server = ctx->server;
+  ensure_server_log_handler(self, server);
+  if (!server_is_running_ui(self, server)) {
+    start_queue_enqueue(self, server, auto_start_server_now, network_proxy_for_server(self, server));
+  }
   auto_start_context_free(ctx);
   return G_SOURCE_REMOVE;
 }